@@ -30,11 +30,11 @@ namespace llp_utils {
  * 
  * Total size: 4 + 32 + 32 + 4 + 4 + 4 + 8 + 4 = 92 bytes
  * 
- * @param data The network payload containing the serialized block header
+ * @param data The network payload containing the serialized block header, usually a slice of the receive buffer
  * @return Deserialized LLP::CBlock instance
  * @throws std::runtime_error if the payload is too small or contains invalid data
  */
-inline ::LLP::CBlock deserialize_block_header(network::Payload const& data)
+inline ::LLP::CBlock deserialize_block_header(network::Payload_slice const& data)
 {
     // Compact block header size: nVersion (4) + hashPrevBlock (32) + hashMerkleRoot (32) + 
     // nChannel (4) + nHeight (4) + nBits (4) + nNonce (8) + nTime (4)
@@ -133,25 +133,25 @@ namespace nexusminer
 	}
 
 	/** Format payload bytes as hex string (up to max_bytes) **/
-	inline std::string format_llp_payload_hex(network::Shared_payload const& payload, std::size_t max_bytes = 16)
+	inline std::string format_llp_payload_hex(network::Payload_slice const& payload, std::size_t max_bytes = 16)
 	{
-		if (!payload || payload->empty())
+		if (payload.empty())
 		{
 			return "";
 		}
 		
 		std::string result;
-		std::size_t bytes_to_show = std::min(payload->size(), max_bytes);
+		std::size_t bytes_to_show = std::min(payload.size(), max_bytes);
 		result.reserve(bytes_to_show * 3);
 		
 		for (std::size_t i = 0; i < bytes_to_show; ++i)
 		{
 			char buf[4];
-			snprintf(buf, sizeof(buf), "%02x ", (*payload)[i]);
+			snprintf(buf, sizeof(buf), "%02x ", payload[i]);
 			result += buf;
 		}
 		
-		if (payload->size() > max_bytes)
+		if (payload.size() > max_bytes)
 		{
 			result += "...";
 		}
@@ -159,6 +159,11 @@ namespace nexusminer
 		return result;
 	}
 
+	inline std::string format_llp_payload_hex(network::Shared_payload const& payload, std::size_t max_bytes = 16)
+	{
+		return format_llp_payload_hex(network::Payload_slice{ payload }, max_bytes);
+	}
+
 }
 
 #endif
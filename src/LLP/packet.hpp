@@ -100,12 +100,12 @@ namespace nexusminer
 		{
 		}
 
-		Packet(std::uint8_t header, network::Payload const& data)
+		Packet(std::uint8_t header, network::Payload data)
 			: m_header{ header }
 			, m_is_valid{ true }
 		{
-			m_data = std::make_shared<network::Payload>(data);
-			m_length = m_data->size();
+			m_data = network::Payload_slice{ std::make_shared<network::Payload>(std::move(data)) };
+			m_length = static_cast<std::uint32_t>(m_data.size());
 		}
 
 		Packet(std::uint8_t header, network::Shared_payload data)
@@ -115,11 +115,20 @@ namespace nexusminer
 		{
 			if (data)
 			{
-				m_data = std::move(data);
-				m_length = m_data->size();
+				m_data = network::Payload_slice{ std::move(data) };
+				m_length = static_cast<std::uint32_t>(m_data.size());
 			}
 		}
 
+		// payload is a slice of a shared buffer, e.g. the receive buffer of the connection. nothing is copied.
+		Packet(std::uint8_t header, network::Payload_slice data)
+			: m_header{ header }
+			, m_length{ static_cast<std::uint32_t>(data.size()) }
+			, m_data{ std::move(data) }
+			, m_is_valid{ true }
+		{
+		}
+
 		explicit Packet(std::uint8_t header)
 			: m_header{ header }
 			, m_length{ 0 }
@@ -127,7 +136,7 @@ namespace nexusminer
 		{
 		}
 
-		// creates a packet from received buffer
+		// creates a packet from received buffer. the payload references the buffer.
 		explicit Packet(network::Shared_payload buffer)
 		{
 			m_is_valid = true;
@@ -148,7 +157,8 @@ namespace nexusminer
 			else if (buffer->size() > 4)
 			{
 				m_length = ((*buffer)[1] << 24) + ((*buffer)[2] << 16) + ((*buffer)[3] << 8) + ((*buffer)[4]);
-				m_data = std::make_shared<network::Payload>(buffer->begin() + 5, buffer->end());
+				auto const data_size = buffer->size() - 5;
+				m_data = network::Payload_slice{ std::move(buffer), 5, data_size };
 			}
 		}
 
@@ -158,7 +168,7 @@ namespace nexusminer
 			BYTE 6 - End : Data      **/
 		std::uint8_t		m_header;
 		std::uint32_t		m_length;
-		network::Shared_payload m_data;
+		network::Payload_slice m_data;
 		bool m_is_valid;
 
 		/**
@@ -173,7 +183,23 @@ namespace nexusminer
 		 */
 		inline bool is_auth_packet() const
 		{
-			return (m_header >= MINER_AUTH_INIT && m_header <= SESSION_KEEPALIVE);
+			return is_auth_header(m_header);
+		}
+
+		static inline bool is_auth_header(std::uint8_t header)
+		{
+			return (header >= MINER_AUTH_INIT && header <= SESSION_KEEPALIVE);
+		}
+
+		/**
+		 * @brief Check if a packet with this header carries the 4 byte length field on the wire
+		 *
+		 * Data packets (< 128) and Falcon Authentication packets (207-212) are followed by a
+		 * big-endian length and the payload. All other headers are sent as a single byte.
+		 */
+		static inline bool has_length_field(std::uint8_t header)
+		{
+			return (header < 128 || is_auth_header(header));
 		}
 
 		/**
@@ -267,29 +293,48 @@ namespace nexusminer
 			return false;
 		}
 
-		network::Shared_payload get_bytes()
+		// wire format in one contiguous buffer
+		network::Shared_payload get_bytes() const
 		{
 			if (!is_valid())
 			{
 				return network::Shared_payload{};
 			}
 
-			network::Payload BYTES(1, m_header);
+			auto const wire = get_gather_payload();
+			auto bytes = std::make_shared<network::Payload>();
+			bytes->reserve(wire.size());
+			bytes->insert(bytes->end(), wire.m_prefix.begin(), wire.m_prefix.begin() + wire.m_prefix_size);
+			bytes->insert(bytes->end(), wire.m_body.begin(), wire.m_body.end());
+			return bytes;
+		}
+
+		// wire format as header/length prefix plus the payload slice for a scatter-gather write. the payload is not copied.
+		network::Gather_payload get_gather_payload() const
+		{
+			network::Gather_payload wire;
+			if (!is_valid())
+			{
+				return wire;
+			}
+
+			wire.m_prefix[0] = m_header;
+			wire.m_prefix_size = 1;
 
 			/** Handle for Data Packets (header < 128) or Authentication Packets (207-212) **/
 			// Both standard data packets and Falcon auth packets use the same wire format:
 			// [header (1 byte)] [length (4 bytes, big-endian)] [payload data]
-			if ((m_header < 128 || is_auth_packet()) && m_length > 0)
+			if (has_length_field(m_header) && m_length > 0)
 			{
-				BYTES.push_back((m_length >> 24));
-				BYTES.push_back((m_length >> 16));
-				BYTES.push_back((m_length >> 8));
-				BYTES.push_back(m_length);
-
-				BYTES.insert(BYTES.end(), m_data->begin(), m_data->end());
+				wire.m_prefix[1] = static_cast<std::uint8_t>(m_length >> 24);
+				wire.m_prefix[2] = static_cast<std::uint8_t>(m_length >> 16);
+				wire.m_prefix[3] = static_cast<std::uint8_t>(m_length >> 8);
+				wire.m_prefix[4] = static_cast<std::uint8_t>(m_length);
+				wire.m_prefix_size = 5;
+				wire.m_body = m_data;
 			}
 
-			return std::make_shared<network::Payload>(BYTES);
+			return wire;
 		}
 
 		inline Packet get_packet(std::uint8_t header) const
@@ -299,58 +344,6 @@ namespace nexusminer
 		}
 	};
 
-	inline Packet extract_packet_from_buffer(network::Shared_payload buffer, std::size_t& remaining_size, std::size_t start_index)
-	{
-		Packet packet;
-		remaining_size = 0;		// buffer invalid
-		if (!buffer)
-		{
-			return packet;
-		}
-		else if (buffer->empty())
-		{
-			return packet;
-		}
-
-		if (start_index >= buffer->size())	// invalid start_index given
-		{
-			return packet;
-		}
-
-		auto const buffer_start = buffer->begin() + start_index;
-		auto const buffer_size = std::distance(buffer_start, buffer->end());
-		if (buffer_size == 1)
-		{
-			packet.m_header = (*buffer)[start_index];
-			packet.m_is_valid = true;
-			remaining_size = 0;		// buffer has only 1 byte size left -> header
-			return packet;
-		}
-		else if (buffer_size > 1 && buffer_size < 5)	// data paket but not even correct length field was transmitted
-		{
-			return packet;
-		}
-		else
-		{
-			std::uint32_t const length = ((*buffer)[start_index + 1] << 24) + ((*buffer)[start_index + 2] << 16) + ((*buffer)[start_index + 3] << 8) + ((*buffer)[start_index + 4]);
-
-			if (length > std::distance(buffer_start + 5, buffer->end()))
-			{
-				return packet;
-			}
-
-			packet.m_is_valid = true;
-			packet.m_header = (*buffer)[start_index];
-			packet.m_length = length;
-			packet.m_data = std::make_shared<network::Payload>(buffer_start + 5, buffer_start + 5 + length);
-
-			remaining_size = buffer_size - (5 + packet.m_data->size());		// header (1 byte) + 4 byte length 
-		}
-
-
-		return packet;
-	}
-
 	/** Wrapper for backward compatibility - delegates to llp_logging.hpp **/
 	inline const char* get_packet_header_name(std::uint8_t header)
 	{
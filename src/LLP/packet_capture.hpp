@@ -0,0 +1,116 @@
+#ifndef NEXUSMINER_LLP_PACKET_CAPTURE_HPP
+#define NEXUSMINER_LLP_PACKET_CAPTURE_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include "network/types.hpp"
+#include "packet.hpp"
+#include "packet_framer.hpp"
+#include "packet_trace.hpp"
+
+namespace nexusminer
+{
+	// one packet or connection event of a capture file
+	struct Packet_capture_record
+	{
+		std::uint64_t m_timestamp{ 0 };		// unix time in ns
+		Packet_trace::Direction m_direction{ Packet_trace::Direction::receive };
+		std::uint16_t m_stream{ 0 };
+		std::uint8_t m_header{ 0 };
+		std::uint32_t m_length{ 0 };
+		network::Payload m_data{};
+
+		// the packet as it was on the wire
+		network::Shared_payload get_wire_bytes() const
+		{
+			auto bytes = std::make_shared<network::Payload>();
+			bytes->reserve(5 + m_data.size());
+			bytes->push_back(m_header);
+			if (Packet::has_length_field(m_header) && m_length > 0)
+			{
+				bytes->push_back(static_cast<std::uint8_t>(m_length >> 24));
+				bytes->push_back(static_cast<std::uint8_t>(m_length >> 16));
+				bytes->push_back(static_cast<std::uint8_t>(m_length >> 8));
+				bytes->push_back(static_cast<std::uint8_t>(m_length));
+				bytes->insert(bytes->end(), m_data.begin(), m_data.end());
+			}
+			return bytes;
+		}
+	};
+
+	/** Reads the binary capture files written by Packet_trace (see there for the layout). **/
+	class Packet_capture_reader
+	{
+	public:
+
+		bool open(std::string const& file_name)
+		{
+			m_file.open(file_name, std::ios::binary);
+			char magic[8];
+			if (!m_file.read(magic, sizeof(magic)) || std::memcmp(magic, "NXLLPCAP", sizeof(magic)) != 0)
+			{
+				m_file.close();
+				return false;
+			}
+
+			m_version = static_cast<std::uint32_t>(read_le(4));
+			if (!m_file || m_version == 0 || m_version > Packet_trace::capture_version)
+			{
+				m_file.close();
+				return false;
+			}
+			return true;
+		}
+
+		// false at the end of the file or on a truncated record
+		bool next(Packet_capture_record& record)
+		{
+			if (!m_file.is_open())
+			{
+				return false;
+			}
+
+			record.m_timestamp = read_le(8);
+			record.m_direction = static_cast<Packet_trace::Direction>(read_le(1));
+			record.m_stream = m_version >= 2 ? static_cast<std::uint16_t>(read_le(2)) : 0;
+			record.m_header = static_cast<std::uint8_t>(read_le(1));
+			record.m_length = static_cast<std::uint32_t>(read_le(4));
+			auto const size = static_cast<std::uint32_t>(read_le(4));
+			// same bound as the receive path, a bigger record means a corrupt file
+			if (!m_file || size > Packet_framer::default_max_packet_length)
+			{
+				return false;
+			}
+			record.m_data.resize(size);
+			if (size > 0)
+			{
+				m_file.read(reinterpret_cast<char*>(record.m_data.data()), size);
+			}
+			return static_cast<bool>(m_file);
+		}
+
+		std::uint32_t version() const { return m_version; }
+
+	private:
+
+		std::uint64_t read_le(std::size_t size)
+		{
+			unsigned char bytes[8]{};
+			m_file.read(reinterpret_cast<char*>(bytes), size);
+			std::uint64_t value = 0;
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				value |= static_cast<std::uint64_t>(bytes[i]) << (8 * i);
+			}
+			return value;
+		}
+
+		std::ifstream m_file;
+		std::uint32_t m_version{ 0 };
+	};
+}
+
+#endif
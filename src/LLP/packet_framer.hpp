@@ -0,0 +1,157 @@
+#ifndef NEXUSMINER_LLP_PACKET_FRAMER_HPP
+#define NEXUSMINER_LLP_PACKET_FRAMER_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include "network/types.hpp"
+#include "packet.hpp"
+
+namespace nexusminer
+{
+	/** Reassembles LLP packets from the TCP byte stream of one connection.
+
+		TCP does not preserve message boundaries, a packet can arrive split over several reads and one read
+		can carry several packets. The framer appends every read behind the unread bytes of its receive
+		buffer and hands out complete packets whose payload is a slice of that buffer. The buffer is reused
+		for the whole connection: consumed space is reclaimed by moving the partial packet at the tail back
+		to the front and the capacity only grows when a single packet does not fit. If a packet handed out
+		earlier still references the buffer, the unread bytes move to a fresh buffer instead. **/
+	class Packet_framer
+	{
+	public:
+
+		enum class Result { packet, need_more_data, corrupt };
+
+		// largest accepted payload. a bigger length field means the stream is out of sync.
+		static constexpr std::uint32_t default_max_packet_length = 1024 * 1024;
+		static constexpr std::size_t default_initial_capacity = 4096;
+
+		explicit Packet_framer(std::size_t initial_capacity = default_initial_capacity,
+			std::uint32_t max_packet_length = default_max_packet_length)
+			: m_buffer{ std::make_shared<network::Payload>(initial_capacity) }
+			, m_read_index{ 0 }
+			, m_write_index{ 0 }
+			, m_max_packet_length{ max_packet_length }
+		{
+		}
+
+		void append(std::uint8_t const* data, std::size_t size)
+		{
+			if (size == 0)
+			{
+				return;
+			}
+
+			auto const unread = buffered();
+			if (m_buffer.use_count() > 1)
+			{
+				// packets still reference the buffer, continue in a new one
+				auto buffer = std::make_shared<network::Payload>(std::max(m_buffer->size(), unread + size));
+				std::memcpy(buffer->data(), m_buffer->data() + m_read_index, unread);
+				m_buffer = std::move(buffer);
+				m_read_index = 0;
+				m_write_index = unread;
+			}
+			else if (m_buffer->size() - m_write_index < size)
+			{
+				// move the unread bytes (at most one partial packet) to the front
+				if (m_read_index > 0)
+				{
+					std::memmove(m_buffer->data(), m_buffer->data() + m_read_index, unread);
+					m_read_index = 0;
+					m_write_index = unread;
+				}
+
+				if (m_buffer->size() - m_write_index < size)
+				{
+					m_buffer->resize(std::max(m_buffer->size() * 2, m_write_index + size));
+				}
+			}
+
+			std::memcpy(m_buffer->data() + m_write_index, data, size);
+			m_write_index += size;
+		}
+
+		void append(network::Payload const& data)
+		{
+			append(data.data(), data.size());
+		}
+
+		/** Extract the next complete packet, its payload is a slice of the receive buffer.
+			Returns need_more_data if the buffered bytes end inside a packet and corrupt if the length field
+			exceeds the maximum packet length. A corrupt stream can't be resynchronised, the caller has to
+			drop the connection. **/
+		Result next(Packet& packet)
+		{
+			auto const available = buffered();
+			if (available == 0)
+			{
+				return Result::need_more_data;
+			}
+
+			auto const* const packet_start = m_buffer->data() + m_read_index;
+			auto const header = packet_start[0];
+			if (!Packet::has_length_field(header))
+			{
+				packet = Packet{ header };
+				consume(1);
+				return Result::packet;
+			}
+
+			if (available < 5)
+			{
+				return Result::need_more_data;
+			}
+
+			std::uint32_t const length = (static_cast<std::uint32_t>(packet_start[1]) << 24) |
+				(static_cast<std::uint32_t>(packet_start[2]) << 16) |
+				(static_cast<std::uint32_t>(packet_start[3]) << 8) |
+				static_cast<std::uint32_t>(packet_start[4]);
+			if (length > m_max_packet_length)
+			{
+				return Result::corrupt;
+			}
+
+			if (available < 5 + static_cast<std::size_t>(length))
+			{
+				return Result::need_more_data;
+			}
+
+			packet = Packet{ header, network::Payload_slice{ m_buffer, m_read_index + 5, length } };
+			consume(5 + length);
+			return Result::packet;
+		}
+
+		// drop all buffered bytes, used when the connection changes. keeps the capacity.
+		void reset()
+		{
+			m_read_index = 0;
+			m_write_index = 0;
+		}
+
+		std::size_t buffered() const { return m_write_index - m_read_index; }
+		std::size_t capacity() const { return m_buffer->size(); }
+
+	private:
+
+		void consume(std::size_t size)
+		{
+			m_read_index += size;
+			if (m_read_index == m_write_index)
+			{
+				// everything consumed, start over at the front
+				m_read_index = 0;
+				m_write_index = 0;
+			}
+		}
+
+		network::Shared_payload m_buffer;
+		std::size_t m_read_index;
+		std::size_t m_write_index;
+		std::uint32_t m_max_packet_length;
+	};
+}
+
+#endif
@@ -0,0 +1,360 @@
+#ifndef NEXUSMINER_LLP_PACKET_TRACE_HPP
+#define NEXUSMINER_LLP_PACKET_TRACE_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <spdlog/spdlog.h>
+#include "network/types.hpp"
+#include "llp_logging.hpp"
+
+namespace nexusminer
+{
+	/** Sampled LLP wire tracing.
+
+		The send and receive paths only check one atomic flag while tracing is off. When a packet is traced,
+		the header, length and a shared reference to the payload are queued; hex formatting, header names
+		and the optional binary capture file are handled by a background thread. Tracing is on when the
+		logger runs at the configured trace level, or when a capture file is open. Sampling only thins out
+		the log, the capture file gets every packet and connection event so it can be replayed.
+
+		Capture file layout: "NXLLPCAP" magic, u32 version, then per record
+		u64 unix time in ns, u8 direction (0 = receive, 1 = send, 2 = connect, 3 = disconnect),
+		u16 stream (local port of the connection), u8 header, u32 length field, u32 captured payload size
+		and the payload bytes. All integers little-endian. Version 1 files have no stream field. **/
+	class Packet_trace
+	{
+	public:
+
+		enum class Direction : std::uint8_t { receive = 0, send = 1, connect = 2, disconnect = 3 };
+
+		static constexpr std::uint32_t capture_version = 2;
+		// bounds the queue for log-only records, capture file records are never dropped
+		static constexpr std::size_t max_queued_records = 4096;
+
+		// process wide tracer, shared by all connections like the spdlog registry
+		static Packet_trace& instance()
+		{
+			static Packet_trace packet_trace;
+			return packet_trace;
+		}
+
+		~Packet_trace()
+		{
+			stop();
+		}
+
+		/** Start tracing. sample_intervals[header] traces every n-th packet of that opcode, 0 disables it. **/
+		void start(std::shared_ptr<spdlog::logger> logger, spdlog::level::level_enum level,
+			std::array<std::uint32_t, 256> const& sample_intervals, std::string const& capture_file)
+		{
+			stop();
+
+			m_logger = std::move(logger);
+			m_level = level;
+			m_sample_intervals = sample_intervals;
+			m_log_enabled.store(m_logger && m_logger->should_log(m_level), std::memory_order_relaxed);
+			if (!capture_file.empty())
+			{
+				m_capture.open(capture_file, std::ios::binary | std::ios::trunc);
+				if (m_capture.is_open())
+				{
+					m_capture.write("NXLLPCAP", 8);
+					write_le(capture_version, 4);
+					m_capture_enabled = true;
+				}
+				else if (m_logger)
+				{
+					m_logger->error("[LLP TRACE] Unable to open capture file {}", capture_file);
+				}
+			}
+
+			if (!log_enabled() && !m_capture.is_open())
+			{
+				return;
+			}
+			start_consumer();
+		}
+
+		/** The logger level changed, log at the trace level from now on if the logger does. Keeps the capture file. **/
+		void update_log_level()
+		{
+			if (!m_logger)
+			{
+				return;
+			}
+			m_log_enabled.store(m_logger->should_log(m_level), std::memory_order_relaxed);
+			if (log_enabled() && !m_consumer.joinable())
+			{
+				start_consumer();
+			}
+		}
+
+		void stop()
+		{
+			m_enabled.store(false, std::memory_order_release);
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_stop = true;
+			}
+			m_condition.notify_one();
+			if (m_consumer.joinable())
+			{
+				m_consumer.join();
+			}
+			if (m_capture.is_open())
+			{
+				m_capture.close();
+			}
+			m_capture_enabled = false;
+			auto const dropped = m_dropped_records.exchange(0, std::memory_order_relaxed);
+			if (m_logger && dropped > 0)
+			{
+				m_logger->warn("[LLP TRACE] {} records dropped from the log, the trace queue was full", dropped);
+			}
+		}
+
+		bool enabled() const
+		{
+			return m_enabled.load(std::memory_order_relaxed);
+		}
+
+		// framed packet of the connection with local port stream, the payload excludes header and length field
+		void trace(Direction direction, std::uint16_t stream, std::uint8_t header, std::uint32_t length,
+			network::Payload_slice const& data)
+		{
+			if (!enabled())
+			{
+				return;
+			}
+
+			auto const log = log_enabled() && sample(header);
+			if (!log && !m_capture_enabled)
+			{
+				return;
+			}
+
+			Record record;
+			record.m_timestamp = std::chrono::system_clock::now().time_since_epoch();
+			record.m_direction = direction;
+			record.m_stream = stream;
+			record.m_header = header;
+			record.m_length = length;
+			record.m_data = data;
+			record.m_log = log;
+			push(std::move(record));
+		}
+
+		// connection established or closed, replays reproduce reconnects from these
+		void trace_event(Direction direction, std::uint16_t stream)
+		{
+			if (!enabled())
+			{
+				return;
+			}
+
+			Record record;
+			record.m_timestamp = std::chrono::system_clock::now().time_since_epoch();
+			record.m_direction = direction;
+			record.m_stream = stream;
+			record.m_log = log_enabled();
+			push(std::move(record));
+		}
+
+		// wire format payload as queued for transmission
+		void trace(Direction direction, std::uint16_t stream, network::Gather_payload const& payload)
+		{
+			if (!enabled() || payload.empty())
+			{
+				return;
+			}
+
+			auto const header = payload[0];
+			std::uint32_t length = 0;
+			network::Payload_slice data;
+			if (payload.size() >= 5)
+			{
+				length = (static_cast<std::uint32_t>(payload[1]) << 24) |
+					(static_cast<std::uint32_t>(payload[2]) << 16) |
+					(static_cast<std::uint32_t>(payload[3]) << 8) |
+					static_cast<std::uint32_t>(payload[4]);
+				// the payload follows the length field in the prefix or at the start of the body
+				auto const body_start = payload.m_prefix_size >= 5 ? 0 : 5 - payload.m_prefix_size;
+				data = network::Payload_slice{ payload.m_body.buffer(), payload.m_body.offset() + body_start,
+					payload.m_body.size() - body_start };
+			}
+			trace(direction, stream, header, length, data);
+		}
+
+		std::uint64_t dropped_records() const
+		{
+			return m_dropped_records.load(std::memory_order_relaxed);
+		}
+
+	private:
+
+		struct Record
+		{
+			std::chrono::system_clock::duration m_timestamp{};
+			Direction m_direction{ Direction::receive };
+			std::uint16_t m_stream{ 0 };
+			std::uint8_t m_header{ 0 };
+			std::uint32_t m_length{ 0 };
+			network::Payload_slice m_data{};
+			bool m_log{ false };
+		};
+
+		Packet_trace()
+			: m_enabled{ false }
+			, m_level{ spdlog::level::debug }
+			, m_log_enabled{ false }
+			, m_capture_enabled{ false }
+			, m_sample_intervals{}
+			, m_sample_counters{}
+			, m_stop{ false }
+			, m_dropped_records{ 0 }
+		{
+		}
+
+		bool log_enabled() const
+		{
+			return m_log_enabled.load(std::memory_order_relaxed);
+		}
+
+		void start_consumer()
+		{
+			m_stop = false;
+			m_consumer = std::thread([this]() { consume(); });
+			m_enabled.store(true, std::memory_order_release);
+		}
+
+		bool sample(std::uint8_t header)
+		{
+			auto const interval = m_sample_intervals[header];
+			if (interval == 0)
+			{
+				return false;
+			}
+			return m_sample_counters[header].fetch_add(1, std::memory_order_relaxed) % interval == 0;
+		}
+
+		void push(Record&& record)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				// with a capture file every record is written to it, the queue grows instead so replays stay complete
+				if (!m_capture_enabled && m_records.size() >= max_queued_records)
+				{
+					m_dropped_records.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				m_records.push_back(std::move(record));
+			}
+			m_condition.notify_one();
+		}
+
+		void consume()
+		{
+			std::deque<Record> records;
+			for (;;)
+			{
+				{
+					std::unique_lock<std::mutex> lock(m_mutex);
+					m_condition.wait(lock, [this]() { return m_stop || !m_records.empty(); });
+					if (m_records.empty() && m_stop)
+					{
+						break;
+					}
+					records.swap(m_records);
+				}
+
+				for (auto const& record : records)
+				{
+					write(record);
+				}
+				records.clear();
+				if (m_capture.is_open())
+				{
+					m_capture.flush();
+				}
+			}
+		}
+
+		void write(Record const& record)
+		{
+			if (record.m_log && (record.m_direction == Direction::connect || record.m_direction == Direction::disconnect))
+			{
+				m_logger->log(m_level, "[LLP {}] stream={}", record.m_direction == Direction::connect ? "CONNECT" : "DISCONNECT",
+					record.m_stream);
+			}
+			else if (record.m_log)
+			{
+				auto const* const direction = record.m_direction == Direction::receive ? "RECV" : "SEND";
+				auto const hex_preview = format_llp_payload_hex(record.m_data, 16);
+				if (!hex_preview.empty())
+				{
+					m_logger->log(m_level, "[LLP {}] header={} (0x{:02x}) {} length={} payload=[{}]", direction,
+						static_cast<int>(record.m_header), record.m_header, get_llp_header_name(record.m_header),
+						record.m_length, hex_preview);
+				}
+				else
+				{
+					m_logger->log(m_level, "[LLP {}] header={} (0x{:02x}) {} length={}", direction,
+						static_cast<int>(record.m_header), record.m_header, get_llp_header_name(record.m_header),
+						record.m_length);
+				}
+			}
+
+			if (m_capture.is_open())
+			{
+				auto const timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(record.m_timestamp).count();
+				write_le(static_cast<std::uint64_t>(timestamp), 8);
+				write_le(static_cast<std::uint8_t>(record.m_direction), 1);
+				write_le(record.m_stream, 2);
+				write_le(record.m_header, 1);
+				write_le(record.m_length, 4);
+				write_le(static_cast<std::uint32_t>(record.m_data.size()), 4);
+				if (!record.m_data.empty())
+				{
+					m_capture.write(reinterpret_cast<char const*>(record.m_data.data()), record.m_data.size());
+				}
+			}
+		}
+
+		void write_le(std::uint64_t value, std::size_t size)
+		{
+			char bytes[8];
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				bytes[i] = static_cast<char>(value >> (8 * i));
+			}
+			m_capture.write(bytes, size);
+		}
+
+		std::atomic<bool> m_enabled;
+		std::shared_ptr<spdlog::logger> m_logger;
+		spdlog::level::level_enum m_level;
+		std::atomic<bool> m_log_enabled;	// logger runs at m_level, follows log level reloads
+		bool m_capture_enabled;
+		std::array<std::uint32_t, 256> m_sample_intervals;
+		std::array<std::atomic<std::uint32_t>, 256> m_sample_counters;
+		std::ofstream m_capture;
+
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::deque<Record> m_records;
+		bool m_stop;
+		std::thread m_consumer;
+		std::atomic<std::uint64_t> m_dropped_records;
+	};
+}
+
+#endif
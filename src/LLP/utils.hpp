@@ -54,8 +54,9 @@ inline std::vector<uint8_t> uint2bytes(uint32_t UINT)
 }
 
 
-/** Convert a byte stream into unsigned integer 32 bit. **/
-inline uint32_t bytes2uint(std::vector<uint8_t> const& BYTES, int nOffset = 0)
+/** Convert a byte stream into unsigned integer 32 bit. Works on byte vectors and payload slices. **/
+template<typename Bytes>
+inline uint32_t bytes2uint(Bytes const& BYTES, int nOffset = 0)
 {
 	if (BYTES.size() < nOffset + 4)
 		return 0;
@@ -79,7 +80,8 @@ inline std::vector<uint8_t> uint2bytes64(uint64_t UINT)
 
 
 /** Convert a byte Vector into unsigned integer 64 bit. **/
-inline uint64_t bytes2uint64(std::vector<uint8_t> const& BYTES, int nOffset = 0) 
+template<typename Bytes>
+inline uint64_t bytes2uint64(Bytes const& BYTES, int nOffset = 0) 
 {
 	return (bytes2uint(BYTES, nOffset) | (static_cast<uint64_t>(bytes2uint(BYTES, nOffset + 4)) << 32));
 }
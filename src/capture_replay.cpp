@@ -0,0 +1,93 @@
+#include "capture_replay.hpp"
+
+namespace nexusminer
+{
+Capture_replay::Capture_replay(chrono::Timer_factory::Sptr timer_factory)
+: m_logger{spdlog::get("logger")}
+, m_timer{timer_factory->create_timer()}
+{
+}
+
+bool Capture_replay::start(std::string const& capture_file, double speed, Record_handler record_handler,
+    Finished_handler finished_handler)
+{
+    if (!m_reader.open(capture_file))
+    {
+        m_logger->error("Replay: {} is not an LLP capture file (version <= {})", capture_file, Packet_trace::capture_version);
+        return false;
+    }
+
+    Packet_capture_record record;
+    if (!m_reader.next(record))
+    {
+        m_logger->error("Replay: {} contains no records", capture_file);
+        return false;
+    }
+
+    m_speed = speed;
+    m_record_handler = std::move(record_handler);
+    m_finished_handler = std::move(finished_handler);
+    m_first_timestamp = record.m_timestamp;
+    m_last_timestamp = record.m_timestamp;
+    m_next_record = std::move(record);
+    m_started = std::chrono::steady_clock::now();
+    if (m_speed > 0.0)
+    {
+        m_logger->info("Replay: {} (capture version {}) at {:g}x speed", capture_file, m_reader.version(), m_speed);
+    }
+    else
+    {
+        m_logger->info("Replay: {} (capture version {}) as fast as possible", capture_file, m_reader.version());
+    }
+    schedule();
+    return true;
+}
+
+void Capture_replay::stop()
+{
+    m_timer->cancel();
+    m_next_record.reset();
+}
+
+void Capture_replay::schedule()
+{
+    auto wait = chrono::Milliseconds{ 0 };
+    if (m_speed > 0.0)
+    {
+        // due time relative to the start, timestamps of a capture only grow
+        auto const offset = std::chrono::nanoseconds{ static_cast<std::int64_t>(
+            static_cast<double>(m_next_record->m_timestamp - m_first_timestamp) / m_speed) };
+        auto const remaining = m_started + offset - std::chrono::steady_clock::now();
+        if (remaining.count() > 0)
+        {
+            wait = std::chrono::ceil<chrono::Milliseconds>(remaining);
+        }
+    }
+
+    m_timer->start(wait, [this](bool canceled)
+    {
+        if (canceled || !m_next_record)
+        {
+            return;
+        }
+
+        auto record = std::move(*m_next_record);
+        m_next_record.reset();
+        m_last_timestamp = record.m_timestamp;
+        m_records++;
+        m_record_handler(std::move(record));
+
+        Packet_capture_record next_record;
+        if (m_reader.next(next_record))
+        {
+            m_next_record = std::move(next_record);
+            schedule();
+        }
+        else if (m_finished_handler)
+        {
+            m_finished_handler();
+        }
+    });
+}
+
+}
@@ -0,0 +1,82 @@
+#ifndef NEXUSMINER_CAPTURE_REPLAY_HPP
+#define NEXUSMINER_CAPTURE_REPLAY_HPP
+
+#include "network/connection.hpp"
+#include "chrono/timer_factory.hpp"
+#include "packet_capture.hpp"
+#include <spdlog/spdlog.h>
+
+#include <memory>
+#include <string>
+#include <functional>
+#include <optional>
+#include <chrono>
+
+namespace nexusminer
+{
+
+// Stand-in connection for replayed sessions. Transmitted packets are counted and dropped.
+class Replay_connection : public network::Connection
+{
+public:
+
+    Replay_connection(network::Endpoint remote_endpoint, network::Endpoint local_endpoint)
+    : m_remote_endpoint{std::move(remote_endpoint)}
+    , m_local_endpoint{std::move(local_endpoint)}
+    {
+    }
+
+    network::Endpoint const& remote_endpoint() const override { return m_remote_endpoint; }
+    network::Endpoint const& local_endpoint() const override { return m_local_endpoint; }
+    void transmit(network::Shared_payload tx_buffer) override { m_transmitted += tx_buffer ? 1 : 0; }
+    void transmit(network::Gather_payload tx_payload) override { m_transmitted += tx_payload.empty() ? 0 : 1; }
+    void close() override {}
+
+    std::uint64_t transmitted() const { return m_transmitted; }
+
+private:
+
+    network::Endpoint m_remote_endpoint;
+    network::Endpoint m_local_endpoint;
+    std::uint64_t m_transmitted{ 0 };
+};
+
+// Plays the records of an LLP capture file (Packet_trace) back on the io_context.
+// Records are handed out at their original pace scaled by speed (2.0 = twice as fast), speed 0 replays
+// as fast as possible. Every record is delivered in its own io_context handler, so timers and posted
+// handlers (found blocks, ...) interleave with the replay like they do with a live connection.
+class Capture_replay
+{
+public:
+
+    using Record_handler = std::function<void(Packet_capture_record&& record)>;
+    using Finished_handler = std::function<void()>;
+
+    explicit Capture_replay(chrono::Timer_factory::Sptr timer_factory);
+
+    bool start(std::string const& capture_file, double speed, Record_handler record_handler, Finished_handler finished_handler);
+    void stop();
+
+    std::uint64_t records() const { return m_records; }
+    // capture time covered by the delivered records
+    std::chrono::nanoseconds capture_duration() const { return std::chrono::nanoseconds{ m_last_timestamp - m_first_timestamp }; }
+
+private:
+
+    void schedule();
+
+    std::shared_ptr<spdlog::logger> m_logger;
+    chrono::Timer::Uptr m_timer;
+    Packet_capture_reader m_reader;
+    double m_speed{ 1.0 };
+    Record_handler m_record_handler;
+    Finished_handler m_finished_handler;
+    std::optional<Packet_capture_record> m_next_record;
+    std::chrono::steady_clock::time_point m_started;
+    std::uint64_t m_first_timestamp{ 0 };
+    std::uint64_t m_last_timestamp{ 0 };
+    std::uint64_t m_records{ 0 };
+};
+}
+
+#endif
@@ -7,6 +7,8 @@
 #include "config/worker_config.hpp"
 #include "config/stats_printer_config.hpp"
 #include "config/pool.hpp"
+#include "config/llp_trace.hpp"
+#include "config/node.hpp"
 #include "config/types.hpp"
 
 namespace spdlog { class logger; }
@@ -16,6 +18,20 @@ namespace config
 {
 #define CONFIG_VERSION 1
 
+// settings of a reloaded config file that differ from the running config, grouped by how they can be applied
+struct Config_changes
+{
+	bool m_log_level{false};
+	bool m_intervals{false};		// statistics, height, ping, connection retry and config watch intervals
+	bool m_connection{false};		// nodes, pool login, local ip, template prefetch and Falcon settings -> reconnect
+	bool m_workers{false};
+	bool m_llp_trace{false};		// restarts the LLP trace, a capture file is started over
+	std::vector<std::string> m_restart_required;	// keys only read at startup, e.g. mining_mode or stats_printers
+
+	// nothing that can be applied while mining
+	bool empty() const { return !m_log_level && !m_intervals && !m_connection && !m_workers && !m_llp_trace; }
+};
+
 class Config
 {
 public:
@@ -24,12 +40,18 @@ public:
 
 	bool read_config(std::string const& miner_config_file);
 
+	// compare with the same config file read again (SIGHUP or config_watch_interval)
+	Config_changes compare(Config const& reloaded) const;
+	// take over the settings of reloaded that changes lists, the ones that need a restart keep their value
+	void apply(Config const& reloaded, Config_changes const& changes);
+
 	std::uint16_t get_version() const { return m_version; }
 	std::string const& get_wallet_ip() const { return m_wallet_ip; }
 	// Phase 2: port refers to the stateless miner LLP port (miningport in nexus.conf)
 	// Default is 8323 to match LLL-TAO's default miningport
 	std::uint16_t get_port() const { return m_port; }
 	std::string const& get_local_ip() const { return m_local_ip; }
+	std::vector<Node> const& get_failover_nodes() const { return m_failover_nodes; }
 	Mining_mode get_mining_mode() const { return m_mining_mode; }
 	std::uint8_t get_log_level() const { return m_log_level; }
 	std::string const& get_logfile() const { return m_logfile; }
@@ -37,26 +59,35 @@ public:
 	std::uint16_t get_print_statistics_interval() const { return m_print_statistics_interval; }
 	std::uint16_t get_height_interval() const { return m_get_height_interval; }
 	std::uint16_t get_ping_interval() const { return m_ping_interval; }
+	std::uint16_t get_template_prefetch_interval() const { return m_template_prefetch_interval; }
+	std::uint16_t get_config_watch_interval() const { return m_config_watch_interval; }
 	std::vector<Worker_config>& get_worker_config() { return m_worker_config; }
 	std::vector<Stats_printer_config>& get_stats_printer_config() { return m_stats_printer_config; }
 	Pool const& get_pool_config() const { return m_pool_config; }
+	Llp_trace const& get_llp_trace_config() const { return m_llp_trace_config; }
+	std::string const& get_event_trace_file() const { return m_event_trace_file; }
 	std::string const& get_miner_falcon_pubkey() const { return m_miner_falcon_pubkey; }
 	std::string const& get_miner_falcon_privkey() const { return m_miner_falcon_privkey; }
 	bool has_miner_falcon_keys() const { return !m_miner_falcon_pubkey.empty() && !m_miner_falcon_privkey.empty(); }
 	bool get_enable_block_signing() const { return m_enable_block_signing; }
+	bool get_falcon_expanded_key() const { return m_falcon_expanded_key; }
 
 private:
 
 	bool read_stats_printer_config(nlohmann::json& j);
 	bool read_worker_config(nlohmann::json& j);
+	void read_llp_trace_config(nlohmann::json& j);
+	void read_failover_nodes_config(nlohmann::json& j);
 	void print_global_config() const;
 	void print_worker_config() const;
 
 	std::shared_ptr<spdlog::logger> m_logger;
+	nlohmann::json m_json;		// the parsed file, compared key by key on a reload
 	std::uint16_t m_version;
 	std::string  m_wallet_ip;
 	std::uint16_t m_port;
 	std::string m_local_ip;
+	std::vector<Node> m_failover_nodes;
 	Mining_mode	 m_mining_mode;
 	Pool 		 m_pool_config; 
 	std::uint8_t m_log_level;
@@ -73,6 +104,10 @@ private:
 	std::uint16_t m_print_statistics_interval;
 	std::uint16_t m_get_height_interval;
 	std::uint16_t m_ping_interval;
+	std::uint16_t m_template_prefetch_interval;	// solo: refresh the standby template every n seconds, 0 = off
+	std::uint16_t m_config_watch_interval;	// reload the config file when it changed, checked every n seconds, 0 = off
+	Llp_trace m_llp_trace_config;
+	std::string m_event_trace_file;	// Chrome trace JSON of the mining and protocol timeline, empty = off
 
 	// Falcon miner authentication keys (optional)
 	std::string m_miner_falcon_pubkey;
@@ -80,6 +115,7 @@ private:
 	
 	// Unified Falcon Signature Protocol options
 	bool m_enable_block_signing;  // Optional block signing for enhanced validation (default: false)
+	bool m_falcon_expanded_key;   // Expand the private key once and sign with the expanded key (default: true)
 
 };
 }
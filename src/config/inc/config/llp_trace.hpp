@@ -0,0 +1,24 @@
+#ifndef NEXUSMINER_CONFIG_LLP_TRACE_HPP
+#define NEXUSMINER_CONFIG_LLP_TRACE_HPP
+
+#include <string>
+#include <map>
+#include <cstdint>
+
+namespace nexusminer
+{
+namespace config
+{
+
+// LLP wire tracing. Packets are traced when the logger runs at m_log_level or lower, or when a capture file is set.
+struct Llp_trace
+{
+    std::uint8_t m_log_level{ 1 };     // debug
+    // trace every n-th packet per opcode (by name, e.g. "PING", or number). 0 disables the opcode, "default" applies to the rest.
+    std::map<std::string, std::uint32_t> m_sample_intervals{};
+    std::string m_capture_file{};      // binary capture of the traced packets, empty = off
+};
+
+}
+}
+#endif
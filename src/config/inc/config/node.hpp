@@ -0,0 +1,21 @@
+#ifndef NEXUSMINER_CONFIG_NODE_HPP
+#define NEXUSMINER_CONFIG_NODE_HPP
+
+#include <string>
+#include <cstdint>
+
+namespace nexusminer
+{
+namespace config
+{
+
+// Additional wallet/node for solo mining, connected in parallel to the primary wallet_ip/port
+struct Node
+{
+    std::string m_wallet_ip{};
+    std::uint16_t m_port{ 8323 };
+};
+
+}
+}
+#endif
@@ -120,6 +120,13 @@ struct Simplified_config_data
     std::string falcon_pubkey{};
     std::string falcon_privkey{};
     bool enable_block_signing{false};
+    bool falcon_expanded_key{true};
+    
+    // Solo mining: refresh a standby block template every n seconds (0 = off)
+    std::uint16_t template_prefetch_interval{0};
+
+    // Reload the config file when it changed, checked every n seconds (0 = off, SIGHUP still reloads)
+    std::uint16_t config_watch_interval{0};
 };
 
 /**
@@ -1,6 +1,7 @@
 #ifndef NEXUSMINER_CONFIG_STATS_PRINTER_CONFIG_HPP
 #define NEXUSMINER_CONFIG_STATS_PRINTER_CONFIG_HPP
 
+#include <cstdint>
 #include <string>
 #include <variant>
 #include "config/types.hpp"
@@ -20,12 +21,27 @@ struct Stats_printer_config_file
 	std::string file_name{};
 };
 
+// OpenMetrics / Prometheus text endpoint, served at /metrics
+struct Stats_printer_config_prometheus
+{
+	std::string address{"127.0.0.1"};
+	std::uint16_t port{9464};
+};
+
+// memory mapped ring of fixed size records, one file per run, read with the stats_reader tool
+struct Stats_printer_config_binary
+{
+	std::string file_name{"stats.nxs"};
+	std::uint32_t records{0};	// ring capacity, 0 = one week at the print statistics interval
+};
+
 class Stats_printer_config
 {
 public:
 
 	Stats_printer_mode m_mode{Stats_printer_mode::CONSOLE};
-	std::variant<Stats_printer_config_console, Stats_printer_config_file>
+	std::variant<Stats_printer_config_console, Stats_printer_config_file, Stats_printer_config_prometheus,
+		Stats_printer_config_binary>
 		m_printer_mode;
 };
 
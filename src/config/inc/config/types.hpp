@@ -18,7 +18,9 @@ namespace config
     enum class Stats_printer_mode : int8_t
 	{
 		CONSOLE = 0,
-		FILE
+		FILE,
+		PROMETHEUS,
+		BINARY
 	};
 
     enum class Worker_mode : uint8_t
@@ -27,6 +29,13 @@ namespace config
 		FPGA,
 		GPU
 	};
+
+	// compressed sieve layout used by the cpu prime worker
+	enum class Sieve_wheel : uint16_t
+	{
+		MOD30 = 30,
+		MOD2310 = 2310
+	};
 }
 }
 #endif
@@ -1,6 +1,7 @@
 #ifndef NEXUSMINER_CONFIG_WORKER_CONFIG_HPP
 #define NEXUSMINER_CONFIG_WORKER_CONFIG_HPP
 
+#include <cstdint>
 #include <string>
 #include <variant>
 #include "config/types.hpp"
@@ -12,12 +13,36 @@ namespace config
 struct Worker_config_cpu
 {
 	// Number of CPU threads to use for mining (default: 1)
-	// Note: Multi-threading within a worker is planned for future implementation
+	// 0 = one per core of the cpu topology, > 1 = that many. Every thread becomes its own pinned worker.
 	std::uint16_t m_threads{1};
 	
 	// CPU affinity mask for thread pinning (default: 0, no affinity)
-	// Note: CPU affinity is planned for future implementation
 	std::uint64_t m_affinity_mask{0};
+
+	// Automatic layout (threads != 1): use SMT siblings if a benchmark shows a gain, use efficiency cores
+	bool m_hyperthreading{true};
+	bool m_efficiency_cores{false};
+
+	// Logical cpu the worker is pinned to, set by the automatic layout (default: -1, use the affinity mask)
+	std::int32_t m_cpu{-1};
+
+	// Configured worker an automatic layout worker was expanded from (default: empty, not expanded)
+	std::string m_group{};
+
+	// OS thread priority, 0 = low, 1 = below normal, 2 = normal, 3 = above normal, 4 = high (default: 2)
+	std::uint8_t m_priority{2};
+
+	// Throttling, shared by all threads of the configured worker (default: no throttling)
+	// power_limit_percent caps the cpu time, target_hashrate (H/s, hash channel) lowers it further
+	std::uint8_t m_power_limit_percent{100};
+	std::uint64_t m_target_hashrate{0};
+
+	// Prime channel sieve wheel (default: mod 30, 8 candidates per 30 integers)
+	// mod 2310 additionally removes multiples of 7 and 11 (480 candidates per 2310 integers)
+	Sieve_wheel m_sieve_wheel{Sieve_wheel::MOD30};
+
+	// Tune the sieving prime limit and minimum chain length while mining (default: true)
+	bool m_sieve_autotune{true};
 };
 
 struct Worker_config_fpga
@@ -3,6 +3,7 @@
 #include <spdlog/spdlog.h>
 #include <fstream>
 #include <iostream>
+#include <set>
 #include <sstream>
 
 using json = nlohmann::json;
@@ -25,6 +26,12 @@ namespace config
 		, m_print_statistics_interval{5}
 		, m_get_height_interval{2}
 		, m_ping_interval{10}
+		, m_template_prefetch_interval{0}	// no template prefetch, default
+		, m_config_watch_interval{0}	// reload on SIGHUP only, default
+		, m_llp_trace_config{}
+		, m_event_trace_file{""}	// no event trace, default
+		, m_enable_block_signing{false}
+		, m_falcon_expanded_key{true}
 	{
 	}
 
@@ -56,6 +63,10 @@ namespace config
 			{
 				j.at("local_ip").get_to(m_local_ip);
 			}
+			if (j.count("failover_nodes") != 0)
+			{
+				read_failover_nodes_config(j);
+			}
 
 			std::string mining_mode = j["mining_mode"];
 			std::for_each(mining_mode.begin(), mining_mode.end(), [](char& c) {
@@ -108,17 +119,35 @@ namespace config
 			{
 				j.at("ping_interval").get_to(m_ping_interval);
 			}
+			if (j.count("template_prefetch_interval") != 0)
+			{
+				j.at("template_prefetch_interval").get_to(m_template_prefetch_interval);
+			}
+			if (j.count("config_watch_interval") != 0)
+			{
+				j.at("config_watch_interval").get_to(m_config_watch_interval);
+			}
 
 			if (j.count("log_level") != 0)
 			{
 				j.at("log_level").get_to(m_log_level);
 			}
 
+			if (j.count("llp_trace") != 0)
+			{
+				read_llp_trace_config(j);
+			}
+
 			if (j.count("logfile") != 0)
 			{
 				j.at("logfile").get_to(m_logfile);
 			}
 
+			if (j.count("event_trace_file") != 0)
+			{
+				j.at("event_trace_file").get_to(m_event_trace_file);
+			}
+
 			// Falcon miner authentication keys (optional)
 			if (j.count("miner_falcon_pubkey") != 0)
 			{
@@ -135,7 +164,13 @@ namespace config
 			{
 				j.at("enable_block_signing").get_to(m_enable_block_signing);
 			}
+			m_falcon_expanded_key = true;  // Default: expanded key, faster signatures for ~56 KB locked memory
+			if (j.count("falcon_expanded_key") != 0)
+			{
+				j.at("falcon_expanded_key").get_to(m_falcon_expanded_key);
+			}
 
+			m_json = std::move(j);
 			print_global_config();
 			print_worker_config();
 			return true;
@@ -147,6 +182,146 @@ namespace config
 		}
 	}
 
+	namespace
+	{
+		// top level keys a reload applies while mining, all others are only read at startup
+		std::set<std::string> const interval_keys{ "connection_retry_interval", "print_statistics_interval",
+			"get_height_interval", "ping_interval", "config_watch_interval" };
+		std::set<std::string> const connection_keys{ "wallet_ip", "port", "local_ip", "failover_nodes", "pool",
+			"template_prefetch_interval", "miner_falcon_pubkey", "miner_falcon_privkey", "enable_block_signing", "falcon_expanded_key" };
+	}
+
+	Config_changes Config::compare(Config const& reloaded) const
+	{
+		std::set<std::string> keys;
+		for (auto const& item : m_json.items())
+		{
+			keys.insert(item.key());
+		}
+		for (auto const& item : reloaded.m_json.items())
+		{
+			keys.insert(item.key());
+		}
+
+		Config_changes changes;
+		for (auto const& key : keys)
+		{
+			auto const it = m_json.find(key);
+			auto const reloaded_it = reloaded.m_json.find(key);
+			if (it != m_json.end() && reloaded_it != reloaded.m_json.end() && *it == *reloaded_it)
+			{
+				continue;
+			}
+
+			if (key == "log_level")
+			{
+				changes.m_log_level = true;
+			}
+			else if (key == "workers")
+			{
+				changes.m_workers = true;
+			}
+			else if (key == "llp_trace")
+			{
+				changes.m_llp_trace = true;
+			}
+			else if (interval_keys.count(key) != 0)
+			{
+				changes.m_intervals = true;
+			}
+			// switching between solo and pool changes the protocol and the stats printers as well
+			else if (connection_keys.count(key) != 0 && (key != "pool" || m_pool_config.m_use_pool == reloaded.m_pool_config.m_use_pool))
+			{
+				changes.m_connection = true;
+			}
+			else
+			{
+				changes.m_restart_required.push_back(key);
+			}
+		}
+		return changes;
+	}
+
+	void Config::apply(Config const& reloaded, Config_changes const& changes)
+	{
+		auto const pool_mode_changed = m_pool_config.m_use_pool != reloaded.m_pool_config.m_use_pool;
+		if (changes.m_log_level)
+		{
+			m_log_level = reloaded.m_log_level;
+		}
+		if (changes.m_intervals)
+		{
+			m_connection_retry_interval = reloaded.m_connection_retry_interval;
+			m_print_statistics_interval = reloaded.m_print_statistics_interval;
+			m_get_height_interval = reloaded.m_get_height_interval;
+			m_ping_interval = reloaded.m_ping_interval;
+			m_config_watch_interval = reloaded.m_config_watch_interval;
+		}
+		if (changes.m_connection)
+		{
+			m_wallet_ip = reloaded.m_wallet_ip;
+			m_port = reloaded.m_port;
+			m_local_ip = reloaded.m_local_ip;
+			m_failover_nodes = reloaded.m_failover_nodes;
+			if (!pool_mode_changed)
+			{
+				m_pool_config = reloaded.m_pool_config;
+			}
+			m_template_prefetch_interval = reloaded.m_template_prefetch_interval;
+			m_miner_falcon_pubkey = reloaded.m_miner_falcon_pubkey;
+			m_miner_falcon_privkey = reloaded.m_miner_falcon_privkey;
+			m_enable_block_signing = reloaded.m_enable_block_signing;
+			m_falcon_expanded_key = reloaded.m_falcon_expanded_key;
+		}
+		if (changes.m_llp_trace)
+		{
+			m_llp_trace_config = reloaded.m_llp_trace_config;
+		}
+		if (changes.m_workers)
+		{
+			// the vector object stays, the stats printers reference it
+			m_worker_config = reloaded.m_worker_config;
+		}
+
+		// keys that were not applied keep their running value, the next reload reports them again
+		auto const applied = [&changes, pool_mode_changed](std::string const& key)
+		{
+			if (key == "log_level")
+			{
+				return changes.m_log_level;
+			}
+			if (key == "workers")
+			{
+				return changes.m_workers;
+			}
+			if (key == "llp_trace")
+			{
+				return changes.m_llp_trace;
+			}
+			if (interval_keys.count(key) != 0)
+			{
+				return changes.m_intervals;
+			}
+			return connection_keys.count(key) != 0 && changes.m_connection && (key != "pool" || !pool_mode_changed);
+		};
+		auto json = reloaded.m_json;
+		for (auto const& item : m_json.items())
+		{
+			if (!applied(item.key()))
+			{
+				json[item.key()] = item.value();
+			}
+		}
+		for (auto const& item : reloaded.m_json.items())
+		{
+			if (!applied(item.key()) && m_json.count(item.key()) == 0)
+			{
+				json.erase(item.key());
+			}
+		}
+		m_json = std::move(json);
+	}
+
 	bool Config::read_stats_printer_config(nlohmann::json& j)
 	{
 		for (auto& stats_printers_json : j["stats_printers"])
@@ -166,6 +341,34 @@ namespace config
 					stats_printer_config.m_mode = Stats_printer_mode::FILE;
 					stats_printer_config.m_printer_mode = Stats_printer_config_file{stats_printer_config_json["filename"]};
 				}
+				else if(stats_printer_mode == "prometheus")
+				{
+					Stats_printer_config_prometheus prometheus_config;
+					if(stats_printer_config_json.count("address") != 0)
+					{
+						stats_printer_config_json.at("address").get_to(prometheus_config.address);
+					}
+					if(stats_printer_config_json.count("port") != 0)
+					{
+						stats_printer_config_json.at("port").get_to(prometheus_config.port);
+					}
+					stats_printer_config.m_mode = Stats_printer_mode::PROMETHEUS;
+					stats_printer_config.m_printer_mode = prometheus_config;
+				}
+				else if(stats_printer_mode == "binary")
+				{
+					Stats_printer_config_binary binary_config;
+					if(stats_printer_config_json.count("filename") != 0)
+					{
+						stats_printer_config_json.at("filename").get_to(binary_config.file_name);
+					}
+					if(stats_printer_config_json.count("records") != 0)
+					{
+						stats_printer_config_json.at("records").get_to(binary_config.records);
+					}
+					stats_printer_config.m_mode = Stats_printer_mode::BINARY;
+					stats_printer_config.m_printer_mode = binary_config;
+				}
 				else
 				{
 					// invalid config
@@ -203,6 +406,41 @@ namespace config
 					if (worker_mode_json.count("affinity_mask") != 0) {
 						cpu_config.m_affinity_mask = worker_mode_json["affinity_mask"];
 					}
+
+					// Read optional core selection of the automatic layout
+					if (worker_mode_json.count("hyperthreading") != 0) {
+						cpu_config.m_hyperthreading = worker_mode_json["hyperthreading"];
+					}
+					if (worker_mode_json.count("efficiency_cores") != 0) {
+						cpu_config.m_efficiency_cores = worker_mode_json["efficiency_cores"];
+					}
+
+					// Read optional thread priority and throttling
+					if (worker_mode_json.count("priority") != 0) {
+						cpu_config.m_priority = worker_mode_json["priority"];
+					}
+					if (worker_mode_json.count("power_limit_percent") != 0) {
+						cpu_config.m_power_limit_percent = worker_mode_json["power_limit_percent"];
+					}
+					if (worker_mode_json.count("target_hashrate") != 0) {
+						cpu_config.m_target_hashrate = worker_mode_json["target_hashrate"];
+					}
+
+					// Read optional prime sieve wheel (30 or 2310, default: 30)
+					if (worker_mode_json.count("sieve_wheel") != 0) {
+						if (worker_mode_json["sieve_wheel"] == 2310) {
+							cpu_config.m_sieve_wheel = Sieve_wheel::MOD2310;
+						}
+						else if (worker_mode_json["sieve_wheel"] != 30) {
+							// invalid config
+							return false;
+						}
+					}
+
+					// Read optional prime sieve autotuning (default: true)
+					if (worker_mode_json.count("sieve_autotune") != 0) {
+						cpu_config.m_sieve_autotune = worker_mode_json["sieve_autotune"];
+					}
 					
 					worker_config.m_worker_mode = cpu_config;
 				}
@@ -244,11 +482,28 @@ namespace config
 					auto const& cpu_cfg = std::get<Worker_config_cpu>(worker.m_worker_mode);
 					ss << worker.m_id << " mode: " << mode;
 					if (cpu_cfg.m_threads != 1) {  // Only show if non-default
-						ss << ", threads: " << cpu_cfg.m_threads;
+						ss << ", threads: " << (cpu_cfg.m_threads == 0 ? std::string{"auto"} : std::to_string(cpu_cfg.m_threads));
+						ss << ", hyperthreading: " << (cpu_cfg.m_hyperthreading ? "on" : "off");
+						ss << ", efficiency cores: " << (cpu_cfg.m_efficiency_cores ? "on" : "off");
 					}
 					if (cpu_cfg.m_affinity_mask != 0) {  // Only show if non-default
 						ss << ", affinity: 0x" << std::hex << cpu_cfg.m_affinity_mask << std::dec;
 					}
+					if (cpu_cfg.m_priority != 2) {  // Only show if non-default
+						ss << ", priority: " << static_cast<int>(cpu_cfg.m_priority);
+					}
+					if (cpu_cfg.m_power_limit_percent < 100) {  // Only show if non-default
+						ss << ", power limit: " << static_cast<int>(cpu_cfg.m_power_limit_percent) << "%";
+					}
+					if (cpu_cfg.m_target_hashrate != 0) {  // Only show if non-default
+						ss << ", target hashrate: " << cpu_cfg.m_target_hashrate << " H/s";
+					}
+					if (cpu_cfg.m_sieve_wheel != Sieve_wheel::MOD30) {  // Only show if non-default
+						ss << ", sieve wheel: mod " << static_cast<int>(cpu_cfg.m_sieve_wheel);
+					}
+					if (!cpu_cfg.m_sieve_autotune) {  // Only show if non-default
+						ss << ", sieve autotune: off";
+					}
 					ss << std::endl;
 				} else {
 					ss << worker.m_id << " mode: " << mode << std::endl;
@@ -261,6 +516,50 @@ namespace config
 		}
 
 		m_logger->info(ss.str());
+
+		for (auto const& node : m_failover_nodes)
+		{
+			m_logger->info("Failover node {}:{}", node.m_wallet_ip, node.m_port);
+		}
+	}
+
+	void Config::read_llp_trace_config(nlohmann::json& j)
+	{
+		auto const& llp_trace_json = j.at("llp_trace");
+		if (llp_trace_json.count("log_level") != 0)
+		{
+			llp_trace_json.at("log_level").get_to(m_llp_trace_config.m_log_level);
+		}
+		if (llp_trace_json.count("sample") != 0)
+		{
+			for (auto const& sample : llp_trace_json.at("sample").items())
+			{
+				m_llp_trace_config.m_sample_intervals[sample.key()] = sample.value().get<std::uint32_t>();
+			}
+		}
+		if (llp_trace_json.count("capture_file") != 0)
+		{
+			llp_trace_json.at("capture_file").get_to(m_llp_trace_config.m_capture_file);
+		}
+	}
+
+	void Config::read_failover_nodes_config(nlohmann::json& j)
+	{
+		m_failover_nodes.clear();
+		for (auto const& node_json : j.at("failover_nodes"))
+		{
+			Node node;
+			node_json.at("wallet_ip").get_to(node.m_wallet_ip);
+			if (node_json.count("port") != 0)
+			{
+				node_json.at("port").get_to(node.m_port);
+			}
+			else
+			{
+				node.m_port = m_port;	// same mining port as the primary node
+			}
+			m_failover_nodes.push_back(node);
+		}
 	}
 
 	void Config::print_global_config() const
@@ -151,6 +151,9 @@ bool Simplified_config::load(std::string const& config_file)
         m_data.falcon_pubkey = j.value("falcon_pubkey", "");
         m_data.falcon_privkey = j.value("falcon_privkey", "");
         m_data.enable_block_signing = j.value("enable_block_signing", false);
+        m_data.falcon_expanded_key = j.value("falcon_expanded_key", true);
+        m_data.template_prefetch_interval = j.value("template_prefetch_interval", 0);
+        m_data.config_watch_interval = j.value("config_watch_interval", 0);
         
         m_logger->info("Loaded simplified config from {}", config_file);
         return true;
@@ -245,6 +248,9 @@ bool Simplified_config::save(std::string const& config_file) const
         j["falcon_privkey"] = m_data.falcon_privkey;
     }
     j["enable_block_signing"] = m_data.enable_block_signing;
+    j["falcon_expanded_key"] = m_data.falcon_expanded_key;
+    j["template_prefetch_interval"] = m_data.template_prefetch_interval;
+    j["config_watch_interval"] = m_data.config_watch_interval;
     
     // Write to file
     std::ofstream file(config_file);
@@ -339,6 +345,11 @@ bool Simplified_config::import_from_json(std::string const& json_config_file)
                         CPU_optimization cpu;
                         cpu.thread_count = mode_json.value("threads", 1);
                         cpu.affinity_mask = mode_json.value("affinity_mask", 0);
+                        cpu.enable_hyperthreading = mode_json.value("hyperthreading", true);
+                        cpu.enable_efficiency_cores = mode_json.value("efficiency_cores", false);
+                        cpu.priority_level = mode_json.value("priority", 2);
+                        cpu.power_limit_percent = mode_json.value("power_limit_percent", 100);
+                        cpu.target_hashrate = mode_json.value("target_hashrate", 0);
                         worker.cpu_settings = cpu;
                     }
                     else if (worker.hardware_type == "fpga")
@@ -379,6 +390,9 @@ bool Simplified_config::import_from_json(std::string const& json_config_file)
         m_data.falcon_pubkey = j.value("miner_falcon_pubkey", "");
         m_data.falcon_privkey = j.value("miner_falcon_privkey", "");
         m_data.enable_block_signing = j.value("enable_block_signing", false);
+        m_data.falcon_expanded_key = j.value("falcon_expanded_key", true);
+        m_data.template_prefetch_interval = j.value("template_prefetch_interval", 0);
+        m_data.config_watch_interval = j.value("config_watch_interval", 0);
         
         m_logger->info("Imported configuration from JSON file: {}", json_config_file);
         return true;
@@ -449,14 +463,29 @@ bool Simplified_config::export_to_json(std::string const& json_config_file) cons
         else if (worker.hardware_type == "cpu" && worker.cpu_settings.has_value())
         {
             auto const& cpu = worker.cpu_settings.value();
-            if (cpu.thread_count > 0)
+            // 0 = automatic layout over the cpu topology
+            worker_json["worker"]["mode"]["threads"] = cpu.thread_count;
+            if (cpu.thread_count != 1)
             {
-                worker_json["worker"]["mode"]["threads"] = cpu.thread_count;
+                worker_json["worker"]["mode"]["hyperthreading"] = cpu.enable_hyperthreading;
+                worker_json["worker"]["mode"]["efficiency_cores"] = cpu.enable_efficiency_cores;
             }
             if (cpu.affinity_mask != 0)
             {
                 worker_json["worker"]["mode"]["affinity_mask"] = cpu.affinity_mask;
             }
+            if (cpu.priority_level != 2)
+            {
+                worker_json["worker"]["mode"]["priority"] = cpu.priority_level;
+            }
+            if (cpu.power_limit_percent < 100)
+            {
+                worker_json["worker"]["mode"]["power_limit_percent"] = cpu.power_limit_percent;
+            }
+            if (cpu.target_hashrate != 0)
+            {
+                worker_json["worker"]["mode"]["target_hashrate"] = cpu.target_hashrate;
+            }
         }
         else if (worker.hardware_type == "fpga")
         {
@@ -476,6 +505,9 @@ bool Simplified_config::export_to_json(std::string const& json_config_file) cons
         j["miner_falcon_privkey"] = m_data.falcon_privkey;
     }
     j["enable_block_signing"] = m_data.enable_block_signing;
+    j["falcon_expanded_key"] = m_data.falcon_expanded_key;
+    j["template_prefetch_interval"] = m_data.template_prefetch_interval;
+    j["config_watch_interval"] = m_data.config_watch_interval;
     
     // Write to file
     std::ofstream file(json_config_file);
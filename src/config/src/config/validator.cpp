@@ -78,6 +78,28 @@ bool Validator::check(std::string const& config_file)
             }
         }
 
+        if (j.count("failover_nodes") != 0)
+        {
+            if (!j.at("failover_nodes").is_array())
+            {
+                m_optional_fields.push_back(Validator_error{ "failover_nodes", "Not an array" });
+            }
+            else
+            {
+                for (auto const& node_json : j.at("failover_nodes"))
+                {
+                    if (node_json.count("wallet_ip") == 0 || !node_json.at("wallet_ip").is_string())
+                    {
+                        m_mandatory_fields.push_back(Validator_error{ "failover_nodes/wallet_ip", "" });
+                    }
+                    if (node_json.count("port") != 0 && !node_json.at("port").is_number())
+                    {
+                        m_optional_fields.push_back(Validator_error{ "failover_nodes/port", "Not a number" });
+                    }
+                }
+            }
+        }
+
         if (j.count("log_level") != 0)
         {
             if (!j.at("log_level").is_number())
@@ -98,9 +120,24 @@ bool Validator::check(std::string const& config_file)
                     break;
                 }
 
-                if(stats_printer_mode != "console" && stats_printer_mode != "file")
+                if(stats_printer_mode != "console" && stats_printer_mode != "file" && stats_printer_mode != "prometheus" &&
+                    stats_printer_mode != "binary")
+                {
+                    m_optional_fields.push_back(Validator_error{"stats_printers/stats_printer/mode", "Not 'console', 'file', 'prometheus' or 'binary'"});
+                    break;
+                }
+
+                if(stats_printer_mode == "prometheus" && stats_printer_config_json.count("port") != 0 &&
+                    !stats_printer_config_json["port"].is_number_unsigned())
                 {
-                    m_optional_fields.push_back(Validator_error{"stats_printers/stats_printer/mode", "Not 'console' or 'prime"});
+                    m_optional_fields.push_back(Validator_error{"stats_printers/stats_printer/port", "Not a port number"});
+                    break;
+                }
+
+                if(stats_printer_mode == "binary" && stats_printer_config_json.count("records") != 0 &&
+                    !stats_printer_config_json["records"].is_number_unsigned())
+                {
+                    m_optional_fields.push_back(Validator_error{"stats_printers/stats_printer/records", "Not a positive number"});
                     break;
                 }
             }
@@ -147,6 +184,36 @@ bool Validator::check(std::string const& config_file)
                         }
                     }
 
+                    if (worker_mode_json["hardware"] == "cpu")
+                    {
+                        if (worker_mode_json.count("threads") != 0 && !worker_mode_json["threads"].is_number_unsigned())
+                        {
+                            m_optional_fields.push_back(Validator_error{ "workers/worker/mode/threads", "Not a positive number or 0 (auto)" });
+                        }
+                        for (auto const* flag : { "hyperthreading", "efficiency_cores" })
+                        {
+                            if (worker_mode_json.count(flag) != 0 && !worker_mode_json[flag].is_boolean())
+                            {
+                                m_optional_fields.push_back(Validator_error{ std::string{"workers/worker/mode/"} + flag, "Not a boolean" });
+                            }
+                        }
+                        if (worker_mode_json.count("priority") != 0 &&
+                            (!worker_mode_json["priority"].is_number_unsigned() || worker_mode_json["priority"] > 4))
+                        {
+                            m_optional_fields.push_back(Validator_error{ "workers/worker/mode/priority", "Not a number between 0 and 4" });
+                        }
+                        if (worker_mode_json.count("power_limit_percent") != 0 &&
+                            (!worker_mode_json["power_limit_percent"].is_number_unsigned() ||
+                            worker_mode_json["power_limit_percent"] < 1 || worker_mode_json["power_limit_percent"] > 100))
+                        {
+                            m_optional_fields.push_back(Validator_error{ "workers/worker/mode/power_limit_percent", "Not a number between 1 and 100" });
+                        }
+                        if (worker_mode_json.count("target_hashrate") != 0 && !worker_mode_json["target_hashrate"].is_number_unsigned())
+                        {
+                            m_optional_fields.push_back(Validator_error{ "workers/worker/mode/target_hashrate", "Not a positive number" });
+                        }
+                    }
+
                     if (worker_mode_json["hardware"] == "gpu")
                     {
                        
@@ -196,6 +263,64 @@ bool Validator::check(std::string const& config_file)
                 m_optional_fields.push_back(Validator_error{ "ping_interval", "Not a number" });
             }
         }
+        if (j.count("template_prefetch_interval") != 0)
+        {
+            if (!j.at("template_prefetch_interval").is_number())
+            {
+                m_optional_fields.push_back(Validator_error{ "template_prefetch_interval", "Not a number" });
+            }
+        }
+        if (j.count("config_watch_interval") != 0)
+        {
+            if (!j.at("config_watch_interval").is_number_unsigned())
+            {
+                m_optional_fields.push_back(Validator_error{ "config_watch_interval", "Not a positive number" });
+            }
+        }
+        if (j.count("event_trace_file") != 0)
+        {
+            if (!j.at("event_trace_file").is_string())
+            {
+                m_optional_fields.push_back(Validator_error{ "event_trace_file", "Not a string" });
+            }
+        }
+        if (j.count("llp_trace") != 0)
+        {
+            auto const& llp_trace_json = j.at("llp_trace");
+            if (!llp_trace_json.is_object())
+            {
+                m_optional_fields.push_back(Validator_error{ "llp_trace", "Not an object" });
+            }
+            else
+            {
+                if (llp_trace_json.count("log_level") != 0 && !llp_trace_json.at("log_level").is_number())
+                {
+                    m_optional_fields.push_back(Validator_error{ "llp_trace/log_level", "Not a number" });
+                }
+                if (llp_trace_json.count("sample") != 0)
+                {
+                    auto const& sample_json = llp_trace_json.at("sample");
+                    if (!sample_json.is_object())
+                    {
+                        m_optional_fields.push_back(Validator_error{ "llp_trace/sample", "Not an object" });
+                    }
+                    else
+                    {
+                        for (auto const& sample : sample_json.items())
+                        {
+                            if (!sample.value().is_number_unsigned())
+                            {
+                                m_optional_fields.push_back(Validator_error{ "llp_trace/sample/" + sample.key(), "Not a positive number" });
+                            }
+                        }
+                    }
+                }
+                if (llp_trace_json.count("capture_file") != 0 && !llp_trace_json.at("capture_file").is_string())
+                {
+                    m_optional_fields.push_back(Validator_error{ "llp_trace/capture_file", "Not a string" });
+                }
+            }
+        }
     }
     catch(const std::exception& e)
     {
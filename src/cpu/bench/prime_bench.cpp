@@ -0,0 +1,334 @@
+//network free prime channel benchmark and regression check.
+//mines a canned prime header (Block_data defaults or a header file) over a fixed range and reports sieve and fermat statistics.
+//with --verify the mod 2310 sieve is checked against the reference mod 30 sieve over the same range.
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <primesieve.hpp>
+#include "worker.hpp"
+#include "hash/nexus_skein.hpp"
+#include "hash/nexus_keccak.hpp"
+#include "hash/byte_utils.hpp"
+#include "gpu/prime_common.hpp"
+#include "prime/chain_sieve.hpp"
+#include "prime/sieve_2310.hpp"
+
+namespace nexusminer {
+namespace cpu
+{
+namespace
+{
+    using uint1k = boost::multiprecision::uint1024_t;
+
+    struct Bench_options
+    {
+        std::string m_header_file;
+        uint64_t m_range = 1000000000;
+        int m_wheel = 30;
+        uint32_t m_sieving_prime_limit = Sieve::get_max_sieving_prime_limit();
+        int m_min_chain_length = 8;
+        bool m_verify = false;
+    };
+
+    struct Bench_result
+    {
+        uint64_t m_range_searched = 0;
+        double m_sieve_ms = 0;
+        double m_find_chains_ms = 0;
+        double m_test_chains_ms = 0;
+        uint64_t m_chain_count = 0;
+        uint64_t m_fermat_test_count = 0;
+        uint64_t m_fermat_prime_count = 0;
+        std::vector<std::uint32_t> m_chain_histogram;
+        std::set<std::pair<uint64_t, int>> m_chain_candidates;  //base offset and length
+        std::set<uint64_t> m_long_chain_starts;
+    };
+
+    void show_usage(std::string const& name)
+    {
+        std::cerr << "Usage: " << name << " <option(s)>\n"
+                  << "Options:\n"
+                  << "\t-h,--help\t\t\tShow this help message\n"
+                  << "\t--header FILE\t\t\tHex encoded prime block header (without nonce). Default: Block_data defaults\n"
+                  << "\t--range N\t\t\tIntegers to search (default 1e9)\n"
+                  << "\t--wheel 30|2310\t\t\tSieve layout (default 30)\n"
+                  << "\t--limit N\t\t\tSieving prime limit (default 3e8)\n"
+                  << "\t--min-length N\t\t\tMinimum chain candidate length (default 8)\n"
+                  << "\t--verify\t\t\tCheck the mod 2310 sieve finds the same chains as the mod 30 reference sieve\n"
+                  << "\t--verbose\t\t\tShow sieve log output"
+                  << std::endl;
+    }
+
+    bool read_header(std::string const& file_name, std::vector<unsigned char>& header)
+    {
+        std::ifstream file(file_name);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        std::string hex;
+        for (char c; file.get(c);)
+        {
+            if (std::isxdigit(static_cast<unsigned char>(c)))
+            {
+                hex.push_back(c);
+            }
+        }
+        if (hex.empty() || hex.size() % 2 != 0)
+        {
+            return false;
+        }
+        header = HexStringToBytes(hex);
+        return true;
+    }
+
+    //same hash the prime worker feeds the sieve with
+    uint1k get_base_hash(std::vector<unsigned char> const& header)
+    {
+        NexusSkein skein;
+        skein.setMessage(header);
+        skein.calculateHash();
+        NexusKeccak keccak(skein.getHash());
+        keccak.calculateHash();
+        NexusKeccak::k_1024 keccak_hash = keccak.getHashResult();
+        keccak_hash.isBigInt = true;
+        return uint1k("0x" + keccak_hash.toHexString(true));
+    }
+
+    //these mirror gpu::Sieve::probability_is_prime_after_sieve and gpu::Sieve::expected_chain_density
+    double probability_is_prime_after_sieve(double bits, uint32_t sieving_prime_limit)
+    {
+        double p_not_divisible_by_nth_prime = 1.0;
+        primesieve::iterator it;
+        for (uint64_t prime = it.next_prime(); prime <= sieving_prime_limit; prime = it.next_prime())
+            p_not_divisible_by_nth_prime *= (prime - 1.0) / prime;
+
+        return (1.0 / (std::log(2.0) * bits)) / p_not_divisible_by_nth_prime;
+    }
+
+    double expected_chain_density(int n, int bits)
+    {
+        double density = 0;
+        if (n >= 1 && n <= 11)
+            density = gpu::hardy_littlewood_constants[n] / std::pow((std::log(2.0) * bits), n);
+
+        return density;
+    }
+
+    std::unique_ptr<Sieve> create_sieve(int wheel)
+    {
+        if (wheel == 2310)
+        {
+            return std::make_unique<Sieve_2310>();
+        }
+        return std::make_unique<Sieve>();
+    }
+
+    Bench_result run_bench(Sieve& sieve, uint1k const& sieve_start, Bench_options const& options)
+    {
+        using clock = std::chrono::steady_clock;
+        using ms = std::chrono::duration<double, std::milli>;
+
+        Bench_result result;
+        sieve.set_sieving_prime_limit(options.m_sieving_prime_limit);
+        sieve.set_min_chain_length(options.m_min_chain_length);
+        sieve.reset_stats();
+        sieve.set_sieve_start(sieve_start);
+        sieve.calculate_starting_multiples();
+        sieve.clear_chains();
+
+        uint64_t const segment_size = sieve.get_segment_size();
+        for (uint64_t low = 0; low < options.m_range; low += segment_size)
+        {
+            sieve.reset_sieve();
+            sieve.clear_chains();
+            auto sieve_start_time = clock::now();
+            sieve.sieve_segment();
+            auto find_chains_start_time = clock::now();
+            sieve.find_chains(low, false);
+            auto test_chains_start_time = clock::now();
+            sieve.test_chains();
+            auto test_chains_stop_time = clock::now();
+
+            result.m_sieve_ms += ms(find_chains_start_time - sieve_start_time).count();
+            result.m_find_chains_ms += ms(test_chains_start_time - find_chains_start_time).count();
+            result.m_test_chains_ms += ms(test_chains_stop_time - test_chains_start_time).count();
+            result.m_range_searched += segment_size;
+
+            for (auto const& chain : sieve.get_chains())
+            {
+                result.m_chain_candidates.insert({ chain.m_base_offset, static_cast<int>(chain.m_offsets.size()) });
+            }
+            result.m_long_chain_starts.insert(sieve.m_long_chain_starts.begin(), sieve.m_long_chain_starts.end());
+        }
+        result.m_chain_count = sieve.m_chain_count;
+        result.m_fermat_test_count = sieve.m_fermat_test_count;
+        result.m_fermat_prime_count = sieve.m_fermat_prime_count;
+        result.m_chain_histogram = sieve.m_chain_histogram;
+        return result;
+    }
+
+    void print_result(Bench_result const& result, std::string const& name, int bits, uint32_t sieving_prime_limit)
+    {
+        double const elapsed_ms = result.m_sieve_ms + result.m_find_chains_ms + result.m_test_chains_ms;
+        double const elapsed_s = elapsed_ms / 1000.0;
+        double const pass_rate = 1.0 * result.m_fermat_prime_count / std::max<uint64_t>(result.m_fermat_test_count, 1);
+
+        std::cout << "--" << name << "--" << std::endl;
+        std::cout << std::fixed << std::setprecision(3) << result.m_range_searched / 1.0e9 << " billion integers searched in "
+            << elapsed_s << "s. GISPS: " << result.m_range_searched / (1.0e9 * elapsed_s) << std::endl;
+        std::cout << "Sieving: " << std::setprecision(1) << 100.0 * result.m_sieve_ms / elapsed_ms << "% Chain filtering: "
+            << 100.0 * result.m_find_chains_ms / elapsed_ms << "% Fermat testing: " << 100.0 * result.m_test_chains_ms / elapsed_ms << "%" << std::endl;
+        std::cout << "Chain candidates: " << result.m_chain_count << " (" << std::setprecision(3)
+            << 1.0e6 * result.m_chain_count / result.m_range_searched << " per million integers, "
+            << result.m_chain_count / elapsed_s << " per second)" << std::endl;
+        std::cout << "Fermat tests: " << result.m_fermat_test_count << " (" << std::setprecision(1) << result.m_fermat_test_count / elapsed_s
+            << "/s) Fermat primes: " << result.m_fermat_prime_count << " Pass rate: " << std::setprecision(3) << 100.0 * pass_rate
+            << "% (predicted " << 100.0 * probability_is_prime_after_sieve(bits, sieving_prime_limit) << "%)" << std::endl;
+
+        //fermat chains are only found inside chain candidates so short chains are undercounted relative to the prediction
+        std::cout << "Fermat chain histogram (length: found, per billion integers observed / predicted)" << std::endl;
+        for (std::size_t n = 1; n < result.m_chain_histogram.size(); n++)
+        {
+            std::cout << "  " << n << ": " << result.m_chain_histogram[n] << ", " << std::scientific << std::setprecision(3)
+                << 1.0e9 * result.m_chain_histogram[n] / result.m_range_searched << " / "
+                << 1.0e9 * expected_chain_density(static_cast<int>(n), bits) << std::fixed << std::endl;
+        }
+    }
+
+    //the reference and optimized sieves must report the same chain candidates and fermat chain starts over the common range
+    bool verify(Bench_result const& reference, Bench_result const& optimized, uint64_t range)
+    {
+        //ignore chains near the end of the range.  the sieves stop at different segment boundaries.
+        uint64_t const limit = range - 2 * maxGap * 32;
+        auto trim_candidates = [limit](std::set<std::pair<uint64_t, int>> const& chains) {
+            std::set<std::pair<uint64_t, int>> trimmed;
+            std::copy_if(chains.begin(), chains.end(), std::inserter(trimmed, trimmed.end()),
+                [limit](auto const& chain) { return chain.first < limit; });
+            return trimmed;
+        };
+        auto trim_starts = [limit](std::set<uint64_t> const& starts) {
+            std::set<uint64_t> trimmed;
+            std::copy_if(starts.begin(), starts.end(), std::inserter(trimmed, trimmed.end()),
+                [limit](auto start) { return start < limit; });
+            return trimmed;
+        };
+
+        auto const reference_candidates = trim_candidates(reference.m_chain_candidates);
+        auto const optimized_candidates = trim_candidates(optimized.m_chain_candidates);
+        auto const reference_starts = trim_starts(reference.m_long_chain_starts);
+        auto const optimized_starts = trim_starts(optimized.m_long_chain_starts);
+        std::cout << "--verify--" << std::endl;
+        std::cout << "Chain candidates: reference " << reference_candidates.size() << " mod 2310 " << optimized_candidates.size() << std::endl;
+        std::cout << "Fermat chain starts: reference " << reference_starts.size() << " mod 2310 " << optimized_starts.size() << std::endl;
+        bool const pass = reference_candidates == optimized_candidates && reference_starts == optimized_starts;
+        std::cout << (pass ? "PASS" : "FAIL") << std::endl;
+        return pass;
+    }
+}
+}
+}
+
+int main(int argc, char** argv)
+{
+    using namespace nexusminer;
+    using namespace nexusminer::cpu;
+
+    Bench_options options;
+    bool verbose = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool const has_value = i + 1 < argc;
+        if ((arg == "-h") || (arg == "--help"))
+        {
+            show_usage(argv[0]);
+            return 0;
+        }
+        else if (arg == "--header" && has_value)
+        {
+            options.m_header_file = argv[++i];
+        }
+        else if (arg == "--range" && has_value)
+        {
+            options.m_range = static_cast<uint64_t>(std::stod(argv[++i]));
+        }
+        else if (arg == "--wheel" && has_value)
+        {
+            options.m_wheel = std::stoi(argv[++i]);
+        }
+        else if (arg == "--limit" && has_value)
+        {
+            options.m_sieving_prime_limit = static_cast<uint32_t>(std::stod(argv[++i]));
+        }
+        else if (arg == "--min-length" && has_value)
+        {
+            options.m_min_chain_length = std::stoi(argv[++i]);
+        }
+        else if (arg == "--verify")
+        {
+            options.m_verify = true;
+        }
+        else if (arg == "--verbose")
+        {
+            verbose = true;
+        }
+        else
+        {
+            show_usage(argv[0]);
+            return -1;
+        }
+    }
+    if (options.m_wheel != 30 && options.m_wheel != 2310)
+    {
+        std::cerr << "Invalid sieve wheel " << options.m_wheel << std::endl;
+        return -1;
+    }
+
+    auto logger = spdlog::stdout_color_mt("logger");
+    logger->set_level(verbose ? spdlog::level::info : spdlog::level::warn);
+
+    std::vector<unsigned char> header = Block_data{}.GetHeaderBytes(true);
+    if (!options.m_header_file.empty() && !read_header(options.m_header_file, header))
+    {
+        std::cerr << "Failed to read header file " << options.m_header_file << std::endl;
+        return -1;
+    }
+    uint1k const base_hash = get_base_hash(header);
+    int const bits = static_cast<int>(boost::multiprecision::msb(base_hash)) + 1;
+    //round the start up to the largest wheel so every layout sieves the same integers
+    uint1k sieve_start = base_hash;
+    if (sieve_start % 2310 > 0)
+    {
+        sieve_start += 2310 - (sieve_start % 2310);
+    }
+
+    std::cout << "Prime bench: " << header.size() << " byte header, " << bits << " bit base hash, range " << options.m_range
+        << ", sieving prime limit " << options.m_sieving_prime_limit << ", min chain length " << options.m_min_chain_length << std::endl;
+
+    auto sieve = create_sieve(options.m_verify ? 30 : options.m_wheel);
+    sieve->generate_sieving_primes();
+    auto const result = run_bench(*sieve, sieve_start, options);
+    print_result(result, options.m_verify ? "mod 30 (reference)" : "mod " + std::to_string(options.m_wheel), bits, options.m_sieving_prime_limit);
+    if (!options.m_verify)
+    {
+        return 0;
+    }
+
+    sieve = create_sieve(2310);
+    sieve->generate_sieving_primes();
+    auto const optimized_result = run_bench(*sieve, sieve_start, options);
+    print_result(optimized_result, "mod 2310", bits, options.m_sieving_prime_limit);
+    return verify(result, optimized_result, std::min(result.m_range_searched, optimized_result.m_range_searched)) ? 0 : 1;
+}
@@ -0,0 +1,40 @@
+#ifndef NEXUSMINER_CPU_CALIBRATION_HPP
+#define NEXUSMINER_CPU_CALIBRATION_HPP
+//measures the throughput of the cpu prime kernels once per start, instead of once per worker, and logs it.
+//the sieving primes generated for the measurement stay cached until the calibration is destroyed.
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <spdlog/spdlog.h>
+#include "config/types.hpp"
+
+namespace nexusminer {
+namespace cpu
+{
+class Calibration
+{
+public:
+
+    Calibration();
+
+    // call before the workers start, they would slow down the measurement. destroy the calibration after
+    // the workers are created so they reuse its sieving primes.
+    void run(std::vector<config::Sieve_wheel> const& wheels);
+
+private:
+
+    double measure_fermat_throughput();
+    double measure_sieve_throughput(config::Sieve_wheel wheel);
+
+    static constexpr int fermat_sample_size = 2000;
+    static constexpr int sieve_segments = 3;
+
+    std::shared_ptr<spdlog::logger> m_logger;
+    std::vector<std::shared_ptr<const std::vector<std::uint32_t>>> m_sieving_primes;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef NEXUSMINER_CPU_LAYOUT_HPP
+#define NEXUSMINER_CPU_LAYOUT_HPP
+//expands cpu workers with "threads" 0 (auto) or > 1 into one worker per selected logical cpu, pinned and
+//grouped per L3. whether SMT siblings are used is decided by a short benchmark of the mining kernel.
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "config/types.hpp"
+#include "config/worker_config.hpp"
+#include "cpu/topology.hpp"
+
+namespace nexusminer {
+namespace cpu
+{
+
+class Layout
+{
+public:
+
+    // a kernel instance for one benchmark thread, every call does one unit of work
+    using Kernel = std::function<void()>;
+    using Kernel_factory = std::function<Kernel()>;
+
+    static constexpr double min_smt_gain = 1.1;     // two siblings must beat one thread by 10%
+    static constexpr std::chrono::milliseconds benchmark_duration{ 300 };
+
+    explicit Layout(Topology topology);
+
+    // Replaces the automatic cpu workers in worker_config. Expanded workers are named "<id>-<cpu>".
+    // The SMT benchmark runs on the first call only, a config reload doesn't benchmark next to the running workers.
+    void apply(std::vector<config::Worker_config>& worker_config, config::Mining_mode mining_mode);
+
+    // work units per second of one kernel per cpu, all running at the same time
+    static double measure(Kernel_factory const& kernel_factory, std::vector<unsigned> const& cpus,
+        std::chrono::milliseconds duration);
+
+private:
+
+    // false if the pair of SMT siblings doesn't beat one thread on the core by min_smt_gain
+    bool smt_pays_off(Kernel_factory const& kernel_factory, std::vector<Logical_cpu> const& candidates);
+
+    Topology m_topology;
+    int m_smt_pays{ -1 };      // benchmark result, -1 = not benchmarked yet
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef NEXUSMINER_CPU_SCHEDULER_HPP
+#define NEXUSMINER_CPU_SCHEDULER_HPP
+//throttles cpu workers to a target hashrate or a cpu budget (power_limit_percent). a feedback loop on the live
+//rate sets the number of active threads of every configured worker and the duty cycle of the active ones.
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "config/types.hpp"
+#include "config/worker_config.hpp"
+#include "cpu/throttle.hpp"
+#include <spdlog/spdlog.h>
+
+namespace nexusminer {
+namespace cpu
+{
+
+class Scheduler
+{
+public:
+
+    static constexpr std::uint16_t update_interval = 2;     // seconds between two feedback steps
+    static constexpr double min_duty = 0.05;                // lowest duty cycle of the last active thread
+
+    explicit Scheduler(config::Mining_mode mining_mode);
+
+    // Registers the throttle of a cpu worker. Workers expanded from one configured worker (automatic layout)
+    // share its target and budget. Workers without target_hashrate and power_limit_percent run unthrottled.
+    void add(config::Worker_config const& worker_config, std::shared_ptr<Throttle> throttle);
+    bool empty() const { return m_groups.empty(); }
+    // one line per throttled worker: threads, budget, target
+    void log_setup() const;
+
+    // one feedback step, called every update_interval seconds
+    void update();
+
+private:
+
+    struct Group
+    {
+        std::string m_id;
+        std::uint64_t m_target_hashrate{ 0 };       // 0 = no target
+        double m_max_budget{ 0.0 };                 // threads * power_limit_percent / 100
+        double m_budget{ 0.0 };                     // busy threads, e.g. 2.5 = two threads full and one at 50%
+        std::size_t m_active{ 0 };
+        std::vector<std::shared_ptr<Throttle>> m_throttles;     // in layout order, the last ones are parked first
+    };
+
+    // active threads and their duty cycle for the budget of the group, true if the active threads changed
+    bool apply(Group& group);
+
+    std::shared_ptr<spdlog::logger> m_logger;
+    config::Mining_mode m_mining_mode;
+    std::vector<Group> m_groups;
+    std::chrono::steady_clock::time_point m_last_update;
+};
+
+}
+}
+
+#endif
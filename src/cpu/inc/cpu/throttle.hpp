@@ -0,0 +1,57 @@
+#ifndef NEXUSMINER_CPU_THROTTLE_HPP
+#define NEXUSMINER_CPU_THROTTLE_HPP
+//duty cycle of one cpu worker thread. the mining thread reports every batch of work and sleeps for the pause
+//that keeps its duty cycle, the Scheduler sets the duty cycle and parks threads from the io thread.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace nexusminer {
+namespace cpu
+{
+
+class Throttle
+{
+public:
+
+    // longest single sleep, a stopping worker (new block) leaves a pause or the parked state within this time
+    static constexpr std::chrono::milliseconds sleep_slice{ 20 };
+    // hashes between two pace calls of the hash worker, a few milliseconds of work
+    static constexpr std::uint64_t batch_hashes = 4096;
+
+    // mining thread: a new run of the thread starts, the next batch is measured from now
+    void begin();
+    // mining thread: a batch of units is done. Sleeps busy * (1 - duty) / duty, blocks while parked.
+    void pace(std::uint64_t units, std::atomic<bool> const& stop);
+
+    // scheduler: duty cycle in (0, 1], parked threads don't mine at all
+    void set(double duty, bool parked);
+    double get_duty() const { return m_duty.load(std::memory_order_relaxed); }
+    bool is_parked() const { return m_parked.load(std::memory_order_relaxed); }
+    // scheduler: units reported since the last call
+    std::uint64_t take_units() { return m_units.exchange(0, std::memory_order_relaxed); }
+
+private:
+
+    // sleeps up to duration in slices, returns early when stop is set
+    static void sleep(std::chrono::steady_clock::duration duration, std::atomic<bool> const& stop);
+
+    std::atomic<double> m_duty{ 1.0 };
+    std::atomic<bool> m_parked{ false };
+    std::atomic<std::uint64_t> m_units{ 0 };
+
+    // mining thread only
+    std::chrono::steady_clock::time_point m_batch_start{ std::chrono::steady_clock::now() };
+    // pause time owed from oversleeping (negative) or undersleeping (positive), keeps the duty cycle exact
+    std::chrono::steady_clock::duration m_pause_debt{ 0 };
+};
+
+// OS priority of the calling thread, 0 = low, 1 = below normal, 2 = normal, 3 = above normal, 4 = high.
+// false if the platform refused it (e.g. raising the priority without privileges). Level 2 doesn't change anything.
+bool set_current_thread_priority(std::uint8_t level);
+
+}
+}
+
+#endif
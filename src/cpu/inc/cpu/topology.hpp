@@ -0,0 +1,72 @@
+#ifndef NEXUSMINER_CPU_TOPOLOGY_HPP
+#define NEXUSMINER_CPU_TOPOLOGY_HPP
+//logical cpus of the host with their core, cache and package relations, and thread pinning.
+//linux reads /sys/devices/system/cpu, other platforms see every logical cpu as its own core.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nexusminer {
+namespace config { struct Worker_config_cpu; }
+namespace cpu
+{
+
+struct Logical_cpu
+{
+    unsigned m_id{0};
+    unsigned m_package{0};
+    unsigned m_core{0};         // lowest logical cpu of the physical core
+    unsigned m_smt_index{0};    // position among the SMT siblings of the core, 0 = first thread
+    int m_l2{-1};               // lowest logical cpu sharing the L2, -1 = unknown
+    int m_l3{-1};               // lowest logical cpu sharing the L3, -1 = unknown
+    bool m_efficiency{false};   // efficiency core of a hybrid cpu
+};
+
+class Topology
+{
+public:
+
+    struct Selection
+    {
+        bool m_smt{true};                   // SMT siblings after the first thread of every core
+        bool m_efficiency_cores{false};
+        std::size_t m_max_threads{0};       // 0 = all
+        std::vector<unsigned> m_excluded;   // logical cpus taken by other workers
+    };
+
+    // falls back to std::thread::hardware_concurrency independent cores if sysfs is missing
+    static Topology detect(std::string const& sysfs_cpu_root = "/sys/devices/system/cpu");
+
+    std::vector<Logical_cpu> const& cpus() const { return m_cpus; }
+    bool from_sysfs() const { return m_from_sysfs; }
+    std::size_t core_count() const;
+    std::size_t efficiency_core_count() const;
+    std::size_t l3_count() const;
+    std::size_t package_count() const;
+    // "2 packages, 4 L3, 32 cores (8 efficiency), 48 threads"
+    std::string describe() const;
+
+    // Logical cpus for worker threads, grouped per L3 (package if unknown). Within a group the first threads
+    // of the performance cores come first, then their SMT siblings, then the efficiency cores. A thread limit
+    // is spread evenly over the groups.
+    std::vector<Logical_cpu> select(Selection const& selection) const;
+
+private:
+
+    std::vector<Logical_cpu> m_cpus;
+    bool m_from_sysfs{false};
+};
+
+// parses a sysfs cpu list like "0-3,8,10-11"
+std::vector<unsigned> parse_cpu_list(std::string const& list);
+
+// pins the calling thread to one logical cpu, false if the platform doesn't support it or the call failed
+bool pin_current_thread(unsigned cpu);
+// pins the calling thread as a cpu worker config asks for (m_cpu, else m_affinity_mask). true if nothing to do
+bool pin_current_thread(config::Worker_config_cpu const& config);
+
+}
+}
+
+#endif
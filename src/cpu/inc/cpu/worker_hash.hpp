@@ -9,6 +9,7 @@
 #include "worker.hpp"
 #include "hash/nexus_skein.hpp"
 #include "hash/nexus_keccak.hpp"
+#include "cpu/throttle.hpp"
 #include <spdlog/spdlog.h>
 
 namespace asio { class io_context; }
@@ -33,6 +34,9 @@ public:
     void set_block(LLP::CBlock block, std::uint32_t nbits, Worker::Block_found_handler result) override;
     void update_statistics(stats::Collector& stats_collector) override;
 
+    // duty cycle of the hashing thread, driven by the cpu Scheduler
+    std::shared_ptr<Throttle> get_throttle() const { return m_throttle; }
+
 private:
 
     void run();
@@ -64,11 +68,14 @@ private:
     std::string m_log_leader;
  
     void reset_statistics();
-    std::uint64_t m_hash_count;
-    int m_best_leading_zeros;
-    int m_met_difficulty_count;
+    // written by the hashing thread under m_mtx, read without the lock by update_statistics.
+    // the hash count is a lifetime count, only the other statistics restart with a new block.
+    std::atomic<std::uint64_t> m_hash_count;
+    std::atomic<int> m_best_leading_zeros;
+    std::atomic<int> m_met_difficulty_count;
 
     std::uint32_t m_pool_nbits;
+    std::shared_ptr<Throttle> m_throttle;
 
 };
 }
@@ -2,6 +2,7 @@
 #define NEXUSMINER_CPU_WORKER_PRIME_HPP
 //a software prime channel miner for demo and test purposes
 
+#include <array>
 #include <memory>
 #include <thread>
 #include <atomic>
@@ -12,6 +13,8 @@
 #include <boost/multiprecision/cpp_int.hpp>
 #include <spdlog/spdlog.h>
 #include "LLC/types/bignum.h"
+#include "stats/pipeline_timer.hpp"
+#include "cpu/throttle.hpp"
 
 namespace asio { class io_context; }
 
@@ -24,6 +27,7 @@ namespace cpu
     using uint1k = boost::multiprecision::uint1024_t;
     class Prime;
     class Sieve;
+    class Sieve_tuner;
 class Worker_prime : public Worker, public std::enable_shared_from_this<Worker_prime>
 {
 public:
@@ -34,6 +38,9 @@ public:
     void set_block(LLP::CBlock block, std::uint32_t nbits, Worker::Block_found_handler result) override;
     void update_statistics(stats::Collector& stats_collector) override;
 
+    // duty cycle of the sieve thread, driven by the cpu Scheduler
+    std::shared_ptr<Throttle> get_throttle() const { return m_throttle; }
+
 private:
 
     void run();
@@ -42,7 +49,6 @@ private:
     bool difficulty_check(uint1k p);
     //std::uint64_t leading_zero_mask();
     bool isPrime(uint1k p);
-    void fermat_performance_test();
 
     //Poor man's difficulty.  Report any nonces with at least this many leading zeros. Let the software perform additional filtering. 
     //static constexpr int leading_zeros_required = 20;    //set lower to find more nonce candidates
@@ -56,6 +62,7 @@ private:
     std::thread m_run_thread;
     Worker::Block_found_handler m_found_nonce_callback;
     std::unique_ptr<Sieve> m_segmented_sieve;
+    std::unique_ptr<Sieve_tuner> m_sieve_tuner;
 
     Block_data m_block;
     std::mutex m_mtx;
@@ -65,9 +72,10 @@ private:
     void reset_statistics();
     std::uint32_t m_primes{ 0 };
     std::uint32_t m_chains{ 0 };
-    std::uint32_t m_difficulty{ 0 };
+    std::atomic<std::uint32_t> m_difficulty{ 0 };
 
     std::uint32_t m_pool_nbits;
+    std::shared_ptr<Throttle> m_throttle;
 
     std::uint64_t m_nonce = 0;
     uint1k m_base_hash;
@@ -97,14 +105,21 @@ private:
     int m_chainCount = 0;  //number of chains found
     int m_candidateCount = 0;  //number of possible primes in the sieve
 
-    //stats
-    std::vector<std::uint32_t> m_chain_histogram;
-    uint64_t m_range_searched = 0;
+    //stats. the sieve counters are plain members of the sieve, the mining thread copies them after every segment.
+    //written by the mining thread only (relaxed stores), read by update_statistics.
+    void publish_statistics();
+    std::atomic<std::uint64_t> m_fermat_test_count{ 0 };
+    std::atomic<std::uint64_t> m_fermat_prime_count{ 0 };
+    std::atomic<std::uint64_t> m_chain_count{ 0 };
+    std::atomic<double> m_best_chain{ 0.0 };
+    std::array<std::atomic<std::uint32_t>, stats::Prime::chain_histogram_size> m_chain_histogram{};
+    std::atomic<std::uint64_t> m_range_searched{ 0 };
+    stats::Prime_pipeline_timer m_pipeline_timer;
     
     // CPU load tracking
     std::chrono::steady_clock::time_point m_cpu_tracking_start;
-    std::chrono::milliseconds m_cpu_active_time{0};
-    std::chrono::milliseconds m_cpu_total_time{0};
+    std::atomic<std::int64_t> m_cpu_active_ms{ 0 };
+    std::atomic<std::int64_t> m_cpu_total_ms{ 0 };
 
 };
 }
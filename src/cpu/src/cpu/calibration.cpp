@@ -0,0 +1,110 @@
+#include "cpu/calibration.hpp"
+#include "prime/chain_sieve.hpp"
+#include "prime/sieve_2310.hpp"
+#include <boost/random.hpp>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace nexusminer
+{
+namespace cpu
+{
+namespace
+{
+std::unique_ptr<Sieve> create_sieve(config::Sieve_wheel wheel)
+{
+	if (wheel == config::Sieve_wheel::MOD2310)
+	{
+		return std::make_unique<Sieve_2310>();
+	}
+	return std::make_unique<Sieve>();
+}
+
+// random odd 1024 bit integers. the fermat test cost does not depend on the value
+std::vector<boost::multiprecision::uint1024_t> random_odd_uint1024(int count)
+{
+	using namespace boost::random;
+	using generator1024_type = independent_bits_engine<mt19937, 1024, boost::multiprecision::uint1024_t>;
+	generator1024_type gen1024;
+	gen1024.seed(static_cast<std::uint32_t>(time(0)));
+	std::vector<boost::multiprecision::uint1024_t> big_uints;
+	for (int i = 0; i < count; ++i)
+	{
+		big_uints.push_back(gen1024() | 1);
+	}
+	return big_uints;
+}
+}
+
+Calibration::Calibration()
+	: m_logger{ spdlog::get("logger") }
+{
+}
+
+void Calibration::run(std::vector<config::Sieve_wheel> const& wheels)
+{
+	try {
+		std::stringstream ss;
+		ss << std::fixed << std::setprecision(2) << "[Calibration] " << measure_fermat_throughput() << " primality tests/second.";
+		for (auto wheel : wheels)
+		{
+			ss << " Mod " << static_cast<int>(wheel) << " sieve: " << measure_sieve_throughput(wheel) / 1.0e6 << " million integers/second.";
+		}
+		m_logger->info(ss.str());
+	}
+	catch (std::exception const& e) {
+		m_logger->error("[Calibration] Failed: {}", e.what());
+	}
+}
+
+//test the throughput of fermat primality test
+double Calibration::measure_fermat_throughput()
+{
+	auto const big_uints = random_odd_uint1024(fermat_sample_size);
+	Sieve sieve;
+	int p_count = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (auto const& big_uint : big_uints)
+	{
+		p_count += sieve.primality_test(big_uint) ? 1 : 0;
+	}
+	auto end = std::chrono::steady_clock::now();
+	auto elapsed = std::chrono::duration<double>(end - start).count();
+	double expected_primes = fermat_sample_size * 2 / (1024 * 0.693147);
+	m_logger->debug("[Calibration] Found {} primes out of {} tested. Expected about {:.1f}.", p_count, fermat_sample_size, expected_primes);
+	return fermat_sample_size / std::max(elapsed, 1e-9);
+}
+
+//sieve and scan a few full segments at the default operating point. setup of the starting multiples is not timed.
+double Calibration::measure_sieve_throughput(config::Sieve_wheel wheel)
+{
+	auto sieve = create_sieve(wheel);
+	sieve->generate_sieving_primes();
+	m_sieving_primes.push_back(sieve->get_sieving_primes());
+	sieve->set_sieve_start(random_odd_uint1024(1).front() >> 1);
+	sieve->calculate_starting_multiples();
+
+	uint64_t const segment_size = sieve->get_segment_size();
+	uint64_t range_searched = 0;
+	auto start = std::chrono::steady_clock::now();
+	//the first segment warms up the caches and is not counted
+	for (int segment = 0; segment <= sieve_segments; segment++)
+	{
+		if (segment == 1)
+		{
+			start = std::chrono::steady_clock::now();
+		}
+		sieve->reset_sieve();
+		sieve->clear_chains();
+		sieve->sieve_segment();
+		sieve->find_chains(segment * segment_size, false);
+		range_searched += segment > 0 ? segment_size : 0;
+	}
+	auto end = std::chrono::steady_clock::now();
+	auto elapsed = std::chrono::duration<double>(end - start).count();
+	return range_searched / std::max(elapsed, 1e-9);
+}
+
+}
+}
@@ -0,0 +1,234 @@
+#include "cpu/layout.hpp"
+#include "hash/nexus_skein.hpp"
+#include "hash/nexus_keccak.hpp"
+#ifdef PRIME_ENABLED
+#include "prime/chain_sieve.hpp"
+#endif
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace nexusminer
+{
+namespace cpu
+{
+namespace
+{
+// skein + keccak of the hash channel, 64 nonces per unit
+Layout::Kernel_factory hash_kernel()
+{
+	return []()
+	{
+		struct State
+		{
+			NexusSkein m_skein;
+			std::uint64_t m_result{ 0 };
+		};
+		auto state = std::make_shared<State>();
+		state->m_skein.setMessage(std::vector<unsigned char>(216, 0x5a));
+		return [state]()
+		{
+			for (int i = 0; i < 64; ++i)
+			{
+				state->m_skein.calculateHash();
+				NexusKeccak keccak(state->m_skein.getHash());
+				keccak.calculateHash();
+				state->m_result ^= keccak.getResult();
+				state->m_skein.setNonce(state->m_skein.getNonce() + 1);
+			}
+		};
+	};
+}
+
+#ifdef PRIME_ENABLED
+// one sieve segment and chain scan at the default operating point, the prime worker's inner loop
+Layout::Kernel_factory sieve_kernel()
+{
+	return []()
+	{
+		auto sieve = std::make_shared<Sieve>();
+		sieve->generate_sieving_primes();
+		sieve->set_sieve_start((boost::multiprecision::uint1024_t{ 1 } << 1000) + 1);
+		sieve->calculate_starting_multiples();
+		return [sieve, low = std::uint64_t{ 0 }]() mutable
+		{
+			sieve->reset_sieve();
+			sieve->clear_chains();
+			sieve->sieve_segment();
+			sieve->find_chains(low, false);
+			low += sieve->get_segment_size();
+		};
+	};
+}
+#endif
+
+std::string cpu_list(std::vector<Logical_cpu> const& cpus)
+{
+	std::stringstream ss;
+	for (std::size_t i = 0; i < cpus.size(); ++i)
+	{
+		ss << (i == 0 ? "" : ",") << cpus[i].m_id;
+	}
+	return ss.str();
+}
+}
+
+Layout::Layout(Topology topology)
+	: m_topology{ std::move(topology) }
+{
+}
+
+void Layout::apply(std::vector<config::Worker_config>& worker_config, config::Mining_mode mining_mode)
+{
+	auto const is_automatic = [](config::Worker_config const& worker)
+	{
+		return worker.m_mode == config::Worker_mode::CPU && std::holds_alternative<config::Worker_config_cpu>(worker.m_worker_mode) &&
+			std::get<config::Worker_config_cpu>(worker.m_worker_mode).m_threads != 1;
+	};
+	if (std::none_of(worker_config.begin(), worker_config.end(), is_automatic))
+	{
+		return;
+	}
+
+	auto logger = spdlog::get("logger");
+	logger->info("[Layout] CPU topology: {}", m_topology.describe());
+#ifdef PRIME_ENABLED
+	auto const kernel_factory = mining_mode == config::Mining_mode::PRIME ? sieve_kernel() : hash_kernel();
+#else
+	(void)mining_mode;
+	auto const kernel_factory = hash_kernel();
+#endif
+
+	std::vector<unsigned> used;
+	std::vector<config::Worker_config> result;
+	for (auto const& worker : worker_config)
+	{
+		if (!is_automatic(worker))
+		{
+			result.push_back(worker);
+			continue;
+		}
+
+		auto const& cpu_config = std::get<config::Worker_config_cpu>(worker.m_worker_mode);
+		Topology::Selection selection;
+		selection.m_smt = cpu_config.m_hyperthreading;
+		selection.m_efficiency_cores = cpu_config.m_efficiency_cores;
+		if (selection.m_smt && m_topology.from_sysfs())
+		{
+			if (m_smt_pays < 0)
+			{
+				m_smt_pays = smt_pays_off(kernel_factory, m_topology.select(selection)) ? 1 : 0;
+			}
+			selection.m_smt = m_smt_pays == 1;
+		}
+
+		selection.m_excluded = used;
+		selection.m_max_threads = cpu_config.m_threads;
+		auto const candidates = m_topology.select(selection);
+		if (candidates.empty())
+		{
+			logger->warn("[Layout] No cpu left for worker {}, it runs one thread without pinning", worker.m_id);
+			auto single = worker;
+			std::get<config::Worker_config_cpu>(single.m_worker_mode).m_threads = 1;
+			result.push_back(std::move(single));
+			continue;
+		}
+		if (cpu_config.m_threads > candidates.size())
+		{
+			logger->warn("[Layout] Worker {} asks for {} threads, {} cpus are available", worker.m_id, cpu_config.m_threads, candidates.size());
+		}
+
+		for (auto const& cpu : candidates)
+		{
+			auto pinned = worker;
+			pinned.m_id = worker.m_id + "-" + std::to_string(cpu.m_id);
+			auto& pinned_config = std::get<config::Worker_config_cpu>(pinned.m_worker_mode);
+			pinned_config.m_threads = 1;
+			pinned_config.m_affinity_mask = 0;
+			pinned_config.m_cpu = static_cast<std::int32_t>(cpu.m_id);
+			pinned_config.m_group = worker.m_id;
+			result.push_back(std::move(pinned));
+			used.push_back(cpu.m_id);
+		}
+		logger->info("[Layout] Worker {}: {} threads on cpus {}", worker.m_id, candidates.size(), cpu_list(candidates));
+	}
+	worker_config = std::move(result);
+}
+
+bool Layout::smt_pays_off(Kernel_factory const& kernel_factory, std::vector<Logical_cpu> const& candidates)
+{
+	auto const sibling = std::find_if(candidates.begin(), candidates.end(), [](auto const& cpu) { return cpu.m_smt_index == 1; });
+	if (sibling == candidates.end())
+	{
+		return true;
+	}
+
+	auto logger = spdlog::get("logger");
+	auto const single = measure(kernel_factory, { sibling->m_core }, benchmark_duration);
+	auto const pair = measure(kernel_factory, { sibling->m_core, sibling->m_id }, benchmark_duration);
+	auto const gain = single > 0.0 ? pair / single : 0.0;
+	if (gain < min_smt_gain)
+	{
+		logger->info("[Layout] SMT siblings off: two threads on core {} reach {:.2f}x of one thread", sibling->m_core, gain);
+		return false;
+	}
+	logger->info("[Layout] SMT siblings on: two threads on core {} reach {:.2f}x of one thread", sibling->m_core, gain);
+	return true;
+}
+
+double Layout::measure(Kernel_factory const& kernel_factory, std::vector<unsigned> const& cpus, std::chrono::milliseconds duration)
+{
+	std::atomic<std::size_t> ready{ 0 };
+	std::atomic<bool> start{ false };
+	std::atomic<bool> stop{ false };
+	std::vector<std::uint64_t> units(cpus.size(), 0);
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < cpus.size(); ++i)
+	{
+		threads.emplace_back([&, i]()
+		{
+			pin_current_thread(cpus[i]);
+			auto kernel = kernel_factory();
+			kernel();	// warm up
+			ready++;
+			while (!start)
+			{
+				std::this_thread::yield();
+			}
+			std::uint64_t count = 0;
+			while (!stop)
+			{
+				kernel();
+				count++;
+			}
+			units[i] = count;
+		});
+	}
+
+	while (ready < cpus.size())
+	{
+		std::this_thread::yield();
+	}
+	auto const begin = std::chrono::steady_clock::now();
+	start = true;
+	std::this_thread::sleep_for(duration);
+	stop = true;
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	auto const elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+	std::uint64_t total = 0;
+	for (auto const count : units)
+	{
+		total += count;
+	}
+	return static_cast<double>(total) / std::max(elapsed, 1e-9);
+}
+
+}
+}
@@ -2,9 +2,12 @@
 #include <primesieve.hpp>
 #include <vector>
 #include <queue>
+#include <algorithm>
 #include <chrono>
 #include <bitset>
 #include <sstream>
+#include <map>
+#include <mutex>
 #include <boost/integer/mod_inverse.hpp>
 
 namespace nexusminer {
@@ -181,6 +184,7 @@ namespace nexusminer {
 
         Sieve::Sieve()
             : m_logger{ spdlog::get("logger") }
+            , m_sieving_primes{ std::make_shared<const std::vector<uint32_t>>() }
         {
             m_sieve.resize(sieve_size);
             reset_stats();
@@ -189,15 +193,32 @@ namespace nexusminer {
 
         void Sieve::generate_sieving_primes()
         {
-            //generate sieving primes
-            m_logger->info("Generating sieving primes up to {}...", sieving_prime_limit);
+            m_sieving_primes = get_shared_sieving_primes(sieving_start_prime, "mod 30 wheel");
+        }
+
+        std::shared_ptr<const std::vector<uint32_t>> Sieve::get_shared_sieving_primes(uint32_t start_prime, std::string const& wheel_name)
+        {
+            //every worker needs the same list.  generate it once and hand out shared read only copies.
+            static std::mutex cache_mutex;
+            static std::map<uint32_t, std::weak_ptr<const std::vector<uint32_t>>> cache;
+
+            std::scoped_lock lock(cache_mutex);
+            if (auto primes = cache[start_prime].lock())
+            {
+                m_logger->debug("Reusing {} sieving primes up to {} ({}).", primes->size(), max_sieving_prime_limit, wheel_name);
+                return primes;
+            }
+            m_logger->info("Generating sieving primes up to {} ({})...", max_sieving_prime_limit, wheel_name);
             auto start = std::chrono::steady_clock::now();
-            primesieve::generate_primes(sieving_start_prime, sieving_prime_limit, &m_sieving_primes);
+            auto primes = std::make_shared<std::vector<uint32_t>>();
+            primesieve::generate_primes(start_prime, max_sieving_prime_limit, primes.get());
             auto end = std::chrono::steady_clock::now();
             auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
             std::stringstream ss;
-            ss << "Done. " << m_sieving_primes.size() << " primes generated in " << std::fixed << std::setprecision(3) << elapsed.count() / 1000.0 << " seconds.";
+            ss << "Done. " << primes->size() << " primes generated in " << std::fixed << std::setprecision(3) << elapsed.count() / 1000.0 << " seconds.";
             m_logger->info(ss.str());
+            cache[start_prime] = primes;
+            return primes;
         }
 
         void Sieve::set_sieve_start(boost::multiprecision::uint1024_t sieve_start)
@@ -217,32 +238,63 @@ namespace nexusminer {
 
         void Sieve::calculate_starting_multiples()
         {
-            //generate starting multiples of the sieving primes
-            m_multiples = {};
-            m_wheel_indices = {};
+            //generate starting multiples of the active sieving primes
             m_logger->info("Calculating starting multiples.");
-            auto start = std::chrono::steady_clock::now();
-            for (auto s : m_sieving_primes)
+            m_sieve_position = 0;
+            update_starting_multiples(m_sieve_start, 0);
+            update_starting_multiples(m_sieve_start, get_sieving_prime_count());
+        }
+
+        void Sieve::update_starting_multiples(boost::multiprecision::uint1024_t start, std::size_t count)
+        {
+            if (count <= m_multiples.size())
+            {
+                m_multiples.resize(count);
+                m_wheel_indices.resize(count);
+                return;
+            }
+            m_multiples.reserve(count);
+            m_wheel_indices.reserve(count);
+            for (auto i = m_multiples.size(); i < count; i++)
             {
-                uint32_t m = get_offset_to_next_multiple(m_sieve_start, s);
+                auto s = (*m_sieving_primes)[i];
+                uint32_t m = get_offset_to_next_multiple(start, s);
                 m_multiples.push_back(m);
                 //where is the starting multiple relative to the wheel
-                int wheel_index = (boost::integer::mod_inverse((int)s, 30) * m) % 30;
+                //reduce m first. the product can overflow 32 bits for large sieving primes.
+                int wheel_index = (boost::integer::mod_inverse((int)s, 30) * (m % 30)) % 30;
                 m_wheel_indices.push_back(sieve30_index[wheel_index]);
             }
-            auto end = std::chrono::steady_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-            //std::stringstream ss;
-            //ss << "Done. (" << std::fixed << std::setprecision(3) << elapsed.count() / 1000.0 << " seconds)";
-            //m_logger->info(ss.str());
+        }
+
+        std::size_t Sieve::get_sieving_prime_count() const
+        {
+            return std::upper_bound(m_sieving_primes->begin(), m_sieving_primes->end(), m_sieving_prime_limit) - m_sieving_primes->begin();
+        }
+
+        void Sieve::set_sieving_prime_limit(uint32_t limit)
+        {
+            limit = std::min(limit, max_sieving_prime_limit);
+            if (limit == m_sieving_prime_limit)
+                return;
+            m_sieving_prime_limit = limit;
+            //primes added mid block start at the current sieve position
+            if (!m_wheel_indices.empty())
+                update_starting_multiples(m_sieve_start + m_sieve_position, get_sieving_prime_count());
+        }
+
+        void Sieve::set_min_chain_length(int min_chain_length)
+        {
+            m_min_chain_length = min_chain_length;
+            m_current_chain.m_min_chain_length = min_chain_length;
         }
 
         void Sieve::sieve_segment()
         {
-            for (std::size_t i = 0; i < m_sieving_primes.size(); i++)
+            for (std::size_t i = 0; i < m_wheel_indices.size(); i++)
             {
                 uint32_t j = m_multiples[i];
-                uint32_t k = m_sieving_primes[i];
+                uint32_t k = (*m_sieving_primes)[i];
                 //where are we in the wheel
                 int wheel_index = m_wheel_indices[i];
                 int next_wheel_gap = sieve30_gaps[wheel_index];
@@ -258,6 +310,7 @@ namespace nexusminer {
                 m_multiples[i] = j - m_segment_size;
                 m_wheel_indices[i] = wheel_index;
             }
+            m_sieve_position += m_segment_size;
         }
 		
 		//batch sieve on the cpu for debug
@@ -305,6 +358,7 @@ namespace nexusminer {
             m_chain_count = 0;
             m_chain_candidate_max_length = 0;
             m_chain_candidate_total_length = 0;
+            m_candidate_length_histogram = std::vector<std::uint64_t>(32, 0);
         }
 
         //search the sieve for chains that meet the minimum length requirement.  Chains can cross segment boundaries.
@@ -334,9 +388,10 @@ namespace nexusminer {
                     pop_count.push(popcnt[sieve[n + 3]]);
                     hits_next_four_bytes += pop_count.back(); 
                 }
-                if (!m_chain_in_process && hits_next_four_bytes < m_min_chain_length)
+                if (!m_chain_in_process && n + 3 < sieve_size && hits_next_four_bytes < m_min_chain_length)
                 {
                     //not enough prime candidates in the next 120 numbers to make a long enough chain
+                    //the last bytes of the segment are always scanned. a chain starting there can continue in the next segment.
 
                 }
                 else if (sieve[n] == 0)
@@ -402,6 +457,7 @@ namespace nexusminer {
                 m_chain_count++;
                 m_chain_candidate_max_length = std::max(m_current_chain.length(), m_chain_candidate_max_length);
                 m_chain_candidate_total_length += m_current_chain.length();
+                m_candidate_length_histogram[std::min(static_cast<size_t>(m_current_chain.length()), m_candidate_length_histogram.size() - 1)]++;
             }
             m_current_chain.close();
             m_chain_in_process = false;
@@ -411,6 +467,7 @@ namespace nexusminer {
         {
             //reset chain in process to the default
             m_current_chain = { base_offset };
+            m_current_chain.m_min_chain_length = m_min_chain_length;
             m_chain_in_process = true;
         }
 
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <atomic>
+#include <memory>
 #include <spdlog/spdlog.h>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <boost/multiprecision/gmp.hpp>
@@ -67,20 +68,21 @@ namespace nexusminer {
 		{
 		public:
 			Sieve();
-			void generate_sieving_primes();
-			void set_sieve_start(boost::multiprecision::uint1024_t);
+			virtual ~Sieve() = default;
+			virtual void generate_sieving_primes();
+			virtual void set_sieve_start(boost::multiprecision::uint1024_t);
 			boost::multiprecision::uint1024_t get_sieve_start();
 			void calculate_starting_multiples();
-			void sieve_segment();
+			virtual void sieve_segment();
 			void sieve_batch(uint64_t low);
 			void sieve_batch_cpu(uint64_t low);
-			std::uint32_t get_segment_size();
+			virtual std::uint32_t get_segment_size();
 			std::uint32_t get_segment_batch_size();
-			void reset_sieve();
+			virtual void reset_sieve();
 			void reset_sieve_batch(uint64_t low);
 			void clear_chains();
 			void reset_stats();
-			void find_chains(uint64_t low, bool batch_sieve_mode);
+			virtual void find_chains(uint64_t low, bool batch_sieve_mode);
 			uint64_t count_fermat_primes(uint64_t sieve_size, uint64_t low);
 			bool primality_test(boost::multiprecision::uint1024_t p);
 			void test_chains();
@@ -88,7 +90,16 @@ namespace nexusminer {
 			void primality_batch_test_cpu();
 			void clean_chains();
 			uint64_t get_current_chain_list_length();
+			const std::vector<Chain>& get_chains() const { return m_chain; }
 			int get_fermat_test_batch_size() { return m_fermat_test_batch_size; }
+			//the sieving prime limit and minimum chain length can be changed between segments.
+			void set_sieving_prime_limit(uint32_t limit);
+			uint32_t get_sieving_prime_limit() const { return m_sieving_prime_limit; }
+			static constexpr uint32_t get_max_sieving_prime_limit() { return max_sieving_prime_limit; }
+			void set_min_chain_length(int min_chain_length);
+			int get_min_chain_length() const { return m_min_chain_length; }
+			//the shared sieving primes, holding them keeps the list cached for the next sieve of the same wheel
+			std::shared_ptr<const std::vector<uint32_t>> get_sieving_primes() const { return m_sieving_primes; }
 			std::vector<std::uint64_t> m_long_chain_starts;
 			uint64_t m_sieve_batch_start_offset;
 
@@ -100,8 +111,9 @@ namespace nexusminer {
 			int m_chain_candidate_max_length = 0;
 			uint64_t m_chain_candidate_total_length = 0;
 			double m_best_chain = 0;
+			std::vector<std::uint64_t> m_candidate_length_histogram;  //length of chain candidates passed to fermat testing
 
-		private:
+		protected:
 			class Fermat_test_candidate {
 			public:
 				uint64_t base_offset = 0;
@@ -120,8 +132,8 @@ namespace nexusminer {
 			static constexpr int L2_CACHE_SIZE = 262144;
 			//upper limit of the sieving range
 			//static constexpr uint64_t sieve_range = 3e9;//3e9;
-			//upper limit of the sieving primes. 
-			static constexpr uint32_t sieving_prime_limit = 3e8; //3e8;
+			//upper limit of the generated sieving primes.  the active limit can be lowered at runtime.
+			static constexpr uint32_t max_sieving_prime_limit = 3e8; //3e8;
 			static constexpr uint32_t sieve_size = L2_CACHE_SIZE * 16;
 			//each segment byte covers a range of 30 sieving primes 
 			static constexpr uint32_t m_segment_size = sieve_size * 30;
@@ -129,7 +141,9 @@ namespace nexusminer {
 			//static constexpr int segments = sieve_range / m_segment_size + (sieve_range % m_segment_size != 0);
 			//we start sieving at 7
 			static constexpr int sieving_start_prime = 7;
-			static constexpr int m_min_chain_length = 8;
+			uint32_t m_sieving_prime_limit = max_sieving_prime_limit;
+			int m_min_chain_length = 8;
+			uint64_t m_sieve_position = 0;  //integers sieved since the sieve start
 
 			/// Bitmasks used to unset bits
 			static constexpr uint8_t unset_bit_mask[30] =
@@ -167,7 +181,8 @@ namespace nexusminer {
 
 			//the sieve.  each bit that is set represents a possible prime.
 			std::vector<uint8_t> m_sieve;
-			std::vector<uint32_t> m_sieving_primes;
+			//sieving primes are read only after generation and shared by all sieves in the process
+			std::shared_ptr<const std::vector<uint32_t>> m_sieving_primes;
 			std::vector<uint32_t> m_multiples;
 			std::vector<int> m_wheel_indices;
 			std::vector<Chain> m_chain;
@@ -180,6 +195,11 @@ namespace nexusminer {
 			static constexpr int m_sieve_batch_buffer_size = sieve_size * m_segment_batch_size;
 			void close_chain();
 			void open_chain(uint64_t base_offset);
+			std::size_t get_sieving_prime_count() const;
+			//generate the sieving primes from start_prime up to the max sieving prime limit once per process
+			std::shared_ptr<const std::vector<uint32_t>> get_shared_sieving_primes(uint32_t start_prime, std::string const& wheel_name);
+			//calculate or drop starting multiples so the first count sieving primes are active at the sieve position start
+			virtual void update_starting_multiples(boost::multiprecision::uint1024_t start, std::size_t count);
 		};
 	}
 }
@@ -0,0 +1,142 @@
+#include "sieve_2310.hpp"
+#include <bitset>
+#include <boost/integer/mod_inverse.hpp>
+
+namespace nexusminer {
+    namespace cpu
+    {
+        using namespace boost::multiprecision;
+
+        Sieve_2310::Sieve_2310()
+            : Sieve()
+        {
+            //the byte sieve of the base class is not used
+            std::vector<uint8_t>().swap(m_sieve);
+            m_sieve_2310.resize(sieve_words);
+        }
+
+        void Sieve_2310::generate_sieving_primes()
+        {
+            m_sieving_primes = get_shared_sieving_primes(sieving_start_prime_2310, "mod 2310 wheel");
+        }
+
+        void Sieve_2310::set_sieve_start(boost::multiprecision::uint1024_t sieve_start)
+        {
+            //set the sieve start to a multiple of 2310
+            if (sieve_start % wheel2310::primorial > 0)
+            {
+                sieve_start += wheel2310::primorial - (sieve_start % wheel2310::primorial);
+            }
+            m_sieve_start = sieve_start;
+            m_chain_in_process = false;
+        }
+
+        void Sieve_2310::update_starting_multiples(boost::multiprecision::uint1024_t start, std::size_t count)
+        {
+            if (count <= m_multiples_2310.size())
+            {
+                m_multiples_2310.resize(count);
+                m_wheel_indices.resize(count);
+                return;
+            }
+            m_multiples_2310.reserve(count);
+            m_wheel_indices.reserve(count);
+            for (auto i = m_multiples_2310.size(); i < count; i++)
+            {
+                auto s = (*m_sieving_primes)[i];
+                uint64_t m = get_offset_to_next_multiple_2310(start, static_cast<uint64_t>(s));
+                m_multiples_2310.push_back(m);
+                //where is the starting multiple relative to the wheel
+                uint64_t s_inverse = boost::integer::mod_inverse(static_cast<int>(s % wheel2310::primorial), wheel2310::primorial);
+                int wheel_index = static_cast<int>((s_inverse * (m % wheel2310::primorial)) % wheel2310::primorial);
+                m_wheel_indices.push_back(wheel2310::tables.index[wheel_index]);
+            }
+        }
+
+        void Sieve_2310::sieve_segment()
+        {
+            constexpr auto& offsets_index = wheel2310::tables.index;
+            constexpr auto& gaps = wheel2310::tables.gaps;
+            for (std::size_t i = 0; i < m_wheel_indices.size(); i++)
+            {
+                uint64_t j = m_multiples_2310[i];
+                uint64_t k = (*m_sieving_primes)[i];
+                //where are we in the wheel
+                int wheel_index = m_wheel_indices[i];
+                while (j < m_segment_size_2310)
+                {
+                    uint32_t jj = static_cast<uint32_t>(j);
+                    uint32_t bit = (jj / wheel2310::primorial) * wheel2310::residue_count + offsets_index[jj % wheel2310::primorial];
+                    m_sieve_2310[bit / 64] &= ~(uint64_t{ 1 } << (bit % 64));
+                    //increment the next multiple of the current prime (rotate the wheel).
+                    j += k * gaps[wheel_index];
+                    if (++wheel_index == wheel2310::residue_count)
+                        wheel_index = 0;
+                }
+                //save the starting multiple and wheel index for the next segment
+                m_multiples_2310[i] = j - m_segment_size_2310;
+                m_wheel_indices[i] = wheel_index;
+            }
+            m_sieve_position += m_segment_size_2310;
+        }
+
+        std::uint32_t Sieve_2310::get_segment_size()
+        {
+            return m_segment_size_2310;
+        }
+
+        void Sieve_2310::reset_sieve()
+        {
+            //fill the sieve with default values (all ones)
+            std::fill(m_sieve_2310.begin(), m_sieve_2310.end(), ~uint64_t{ 0 });
+            m_long_chain_starts = {};
+        }
+
+        //search the sieve for chains that meet the minimum length requirement.  Chains can cross segment boundaries.
+        //batch sieve mode is not supported by this layout and is ignored.
+        void Sieve_2310::find_chains(uint64_t low, bool /*batch_sieve_mode*/)
+        {
+            constexpr auto& offsets = wheel2310::tables.offsets;
+            const std::size_t word_count = m_sieve_2310.size();
+            for (std::size_t w = 0; w < word_count; w++)
+            {
+                uint64_t word = m_sieve_2310[w];
+                //a 64 bit word spans about 300 integers and a chain of minimum length spans at most 12 * (length - 1).
+                //if this word and the next don't hold enough candidates no new chain can start in this word.
+                //the last word of the segment is always scanned. a chain starting there can continue in the next segment.
+                if (!m_chain_in_process && w + 1 < word_count)
+                {
+                    std::size_t hits = std::bitset<64>(word).count() + std::bitset<64>(m_sieve_2310[w + 1]).count();
+                    if (hits < static_cast<std::size_t>(m_min_chain_length))
+                        continue;
+                }
+                for (; word > 0; word &= word - 1)
+                {
+                    uint32_t bit = static_cast<uint32_t>(w * 64 + boost::multiprecision::lsb(word));
+                    uint64_t prime_candidate_offset = low + static_cast<uint64_t>(bit / wheel2310::residue_count) * wheel2310::primorial
+                        + offsets[bit % wheel2310::residue_count];
+                    if (m_chain_in_process)
+                    {
+                        if (prime_candidate_offset - m_last_candidate_offset > maxGap)
+                        {
+                            //max gap exceeded.  close open chain and start a new one.
+                            close_chain();
+                            open_chain(prime_candidate_offset);
+                        }
+                        else
+                        {
+                            //continue chain
+                            m_current_chain.push_back(prime_candidate_offset - m_current_chain.m_base_offset);
+                        }
+                    }
+                    else
+                    {
+                        //start a new chain
+                        open_chain(prime_candidate_offset);
+                    }
+                    m_last_candidate_offset = prime_candidate_offset;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef SIEVE_2310_HPP
+#define SIEVE_2310_HPP
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include "chain_sieve.hpp"
+
+namespace nexusminer {
+	namespace cpu
+	{
+		//compressed sieve wheel for primorial 2*3*5*7*11 = 2310.
+		//480 of every 2310 integers are coprime to the wheel so each bit of the sieve represents 4.8 integers vs 3.75 for the mod 30 wheel.
+		namespace wheel2310
+		{
+			static constexpr int primorial = 2310;
+			static constexpr int residue_count = 480;
+
+			struct Tables
+			{
+				std::array<uint16_t, residue_count> offsets{};  //the residues mod 2310 that are coprime to 2310
+				std::array<uint8_t, residue_count> gaps{};  //distance from each residue to the next one (wrapping)
+				std::array<int16_t, primorial> index{};  //reverse lookup table (offset mod 2310 to index). -1 if not coprime.
+			};
+
+			constexpr bool is_coprime(int n)
+			{
+				return n % 2 != 0 && n % 3 != 0 && n % 5 != 0 && n % 7 != 0 && n % 11 != 0;
+			}
+
+			constexpr Tables make_tables()
+			{
+				Tables t{};
+				int count = 0;
+				for (int n = 0; n < primorial; n++)
+				{
+					t.index[n] = -1;
+					if (is_coprime(n))
+					{
+						t.index[n] = static_cast<int16_t>(count);
+						t.offsets[count] = static_cast<uint16_t>(n);
+						count++;
+					}
+				}
+				for (int i = 0; i < residue_count; i++)
+				{
+					int next = (i + 1 < residue_count) ? t.offsets[i + 1] : t.offsets[0] + primorial;
+					t.gaps[i] = static_cast<uint8_t>(next - t.offsets[i]);
+				}
+				return t;
+			}
+
+			static constexpr Tables tables = make_tables();
+			static_assert(tables.offsets[0] == 1 && tables.offsets[residue_count - 1] == primorial - 1, "unexpected 2310 wheel residues");
+			static_assert(tables.gaps[residue_count - 1] == 2, "unexpected 2310 wheel gap");
+		}
+
+		//the mod 30 sieve with multiples of 7 and 11 removed from the layout.
+		//the sieve is a flat bit array.  bit b represents the integer 2310 * (b / 480) + offsets[b % 480] relative to the sieve start.
+		class Sieve_2310 : public Sieve
+		{
+		public:
+			Sieve_2310();
+			void generate_sieving_primes() override;
+			void set_sieve_start(boost::multiprecision::uint1024_t) override;
+			void sieve_segment() override;
+			std::uint32_t get_segment_size() override;
+			void reset_sieve() override;
+			void find_chains(uint64_t low, bool batch_sieve_mode) override;
+
+		protected:
+			void update_starting_multiples(boost::multiprecision::uint1024_t start, std::size_t count) override;
+
+		private:
+			//we start sieving at 13.  7 and 11 are part of the wheel
+			static constexpr int sieving_start_prime_2310 = 13;
+			//keep the memory footprint of the mod 30 sieve.  round down to a whole number of 64 bit words (8 wheel turns = 60 words)
+			static constexpr uint32_t wheels_per_segment = (sieve_size / 60) / 8 * 8;
+			static constexpr uint32_t sieve_words = wheels_per_segment * wheel2310::residue_count / 64;
+			static constexpr uint32_t m_segment_size_2310 = wheels_per_segment * wheel2310::primorial;
+
+			std::vector<uint64_t> m_sieve_2310;
+			//offsets to the next multiple can exceed 32 bits for large sieving primes on this wheel
+			std::vector<uint64_t> m_multiples_2310;
+			uint64_t m_last_candidate_offset = 0;
+		};
+	}
+}
+
+#endif
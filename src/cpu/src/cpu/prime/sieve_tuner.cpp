@@ -0,0 +1,149 @@
+#include "sieve_tuner.hpp"
+#include "chain_sieve.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace nexusminer {
+    namespace cpu
+    {
+        Sieve_tuner::Sieve_tuner(std::string log_leader, Operating_point initial_point)
+            : m_logger{ spdlog::get("logger") }
+            , m_log_leader{ std::move(log_leader) }
+            , m_best{ initial_point }
+            , m_last_round{ std::chrono::steady_clock::now() }
+        {
+        }
+
+        void Sieve_tuner::set_target_chain_length(int target_chain_length)
+        {
+            target_chain_length = std::max(target_chain_length, min_chain_length_floor);
+            if (target_chain_length == m_target_chain_length)
+                return;
+            //scores depend on the target.  abandon any round in process and start over.
+            m_target_chain_length = target_chain_length;
+            m_phase = Phase::idle;
+            m_round_pending = true;
+        }
+
+        void Sieve_tuner::begin_segment(Sieve const& sieve)
+        {
+            if (m_phase == Phase::idle && (m_round_pending || std::chrono::steady_clock::now() - m_last_round >= retune_interval))
+            {
+                start_round();
+            }
+            m_fermat_tests_start = sieve.m_fermat_test_count;
+            m_fermat_primes_start = sieve.m_fermat_prime_count;
+            m_candidate_length_histogram_start = sieve.m_candidate_length_histogram;
+        }
+
+        void Sieve_tuner::end_segment(Sieve const& sieve, double elapsed_ms, uint64_t range_searched)
+        {
+            if (m_phase == Phase::idle)
+                return;
+
+            auto& trial = m_trials[m_trial_index];
+            trial.m_segments++;
+            trial.m_elapsed_ms += elapsed_ms;
+            trial.m_range_searched += range_searched;
+            trial.m_fermat_tests += sieve.m_fermat_test_count - m_fermat_tests_start;
+            trial.m_fermat_primes += sieve.m_fermat_prime_count - m_fermat_primes_start;
+            trial.m_candidate_length_histogram.resize(sieve.m_candidate_length_histogram.size(), 0);
+            for (std::size_t i = 0; i < sieve.m_candidate_length_histogram.size() && i < m_candidate_length_histogram_start.size(); i++)
+            {
+                trial.m_candidate_length_histogram[i] += sieve.m_candidate_length_histogram[i] - m_candidate_length_histogram_start[i];
+            }
+
+            if (trial.m_segments >= segments_per_trial && ++m_trial_index == m_trials.size())
+            {
+                finish_phase();
+            }
+        }
+
+        Sieve_tuner::Operating_point Sieve_tuner::get_operating_point() const
+        {
+            return m_phase == Phase::idle ? m_best : m_trials[m_trial_index].m_point;
+        }
+
+        void Sieve_tuner::start_round()
+        {
+            m_round_pending = false;
+            m_last_round = std::chrono::steady_clock::now();
+            std::vector<Operating_point> points;
+            for (auto limit : sieving_prime_limits)
+            {
+                points.push_back({ std::min(limit, Sieve::get_max_sieving_prime_limit()), m_best.m_min_chain_length });
+            }
+            m_logger->debug(m_log_leader + "Sieve tuner: starting round for {}-chains", m_target_chain_length);
+            start_phase(Phase::sieving_prime_limit, points);
+        }
+
+        void Sieve_tuner::start_phase(Phase phase, std::vector<Operating_point> points)
+        {
+            m_trials = {};
+            for (auto const& point : points)
+            {
+                Trial trial;
+                trial.m_point = point;
+                m_trials.push_back(trial);
+            }
+            m_trial_index = 0;
+            m_phase = phase;
+        }
+
+        void Sieve_tuner::finish_phase()
+        {
+            std::size_t best_index = 0;
+            double best_score = -1;
+            for (std::size_t i = 0; i < m_trials.size(); i++)
+            {
+                double score = expected_chains_per_second(m_trials[i]);
+                m_logger->debug(m_log_leader + "Sieve tuner: sieving prime limit {} min chain length {}: {:.3f} million integers/s, {:.4f}% fermat pass rate, {:.4g} expected {}-chains/hour",
+                    m_trials[i].m_point.m_sieving_prime_limit, m_trials[i].m_point.m_min_chain_length,
+                    m_trials[i].m_range_searched / (1.0e3 * std::max(m_trials[i].m_elapsed_ms, 1.0)),
+                    100.0 * m_trials[i].m_fermat_primes / std::max<uint64_t>(m_trials[i].m_fermat_tests, 1),
+                    3600.0 * score, m_target_chain_length);
+                if (score > best_score)
+                {
+                    best_score = score;
+                    best_index = i;
+                }
+            }
+            auto const best_point = m_trials[best_index].m_point;
+
+            if (m_phase == Phase::sieving_prime_limit)
+            {
+                m_best.m_sieving_prime_limit = best_point.m_sieving_prime_limit;
+                std::vector<Operating_point> points;
+                for (int i = 0; i < min_chain_length_steps; i++)
+                {
+                    points.push_back({ best_point.m_sieving_prime_limit, m_target_chain_length + i });
+                }
+                start_phase(Phase::min_chain_length, points);
+                return;
+            }
+
+            m_best = best_point;
+            m_best_score = best_score;
+            m_phase = Phase::idle;
+            m_logger->info(m_log_leader + "Sieve tuner: sieving prime limit {}, min chain length {}. {:.4g} expected {}-chains/hour",
+                m_best.m_sieving_prime_limit, m_best.m_min_chain_length, 3600.0 * m_best_score, m_target_chain_length);
+        }
+
+        //a chain candidate with n sieve survivors contains about n - L + 1 windows of L consecutive candidates.
+        //each window is a fermat chain of length L with probability p^L where p is the measured fermat pass rate.
+        double Sieve_tuner::expected_chains_per_second(Trial const& trial) const
+        {
+            if (trial.m_fermat_tests == 0 || trial.m_elapsed_ms <= 0)
+                return 0;
+
+            double pass_rate = static_cast<double>(trial.m_fermat_primes) / trial.m_fermat_tests;
+            double chain_probability = std::pow(pass_rate, m_target_chain_length);
+            double expected_chains = 0;
+            for (std::size_t n = m_target_chain_length; n < trial.m_candidate_length_histogram.size(); n++)
+            {
+                expected_chains += trial.m_candidate_length_histogram[n] * (n - m_target_chain_length + 1) * chain_probability;
+            }
+            return expected_chains / (trial.m_elapsed_ms / 1000.0);
+        }
+    }
+}
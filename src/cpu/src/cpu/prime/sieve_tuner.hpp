@@ -0,0 +1,89 @@
+#ifndef SIEVE_TUNER_HPP
+#define SIEVE_TUNER_HPP
+
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <spdlog/spdlog.h>
+
+namespace nexusminer {
+	namespace cpu
+	{
+		class Sieve;
+
+		//picks the sieving prime limit and minimum chain length that maximize the expected rate of long fermat chains.
+		//each trial operating point is mined for a few segments.  the sieving prime limit is searched first, then the minimum chain length.
+		//a round runs on the first segments mined and again after the retune interval or when the target chain length changes.
+		class Sieve_tuner
+		{
+		public:
+			struct Operating_point
+			{
+				uint32_t m_sieving_prime_limit = 0;
+				int m_min_chain_length = 0;
+				bool operator==(Operating_point const& other) const
+				{
+					return m_sieving_prime_limit == other.m_sieving_prime_limit && m_min_chain_length == other.m_min_chain_length;
+				}
+			};
+
+			Sieve_tuner(std::string log_leader, Operating_point initial_point);
+
+			//the chain length we are trying to find. usually the integer part of the network difficulty.
+			void set_target_chain_length(int target_chain_length);
+			//call before and after each segment is sieved, filtered and fermat tested
+			void begin_segment(Sieve const& sieve);
+			void end_segment(Sieve const& sieve, double elapsed_ms, uint64_t range_searched);
+			//the operating point to use for the next segment
+			Operating_point get_operating_point() const;
+
+		private:
+			struct Trial
+			{
+				Operating_point m_point;
+				int m_segments = 0;
+				double m_elapsed_ms = 0;
+				uint64_t m_range_searched = 0;
+				uint64_t m_fermat_tests = 0;
+				uint64_t m_fermat_primes = 0;
+				std::vector<uint64_t> m_candidate_length_histogram;
+			};
+
+			enum class Phase {
+				idle,
+				sieving_prime_limit,
+				min_chain_length
+			};
+
+			static constexpr int segments_per_trial = 2;
+			static constexpr std::chrono::minutes retune_interval{ 30 };
+			static constexpr uint32_t sieving_prime_limits[]{ 300000000, 200000000, 100000000, 50000000, 25000000 };
+			static constexpr int min_chain_length_floor = 5;
+			static constexpr int min_chain_length_steps = 3;
+
+			void start_round();
+			void start_phase(Phase phase, std::vector<Operating_point> points);
+			void finish_phase();
+			double expected_chains_per_second(Trial const& trial) const;
+
+			std::shared_ptr<spdlog::logger> m_logger;
+			std::string m_log_leader;
+			Phase m_phase = Phase::idle;
+			bool m_round_pending = true;
+			int m_target_chain_length = 8;
+			Operating_point m_best;
+			double m_best_score = 0;
+			std::vector<Trial> m_trials;
+			std::size_t m_trial_index = 0;
+			std::chrono::steady_clock::time_point m_last_round;
+
+			//sieve counters at the start of the current segment
+			uint64_t m_fermat_tests_start = 0;
+			uint64_t m_fermat_primes_start = 0;
+			std::vector<uint64_t> m_candidate_length_histogram_start;
+		};
+	}
+}
+
+#endif
@@ -42,4 +42,23 @@ static T2 get_offset_to_next_multiple(T1 x, T2 n)
 
 }
 
+//same as above for the 2310 wheel. the offset is not divisible by 2, 3, 5, 7, or 11.  
+//x must be a multiple of the primorial 2310 and n must be a prime greater than 11.
+//the result can exceed n * 8 so use a 64 bit type for large n.
+template <typename T1, typename T2>
+static T2 get_offset_to_next_multiple_2310(T1 x, T2 n)
+{
+    T2 m = n - static_cast<T2>(x % n);
+    if (m % 2 == 0)
+    {
+        m += n;
+    }
+    while (m % 3 == 0 || m % 5 == 0 || m % 7 == 0 || m % 11 == 0)
+    {
+        m += 2 * n;
+    }
+    return m;
+
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "cpu/scheduler.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace nexusminer
+{
+namespace cpu
+{
+
+Scheduler::Scheduler(config::Mining_mode mining_mode)
+	: m_logger{ spdlog::get("logger") }
+	, m_mining_mode{ mining_mode }
+	, m_last_update{ std::chrono::steady_clock::now() }
+{
+}
+
+void Scheduler::add(config::Worker_config const& worker_config, std::shared_ptr<Throttle> throttle)
+{
+	if (!std::holds_alternative<config::Worker_config_cpu>(worker_config.m_worker_mode))
+	{
+		return;
+	}
+	auto const& cpu_config = std::get<config::Worker_config_cpu>(worker_config.m_worker_mode);
+	auto target_hashrate = cpu_config.m_target_hashrate;
+	if (target_hashrate > 0 && m_mining_mode == config::Mining_mode::PRIME)
+	{
+		m_logger->warn("[Scheduler] Worker {}: target_hashrate only applies to HASH mining, ignored", worker_config.m_id);
+		target_hashrate = 0;
+	}
+	if (target_hashrate == 0 && cpu_config.m_power_limit_percent >= 100)
+	{
+		// a reload may have lifted the limits of a running worker
+		throttle->set(1.0, false);
+		return;
+	}
+
+	auto const id = cpu_config.m_group.empty() ? worker_config.m_id : cpu_config.m_group;
+	auto group = std::find_if(m_groups.begin(), m_groups.end(), [&id](auto const& group) { return group.m_id == id; });
+	if (group == m_groups.end())
+	{
+		group = m_groups.insert(m_groups.end(), Group{});
+		group->m_id = id;
+		group->m_target_hashrate = target_hashrate;
+	}
+	group->m_throttles.push_back(std::move(throttle));
+	group->m_max_budget = std::max(min_duty, group->m_throttles.size() * cpu_config.m_power_limit_percent / 100.0);
+	group->m_budget = group->m_max_budget;
+	apply(*group);
+}
+
+void Scheduler::update()
+{
+	auto const now = std::chrono::steady_clock::now();
+	auto const elapsed = std::chrono::duration<double>(now - m_last_update).count();
+	m_last_update = now;
+
+	for (auto& group : m_groups)
+	{
+		std::uint64_t units = 0;
+		for (auto& throttle : group.m_throttles)
+		{
+			units += throttle->take_units();
+		}
+		// a budget alone is static, no units means the workers wait for work
+		if (group.m_target_hashrate == 0 || units == 0 || elapsed <= 0.0)
+		{
+			continue;
+		}
+
+		// the rate scales with the budget, the square root of the correction damps noise and overshoot
+		auto const rate = units / elapsed;
+		auto const correction = std::sqrt(static_cast<double>(group.m_target_hashrate) / rate);
+		group.m_budget = std::clamp(group.m_budget * correction, min_duty, group.m_max_budget);
+		m_logger->debug("[Scheduler] Worker {}: {:.0f} H/s, target {} H/s, budget {:.2f} threads", group.m_id, rate,
+			group.m_target_hashrate, group.m_budget);
+		if (apply(group))
+		{
+			m_logger->info("[Scheduler] Worker {}: {} of {} threads active at {:.0f}% duty cycle", group.m_id, group.m_active,
+				group.m_throttles.size(), 100.0 * group.m_throttles.front()->get_duty());
+		}
+	}
+}
+
+bool Scheduler::apply(Group& group)
+{
+	auto const active = std::clamp<std::size_t>(static_cast<std::size_t>(std::ceil(group.m_budget - 1e-6)), 1, group.m_throttles.size());
+	auto const duty = std::min(1.0, group.m_budget / active);
+	for (std::size_t i = 0; i < group.m_throttles.size(); ++i)
+	{
+		group.m_throttles[i]->set(duty, i >= active);
+	}
+	auto const changed = active != group.m_active;
+	group.m_active = active;
+	return changed;
+}
+
+void Scheduler::log_setup() const
+{
+	for (auto const& group : m_groups)
+	{
+		auto const& throttle = *group.m_throttles.front();
+		m_logger->info("[Scheduler] Worker {}: {} thread(s), {:.0f}% cpu budget{}, {} active at {:.0f}% duty cycle", group.m_id,
+			group.m_throttles.size(), 100.0 * group.m_max_budget / group.m_throttles.size(),
+			group.m_target_hashrate > 0 ? fmt::format(", target {} H/s", group.m_target_hashrate) : std::string{},
+			group.m_active, 100.0 * throttle.get_duty());
+	}
+}
+
+}
+}
@@ -0,0 +1,92 @@
+#include "cpu/throttle.hpp"
+#include <algorithm>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace nexusminer
+{
+namespace cpu
+{
+
+void Throttle::begin()
+{
+	m_batch_start = std::chrono::steady_clock::now();
+	m_pause_debt = std::chrono::steady_clock::duration::zero();
+}
+
+void Throttle::pace(std::uint64_t units, std::atomic<bool> const& stop)
+{
+	m_units.fetch_add(units, std::memory_order_relaxed);
+	if (m_parked.load(std::memory_order_relaxed))
+	{
+		while (m_parked.load(std::memory_order_relaxed) && !stop)
+		{
+			std::this_thread::sleep_for(sleep_slice);
+		}
+		begin();
+		return;
+	}
+
+	auto const duty = m_duty.load(std::memory_order_relaxed);
+	if (duty >= 1.0)
+	{
+		m_batch_start = std::chrono::steady_clock::now();
+		return;
+	}
+
+	auto const pause_start = std::chrono::steady_clock::now();
+	auto const busy = pause_start - m_batch_start;
+	auto const pause = std::chrono::duration_cast<std::chrono::steady_clock::duration>(busy * ((1.0 - duty) / duty)) + m_pause_debt;
+	if (pause > std::chrono::steady_clock::duration::zero())
+	{
+		sleep(pause, stop);
+	}
+	m_batch_start = std::chrono::steady_clock::now();
+	// carry the sleep error to the next pause, bounded so a long stall doesn't turn into a long catch up
+	m_pause_debt = std::clamp<std::chrono::steady_clock::duration>(pause - (m_batch_start - pause_start),
+		-std::chrono::steady_clock::duration{ sleep_slice }, std::chrono::steady_clock::duration{ sleep_slice });
+}
+
+void Throttle::set(double duty, bool parked)
+{
+	m_duty.store(std::clamp(duty, 0.01, 1.0), std::memory_order_relaxed);
+	m_parked.store(parked, std::memory_order_relaxed);
+}
+
+void Throttle::sleep(std::chrono::steady_clock::duration duration, std::atomic<bool> const& stop)
+{
+	auto const end = std::chrono::steady_clock::now() + duration;
+	for (auto now = std::chrono::steady_clock::now(); now < end && !stop; now = std::chrono::steady_clock::now())
+	{
+		std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(end - now, sleep_slice));
+	}
+}
+
+bool set_current_thread_priority(std::uint8_t level)
+{
+	if (level == 2)
+	{
+		return true;
+	}
+#if defined(_WIN32)
+	static constexpr int priorities[] = { THREAD_PRIORITY_LOWEST, THREAD_PRIORITY_BELOW_NORMAL, THREAD_PRIORITY_NORMAL,
+		THREAD_PRIORITY_ABOVE_NORMAL, THREAD_PRIORITY_HIGHEST };
+	return level < 5 && SetThreadPriority(GetCurrentThread(), priorities[level]) != 0;
+#elif defined(__linux__)
+	// linux applies the nice value of PRIO_PROCESS with a thread id to that thread only
+	static constexpr int nice_values[] = { 19, 10, 0, -5, -10 };
+	return level < 5 && setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice_values[level]) == 0;
+#else
+	return false;
+#endif
+}
+
+}
+}
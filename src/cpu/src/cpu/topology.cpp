@@ -0,0 +1,319 @@
+#include "cpu/topology.hpp"
+#include "config/worker_config.hpp"
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace nexusminer
+{
+namespace cpu
+{
+namespace
+{
+bool read_line(std::string const& file_name, std::string& line)
+{
+	std::ifstream file(file_name);
+	return file.is_open() && std::getline(file, line) && !line.empty();
+}
+
+bool read_number(std::string const& file_name, unsigned& value)
+{
+	std::string line;
+	if (!read_line(file_name, line))
+	{
+		return false;
+	}
+	try {
+		value = static_cast<unsigned>(std::stoul(line));
+		return true;
+	}
+	catch (std::exception const&) {
+		return false;
+	}
+}
+
+// lowest cpu of a sysfs cpu list file, -1 if it can't be read
+int first_cpu(std::string const& file_name)
+{
+	std::string line;
+	if (!read_line(file_name, line))
+	{
+		return -1;
+	}
+	auto const cpus = parse_cpu_list(line);
+	return cpus.empty() ? -1 : static_cast<int>(*std::min_element(cpus.begin(), cpus.end()));
+}
+}
+
+std::vector<unsigned> parse_cpu_list(std::string const& list)
+{
+	std::vector<unsigned> cpus;
+	std::stringstream ss(list);
+	std::string range;
+	while (std::getline(ss, range, ','))
+	{
+		try {
+			auto const dash = range.find('-');
+			auto const first = static_cast<unsigned>(std::stoul(range.substr(0, dash)));
+			auto const last = dash == std::string::npos ? first : static_cast<unsigned>(std::stoul(range.substr(dash + 1)));
+			for (auto cpu = first; cpu <= last; ++cpu)
+			{
+				cpus.push_back(cpu);
+			}
+		}
+		catch (std::exception const&) {
+			// empty or malformed entry (e.g. the trailing newline)
+		}
+	}
+	return cpus;
+}
+
+Topology Topology::detect(std::string const& sysfs_cpu_root)
+{
+	Topology topology;
+	std::string online;
+	auto const online_cpus = read_line(sysfs_cpu_root + "/online", online) ? parse_cpu_list(online) : std::vector<unsigned>{};
+
+	// hybrid intel cpus list their efficiency cores under the cpu_atom pmu, arm reports a lower capacity
+	std::set<unsigned> efficiency_cpus;
+	std::string atom;
+	if (read_line(sysfs_cpu_root + "/../../cpu_atom/cpus", atom))
+	{
+		auto const atom_cpus = parse_cpu_list(atom);
+		efficiency_cpus.insert(atom_cpus.begin(), atom_cpus.end());
+	}
+
+	std::map<unsigned, unsigned> capacity;
+	for (auto const id : online_cpus)
+	{
+		auto const cpu_root = sysfs_cpu_root + "/cpu" + std::to_string(id);
+		Logical_cpu cpu;
+		cpu.m_id = id;
+		read_number(cpu_root + "/topology/physical_package_id", cpu.m_package);
+
+		std::string siblings_line;
+		auto const siblings = read_line(cpu_root + "/topology/thread_siblings_list", siblings_line) ?
+			parse_cpu_list(siblings_line) : std::vector<unsigned>{ id };
+		cpu.m_core = siblings.empty() ? id : *std::min_element(siblings.begin(), siblings.end());
+		cpu.m_smt_index = static_cast<unsigned>(std::count_if(siblings.begin(), siblings.end(), [id](auto sibling) { return sibling < id; }));
+
+		for (unsigned index = 0;; ++index)
+		{
+			auto const cache_root = cpu_root + "/cache/index" + std::to_string(index);
+			unsigned level = 0;
+			if (!read_number(cache_root + "/level", level))
+			{
+				break;
+			}
+			std::string type;
+			read_line(cache_root + "/type", type);
+			if (type == "Instruction")
+			{
+				continue;
+			}
+			if (level == 2)
+			{
+				cpu.m_l2 = first_cpu(cache_root + "/shared_cpu_list");
+			}
+			else if (level == 3)
+			{
+				cpu.m_l3 = first_cpu(cache_root + "/shared_cpu_list");
+			}
+		}
+
+		unsigned cpu_capacity = 0;
+		if (read_number(cpu_root + "/cpu_capacity", cpu_capacity))
+		{
+			capacity[id] = cpu_capacity;
+		}
+		cpu.m_efficiency = efficiency_cpus.count(id) != 0;
+		topology.m_cpus.push_back(cpu);
+	}
+
+	if (efficiency_cpus.empty() && !capacity.empty())
+	{
+		auto const max_capacity = std::max_element(capacity.begin(), capacity.end(),
+			[](auto const& a, auto const& b) { return a.second < b.second; })->second;
+		for (auto& cpu : topology.m_cpus)
+		{
+			auto const it = capacity.find(cpu.m_id);
+			cpu.m_efficiency = it != capacity.end() && it->second < max_capacity;
+		}
+	}
+
+	topology.m_from_sysfs = !topology.m_cpus.empty();
+	if (!topology.m_from_sysfs)
+	{
+		auto const hardware_threads = std::max(1U, std::thread::hardware_concurrency());
+		for (unsigned id = 0; id < hardware_threads; ++id)
+		{
+			Logical_cpu cpu;
+			cpu.m_id = id;
+			cpu.m_core = id;
+			topology.m_cpus.push_back(cpu);
+		}
+	}
+	return topology;
+}
+
+std::size_t Topology::core_count() const
+{
+	return static_cast<std::size_t>(std::count_if(m_cpus.begin(), m_cpus.end(), [](auto const& cpu) { return cpu.m_smt_index == 0; }));
+}
+
+std::size_t Topology::efficiency_core_count() const
+{
+	return static_cast<std::size_t>(std::count_if(m_cpus.begin(), m_cpus.end(),
+		[](auto const& cpu) { return cpu.m_smt_index == 0 && cpu.m_efficiency; }));
+}
+
+std::size_t Topology::l3_count() const
+{
+	std::set<std::pair<unsigned, int>> l3;
+	for (auto const& cpu : m_cpus)
+	{
+		l3.emplace(cpu.m_package, cpu.m_l3);
+	}
+	return l3.size();
+}
+
+std::size_t Topology::package_count() const
+{
+	std::set<unsigned> packages;
+	for (auto const& cpu : m_cpus)
+	{
+		packages.insert(cpu.m_package);
+	}
+	return packages.size();
+}
+
+std::string Topology::describe() const
+{
+	std::stringstream ss;
+	ss << package_count() << (package_count() == 1 ? " package, " : " packages, ") << l3_count() << " L3, " << core_count() << " cores";
+	if (efficiency_core_count() > 0)
+	{
+		ss << " (" << efficiency_core_count() << " efficiency)";
+	}
+	ss << ", " << m_cpus.size() << " threads";
+	if (!m_from_sysfs)
+	{
+		ss << " (no topology information)";
+	}
+	return ss.str();
+}
+
+std::vector<Logical_cpu> Topology::select(Selection const& selection) const
+{
+	// cpus per L3 group in the order they should be taken
+	std::map<std::pair<unsigned, int>, std::vector<Logical_cpu>> groups;
+	for (auto const& cpu : m_cpus)
+	{
+		if ((cpu.m_smt_index > 0 && !selection.m_smt) || (cpu.m_efficiency && !selection.m_efficiency_cores) ||
+			std::find(selection.m_excluded.begin(), selection.m_excluded.end(), cpu.m_id) != selection.m_excluded.end())
+		{
+			continue;
+		}
+		groups[{ cpu.m_package, cpu.m_l3 }].push_back(cpu);
+	}
+	for (auto& [key, cpus] : groups)
+	{
+		std::stable_sort(cpus.begin(), cpus.end(), [](auto const& a, auto const& b)
+		{
+			return std::make_tuple(a.m_efficiency, a.m_smt_index, a.m_l2, a.m_core) <
+				std::make_tuple(b.m_efficiency, b.m_smt_index, b.m_l2, b.m_core);
+		});
+	}
+
+	// round robin over the groups for the share of every group, then group by group
+	std::map<std::pair<unsigned, int>, std::size_t> taken;
+	std::size_t total = 0;
+	for (auto const& [key, cpus] : groups)
+	{
+		total += cpus.size();
+	}
+	auto const limit = selection.m_max_threads == 0 ? total : std::min(total, selection.m_max_threads);
+	for (std::size_t selected = 0; selected < limit;)
+	{
+		for (auto const& [key, cpus] : groups)
+		{
+			if (selected < limit && taken[key] < cpus.size())
+			{
+				taken[key]++;
+				selected++;
+			}
+		}
+	}
+
+	std::vector<Logical_cpu> result;
+	for (auto const& [key, cpus] : groups)
+	{
+		result.insert(result.end(), cpus.begin(), cpus.begin() + static_cast<std::ptrdiff_t>(taken[key]));
+	}
+	return result;
+}
+
+bool pin_current_thread(unsigned cpu)
+{
+#if defined(_WIN32)
+	if (cpu >= 64)
+	{
+		return false;
+	}
+	return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{ 1 } << cpu) != 0;
+#elif defined(__linux__)
+	if (cpu >= CPU_SETSIZE)
+	{
+		return false;
+	}
+	cpu_set_t cpu_set;
+	CPU_ZERO(&cpu_set);
+	CPU_SET(cpu, &cpu_set);
+	return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+	(void)cpu;
+	return false;
+#endif
+}
+
+bool pin_current_thread(config::Worker_config_cpu const& config)
+{
+	if (config.m_cpu >= 0)
+	{
+		return pin_current_thread(static_cast<unsigned>(config.m_cpu));
+	}
+	if (config.m_affinity_mask == 0)
+	{
+		return true;
+	}
+#if defined(_WIN32)
+	return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(config.m_affinity_mask)) != 0;
+#elif defined(__linux__)
+	cpu_set_t cpu_set;
+	CPU_ZERO(&cpu_set);
+	for (unsigned cpu = 0; cpu < 64; ++cpu)
+	{
+		if (config.m_affinity_mask & (std::uint64_t{ 1 } << cpu))
+		{
+			CPU_SET(cpu, &cpu_set);
+		}
+	}
+	return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+	return false;
+#endif
+}
+
+}
+}
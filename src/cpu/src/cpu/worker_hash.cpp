@@ -1,6 +1,9 @@
 #include "cpu/worker_hash.hpp"
+#include "cpu/topology.hpp"
+#include "cpu/throttle.hpp"
 #include "config/config.hpp"
 #include "stats/stats_collector.hpp"
+#include "stats/event_trace.hpp"
 #include "block.hpp"
 #include "hash/nexus_hash_utils.hpp"
 #include <asio.hpp>
@@ -23,21 +26,18 @@ Worker_hash::Worker_hash(std::shared_ptr<asio::io_context> io_context, Worker_co
 , m_best_leading_zeros{0}
 , m_met_difficulty_count {0}
 , m_pool_nbits{0}
+, m_throttle{std::make_shared<Throttle>()}
 {
 	m_logger->info(m_log_leader + "Initialized (Internal ID: {})", m_config.m_internal_id);
 	
-	// Log CPU-specific configuration for multi-core support
+	// pinning happens in run(), the mining thread is recreated for every block
 	if (std::holds_alternative<config::Worker_config_cpu>(m_config.m_worker_mode)) {
 		auto const& cpu_cfg = std::get<config::Worker_config_cpu>(m_config.m_worker_mode);
-		if (cpu_cfg.m_threads > 1) {
-			m_logger->info(m_log_leader + "Multi-core configuration: {} thread(s)", cpu_cfg.m_threads);
-			m_logger->warn(m_log_leader + "Note: Multi-threading within a worker is planned for future implementation");
-			m_logger->info(m_log_leader + "Current implementation: Single thread per worker instance");
-			m_logger->info(m_log_leader + "For multi-core mining: Configure multiple CPU workers in miner.conf");
+		if (cpu_cfg.m_cpu >= 0) {
+			m_logger->info(m_log_leader + "Pinned to cpu {}", cpu_cfg.m_cpu);
 		}
-		if (cpu_cfg.m_affinity_mask > 0) {
+		else if (cpu_cfg.m_affinity_mask > 0) {
 			m_logger->info(m_log_leader + "CPU affinity mask: 0x{:016x}", cpu_cfg.m_affinity_mask);
-			m_logger->warn(m_log_leader + "Note: CPU affinity is planned for future implementation");
 		}
 	}
 }
@@ -53,9 +53,11 @@ Worker_hash::~Worker_hash()
 void Worker_hash::set_block(LLP::CBlock block, std::uint32_t nbits, Worker::Block_found_handler result)
 {
 	//stop the existing mining loop if it is running
+	auto const stop_start_ticks = stats::Tick_clock::now();
 	m_stop = true;
 	if (m_run_thread.joinable())
 		m_run_thread.join();
+	stats::Event_trace::instance().complete("stop_mining", "worker", stop_start_ticks, stats::Tick_clock::now());
 	{
 		std::scoped_lock<std::mutex> lck(m_mtx);
 		m_found_nonce_callback = result;
@@ -105,7 +107,7 @@ void Worker_hash::set_block(LLP::CBlock block, std::uint32_t nbits, Worker::Bloc
 		// Log midstate calculation for debugging
 		log_midstate_calculation();
 		
-		// Reset statistics for new block
+		// Reset the per block statistics, the hash count keeps counting
 		reset_statistics();
 	}
 	//restart the mining loop
@@ -118,11 +120,27 @@ void Worker_hash::set_block(LLP::CBlock block, std::uint32_t nbits, Worker::Bloc
 void Worker_hash::run()
 {
 	m_logger->info(m_log_leader + "Hashing thread started");
-	uint64_t last_log_hash_count = 0;
+	if (std::holds_alternative<config::Worker_config_cpu>(m_config.m_worker_mode))
+	{
+		auto const& cpu_cfg = std::get<config::Worker_config_cpu>(m_config.m_worker_mode);
+		if (!pin_current_thread(cpu_cfg))
+		{
+			m_logger->warn(m_log_leader + "Unable to set the cpu affinity of the hashing thread");
+		}
+		if (!set_current_thread_priority(cpu_cfg.m_priority))
+		{
+			m_logger->warn(m_log_leader + "Unable to set priority {} for the hashing thread", cpu_cfg.m_priority);
+		}
+	}
+	m_throttle->begin();
+	stats::Event_trace::instance().set_thread_name("cpu hash " + m_config.m_id);
+	stats::Event_trace::instance().instant("mining_started", "worker", "worker", m_config.m_internal_id);
+	uint64_t last_log_hash_count = m_hash_count.load(std::memory_order_relaxed);
 	constexpr uint64_t log_interval = 1000000;  // Log every 1M hashes
 	constexpr int max_retries = 3;
 	uint64_t payload_validation_failures = 0;
 	uint64_t hash_mismatches = 0;
+	std::uint64_t throttle_batch = 0;
 	
 	while (!m_stop)
 	{
@@ -188,6 +206,7 @@ void Worker_hash::run()
 				// Check the result for leading zeros
 				if ((keccakHash & leading_zero_mask()) == 0)
 				{
+					auto const found = std::chrono::steady_clock::now();
 					m_logger->info(m_log_leader + "Found a nonce candidate {}", nonce);
 					m_skein.setNonce(nonce);
 					// Verify the difficulty
@@ -196,6 +215,8 @@ void Worker_hash::run()
 						++m_met_difficulty_count;
 						// Update the block with the nonce and call the callback function
 						m_block.nNonce = nonce;
+						m_block.m_found = found;
+						m_block.m_checked = std::chrono::steady_clock::now();
 						{
 							if (m_found_nonce_callback)
 							{
@@ -212,20 +233,22 @@ void Worker_hash::run()
 					}
 				}
 				m_skein.setNonce(++nonce);	
-				++m_hash_count;
+				// single writer, a plain store keeps the hashing loop free of locked instructions
+				auto const hash_count = m_hash_count.load(std::memory_order_relaxed) + 1;
+				m_hash_count.store(hash_count, std::memory_order_relaxed);
 				hash_calculated = true;
 				
 				// Log progress periodically with enhanced diagnostics
-				if (m_hash_count - last_log_hash_count >= log_interval)
+				if (hash_count - last_log_hash_count >= log_interval)
 				{
 					m_logger->debug(m_log_leader + "Hashing progress: {} hashes computed, current nonce: 0x{:016x}", 
-						m_hash_count, nonce);
+						hash_count, nonce);
 					if (payload_validation_failures > 0 || hash_mismatches > 0)
 					{
 						m_logger->info(m_log_leader + "Diagnostics: {} payload validation failures, {} hash mismatches", 
 							payload_validation_failures, hash_mismatches);
 					}
-					last_log_hash_count = m_hash_count;
+					last_log_hash_count = hash_count;
 				}
 			}
 			catch (const std::exception& e)
@@ -248,16 +271,21 @@ void Worker_hash::run()
 				}
 			}
 		}
+
+		// duty cycle pause of the cpu scheduler, outside m_mtx so set_block isn't held up
+		if (++throttle_batch == Throttle::batch_hashes)
+		{
+			m_throttle->pace(throttle_batch, m_stop);
+			throttle_batch = 0;
+		}
 	}
 	m_logger->info(m_log_leader + "Hashing thread stopped. Total hashes: {}, Payload failures: {}, Hash mismatches: {}", 
-		m_hash_count, payload_validation_failures, hash_mismatches);
+		m_hash_count.load(), payload_validation_failures, hash_mismatches);
 }
 
 void Worker_hash::update_statistics(stats::Collector& stats_collector)
 {
-	std::scoped_lock<std::mutex> lck(m_mtx);
-
-	auto hash_stats = std::get<stats::Hash>(stats_collector.get_worker_stats(m_config.m_internal_id));
+	stats::Hash hash_stats;
 	hash_stats.m_hash_count = m_hash_count;
 	hash_stats.m_best_leading_zeros = m_best_leading_zeros;
 	hash_stats.m_met_difficulty_count = m_met_difficulty_count;
@@ -315,7 +343,7 @@ bool Worker_hash::difficulty_check()
 	if (hashActualLeadingZeros > m_best_leading_zeros)
 	{
 		m_best_leading_zeros = hashActualLeadingZeros;
-		m_logger->info(m_log_leader + "New best leading zeros: {}", m_best_leading_zeros);
+		m_logger->info(m_log_leader + "New best leading zeros: {}", hashActualLeadingZeros);
 	}
 	
 	//check the hash result is less than the difficulty.  We truncate to just use the upper 64 bits for easier calculation.
@@ -344,7 +372,6 @@ uint64_t Worker_hash::leading_zero_mask()
 
 void Worker_hash::reset_statistics()
 {
-	m_hash_count = 0;
 	m_best_leading_zeros = 0;
 	m_met_difficulty_count = 0;
 }
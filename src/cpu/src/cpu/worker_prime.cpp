@@ -1,24 +1,41 @@
 #include "cpu/worker_prime.hpp"
+#include "cpu/topology.hpp"
 #include "config/config.hpp"
 #include "stats/stats_collector.hpp"
+#include "stats/event_trace.hpp"
 #include "prime/prime.hpp"
 #include "prime/chain_sieve.hpp"
+#include "prime/sieve_2310.hpp"
+#include "prime/sieve_tuner.hpp"
 #include "block.hpp"
 #include <asio.hpp>
 #include <primesieve.hpp>
 #include <sstream> 
-#include <boost/random.hpp>
+#include <algorithm>
 
 namespace nexusminer
 {
 namespace cpu
 {
+namespace
+{
+std::unique_ptr<Sieve> create_sieve(config::Worker_config const& config)
+{
+	if (std::holds_alternative<config::Worker_config_cpu>(config.m_worker_mode) &&
+		std::get<config::Worker_config_cpu>(config.m_worker_mode).m_sieve_wheel == config::Sieve_wheel::MOD2310)
+	{
+		return std::make_unique<Sieve_2310>();
+	}
+	return std::make_unique<Sieve>();
+}
+}
+
 Worker_prime::Worker_prime(std::shared_ptr<asio::io_context> io_context, config::Worker_config& config)
 	: m_io_context{ std::move(io_context) }
 	, m_logger{ spdlog::get("logger") }
 	, m_config{ config }
 	, m_prime_helper{std::make_unique<Prime>()}
-	, m_segmented_sieve{std::make_unique<Sieve>()}
+	, m_segmented_sieve{create_sieve(config)}
 	, m_stop{ true }
 	, m_initialized{ false }
 	, m_log_leader{ "CPU Worker " + m_config.m_id + ": " }
@@ -26,33 +43,32 @@ Worker_prime::Worker_prime(std::shared_ptr<asio::io_context> io_context, config:
 	, m_chains{ 0 }
 	, m_difficulty{ 0 }
 	, m_pool_nbits{ 0 }
+	, m_throttle{ std::make_shared<Throttle>() }
 {
 	try {
 		m_logger->debug("Worker_prime constructor: Initializing worker {}", m_config.m_id);
 		
-		// Log CPU-specific configuration for multi-core support
+		// cpu placement (pinning happens in run()) and sieve settings
 		if (std::holds_alternative<config::Worker_config_cpu>(m_config.m_worker_mode)) {
 			auto const& cpu_cfg = std::get<config::Worker_config_cpu>(m_config.m_worker_mode);
-			if (cpu_cfg.m_threads > 1) {
-				m_logger->info(m_log_leader + "Multi-core configuration: {} thread(s)", cpu_cfg.m_threads);
-				m_logger->warn(m_log_leader + "Note: Multi-threading within a worker is planned for future implementation");
-				m_logger->info(m_log_leader + "Current implementation: Single thread per worker instance");
-				m_logger->info(m_log_leader + "For multi-core mining: Configure multiple CPU workers in miner.conf");
+			if (cpu_cfg.m_cpu >= 0) {
+				m_logger->info(m_log_leader + "Pinned to cpu {}", cpu_cfg.m_cpu);
 			}
-			if (cpu_cfg.m_affinity_mask > 0) {
+			else if (cpu_cfg.m_affinity_mask > 0) {
 				m_logger->info(m_log_leader + "CPU affinity mask: 0x{:016x}", cpu_cfg.m_affinity_mask);
-				m_logger->warn(m_log_leader + "Note: CPU affinity is planned for future implementation");
+			}
+			m_logger->info(m_log_leader + "Sieve wheel: mod {}", static_cast<int>(cpu_cfg.m_sieve_wheel));
+			if (cpu_cfg.m_sieve_autotune) {
+				m_sieve_tuner = std::make_unique<Sieve_tuner>(m_log_leader, Sieve_tuner::Operating_point{
+					m_segmented_sieve->get_sieving_prime_limit(), m_segmented_sieve->get_min_chain_length() });
 			}
 		}
 		
-		// Initialize segmented sieve with error handling
+		// Initialize segmented sieve with error handling. the sieving primes are shared by all workers.
+		// kernel throughput is measured once per host by cpu::Calibration
 		m_segmented_sieve->generate_sieving_primes();
 		
-		// Run performance test
-		fermat_performance_test();
-		
 		// Initialize data structures
-		m_chain_histogram = std::vector<std::uint32_t>(10, 0);
 		m_segmented_sieve->reset_stats();
 		
 		// Mark as initialized
@@ -116,6 +132,7 @@ void Worker_prime::set_block(LLP::CBlock block, std::uint32_t nbits, Worker::Blo
 		m_logger->debug("Worker_prime::set_block: Setting new block for worker {}", m_config.m_id);
 		
 		//stop the existing mining loop if it is running
+		auto const stop_start_ticks = stats::Tick_clock::now();
 		m_stop = true;
 		if (m_run_thread.joinable())
 		{
@@ -123,6 +140,7 @@ void Worker_prime::set_block(LLP::CBlock block, std::uint32_t nbits, Worker::Blo
 			                m_config.m_id);
 			m_run_thread.join();
 		}
+		stats::Event_trace::instance().complete("stop_mining", "worker", stop_start_ticks, stats::Tick_clock::now());
 
 		{
 			std::scoped_lock<std::mutex> lck(m_mtx);
@@ -163,6 +181,10 @@ void Worker_prime::set_block(LLP::CBlock block, std::uint32_t nbits, Worker::Blo
 			//m_logger->debug("starting nonce: {}", m_nonce);
 			//clear out any old chains from the last block
 			m_segmented_sieve->clear_chains();
+			if (m_sieve_tuner)
+			{
+				m_sieve_tuner->set_target_chain_length(static_cast<int>(getNetworkDifficulty()));
+			}
 		}
 		//restart the mining loop
 		m_stop = false;
@@ -180,53 +202,74 @@ void Worker_prime::set_block(LLP::CBlock block, std::uint32_t nbits, Worker::Blo
 
 void Worker_prime::run()
 {
-	m_segmented_sieve->calculate_starting_multiples();
+	auto& event_trace = stats::Event_trace::instance();
+	event_trace.set_thread_name("cpu prime " + m_config.m_id);
+	if (std::holds_alternative<config::Worker_config_cpu>(m_config.m_worker_mode))
+	{
+		auto const& cpu_cfg = std::get<config::Worker_config_cpu>(m_config.m_worker_mode);
+		if (!pin_current_thread(cpu_cfg))
+		{
+			m_logger->warn(m_log_leader + "Unable to set the cpu affinity of the sieve thread");
+		}
+		if (!set_current_thread_priority(cpu_cfg.m_priority))
+		{
+			m_logger->warn(m_log_leader + "Unable to set priority {} for the sieve thread", cpu_cfg.m_priority);
+		}
+	}
+	{
+		stats::Trace_span span{ "starting_multiples", "prime" };
+		m_segmented_sieve->calculate_starting_multiples();
+	}
+	event_trace.instant("mining_started", "worker", "worker", m_config.m_internal_id);
+	m_throttle->begin();
 	uint32_t segment_size = m_segmented_sieve->get_segment_size();
-	uint64_t find_chains_ms = 0;
-	uint64_t sieving_ms = 0;
-	uint64_t test_chains_ms = 0;
-	uint64_t elapsed_ms = 0;
-	uint64_t high = 0;
 	uint64_t low = 0;
-	uint64_t range_searched_this_cycle = 0;
-
-	auto start = std::chrono::steady_clock::now();
-	auto interval_start = std::chrono::steady_clock::now();
 	
 	// Initialize CPU tracking
 	m_cpu_tracking_start = std::chrono::steady_clock::now();
-	m_cpu_active_time = std::chrono::milliseconds{0};
-	m_cpu_total_time = std::chrono::milliseconds{0};
+	std::chrono::milliseconds cpu_active_time{0};
+	m_cpu_active_ms.store(0, std::memory_order_relaxed);
+	m_cpu_total_ms.store(0, std::memory_order_relaxed);
 	
 	while (!m_stop)
 	{
 		auto iteration_start = std::chrono::steady_clock::now();
+		auto const loop_start_ticks = stats::Tick_clock::now();
 		
+		if (m_sieve_tuner)
+		{
+			m_sieve_tuner->begin_segment(*m_segmented_sieve);
+			auto const point = m_sieve_tuner->get_operating_point();
+			m_segmented_sieve->set_sieving_prime_limit(point.m_sieving_prime_limit);
+			m_segmented_sieve->set_min_chain_length(point.m_min_chain_length);
+		}
 		m_segmented_sieve->reset_sieve();
 		m_segmented_sieve->clear_chains();
 
-		// current segment = [low, high]
-		high = low + segment_size - 1;
-		uint64_t sieve_size = (high - low) / 30 + 1;
-		m_range_searched += segment_size;
-		range_searched_this_cycle += segment_size;
-
+		// current segment = [low, low + segment_size)
 		auto sieve_start = std::chrono::steady_clock::now();
+		auto const sieve_start_ticks = stats::Tick_clock::now();
 		m_segmented_sieve->sieve_segment();
-		auto sieve_stop = std::chrono::steady_clock::now();
-		auto sieve_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(sieve_stop - sieve_start);
-		sieving_ms += sieve_elapsed.count();
-		auto find_chains_start = std::chrono::steady_clock::now();
+		auto const find_chains_start_ticks = stats::Tick_clock::now();
 		m_segmented_sieve->find_chains(low, false);
-		auto find_chains_stop = std::chrono::steady_clock::now();
-		auto find_chains_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(find_chains_stop - find_chains_start);
-		find_chains_ms += find_chains_elapsed.count();
-		auto test_chains_start = std::chrono::steady_clock::now();
+		auto const test_chains_start_ticks = stats::Tick_clock::now();
 		m_segmented_sieve->test_chains();
-		auto test_chains_stop = std::chrono::steady_clock::now();
-		auto test_chains_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(test_chains_stop - test_chains_start);
-		test_chains_ms += test_chains_elapsed.count();
+		auto const test_chains_stop_ticks = stats::Tick_clock::now();
+		m_pipeline_timer.add(stats::Prime_pipeline_timer::sieve, sieve_start_ticks, find_chains_start_ticks);
+		m_pipeline_timer.add(stats::Prime_pipeline_timer::find_chains, find_chains_start_ticks, test_chains_start_ticks);
+		m_pipeline_timer.add(stats::Prime_pipeline_timer::fermat, test_chains_start_ticks, test_chains_stop_ticks);
+		event_trace.complete("sieve", "prime", sieve_start_ticks, find_chains_start_ticks);
+		event_trace.complete("find_chains", "prime", find_chains_start_ticks, test_chains_start_ticks);
+		event_trace.complete("fermat", "prime", test_chains_start_ticks, test_chains_stop_ticks);
+		if (m_sieve_tuner)
+		{
+			std::chrono::duration<double, std::milli> const segment_elapsed = std::chrono::steady_clock::now() - sieve_start;
+			m_sieve_tuner->end_segment(*m_segmented_sieve, segment_elapsed.count(), segment_size);
+		}
 		//check difficulty of any chains that passed through the filter
+		auto const difficulty_start_ticks = stats::Tick_clock::now();
+		auto const found = m_segmented_sieve->m_long_chain_starts.empty() ? std::chrono::steady_clock::time_point{} :
+			std::chrono::steady_clock::now();
 		for (auto x : m_segmented_sieve->m_long_chain_starts)
 		{
 			m_block.nNonce = m_nonce + x;
@@ -236,6 +279,8 @@ void Worker_prime::run()
 			m_logger->info("Actual difficulty {} required {}", difficulty, getNetworkDifficulty());
 			if (difficulty_check(chain_start))
 			{
+				m_block.m_found = found;
+				m_block.m_checked = std::chrono::steady_clock::now();
 				//we found a valid chain.  submit it. 
 				{
 					if (m_found_nonce_callback)
@@ -252,49 +297,27 @@ void Worker_prime::run()
 				}
 			}
 		}
+		if (!m_segmented_sieve->m_long_chain_starts.empty())
+		{
+			event_trace.complete("difficulty_check", "prime", difficulty_start_ticks, stats::Tick_clock::now(),
+				"chains", m_segmented_sieve->m_long_chain_starts.size());
+		}
 		low += segment_size;
+		m_range_searched.store(m_range_searched.load(std::memory_order_relaxed) + segment_size, std::memory_order_relaxed);
+		publish_statistics();
+		m_pipeline_timer.add(stats::Prime_pipeline_timer::total, loop_start_ticks, stats::Tick_clock::now());
 		
 		// Track CPU active time for this iteration
 		auto iteration_end = std::chrono::steady_clock::now();
-		auto iteration_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(iteration_end - iteration_start);
-		m_cpu_active_time += iteration_elapsed;
+		cpu_active_time += std::chrono::duration_cast<std::chrono::milliseconds>(iteration_end - iteration_start);
+		m_cpu_active_ms.store(cpu_active_time.count(), std::memory_order_relaxed);
 		
 		// Update total time
-		m_cpu_total_time = std::chrono::duration_cast<std::chrono::milliseconds>(
-			iteration_end - m_cpu_tracking_start);
+		m_cpu_total_ms.store(std::chrono::duration_cast<std::chrono::milliseconds>(
+			iteration_end - m_cpu_tracking_start).count(), std::memory_order_relaxed);
 		
-		//debug
-		auto end = std::chrono::steady_clock::now();
-		auto interval_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - interval_start);
-		bool print_debug = false;
-		if (print_debug && interval_elapsed.count() > 10000)
-		{
-			std::cout << "--debug--" << std::endl;
-			auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-			elapsed_ms = elapsed.count();
-			double chains_per_mm = 1.0e6 * m_segmented_sieve->m_chain_count / m_range_searched;
-			double chains_per_sec = 1.0e3 * m_segmented_sieve->m_chain_count / elapsed_ms;
-			double fermat_positive_rate = 1.0 * m_segmented_sieve->m_fermat_prime_count / m_segmented_sieve->m_fermat_test_count;
-			double fermat_tests_per_chain = 1.0 * m_segmented_sieve->m_fermat_test_count / m_segmented_sieve->m_chain_count;
-			std::cout << std::fixed << std::setprecision(2) << m_range_searched / 1.0e9 << " billion integers searched." <<
-				" Found " << m_segmented_sieve->m_chain_count << " chain candidates. (" << chains_per_mm << " chains per million integers)" << std::endl;
-			std::cout << "Fermat Tests: " << m_segmented_sieve->m_fermat_test_count << " Fermat Primes: " << m_segmented_sieve->m_fermat_prime_count <<
-				" Fermat Positive Rate: " << std::fixed << std::setprecision(3) <<
-				100.0 * fermat_positive_rate << "% Fermat tests per million integers sieved: " <<
-				1.0e6 * m_segmented_sieve->m_fermat_test_count / m_range_searched << std::endl;
-
-			std::cout << "Search rate: " << std::fixed << std::setprecision(1) << range_searched_this_cycle / (elapsed.count() * 1.0e3) << " million integers per second." << std::endl;
-			double predicted_8chain_positivity_rate = std::pow(fermat_positive_rate, 8);
-			//std::cout << "Predicted chains tested to find one Fermat 8-chains: " << 1 / predicted_8chain_positivity_rate << std::endl;
-			//double predicted_days_between_8chains = 1.0 / (predicted_8chain_positivity_rate * chains_per_sec * 3600 * 24);
-			//std::cout << "Predicted days between 8 chains per core: " << std::fixed << std::setprecision(2) << predicted_days_between_8chains << std::endl;
-			std::cout << "Elapsed time: " << std::fixed << std::setprecision(2) << elapsed_ms / 1000.0 << "s. Sieving: " <<
-				100.0 * sieving_ms / elapsed_ms << "% Chain filtering: " << 100.0 * find_chains_ms / elapsed_ms
-				<< "% Fermat testing: " << 100.0 * test_chains_ms / elapsed_ms << "% Other: " <<
-				100.0 * (elapsed_ms - (sieving_ms + find_chains_ms + test_chains_ms)) / elapsed_ms << "%" << std::endl;
-			interval_start = std::chrono::steady_clock::now();
-			std::cout << std::endl;
-		}
+		// duty cycle pause of the cpu scheduler, after the cpu load tracking so it only counts work
+		m_throttle->pace(segment_size, m_stop);
 	}
 }
 
@@ -328,20 +351,41 @@ LLC::CBigNum Worker_prime::boost_uint1024_t_to_CBignum(uint1k p)
 	return p_CBignum;
 }
 
+void Worker_prime::publish_statistics()
+{
+	auto const& sieve = *m_segmented_sieve;
+	m_fermat_test_count.store(sieve.m_fermat_test_count, std::memory_order_relaxed);
+	m_fermat_prime_count.store(sieve.m_fermat_prime_count, std::memory_order_relaxed);
+	m_chain_count.store(sieve.m_chain_count, std::memory_order_relaxed);
+	m_best_chain.store(sieve.m_best_chain, std::memory_order_relaxed);
+	for (std::size_t i = 0; i < std::min(sieve.m_chain_histogram.size(), m_chain_histogram.size()); ++i)
+	{
+		m_chain_histogram[i].store(sieve.m_chain_histogram[i], std::memory_order_relaxed);
+	}
+}
+
 void Worker_prime::update_statistics(stats::Collector& stats_collector)
 {
-	auto prime_stats = std::get<stats::Prime>(stats_collector.get_worker_stats(m_config.m_internal_id));
-	prime_stats.m_primes = m_segmented_sieve->m_fermat_prime_count;
-	prime_stats.m_chains = m_segmented_sieve->m_chain_count;
-	prime_stats.m_difficulty = m_difficulty;
-	prime_stats.m_chain_histogram = m_segmented_sieve->m_chain_histogram;
-	prime_stats.m_range_searched = m_range_searched;
-	prime_stats.m_most_difficult_chain = m_segmented_sieve->m_best_chain;
+	stats::Prime prime_stats;
+	prime_stats.m_primes = static_cast<std::uint32_t>(m_fermat_prime_count.load(std::memory_order_relaxed));
+	prime_stats.m_chains = static_cast<std::uint32_t>(m_chain_count.load(std::memory_order_relaxed));
+	prime_stats.m_difficulty = m_difficulty.load(std::memory_order_relaxed);
+	for (std::size_t i = 0; i < m_chain_histogram.size(); ++i)
+	{
+		prime_stats.m_chain_histogram[i] = m_chain_histogram[i].load(std::memory_order_relaxed);
+	}
+	prime_stats.m_range_searched = m_range_searched.load(std::memory_order_relaxed);
+	prime_stats.m_most_difficult_chain = m_best_chain.load(std::memory_order_relaxed);
+	m_pipeline_timer.get_stages(prime_stats.m_pipeline);
+	prime_stats.m_pipeline.m_fermat_tests = m_fermat_test_count.load(std::memory_order_relaxed);
+	prime_stats.m_pipeline.m_fermat_passes = m_fermat_prime_count.load(std::memory_order_relaxed);
+	prime_stats.m_pipeline.m_chains = m_chain_count.load(std::memory_order_relaxed);
 	
 	// Calculate CPU load as ratio of active time to total time
-	if (m_cpu_total_time.count() > 0) {
-		prime_stats.m_cpu_load = static_cast<double>(m_cpu_active_time.count()) / 
-		                          static_cast<double>(m_cpu_total_time.count());
+	auto const cpu_total_ms = m_cpu_total_ms.load(std::memory_order_relaxed);
+	if (cpu_total_ms > 0) {
+		prime_stats.m_cpu_load = static_cast<double>(m_cpu_active_ms.load(std::memory_order_relaxed)) / 
+		                          static_cast<double>(cpu_total_ms);
 		// Clamp to [0.0, 1.0]
 		prime_stats.m_cpu_load = std::max(0.0, std::min(1.0, prime_stats.m_cpu_load));
 	} else {
@@ -354,41 +398,5 @@ void Worker_prime::update_statistics(stats::Collector& stats_collector)
 	m_chains = 0;
 }
 
-void Worker_prime::fermat_performance_test()
-//test the throughput of fermat primality test
-{
-	using namespace boost::multiprecision;
-	using namespace boost::random;
-
-	typedef independent_bits_engine<mt19937, 1024, boost::multiprecision::uint1024_t> generator1024_type;
-	generator1024_type gen1024;
-	gen1024.seed(time(0));
-	// Generate some random 1024-bit unsigned values:
-	std::vector<boost::multiprecision::uint1024_t> big_uints;
-	int sample_size = 2000;
-	for (unsigned i = 0; i < sample_size; ++i)
-	{
-		boost::multiprecision::uint1024_t pp = gen1024();
-		//make it odd
-		pp += 1?(pp % 2) == 0:0;
-		big_uints.push_back(pp);
-	}
-
-	int p_count = 0;
-	auto start = std::chrono::steady_clock::now();
-	for (unsigned i = 0; i < sample_size; ++i)
-	{
-		p_count += 1 ? m_segmented_sieve->primality_test(big_uints[i]) : 0;
-	}
-	auto end = std::chrono::steady_clock::now();
-	auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-	double expected_primes = sample_size * 2 / (1024 * 0.693147);
-	std::stringstream ss;
-	ss << "Found " << p_count << " primes out of " << sample_size << " tested. Expected about " << expected_primes << ". ";
-	ss << std::fixed << std::setprecision(2) << 1000.0* sample_size /elapsed.count()<< " primality tests/second. (" << 1.0*elapsed.count()/ sample_size << "ms)";
-	m_logger->info(ss.str());
-	
 }
-
 }
-}
\ No newline at end of file
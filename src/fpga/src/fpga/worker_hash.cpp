@@ -116,6 +116,7 @@ void Worker_hash::handle_read(const asio::error_code& error_code, std::size_t by
 		}
 		else
 		{
+			auto const found = std::chrono::steady_clock::now();
 			++m_nonce_candidates_recieved;
 			//m_logger->info(m_log_leader + "found a nonce candidate {}", nonce);
 			m_skein.setNonce(nonce);
@@ -125,6 +126,8 @@ void Worker_hash::handle_read(const asio::error_code& error_code, std::size_t by
 				++m_met_difficulty_count;
 				//update the block with the nonce and call the callback function;
 				m_block.nNonce = nonce;
+				m_block.m_found = found;
+				m_block.m_checked = std::chrono::steady_clock::now();
 				{
 					std::scoped_lock<std::mutex> lck(m_mtx);
 					if (m_found_nonce_callback)
@@ -165,7 +168,7 @@ void Worker_hash::update_statistics(stats::Collector& stats_collector)
 {
 	std::scoped_lock<std::mutex> lck(m_mtx);
 
-	auto hash_stats = std::get<stats::Hash>(stats_collector.get_worker_stats(m_config.m_internal_id));
+	stats::Hash hash_stats;
 	hash_stats.m_hash_count = (m_nonce_candidates_recieved - m_hash_error_count) * nonce_difficulty_filter;
 	hash_stats.m_best_leading_zeros = m_best_leading_zeros;
 	hash_stats.m_met_difficulty_count = m_met_difficulty_count;
@@ -216,12 +219,11 @@ bool Worker_hash::difficulty_check()
 	}
 }
 
+//the nonce candidates and hash errors are lifetime counts, the hash count is derived from them
 void Worker_hash::reset_statistics()
 {
-	m_nonce_candidates_recieved = 0;
 	m_best_leading_zeros = 0;
 	m_met_difficulty_count = 0;
-	m_hash_error_count = 0;
 }
 
 }
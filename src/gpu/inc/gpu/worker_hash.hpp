@@ -47,6 +47,7 @@ private:
     std::uint32_t m_pool_nbits;
     uint1024_t m_target;
     std::uint64_t m_hashes = 0;
+    std::uint64_t m_hash_count = 0;     // published total
     std::uint32_t m_intensity;
     std::uint32_t m_throughput;
     std::uint32_t m_threads_per_block;
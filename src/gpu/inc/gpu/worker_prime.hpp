@@ -11,6 +11,7 @@
 #include <boost/multiprecision/cpp_int.hpp>
 #include <spdlog/spdlog.h>
 #include "LLC/types/bignum.h"
+#include "stats/pipeline_timer.hpp"
 
 namespace asio { class io_context; }
 
@@ -67,6 +68,10 @@ private:
 
     //stats
     uint64_t m_range_searched = 0;
+    stats::Prime_pipeline_timer m_pipeline_timer;
+    // device counters, copied by the mining thread about once a second
+    std::atomic<std::uint64_t> m_fermat_tests{ 0 };
+    std::atomic<std::uint64_t> m_fermat_passes{ 0 };
 
 };
 }
@@ -0,0 +1,20 @@
+#ifndef NEXUSMINER_GPU_CPU_CUDA_CHAIN_HPP
+#define NEXUSMINER_GPU_CPU_CUDA_CHAIN_HPP
+
+//host versions of the CudaChain helpers in cuda_prime/cuda_chain.cu
+#include <stdint.h>
+#include "../cuda_prime/cuda_chain.cuh"
+
+namespace nexusminer {
+	namespace gpu
+	{
+		void cuda_chain_push_back(CudaChain& chain, uint16_t offset);
+		void cuda_chain_open(CudaChain& chain, uint64_t base_offset);
+		void get_best_fermat_chain(const CudaChain& chain, uint64_t& base_offset, int& offset, int& best_length);
+		bool is_there_still_hope(CudaChain& chain);
+		bool get_next_fermat_candidate(CudaChain& chain, uint64_t& base_offset, int& offset);
+		bool update_fermat_status(CudaChain& chain, bool is_prime);
+	}
+}
+
+#endif
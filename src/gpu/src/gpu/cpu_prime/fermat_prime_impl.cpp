@@ -0,0 +1,249 @@
+#include "fermat_prime_impl.hpp"
+#include "cuda_chain.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+
+namespace nexusminer {
+    namespace gpu {
+
+        namespace
+        {
+            //gmp scratch space for the fermat test.  one per work item.
+            class Fermat_test
+            {
+            public:
+                Fermat_test()
+                {
+                    mpz_init(m_n);
+                    mpz_init(m_exponent);
+                    mpz_init(m_result);
+                    mpz_init_set_ui(m_two, 2);
+                }
+
+                ~Fermat_test()
+                {
+                    mpz_clear(m_n);
+                    mpz_clear(m_exponent);
+                    mpz_clear(m_result);
+                    mpz_clear(m_two);
+                }
+
+                //base 2 fermat test of base_int + offset
+                bool is_prime(const mpz_t base_int, uint64_t offset)
+                {
+                    //add the offset in two 32 bit halves.  unsigned long is 32 bits on windows.
+                    mpz_set_ui(m_n, static_cast<unsigned long>(offset >> 32));
+                    mpz_mul_2exp(m_n, m_n, 32);
+                    mpz_add_ui(m_n, m_n, static_cast<unsigned long>(offset & 0xFFFFFFFF));
+                    mpz_add(m_n, m_n, base_int);
+                    mpz_sub_ui(m_exponent, m_n, 1);
+                    mpz_powm(m_result, m_two, m_exponent, m_n);
+                    return mpz_cmp_ui(m_result, 1) == 0;
+                }
+
+            private:
+                mpz_t m_n;
+                mpz_t m_exponent;
+                mpz_t m_result;
+                mpz_t m_two;
+            };
+        }
+
+        Fermat_prime_impl::Fermat_prime_impl()
+            : m_trial_division_test_count{ 0 }
+            , m_trial_division_composite_count{ 0 }
+            , m_fermat_test_count{ 0 }
+            , m_fermat_pass_count{ 0 }
+        {
+            mpz_init(m_base_int);
+        }
+
+        Fermat_prime_impl::~Fermat_prime_impl()
+        {
+            mpz_clear(m_base_int);
+        }
+
+        void Fermat_prime_impl::fermat_run()
+        {
+            const uint64_t offset_count = m_offsets.size();
+            const uint32_t work_items = static_cast<uint32_t>((offset_count + m_tests_per_work_item - 1) / m_tests_per_work_item);
+            parallel_for(work_items, [&](uint32_t work_item)
+            {
+                Fermat_test fermat_test;
+                uint64_t passes = 0;
+                const uint64_t first = static_cast<uint64_t>(work_item) * m_tests_per_work_item;
+                const uint64_t last = std::min<uint64_t>(first + m_tests_per_work_item, offset_count);
+                for (uint64_t index = first; index < last; index++)
+                {
+                    const bool is_prime = fermat_test.is_prime(m_base_int, m_offsets[index]);
+                    passes += is_prime ? 1 : 0;
+                    m_results[index] = is_prime ? 1 : 0;
+                }
+                m_fermat_pass_count += passes;
+                m_fermat_test_count += last - first;
+            });
+        }
+
+        //test the next candidate of each chain and record the result in the chain
+        void Fermat_prime_impl::fermat_chain_run()
+        {
+            const uint32_t chain_count = *m_chain_count;
+            const uint32_t work_items = (chain_count + m_tests_per_work_item - 1) / m_tests_per_work_item;
+            parallel_for(work_items, [&](uint32_t work_item)
+            {
+                Fermat_test fermat_test;
+                uint64_t passes = 0;
+                const uint32_t first = work_item * m_tests_per_work_item;
+                const uint32_t last = std::min(first + m_tests_per_work_item, chain_count);
+                for (uint32_t index = first; index < last; index++)
+                {
+                    uint64_t base_offset = 0;
+                    int relative_offset = 0;
+                    get_next_fermat_candidate(m_chains[index], base_offset, relative_offset);
+                    const bool is_prime = fermat_test.is_prime(m_base_int, base_offset + relative_offset);
+                    update_fermat_status(m_chains[index], is_prime);
+                    passes += is_prime ? 1 : 0;
+                    if (index < m_results.size())
+                        m_results[index] = is_prime ? 1 : 0;
+                }
+                m_fermat_pass_count += passes;
+                m_fermat_test_count += last - first;
+            });
+        }
+
+        //allocate memory for fermat testing.  we use a fixed maximum batch size and allocate once at the beginning.  the device is ignored.
+        void Fermat_prime_impl::fermat_init(uint64_t batch_size, int /*device*/)
+        {
+            m_offsets = {};
+            m_results.assign(batch_size, 0);
+            reset_stats();
+        }
+
+        void Fermat_prime_impl::fermat_free()
+        {
+            m_offsets = {};
+            m_results = {};
+        }
+
+        void Fermat_prime_impl::set_base_int(mpz_t base_big_int)
+        {
+            mpz_set(m_base_int, base_big_int);
+        }
+
+        void Fermat_prime_impl::set_offsets(uint64_t offsets[], uint64_t offset_count)
+        {
+            m_offsets.assign(offsets, offsets + offset_count);
+            if (m_results.size() < offset_count)
+                m_results.resize(offset_count);
+        }
+
+        void Fermat_prime_impl::get_results(uint8_t results[])
+        {
+            std::copy(m_results.begin(), m_results.begin() + m_offsets.size(), results);
+        }
+
+        void Fermat_prime_impl::get_stats(uint64_t& fermat_tests, uint64_t& fermat_passes,
+            uint64_t& trial_division_tests, uint64_t& trial_division_composites)
+        {
+            fermat_tests = m_fermat_test_count;
+            fermat_passes = m_fermat_pass_count;
+            trial_division_tests = m_trial_division_test_count;
+            trial_division_composites = m_trial_division_composite_count;
+        }
+
+        void Fermat_prime_impl::reset_stats()
+        {
+            m_fermat_test_count = 0;
+            m_fermat_pass_count = 0;
+            m_trial_division_test_count = 0;
+            m_trial_division_composite_count = 0;
+        }
+
+        void Fermat_prime_impl::set_chain_ptr(CudaChain* chains, uint32_t* chain_count)
+        {
+            m_chains = chains;
+            m_chain_count = chain_count;
+        }
+
+        //every call runs to completion before it returns
+        void Fermat_prime_impl::synchronize()
+        {
+        }
+
+        //Experimental.  port of the trial_division_chains kernel.
+        void Fermat_prime_impl::trial_division_chain_run()
+        {
+            const uint32_t chain_count = *m_chain_count;
+            const uint32_t work_items = (chain_count + m_tests_per_work_item - 1) / m_tests_per_work_item;
+            parallel_for(work_items, [&](uint32_t work_item)
+            {
+                uint64_t composites = 0;
+                const uint32_t first = work_item * m_tests_per_work_item;
+                const uint32_t last = std::min(first + m_tests_per_work_item, chain_count);
+                for (uint32_t index = first; index < last; index++)
+                {
+                    uint64_t base_offset = 0;
+                    int relative_offset = 0;
+                    get_next_fermat_candidate(m_chains[index], base_offset, relative_offset);
+                    const uint64_t offset64 = base_offset + relative_offset;
+                    const bool is_composite = std::any_of(m_trial_divisors.begin(), m_trial_divisors.end(),
+                        [offset64](trial_divisors_uint32_t const& trial_divisor)
+                        {
+                            return (trial_divisor.starting_multiple + offset64) % trial_divisor.divisor == 0;
+                        });
+                    if (is_composite)
+                    {
+                        update_fermat_status(m_chains[index], false);
+                        composites++;
+                    }
+                }
+                m_trial_division_composite_count += composites;
+                m_trial_division_test_count += static_cast<uint64_t>(last - first) * m_trial_divisors.size();
+            });
+        }
+
+        void Fermat_prime_impl::trial_division_init(uint32_t trial_divisor_count, trial_divisors_uint32_t trial_divisors[],
+            int /*device*/)
+        {
+            m_trial_divisors.assign(trial_divisors, trial_divisors + trial_divisor_count);
+        }
+
+        void Fermat_prime_impl::trial_division_free()
+        {
+            m_trial_divisors = {};
+        }
+
+        //the cuda logic test kernel has no active test.  the test vectors only need to be counted.
+        void Fermat_prime_impl::test_init(uint64_t /*batch_size*/, int /*device*/)
+        {
+            m_test_vector_a_size = 0;
+        }
+
+        void Fermat_prime_impl::test_free()
+        {
+            m_test_vector_a_size = 0;
+        }
+
+        void Fermat_prime_impl::set_input_a(mpz_t* /*a*/, uint64_t count)
+        {
+            m_test_vector_a_size = count;
+        }
+
+        void Fermat_prime_impl::set_input_b(mpz_t* /*b*/, uint64_t /*count*/)
+        {
+        }
+
+        void Fermat_prime_impl::get_test_results(mpz_t* test_results)
+        {
+            for (uint64_t i = 0; i < m_test_vector_a_size; i++)
+            {
+                mpz_set_ui(test_results[i], 0);
+            }
+        }
+
+        void Fermat_prime_impl::logic_test()
+        {
+        }
+
+    }
+}
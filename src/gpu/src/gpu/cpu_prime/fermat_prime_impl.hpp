@@ -0,0 +1,79 @@
+#ifndef NEXUSMINER_GPU_CPU_FERMAT_PRIME_IMPL_HPP
+#define NEXUSMINER_GPU_CPU_FERMAT_PRIME_IMPL_HPP
+
+//cpu emulation of the cuda fermat test.  Implements the same interface as cuda_prime/fermat_prime/fermat_prime_impl.cuh
+//using gmp on a team of host threads.
+
+#include "../cuda_prime/fermat_prime/fermat_prime.hpp"
+#include "../cuda_prime/cuda_chain.cuh"
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+#include <gmp.h>
+
+namespace nexusminer {
+	namespace gpu {
+
+		class Fermat_prime_impl
+		{
+        public:
+
+            Fermat_prime_impl();
+            ~Fermat_prime_impl();
+
+            void fermat_run();
+            void fermat_chain_run();
+            void fermat_init(uint64_t batch_size, int device);
+            void fermat_free();
+            void set_base_int(mpz_t base_big_int);
+            void set_offsets(uint64_t offsets[], uint64_t offset_count);
+            void get_results(uint8_t results[]);
+            void get_stats(uint64_t& fermat_tests, uint64_t& fermat_passes, uint64_t& trial_division_tests,
+                uint64_t& trial_division_composites);
+            void reset_stats();
+            void set_chain_ptr(CudaChain* chains, uint32_t* chain_count);
+            void synchronize();
+
+            void trial_division_chain_run();
+            void trial_division_init(uint32_t trial_divisor_count, trial_divisors_uint32_t trial_divisors[], int device);
+            void trial_division_free();
+
+
+            //non-fermat related test functions
+            void test_init(uint64_t batch_size, int device);
+            void test_free();
+            void set_input_a(mpz_t* a, uint64_t count);
+            void set_input_b(mpz_t* b, uint64_t count);
+            void get_test_results(mpz_t* test_results);
+            void logic_test();
+
+            //number of tests handed to a host thread at a time
+            static constexpr uint32_t m_tests_per_work_item = 256;
+
+        private:
+            //inputs to the fermat test
+            std::vector<uint64_t> m_offsets;  //64 bit offsets from the 1024 bit base integer
+            mpz_t m_base_int;
+
+            //results of the fermat test
+            std::vector<uint8_t> m_results;
+
+            //trial division
+            std::vector<trial_divisors_uint32_t> m_trial_divisors;
+            std::atomic<uint64_t> m_trial_division_test_count;
+            std::atomic<uint64_t> m_trial_division_composite_count;
+
+            std::atomic<uint64_t> m_fermat_test_count;
+            std::atomic<uint64_t> m_fermat_pass_count;
+
+            //array of chain candidates - these are not owned, just pointers
+            CudaChain* m_chains = nullptr;
+            uint32_t* m_chain_count = nullptr;
+
+            uint64_t m_test_vector_a_size = 0;
+
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef NEXUSMINER_GPU_CPU_PARALLEL_HPP
+#define NEXUSMINER_GPU_CPU_PARALLEL_HPP
+
+//stands in for a kernel launch in the cpu emulation backend.
+//work items are handed out one at a time to a team of host threads, the same way the gpu schedules thread blocks.
+//the team is one pool per process, shared by all emulated workers and reused across launches.
+
+#include <stdint.h>
+#include <atomic>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nexusminer {
+	namespace gpu {
+
+		inline unsigned int emulation_thread_count()
+		{
+			return std::max(1u, std::thread::hardware_concurrency());
+		}
+
+		class Emulation_pool
+		{
+		public:
+			static Emulation_pool& instance()
+			{
+				static Emulation_pool pool;
+				return pool;
+			}
+
+			~Emulation_pool()
+			{
+				{
+					std::scoped_lock lock(m_mutex);
+					m_stop = true;
+				}
+				m_work_cv.notify_all();
+				for (auto& thread : m_threads)
+				{
+					thread.join();
+				}
+			}
+
+			//call fn(i) for each i in [0, count).  the calling thread takes part and returns when all work items are done.
+			//launches from several threads queue up, the pool works on the oldest one.
+			void run(uint32_t count, std::function<void(uint32_t)> const& fn)
+			{
+				auto job = std::make_shared<Job>();
+				job->m_count = count;
+				job->m_fn = &fn;
+				if (!m_threads.empty() && count > 1)
+				{
+					{
+						std::scoped_lock lock(m_mutex);
+						m_jobs.push_back(job);
+					}
+					m_work_cv.notify_all();
+				}
+				work(*job);
+				std::unique_lock lock(m_mutex);
+				m_done_cv.wait(lock, [&job]() { return job->m_done == job->m_count; });
+			}
+
+		private:
+
+			struct Job
+			{
+				uint32_t m_count = 0;
+				std::atomic<uint32_t> m_next{ 0 };
+				std::atomic<uint32_t> m_done{ 0 };
+				std::function<void(uint32_t)> const* m_fn = nullptr;
+			};
+
+			Emulation_pool()
+			{
+				for (unsigned int t = 1; t < emulation_thread_count(); t++)
+				{
+					m_threads.emplace_back(&Emulation_pool::thread_main, this);
+				}
+			}
+
+			void work(Job& job)
+			{
+				for (uint32_t i = job.m_next++; i < job.m_count; i = job.m_next++)
+				{
+					(*job.m_fn)(i);
+					if (++job.m_done == job.m_count)
+					{
+						//lock so the launching thread can't miss the notification between its check and its wait
+						std::scoped_lock lock(m_mutex);
+						m_done_cv.notify_all();
+					}
+				}
+			}
+
+			void thread_main()
+			{
+				std::unique_lock lock(m_mutex);
+				while (true)
+				{
+					m_work_cv.wait(lock, [this]() { return m_stop || !m_jobs.empty(); });
+					if (m_stop)
+					{
+						return;
+					}
+					auto job = m_jobs.front();
+					if (job->m_next >= job->m_count)
+					{
+						//all work items handed out, the last ones may still be running
+						m_jobs.pop_front();
+						continue;
+					}
+					lock.unlock();
+					work(*job);
+					lock.lock();
+				}
+			}
+
+			std::mutex m_mutex;
+			std::condition_variable m_work_cv;
+			std::condition_variable m_done_cv;
+			std::deque<std::shared_ptr<Job>> m_jobs;
+			std::vector<std::thread> m_threads;
+			bool m_stop = false;
+		};
+
+		//call fn(i) for each i in [0, count).  returns when all work items are done.
+		template<typename Fn>
+		void parallel_for(uint32_t count, Fn&& fn)
+		{
+			if (count == 0)
+			{
+				return;
+			}
+			Emulation_pool::instance().run(count, std::function<void(uint32_t)>(std::ref(fn)));
+		}
+
+	}
+}
+
+#endif
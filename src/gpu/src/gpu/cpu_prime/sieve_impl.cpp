@@ -0,0 +1,451 @@
+#include "sieve_impl.hpp"
+#include "cuda_chain.hpp"
+#include "parallel.hpp"
+#include "sieve_lookup_tables.hpp"
+#include <algorithm>
+#include <bitset>
+
+namespace nexusminer {
+    namespace gpu {
+
+        namespace
+        {
+            int popcount(uint32_t x)
+            {
+                return static_cast<int>(std::bitset<32>(x).count());
+            }
+
+            //index of the lowest set bit. x must be non zero.
+            int lowest_set_bit(uint32_t x)
+            {
+                return popcount((x & (~x + 1)) - 1);
+            }
+
+            //offset from start_offset to the first multiple of the prime k at or above start_offset that is not divisible by 2, 3 or 5.
+            //starting_multiple is the offset of the first such multiple above the sieve start.  start_offset must be a multiple of 30.
+            uint64_t get_next_multiple(uint64_t start_offset, uint64_t starting_multiple, uint64_t k)
+            {
+                if (start_offset <= starting_multiple)
+                    return starting_multiple - start_offset;
+                uint64_t m = k - ((start_offset - starting_multiple) % k);
+                m += (m % 2 == 0) ? k : 0;
+                m += (m % 3 == 0 || m % 5 == 0) ? 2 * k : 0;
+                m += (m % 3 == 0 || m % 5 == 0) ? 2 * k : 0;
+                return m;
+            }
+
+            //cross off multiples of the prime k from j to the end of the range.  returns the first multiple past the end.
+            uint64_t cross_off(Cuda_sieve::sieve_word_t* sieve, uint64_t range, uint64_t j, uint32_t k)
+            {
+                unsigned int wheel_index = sieve30_index[(prime_mod30_inverse[k % 30] * (j % 30)) % 30];
+                while (j < range)
+                {
+                    sieve[j / Cuda_sieve::m_sieve_word_range] &= ~(static_cast<Cuda_sieve::sieve_word_t>(1) <<
+                        sieve120_index[j % Cuda_sieve::m_sieve_word_range]);
+                    //increment the next multiple of the current prime (rotate the wheel).
+                    j += static_cast<uint64_t>(k) * sieve30_gaps[wheel_index];
+                    wheel_index = (wheel_index + 1) % 8;
+                }
+                return j;
+            }
+        }
+
+        // cross off small primes.  We iterate through the sieve words and apply the precalculated masks.
+        // each block of the sieve is one work item.  start is the offset from the sieve start
+        void Cuda_sieve_impl::run_small_prime_sieve(uint64_t sieve_start_offset)
+        {
+            //each prime has its own table of masks. the tables are stored back to back.
+            const uint32_t* masks[Cuda_sieve::m_small_prime_count];
+            const uint32_t* mask_table = m_small_prime_masks.data();
+            for (int i = 0; i < Cuda_sieve::m_small_prime_count; i++)
+            {
+                masks[i] = mask_table;
+                mask_table += m_small_primes[i];
+            }
+
+            const uint64_t words_per_block = m_sieve_properties.m_kernel_sieve_size_words_per_block;
+            parallel_for(Cuda_sieve::m_num_blocks, [&](uint32_t block_id)
+            {
+                const uint64_t first_word = block_id * words_per_block;
+                uint32_t index[Cuda_sieve::m_small_prime_count];
+                uint32_t increment[Cuda_sieve::m_small_prime_count];
+                for (int i = 0; i < Cuda_sieve::m_small_prime_count; i++)
+                {
+                    const uint32_t p = m_small_primes[i];
+                    increment[i] = Cuda_sieve::m_sieve_word_range % p;
+                    index[i] = static_cast<uint32_t>((m_small_prime_offsets[i] + sieve_start_offset % p + (first_word % p) * increment[i]) % p);
+                }
+                for (uint64_t w = first_word; w < first_word + words_per_block; w++)
+                {
+                    Cuda_sieve::sieve_word_t word = ~static_cast<Cuda_sieve::sieve_word_t>(0);
+                    for (int i = 0; i < Cuda_sieve::m_small_prime_count; i++)
+                    {
+                        word &= masks[i][index[i]];
+                        index[i] += increment[i];
+                        if (index[i] >= m_small_primes[i])
+                            index[i] -= m_small_primes[i];
+                    }
+                    m_sieve[w] = word;
+                }
+            });
+        }
+
+        //large primes hit a segment no more than once so there is nothing to gain from segmenting.
+        //the sieve is split into one contiguous range per host thread and each thread crosses off every large prime in its own range.
+        void Cuda_sieve_impl::run_large_prime_sieve(uint64_t sieve_start_offset)
+        {
+            const uint32_t range_count = emulation_thread_count();
+            const uint64_t words_per_range = (m_sieve_properties.m_sieve_total_size + range_count - 1) / range_count;
+            parallel_for(range_count, [&](uint32_t range_id)
+            {
+                const uint64_t first_word = range_id * words_per_range;
+                if (first_word >= m_sieve_properties.m_sieve_total_size)
+                    return;
+                const uint64_t words = std::min(words_per_range, m_sieve_properties.m_sieve_total_size - first_word);
+                const uint64_t start_offset = sieve_start_offset + first_word * Cuda_sieve::m_sieve_word_range;
+                const uint64_t range = words * Cuda_sieve::m_sieve_word_range;
+                for (std::size_t i = 0; i < m_large_primes.size(); i++)
+                {
+                    const uint32_t k = m_large_primes[i];
+                    cross_off(&m_sieve[first_word], range, get_next_multiple(start_offset, m_large_prime_starting_multiples[i], k), k);
+                }
+            });
+        }
+
+        //medium prime sieve.
+        void Cuda_sieve_impl::run_sieve(uint64_t sieve_start_offset)
+        {
+            m_sieve_start_offset = sieve_start_offset;
+
+            if (Cuda_sieve::m_medium_prime_count == 0)
+                return;
+            parallel_for(Cuda_sieve::m_num_blocks, [&](uint32_t block_id)
+            {
+                medium_sieve_block(block_id, sieve_start_offset, m_sieving_primes, m_starting_multiples);
+            });
+        }
+
+        void Cuda_sieve_impl::run_medium_small_prime_sieve(uint64_t sieve_start_offset)
+        {
+            parallel_for(Cuda_sieve::m_num_blocks, [&](uint32_t block_id)
+            {
+                medium_sieve_block(block_id, sieve_start_offset, m_medium_small_primes, m_medium_small_prime_starting_multiples);
+            });
+        }
+
+        //sieve the segments of one block in order.  the next multiple of each prime carries over from one segment to the next.
+        void Cuda_sieve_impl::medium_sieve_block(uint32_t block_id, uint64_t sieve_start_offset, const std::vector<uint32_t>& primes,
+            const std::vector<uint32_t>& starting_multiples)
+        {
+            const uint64_t segment_size = m_sieve_properties.m_segment_range;
+            const uint64_t start_offset = sieve_start_offset + block_id * m_sieve_properties.m_block_range;
+            Cuda_sieve::sieve_word_t* segment = &m_sieve[block_id * m_sieve_properties.m_kernel_sieve_size_words_per_block];
+
+            std::vector<uint64_t> multiples(primes.size());
+            for (std::size_t i = 0; i < primes.size(); i++)
+            {
+                multiples[i] = get_next_multiple(start_offset, starting_multiples[i], primes[i]);
+            }
+            for (int s = 0; s < Cuda_sieve::m_kernel_segments_per_block; s++)
+            {
+                for (std::size_t i = 0; i < primes.size(); i++)
+                {
+                    //save the starting multiple for this prime for the next segment
+                    multiples[i] = cross_off(segment, segment_size, multiples[i], primes[i]) - segment_size;
+                }
+                segment += m_sieve_properties.m_kernel_sieve_size_words;
+            }
+        }
+
+        void Cuda_sieve_impl::get_sieve(Cuda_sieve::sieve_word_t sieve[])
+        {
+            std::copy(m_sieve.begin(), m_sieve.end(), sieve);
+        }
+
+        void Cuda_sieve_impl::get_prime_candidate_count(uint64_t& prime_candidate_count)
+        {
+            prime_candidate_count = 0;
+            for (auto word : m_sieve)
+            {
+                prime_candidate_count += popcount(word);
+            }
+        }
+
+        //Each block is one work item.  Chains are collected per block and appended in block order so the chain list does not
+        //depend on thread timing.
+        void Cuda_sieve_impl::find_chains()
+        {
+            const uint64_t search_words = Cuda_sieve::m_sieve_chain_search_boundary * Cuda_sieve::m_sieve_word_byte_count / Cuda_sieve::m_sieve_word_range;
+            const uint64_t regions_per_block = m_sieve_properties.m_kernel_sieve_size_words_per_block / search_words;
+            std::vector<std::vector<CudaChain>> block_chains(Cuda_sieve::m_num_blocks);
+            parallel_for(Cuda_sieve::m_num_blocks, [&](uint32_t block_id)
+            {
+                for (uint64_t region = 0; region < regions_per_block; region++)
+                {
+                    find_chains_in_region(block_id * regions_per_block + region, block_chains[block_id]);
+                }
+            });
+            for (auto const& chains : block_chains)
+            {
+                m_chain_stat_count += chains.size();
+                for (auto const& chain : chains)
+                {
+                    if (m_chains.size() >= Cuda_sieve::m_max_chains)
+                        break;
+                    m_chains.push_back(chain);
+                }
+            }
+            m_chain_count = static_cast<uint32_t>(m_chains.size());
+        }
+
+        //search a range of 2310*4 for chains.  chains can't cross the region boundary.  port of find_chain_kernel2
+        void Cuda_sieve_impl::find_chains_in_region(uint64_t region, std::vector<CudaChain>& chains) const
+        {
+            const unsigned int search_range = Cuda_sieve::m_sieve_chain_search_boundary * Cuda_sieve::m_sieve_word_byte_count;
+            const unsigned int search_words = search_range / Cuda_sieve::m_sieve_word_range;
+            const uint64_t region_offset = m_sieve_start_offset + region * search_range;
+            uint64_t sieve_index = region * search_words;
+
+            auto close_chain = [&chains](const CudaChain& chain)
+            {
+                if (chain.m_offset_count >= Cuda_sieve::m_min_chain_length)
+                {
+                    chains.push_back(chain);
+                }
+            };
+
+            bool chain_in_process = false;
+            CudaChain current_chain;
+            uint32_t chain_start = 0;
+            uint32_t last_offset = 0;
+            bool previous_word_last_bit_set = false;
+            //iterate through each word in the search region
+            for (unsigned int word = 0; word < search_words; word++, sieve_index++)
+            {
+                uint32_t sieve_word = m_sieve[sieve_index];
+                uint32_t next_word = sieve_index + 1 < m_sieve.size() ? m_sieve[sieve_index + 1] : 0;
+                bool next_word_first_bit_set = (next_word & 1) == 1;
+                if (chain_in_process)
+                {
+                    uint32_t word_start = sieve_word & 0x7;
+                    bool first_bit_set = (sieve_word & 1) == 1;
+                    //if the first 3 bits are zeros any in process chain is broken
+                    //if the last bit of the previous word and the first bit of the currnet word are both 0 the chain is broken
+                    if (word_start == 0 || (!previous_word_last_bit_set && !first_bit_set))
+                    {
+                        close_chain(current_chain);
+                        chain_in_process = false;
+                    }
+                }
+                bool last_bit_set = sieve_word >= 0x80000000;
+                previous_word_last_bit_set = last_bit_set;
+                //gross check to ensure there are enough set bits in the word to make it worthwhile to process
+                if (!chain_in_process)
+                {
+                    //if bits 7 and 8 are both zero, no chain originating in the first byte can make it through.  discard any set bits in the first byte
+                    if ((sieve_word & 0x000000180) == 0)
+                        sieve_word &= 0xFFFFFF00;
+                    if ((sieve_word & 0x000018000) == 0 && popcount(sieve_word & 0x0000FFFF) < Cuda_sieve::m_min_chain_length)
+                        sieve_word &= 0xFFFF0000;
+                    if ((sieve_word & 0x001800000) == 0 && popcount(sieve_word & 0x00FFFFFF) < Cuda_sieve::m_min_chain_length)
+                        sieve_word &= 0xFF000000;
+
+                    //if the last 3 bits are all zero, or the last bit is zero and first bit of the next word is zero, any chain must end at the current word
+                    uint32_t word_end = sieve_word & 0xE0000000;
+                    bool chain_must_end = (word_end == 0 || (!last_bit_set && !next_word_first_bit_set));
+                    if (chain_must_end && popcount(sieve_word) < Cuda_sieve::m_min_chain_length)
+                        continue;
+                }
+
+                //iterate through each set bit in the sieve word
+                for (uint32_t b = sieve_word; b > 0; b &= b - 1)
+                {
+                    int bit = lowest_set_bit(b);
+                    uint32_t local_offset = word * Cuda_sieve::m_sieve_word_range +
+                        (bit / 8) * Cuda_sieve::m_sieve_byte_range + sieve30_offsets[bit % 8];
+                    uint32_t gap = local_offset - last_offset;
+                    if (chain_in_process)
+                    {
+                        if (gap > maxGap)
+                        {
+                            //We reached the end of the chain.  start a new one.
+                            close_chain(current_chain);
+                            cuda_chain_open(current_chain, region_offset + local_offset);
+                            chain_start = local_offset;
+                        }
+                        else
+                        {
+                            //grow the chain
+                            cuda_chain_push_back(current_chain, static_cast<uint16_t>(local_offset - chain_start));
+                        }
+                    }
+                    else
+                    {
+                        //start a new chain
+                        cuda_chain_open(current_chain, region_offset + local_offset);
+                        chain_start = local_offset;
+                        chain_in_process = true;
+                    }
+                    last_offset = local_offset;
+                }
+            }
+            //we reached the end of the search region.  do a final check on the chain in process
+            if (chain_in_process)
+            {
+                close_chain(current_chain);
+            }
+        }
+
+        void Cuda_sieve_impl::get_chains(CudaChain chains[], uint32_t& chain_count)
+        {
+            chain_count = m_chain_count;
+            std::copy(m_chains.begin(), m_chains.end(), chains);
+        }
+
+        void Cuda_sieve_impl::get_chain_count(uint32_t& chain_count)
+        {
+            chain_count = m_chain_count;
+        }
+
+        //get a pointer to the chain array.  fermat test uses the chain array as input.
+        void Cuda_sieve_impl::get_chain_pointer(CudaChain*& chains_ptr, uint32_t*& chain_count_ptr)
+        {
+            chains_ptr = m_chains.data();
+            chain_count_ptr = &m_chain_count;
+        }
+
+        //check the list of chains for winners.  save winners and remove losers.  port of filter_busted_chains
+        void Cuda_sieve_impl::clean_chains()
+        {
+            std::size_t good_chain_count = 0;
+            for (auto& chain : m_chains)
+            {
+                if (is_there_still_hope(chain))
+                {
+                    //keep the chain
+                    m_chains[good_chain_count++] = chain;
+                    continue;
+                }
+                //this chain is busted.  collect stats for chains 3 or longer
+                if (chain.m_prime_count >= 3)
+                {
+                    int chain_length, local_offset;
+                    uint64_t base_offset;
+                    get_best_fermat_chain(chain, base_offset, local_offset, chain_length);
+                    if (chain_length >= 3)
+                        m_chain_histogram[std::min(chain_length, Cuda_sieve::chain_histogram_max)]++;
+
+                    //check for winners
+                    if (chain_length >= chain.m_min_chain_report_length && m_long_chains.size() < Cuda_sieve::m_max_long_chains)
+                    {
+                        m_long_chains.push_back(chain);
+                    }
+                }
+            }
+            //shrinking does not reallocate so the pointer held by the fermat test stays valid
+            m_chains.resize(good_chain_count);
+            m_chain_count = static_cast<uint32_t>(good_chain_count);
+        }
+
+        void Cuda_sieve_impl::get_long_chains(CudaChain chains[], uint32_t& chain_count)
+        {
+            chain_count = static_cast<uint32_t>(m_long_chains.size());
+            std::copy(m_long_chains.begin(), m_long_chains.end(), chains);
+            //clear the long chain list
+            m_long_chains.clear();
+        }
+
+        //read the histogram
+        void Cuda_sieve_impl::get_stats(uint32_t chain_histogram[], uint64_t& chain_count)
+        {
+            std::copy(m_chain_histogram.begin(), m_chain_histogram.end(), chain_histogram);
+            chain_count = m_chain_stat_count;
+        }
+
+        //every call runs to completion before it returns
+        void Cuda_sieve_impl::synchronize()
+        {
+        }
+
+        //The gpu sizes the sieve to the shared memory of a thread block.  Here the shared memory size is fixed and chosen to fit in L1.
+        //Many other sieve constants are set based on the size of the sieve.  The device is ignored.
+        void Cuda_sieve_impl::init_sieve_size(int /*device*/, Cuda_sieve::Cuda_sieve_properties& sieve_properties)
+        {
+            //the large prime sieve does not use buckets
+            sieve_properties.m_bucket_ram_budget = 0;
+            sieve_properties.m_large_prime_bucket_size = 0;
+
+            sieve_properties.m_shared_mem_size_kbytes = m_emulated_shared_mem_size_kbytes;
+            sieve_properties.m_shared_mem_size_bytes = sieve_properties.m_shared_mem_size_kbytes * 1024;
+            //The span of the primorial 30030 is represented by 30030/30 = 1001 bytes which conveniently is just below 1KB
+            sieve_properties.m_kernel_sieve_size_bytes = 1001 * (sieve_properties.m_shared_mem_size_kbytes / 4) * 4;
+            sieve_properties.m_kernel_sieve_size_words = sieve_properties.m_kernel_sieve_size_bytes / Cuda_sieve::m_sieve_word_byte_count;
+            sieve_properties.m_segment_range = sieve_properties.m_kernel_sieve_size_words * Cuda_sieve::m_sieve_word_range;
+            sieve_properties.m_kernel_sieve_size_words_per_block = sieve_properties.m_kernel_sieve_size_words * Cuda_sieve::m_kernel_segments_per_block;
+            sieve_properties.m_block_range = sieve_properties.m_segment_range * Cuda_sieve::m_kernel_segments_per_block;
+            sieve_properties.m_sieve_total_size = sieve_properties.m_kernel_sieve_size_words_per_block * Cuda_sieve::m_num_blocks; //size of the sieve in words
+            sieve_properties.m_sieve_range = sieve_properties.m_sieve_total_size * Cuda_sieve::m_sieve_word_range;
+
+            //keep a local cache of sieve properties
+            m_sieve_properties = sieve_properties;
+        }
+
+        //allocate host memory and copy values used by the sieve
+        void Cuda_sieve_impl::load_sieve(uint32_t primes[], uint32_t prime_count, uint32_t large_primes[], uint32_t medium_small_primes[],
+            uint32_t small_prime_masks[], uint32_t small_prime_mask_count, uint8_t small_primes[], uint16_t /*device*/)
+        {
+            m_sieving_prime_count = prime_count;
+            m_sieve_start_offset = 0;
+            m_sieving_primes.assign(primes, primes + prime_count);
+            m_large_primes.assign(large_primes, large_primes + Cuda_sieve::m_large_prime_count);
+            m_medium_small_primes.assign(medium_small_primes, medium_small_primes + Cuda_sieve::m_medium_small_prime_count);
+            m_small_prime_masks.assign(small_prime_masks, small_prime_masks + small_prime_mask_count);
+            m_small_primes.assign(small_primes, small_primes + Cuda_sieve::m_small_prime_count);
+
+            m_sieve.assign(m_sieve_properties.m_sieve_total_size, 0);
+            m_chains = {};
+            m_chains.reserve(Cuda_sieve::m_max_chains);
+            m_chain_count = 0;
+            m_long_chains = {};
+            m_long_chains.reserve(Cuda_sieve::m_max_long_chains);
+            reset_stats();
+        }
+
+        //reset sieve with new starting offsets
+        void Cuda_sieve_impl::init_sieve(uint32_t starting_multiples[], uint16_t small_prime_offsets[], uint32_t large_prime_multiples[],
+            uint32_t medium_small_prime_multiples[])
+        {
+            m_starting_multiples.assign(starting_multiples, starting_multiples + m_sieving_prime_count);
+            m_large_prime_starting_multiples.assign(large_prime_multiples, large_prime_multiples + Cuda_sieve::m_large_prime_count);
+            m_small_prime_offsets.assign(small_prime_offsets, small_prime_offsets + Cuda_sieve::m_small_prime_count);
+            m_medium_small_prime_starting_multiples.assign(medium_small_prime_multiples,
+                medium_small_prime_multiples + Cuda_sieve::m_medium_small_prime_count);
+            m_chains.clear();
+            m_chain_count = 0;
+            m_long_chains.clear();
+        }
+
+        void Cuda_sieve_impl::reset_stats()
+        {
+            m_chain_histogram.assign(Cuda_sieve::chain_histogram_max + 1, 0);
+            m_chain_stat_count = 0;
+        }
+
+        void Cuda_sieve_impl::free_sieve()
+        {
+            m_sieving_primes = {};
+            m_large_primes = {};
+            m_starting_multiples = {};
+            m_sieve = {};
+            m_chains = {};
+            m_chain_count = 0;
+            m_long_chains = {};
+            m_medium_small_primes = {};
+            m_medium_small_prime_starting_multiples = {};
+            m_small_primes = {};
+            m_small_prime_masks = {};
+            m_small_prime_offsets = {};
+            m_large_prime_starting_multiples = {};
+        }
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef NEXUSMINER_GPU_CPU_SIEVE_IMPL_HPP
+#define NEXUSMINER_GPU_CPU_SIEVE_IMPL_HPP
+
+//cpu emulation of the cuda sieve.  Implements the same interface as cuda_prime/sieve_impl.cuh with host memory and host threads
+//so the gpu prime worker can run on machines without a gpu.
+//Each gpu thread block becomes one work item that sieves its 32 segments in order.  Work items run on a team of host threads.
+//A segment sized to the emulated shared memory stays in the L1 cache while it is sieved.
+
+#include "../cuda_prime/sieve.hpp"
+#include "../cuda_prime/cuda_chain.cuh"
+#include <stdint.h>
+#include <vector>
+
+namespace nexusminer {
+	namespace gpu {
+
+		class Cuda_sieve_impl
+		{
+		public:
+			uint32_t m_sieving_prime_count;
+			uint64_t m_sieve_start_offset;
+
+			void load_sieve(uint32_t primes[], uint32_t prime_count, uint32_t large_primes[], uint32_t medium_small_primes[],
+				uint32_t small_prime_masks[], uint32_t small_prime_mask_count, uint8_t small_primes[], uint16_t device);
+			void init_sieve(uint32_t starting_multiples[], uint16_t small_prime_offsets[], uint32_t large_prime_starting_multiples[],
+				uint32_t medium_small_prime_multiples[]);
+			void reset_stats();
+			void free_sieve();
+			void run_small_prime_sieve(uint64_t sieve_start_offset);
+			void run_large_prime_sieve(uint64_t sieve_start_offset);
+			void run_sieve(uint64_t sieve_start_offset);
+			void run_medium_small_prime_sieve(uint64_t sieve_start_offset);
+			void get_sieve(Cuda_sieve::sieve_word_t sieve[]);
+			void get_prime_candidate_count(uint64_t& prime_candidate_count);
+			void find_chains();
+			void get_chains(CudaChain chains[], uint32_t& chain_count);
+			void get_chain_count(uint32_t& chain_count);
+			void get_chain_pointer(CudaChain*& chains_ptr, uint32_t*& chain_count_ptr);
+			void clean_chains();
+			void get_long_chains(CudaChain chains[], uint32_t& chain_count);
+			void get_stats(uint32_t chain_histogram[], uint64_t& chain_count);
+			void synchronize();
+			void init_sieve_size(int device, Cuda_sieve::Cuda_sieve_properties& sieve_properties);
+
+			//size of the emulated shared memory.  8KB sieve segments leave room in L1 for the lookup tables and the prime list.
+			static constexpr int m_emulated_shared_mem_size_kbytes = 8;
+
+		private:
+			void medium_sieve_block(uint32_t block_id, uint64_t sieve_start_offset, const std::vector<uint32_t>& primes,
+				const std::vector<uint32_t>& starting_multiples);
+			void find_chains_in_region(uint64_t region, std::vector<CudaChain>& chains) const;
+
+			Cuda_sieve::Cuda_sieve_properties m_sieve_properties;
+			//host memory standing in for device memory
+			std::vector<uint32_t> m_sieving_primes;  //medium sieving primes
+			std::vector<uint32_t> m_starting_multiples;
+			std::vector<uint32_t> m_large_primes;
+			std::vector<uint32_t> m_large_prime_starting_multiples;
+			std::vector<uint16_t> m_small_prime_offsets;
+			std::vector<uint32_t> m_medium_small_primes;
+			std::vector<uint32_t> m_medium_small_prime_starting_multiples;
+			std::vector<uint32_t> m_small_prime_masks;
+			std::vector<uint8_t> m_small_primes;
+			//the full sieve
+			std::vector<Cuda_sieve::sieve_word_t> m_sieve;
+			//array of chains.  capacity is reserved once so the fermat test can hold a pointer to it.
+			std::vector<CudaChain> m_chains;
+			uint32_t m_chain_count = 0;
+			//array of winners
+			std::vector<CudaChain> m_long_chains;
+			//histogram of confirmed fermat chains
+			std::vector<uint32_t> m_chain_histogram;
+			//chain stats
+			uint64_t m_chain_stat_count = 0;
+
+		};
+	}
+}
+
+#endif
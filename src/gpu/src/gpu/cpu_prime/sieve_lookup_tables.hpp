@@ -0,0 +1,30 @@
+#ifndef NEXUSMINER_GPU_CPU_SIEVE_LOOKUP_TABLES_HPP
+#define NEXUSMINER_GPU_CPU_SIEVE_LOOKUP_TABLES_HPP
+
+//host copies of the lookup tables in cuda_prime/sieve_lookup_tables.cuh
+#include <stdint.h>
+
+namespace nexusminer {
+	namespace gpu {
+
+		inline constexpr unsigned int sieve30_offsets[]{ 1,7,11,13,17,19,23,29 };  //mod 30 wheel
+
+		inline constexpr uint8_t sieve30_gaps[]{ 6,4,2,4,2,4,6,2 };  //gaps in the mod 30 wheel
+
+		inline constexpr unsigned int sieve30_index[]  //reverse lookup table (offset mod 30 to index)
+		{ 0,0,1,1,1,1,1, 1, 2, 2, 2, 2, 3, 3, 4, 4, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7 };
+
+		inline constexpr unsigned int prime_mod30_inverse[]  //lookup table - prime % 30 to prime inverse % 30
+		{ 1,1,13,13,13,13,13, 13, 11, 11, 11, 11, 7, 7, 23, 23, 23, 23, 19, 19, 17, 17, 17, 17, 29, 29, 29, 29, 29, 29 };
+
+		inline constexpr uint8_t sieve120_index[]  //reverse lookup table (offset mod 120 to index)
+		{ 0, 0, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 4, 4, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7,
+			 8, 8, 9, 9, 9, 9, 9, 9,10,10,10,10,11,11,12,12,12,12,13,13,14,14,14,14,15,15,15,15,15,15,
+			16,16,17,17,17,17,17,17,18,18,18,18,19,19,20,20,20,20,21,21,22,22,22,22,23,23,23,23,23,23,
+			24,24,25,25,25,25,25,25,26,26,26,26,27,27,28,28,28,28,29,29,30,30,30,30,31,31,31,31,31,31
+		};
+
+	}
+}
+
+#endif
@@ -5,7 +5,7 @@
 #if defined(GPU_CUDA_ENABLED)
 #define GPU_LARGE_PRIME_COUNT 50000
 #else
-//AMD gpu has slower fermat testing which can be offset somewhat with more sieving
+//AMD gpu and the cpu emulation have slower fermat testing which can be offset somewhat with more sieving
 #define GPU_LARGE_PRIME_COUNT 150000
 #endif
 
@@ -1,6 +1,7 @@
 #include "gpu/worker_hash.hpp"
 #include "config/worker_config.hpp"
 #include "stats/stats_collector.hpp"
+#include "stats/event_trace.hpp"
 #include "block.hpp"
 #include <asio/io_context.hpp>
 #include <asio/post.hpp>
@@ -61,11 +62,13 @@ Worker_hash::~Worker_hash()
 void Worker_hash::set_block(LLP::CBlock block, std::uint32_t nbits, Worker::Block_found_handler result)
 {
     //stop the existing mining loop if it is running
+    auto const stop_start_ticks = stats::Tick_clock::now();
     m_stop = true;
     if (m_run_thread.joinable())
     {
         m_run_thread.join();
     }
+    stats::Event_trace::instance().complete("stop_mining", "worker", stop_start_ticks, stats::Tick_clock::now());
 
 
     m_found_nonce_callback = result;
@@ -105,11 +108,15 @@ void Worker_hash::set_block(LLP::CBlock block, std::uint32_t nbits, Worker::Bloc
 
 void Worker_hash::run()
 {
+    auto& event_trace = stats::Event_trace::instance();
+    event_trace.set_thread_name("gpu hash " + m_config.m_id);
+    event_trace.instant("mining_started", "worker", "worker", m_config.m_internal_id);
     while (!m_stop)
     {
         std::uint64_t hashes = 0;
 
         // Do hashing on a CUDA device
+        auto const batch_start_ticks = stats::Tick_clock::now();
         bool found = cuda_sk1024_hash(
             m_config.m_internal_id,
             reinterpret_cast<uint32_t*>(&m_block.nVersion),
@@ -119,12 +126,14 @@ void Worker_hash::run()
             m_throughput,
             m_threads_per_block,
             m_block.nHeight);
+        event_trace.complete("hash_batch", "hash", batch_start_ticks, stats::Tick_clock::now(), "hashes", hashes);
 
         m_hashes += hashes;
 
         // If a nonce with the right diffulty was found submit block.
         if (found && !m_stop.load())
         {
+            m_block.m_found = std::chrono::steady_clock::now();
             ++m_met_difficulty_count;
             // Calculate the number of leading zero-bits
             uint1024_t hash_proof = LLC::SK1024(BEGIN(m_block.nVersion), END(m_block.nNonce));
@@ -136,6 +145,8 @@ void Worker_hash::run()
            // debug::log(0, "[MASTER] Found Hash Block ");
            // block.print();
 
+            // the kernel checked the difficulty, the host only recounts the leading zeros
+            m_block.m_checked = std::chrono::steady_clock::now();
             if (m_found_nonce_callback)
             {
                 ::asio::post([self = shared_from_this()]()
@@ -157,8 +168,9 @@ void Worker_hash::run()
 
 void Worker_hash::update_statistics(stats::Collector& stats_collector)
 {
-    auto hash_stats = std::get<stats::Hash>(stats_collector.get_worker_stats(m_config.m_internal_id));
-    hash_stats.m_hash_count += m_hashes;
+    m_hash_count += m_hashes;
+    stats::Hash hash_stats;
+    hash_stats.m_hash_count = m_hash_count;
     hash_stats.m_best_leading_zeros = m_best_leading_zeros;
     hash_stats.m_met_difficulty_count = m_met_difficulty_count;
 
@@ -1,6 +1,7 @@
 #include "gpu/worker_prime.hpp"
 #include "config/config.hpp"
 #include "stats/stats_collector.hpp"
+#include "stats/event_trace.hpp"
 #include "prime/prime.hpp"
 #include "prime/sieve.hpp"
 #include "prime/prime_tests.hpp"
@@ -8,6 +9,7 @@
 #include <asio.hpp>
 #include <primesieve.hpp>
 #include <sstream> 
+#include <algorithm>
 #include <boost/random.hpp>
 
 namespace nexusminer
@@ -57,11 +59,13 @@ Worker_prime::~Worker_prime() noexcept
 void Worker_prime::set_block(LLP::CBlock block, std::uint32_t nbits, Worker::Block_found_handler result)
 {
 	//stop the existing mining loop if it is running
+	auto const stop_start_ticks = stats::Tick_clock::now();
 	m_stop = true;
 	if (m_run_thread.joinable())
 	{
 		m_run_thread.join();
 	}
+	stats::Event_trace::instance().complete("stop_mining", "worker", stop_start_ticks, stats::Tick_clock::now());
 
 	{
 		std::scoped_lock<std::mutex> lck(m_mtx);
@@ -119,15 +123,17 @@ void Worker_prime::set_block(LLP::CBlock block, std::uint32_t nbits, Worker::Blo
 
 void Worker_prime::run()
 {
-	m_segmented_sieve->calculate_starting_multiples();
-	//copy starting multiples to the sieve
-	m_segmented_sieve->gpu_sieve_init();
-	m_segmented_sieve->gpu_fermat_test_set_base_int(m_segmented_sieve->get_sieve_start());
+	auto& event_trace = stats::Event_trace::instance();
+	event_trace.set_thread_name("gpu prime " + m_config.m_id);
+	{
+		stats::Trace_span span{ "sieve_init", "prime" };
+		m_segmented_sieve->calculate_starting_multiples();
+		//copy starting multiples to the sieve
+		m_segmented_sieve->gpu_sieve_init();
+		m_segmented_sieve->gpu_fermat_test_set_base_int(m_segmented_sieve->get_sieve_start());
+	}
+	event_trace.instant("mining_started", "worker", "worker", m_config.m_internal_id);
 	uint64_t sieve_batch_range = m_segmented_sieve->m_sieve_range;
-	uint64_t find_chains_ms = 0;
-	uint64_t sieving_ms = 0;
-	uint64_t test_chains_ms = 0;
-	uint64_t clean_chains_ms = 0;
 	uint64_t elapsed_ms = 0;
 	uint64_t low = 0;
 	uint64_t range_searched_this_cycle = 0;
@@ -138,50 +144,52 @@ void Worker_prime::run()
 		trial_division_tests, trial_division_composites);
 
 	//Setting debug to true can impact performance.  we will set it to true if the log level is set to debug or more verbose.
-	//setting debug to true is required to measure individual kernel run time
+	//setting debug to true is required to measure individual kernel run time. Without it the stage times are the
+	//host time until each stage returns, queued kernel time shows up in the stage that waits for it.
 	bool debug = m_logger->level() <= spdlog::level::level_enum::debug;
 	auto start = std::chrono::steady_clock::now();
 	auto interval_start = std::chrono::steady_clock::now();
+	auto fermat_stats_ticks = stats::Tick_clock::now();
 	while (!m_stop)
 	{
 		m_range_searched += sieve_batch_range;
 		range_searched_this_cycle += sieve_batch_range;
 
-		auto sieve_start = std::chrono::steady_clock::now();
+		auto const sieve_start_ticks = stats::Tick_clock::now();
 		m_segmented_sieve->gpu_sieve_small_primes(low);
 		m_segmented_sieve->gpu_sieve_medium_small_primes(low);
 		m_segmented_sieve->sieve_batch(low);
 		m_segmented_sieve->gpu_sieve_large_primes(low);
 		if (debug) m_segmented_sieve->gpu_sieve_synchronize();
-		auto sieve_stop = std::chrono::steady_clock::now();
-		auto sieve_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(sieve_stop - sieve_start);
-		sieving_ms += sieve_elapsed.count();
+		auto const find_chains_start_ticks = stats::Tick_clock::now();
+		m_pipeline_timer.add(stats::Prime_pipeline_timer::sieve, sieve_start_ticks, find_chains_start_ticks);
+		event_trace.complete("sieve", "prime", sieve_start_ticks, find_chains_start_ticks);
 		if (m_stop) break;
-		auto find_chains_start = std::chrono::steady_clock::now();
 		m_segmented_sieve->find_chains();
 		if (debug) m_segmented_sieve->gpu_sieve_synchronize();
-		auto find_chains_stop = std::chrono::steady_clock::now();
-		auto find_chains_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(find_chains_stop - find_chains_start);
-		find_chains_ms += find_chains_elapsed.count();
+		auto const test_chains_start_ticks = stats::Tick_clock::now();
+		m_pipeline_timer.add(stats::Prime_pipeline_timer::find_chains, find_chains_start_ticks, test_chains_start_ticks);
+		event_trace.complete("find_chains", "prime", find_chains_start_ticks, test_chains_start_ticks);
 		if (m_stop) break;
 		//m_segmented_sieve->do_chain_trial_division_check();
-		auto test_chains_start = std::chrono::steady_clock::now();
 		m_segmented_sieve->gpu_run_fermat_chain_test();
 		if (debug) m_segmented_sieve->gpu_fermat_synchronize();
-		auto test_chains_stop = std::chrono::steady_clock::now();
-		auto test_chains_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(test_chains_stop - test_chains_start);
-		test_chains_ms += test_chains_elapsed.count();
+		auto const clean_chains_start_ticks = stats::Tick_clock::now();
+		m_pipeline_timer.add(stats::Prime_pipeline_timer::fermat, test_chains_start_ticks, clean_chains_start_ticks);
+		event_trace.complete("fermat", "prime", test_chains_start_ticks, clean_chains_start_ticks);
 		if (m_stop) break;
-		auto clean_chains_start = std::chrono::steady_clock::now();
 		m_segmented_sieve->gpu_clean_chains();
 		if (debug) m_segmented_sieve->gpu_sieve_synchronize();
-		auto clean_chains_stop = std::chrono::steady_clock::now();
-		auto clean_chains_elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(clean_chains_stop - clean_chains_start);
-		clean_chains_ms += clean_chains_elapsed.count();
+		auto const clean_chains_stop_ticks = stats::Tick_clock::now();
+		m_pipeline_timer.add(stats::Prime_pipeline_timer::clean_chains, clean_chains_start_ticks, clean_chains_stop_ticks);
+		event_trace.complete("clean_chains", "prime", clean_chains_start_ticks, clean_chains_stop_ticks);
 		if (m_stop) break;
 		//check for winners
 		m_segmented_sieve->get_long_chains();
 		//check difficulty of any chains that passed through the filter
+		auto const difficulty_start_ticks = stats::Tick_clock::now();
+		auto const found = m_segmented_sieve->m_long_chain_starts.empty() ? std::chrono::steady_clock::time_point{} :
+			std::chrono::steady_clock::now();
 		for (auto x : m_segmented_sieve->m_long_chain_starts)
 		{
 			m_block.nNonce = m_nonce + x;
@@ -191,6 +199,8 @@ void Worker_prime::run()
 			m_logger->info("Actual difficulty {} required {}", difficulty, getNetworkDifficulty());
 			if (difficulty_check(chain_start))
 			{
+				m_block.m_found = found;
+				m_block.m_checked = std::chrono::steady_clock::now();
 				//we found a valid chain.  submit it. 
 				if (m_found_nonce_callback)
 				{
@@ -205,9 +215,25 @@ void Worker_prime::run()
 				}
 			}
 		}
+		if (!m_segmented_sieve->m_long_chain_starts.empty())
+		{
+			event_trace.complete("difficulty_check", "prime", difficulty_start_ticks, stats::Tick_clock::now(),
+				"chains", m_segmented_sieve->m_long_chain_starts.size());
+		}
 		m_segmented_sieve->gpu_get_stats();
 		m_segmented_sieve->m_long_chain_starts = {};
 		low += sieve_batch_range;
+		auto const loop_stop_ticks = stats::Tick_clock::now();
+		m_pipeline_timer.add(stats::Prime_pipeline_timer::total, sieve_start_ticks, loop_stop_ticks);
+		// the Fermat counters live on the device, fetch them after about a second (2^30 ticks or ns)
+		if (loop_stop_ticks - fermat_stats_ticks > (1ULL << 30))
+		{
+			uint64_t fermat_tests, fermat_passes, trial_divisions, trial_division_composites;
+			m_segmented_sieve->gpu_get_fermat_stats(fermat_tests, fermat_passes, trial_divisions, trial_division_composites);
+			m_fermat_tests.store(fermat_tests, std::memory_order_relaxed);
+			m_fermat_passes.store(fermat_passes, std::memory_order_relaxed);
+			fermat_stats_ticks = loop_stop_ticks;
+		}
 		if (m_stop) break;
 
 		//debug
@@ -230,15 +256,18 @@ void Worker_prime::run()
 				" Found " << chains_per_mm << " chain candidates per million integers." << std::endl;
 			/*std::cout << "Avg chain length: " << std::fixed << std::setprecision(2) << 1.0 * m_segmented_sieve->m_chain_candidate_total_length / m_segmented_sieve->m_chain_count
 				<< " Max chain: " << m_segmented_sieve->m_chain_candidate_max_length << std::endl;*/
+			stats::Prime_pipeline pipeline;
+			m_pipeline_timer.get_stages(pipeline);
+			auto const test_chains_ms = std::chrono::duration_cast<std::chrono::milliseconds>(pipeline.m_fermat).count();
 			ss << "Fermat test rate: " << 1.0* fermat_tests_this_cycle /(double)test_chains_ms << "k tests/s. Fermat Positive Rate: " << std::fixed << std::setprecision(3) <<
 				100.0 * fermat_positive_rate << "% Fermat tests per million integers sieved: " <<
 				1.0e6 * fermat_test_count / m_range_searched << std::endl;
 
 			ss << "Search rate: " << std::fixed << std::setprecision(2) << range_searched_this_cycle / (elapsed.count() * 1.0e6) << " billion integers per second." << std::endl;
 			ss << "Elapsed time: " << std::fixed << std::setprecision(2) << elapsed_ms / 1000.0 << "s. Sieving: " <<
-				100.0 * sieving_ms / elapsed_ms << "% Chain filtering: " << 100.0 * find_chains_ms / elapsed_ms
-				<< "% Fermat testing: " << 100.0 * test_chains_ms / elapsed_ms << "% Clean chains: " << 100.0 * clean_chains_ms / elapsed_ms <<
-				"% Other: " << 100.0 * (elapsed_ms - (sieving_ms + find_chains_ms + test_chains_ms + clean_chains_ms)) / elapsed_ms << "%";
+				100.0 * pipeline.share(pipeline.m_sieve) << "% Chain filtering: " << 100.0 * pipeline.share(pipeline.m_find_chains)
+				<< "% Fermat testing: " << 100.0 * pipeline.share(pipeline.m_fermat) << "% Clean chains: " << 100.0 * pipeline.share(pipeline.m_clean_chains) <<
+				"% Other: " << 100.0 * pipeline.share(pipeline.m_total - pipeline.m_sieve - pipeline.m_find_chains - pipeline.m_fermat - pipeline.m_clean_chains) << "%";
 			interval_start = std::chrono::steady_clock::now();
 			m_logger->debug(ss.str());
 		}
@@ -277,13 +306,19 @@ LLC::CBigNum Worker_prime::boost_uint1024_t_to_CBignum(uint1k p)
 
 void Worker_prime::update_statistics(stats::Collector& stats_collector)
 {
-	auto prime_stats = std::get<stats::Prime>(stats_collector.get_worker_stats(m_config.m_internal_id));
+	stats::Prime prime_stats;
 	prime_stats.m_primes = m_segmented_sieve->m_fermat_prime_count;
 	prime_stats.m_chains = m_segmented_sieve->m_chain_count;
 	prime_stats.m_difficulty = m_difficulty;
-	prime_stats.m_chain_histogram = m_segmented_sieve->m_chain_histogram;
+	auto const& chain_histogram = m_segmented_sieve->m_chain_histogram;
+	std::copy_n(chain_histogram.begin(), std::min(chain_histogram.size(), prime_stats.m_chain_histogram.size()),
+		prime_stats.m_chain_histogram.begin());
 	prime_stats.m_range_searched = m_range_searched;
 	prime_stats.m_most_difficult_chain = m_segmented_sieve->m_best_chain;
+	m_pipeline_timer.get_stages(prime_stats.m_pipeline);
+	prime_stats.m_pipeline.m_fermat_tests = m_fermat_tests.load(std::memory_order_relaxed);
+	prime_stats.m_pipeline.m_fermat_passes = m_fermat_passes.load(std::memory_order_relaxed);
+	prime_stats.m_pipeline.m_chains = m_segmented_sieve->m_chain_count;
 	stats_collector.update_worker_stats(m_config.m_internal_id, prime_stats);
 
 	m_primes = 0;
@@ -14,6 +14,8 @@ void show_usage(std::string const& name)
               << "\t-c,--check\t\t\t\tCheck for valid miner config file\n"
               << "\t-v,--version\t\t\t\tVersion of NexusMiner\n"
               << "\t--create-keys\t\t\t\tGenerate Falcon miner keypair for authentication\n"
+              << "\t--replay FILE\t\t\t\tMine the templates of an LLP capture file instead of connecting\n"
+              << "\t--replay-speed X\t\t\tReplay at X times the captured pace, 0 = as fast as possible (default 1)\n"
               << "\n"
               << "SOLO Mining Config Generation:\n"
               << "\t--create-falcon-config\t\t\tGenerate SOLO mining config with Falcon auth (falconminer.conf)\n"
@@ -30,6 +32,8 @@ int main(int argc, char **argv)
     bool create_keys = false;
     bool create_falcon_config = false;
     bool include_privkey = false;
+    std::string replay_file{};
+    double replay_speed = 1.0;
     
     for (int i = 1; i < argc; ++i) 
     {
@@ -62,6 +66,14 @@ int main(int argc, char **argv)
         {
             create_falcon_config = true;
         }
+        else if (arg == "--replay" && i + 1 < argc)
+        {
+            replay_file = argv[++i];
+        }
+        else if (arg == "--replay-speed" && i + 1 < argc)
+        {
+            replay_speed = std::stod(argv[++i]);
+        }
         else 
         {
             miner_config_file = argv[i];
@@ -145,6 +157,11 @@ int main(int argc, char **argv)
         return -1;
     }
 
+    if (!replay_file.empty())
+    {
+        return miner.replay(replay_file, replay_speed) ? 0 : -1;
+    }
+
     miner.run();
   
     return 0;
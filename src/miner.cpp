@@ -6,7 +6,10 @@
 #include "config/validator.hpp"
 #include "worker_manager.hpp"
 #include "worker.hpp"
+#include "cpu/layout.hpp"
 #include "version.h"
+#include "LLP/packet_trace.hpp"
+#include "stats/event_trace.hpp"
 
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -19,12 +22,48 @@
 
 namespace nexusminer
 {
+namespace
+{
+	// opcode names or numbers from the llp_trace config to a sampling interval per header
+	std::array<std::uint32_t, 256> get_llp_trace_sample_intervals(config::Llp_trace const& llp_trace_config,
+		std::shared_ptr<spdlog::logger> const& logger)
+	{
+		std::array<std::uint32_t, 256> sample_intervals;
+		auto const default_interval = llp_trace_config.m_sample_intervals.count("default") != 0 ?
+			llp_trace_config.m_sample_intervals.at("default") : 1U;
+		sample_intervals.fill(default_interval);
+
+		for (auto const& [name, interval] : llp_trace_config.m_sample_intervals)
+		{
+			if (name == "default")
+			{
+				continue;
+			}
+
+			auto found = false;
+			for (std::uint32_t header = 0; header < sample_intervals.size(); ++header)
+			{
+				if (name == get_llp_header_name(static_cast<std::uint8_t>(header)) || name == std::to_string(header))
+				{
+					sample_intervals[header] = interval;
+					found = true;
+				}
+			}
+			if (!found)
+			{
+				logger->warn("llp_trace: unknown opcode '{}' in sample config", name);
+			}
+		}
+		return sample_intervals;
+	}
+}
 
 	Miner::Miner() 
 	: m_io_context{std::make_shared<::asio::io_context>()}
 	, m_signals{std::make_shared<::asio::signal_set>(*m_io_context)}
 	, m_logger{ spdlog::stdout_color_mt("logger") }
 	, m_config{ m_logger }
+	, m_reload_signals{std::make_shared<::asio::signal_set>(*m_io_context)}
 	{
 		m_logger->set_pattern("[%D %H:%M:%S.%e][%^%l%$] %v");
 
@@ -36,6 +75,10 @@ namespace nexusminer
 #if defined(SIGQUIT)
 		m_signals->add(SIGQUIT);
 #endif 
+#if defined(SIGHUP)
+		// SIGHUP reloads the config file
+		m_reload_signals->add(SIGHUP);
+#endif
 
 		m_signals->async_wait([this](auto, auto)
 		{
@@ -52,6 +95,8 @@ namespace nexusminer
 	Miner::~Miner()
 	{
 		m_io_context->stop();
+		Packet_trace::instance().stop();
+		stats::Event_trace::instance().stop();
 	}
 
 	bool Miner::check_config(std::string const& miner_config_file)
@@ -79,6 +124,9 @@ namespace nexusminer
 		{
 			return false;
 		}
+		m_config_file = miner_config_file;
+		std::error_code error;
+		m_config_write_time = std::filesystem::last_write_time(m_config_file, error);
 
 		// logger settings
 		if (!m_config.get_logfile().empty())
@@ -96,22 +144,36 @@ namespace nexusminer
 
 		m_logger->set_level(static_cast<spdlog::level::level_enum>(m_config.get_log_level()));
 
+		// LLP wire tracing, off unless the log level or a capture file asks for it
+		auto const& llp_trace_config = m_config.get_llp_trace_config();
+		Packet_trace::instance().start(m_logger, static_cast<spdlog::level::level_enum>(llp_trace_config.m_log_level),
+			get_llp_trace_sample_intervals(llp_trace_config, m_logger), llp_trace_config.m_capture_file);
+
+		// timeline of the mining and protocol hot paths for chrome://tracing / Perfetto, off unless a file is set
+		stats::Event_trace::instance().start(m_logger, m_config.get_event_trace_file());
+		stats::Event_trace::instance().set_thread_name("io");
+
+		// cpu workers with "threads" 0 (auto) or > 1 become one pinned worker per logical cpu
+		m_layout = std::make_unique<cpu::Layout>(cpu::Topology::detect());
+		m_layout->apply(m_config.get_worker_config(), m_config.get_mining_mode());
+
 		// timer initialisation
 		chrono::Timer_factory::Sptr timer_factory = std::make_shared<chrono::Timer_factory>(m_io_context);
+		m_config_watch_timer = timer_factory->create_timer();
 
 		// network initialisation
 		m_logger->debug("Initializing network component");
 		m_network_component = network::create_component(m_io_context);
 		
 		m_logger->debug("Getting local IP address");
-		auto const local_endpoint = get_local_ip();
+		auto const local_endpoint = get_local_ip(m_config.get_local_ip());
 		std::string local_addr;
 		local_endpoint.address(local_addr);
 		m_logger->debug("Local endpoint: {}:{}", local_addr, local_endpoint.port());
 		
 		m_logger->debug("Creating worker manager");
 		m_worker_manager = std::make_shared<Worker_manager>(m_io_context, m_config, timer_factory, 
-			m_network_component->get_socket_factory()->create_socket(local_endpoint));
+			m_network_component->get_socket_factory(), local_endpoint);
 		
 		return true;
 	}
@@ -127,18 +189,10 @@ namespace nexusminer
 		m_logger->info("Note: This is the miningport in LLL-TAO's nexus.conf");
 		m_logger->info("=====================================");
 		
-		network::Endpoint wallet_endpoint{network::Transport_protocol::tcp, ip_address, port};
-		if(wallet_endpoint.transport_protocol() == network::Transport_protocol::none)
+		auto const wallet_endpoints = get_wallet_endpoints(m_config);
+		if(wallet_endpoints.empty())
 		{
-			// resolve dns name
-			m_logger->info("Resolving DNS name: {}", ip_address);
-			wallet_endpoint = resolve_dns(ip_address, port);
-			if(wallet_endpoint.transport_protocol() == network::Transport_protocol::none)
-			{
-				m_logger->error("Failed to resolve DNS name: {}", ip_address);
-				return;
-			}
-			m_logger->info("DNS resolved to: {}", wallet_endpoint.to_string());
+			return;
 		}
 
 		if (!m_worker_manager)
@@ -147,15 +201,193 @@ namespace nexusminer
 			return;
 		}
 		
-		auto result = m_worker_manager->connect(wallet_endpoint);
+		auto result = m_worker_manager->connect(wallet_endpoints);
 		if (!result)
 		{
 			m_logger->error("Failed to initialise socket. Result: {}", result);
 			return;
 		}
 
+		wait_for_reload_signal();
+		start_config_watch();
+		m_io_context->run();
+
+	}
+
+	bool Miner::replay(std::string const& capture_file, double speed)
+	{
+		if (!m_worker_manager)
+		{
+			m_logger->error("Worker manager is not initialized");
+			return false;
+		}
+
+		auto result = m_worker_manager->replay(capture_file, speed, [this]()
+		{
+			::asio::post(*m_io_context, [this]()
+			{
+				m_worker_manager->stop();
+				m_io_context->stop();
+			});
+		});
+		if (!result)
+		{
+			return false;
+		}
+
 		m_io_context->run();
+		return true;
+	}
+
+	void Miner::wait_for_reload_signal()
+	{
+		m_reload_signals->async_wait([this](auto const& error, auto)
+		{
+			if (error)
+			{
+				return;
+			}
+			m_logger->info("[Reload] SIGHUP received");
+			reload();
+			wait_for_reload_signal();
+		});
+	}
+
+	void Miner::start_config_watch()
+	{
+		auto const config_watch_interval = m_config.get_config_watch_interval();
+		if (config_watch_interval == 0)
+		{
+			m_config_watch_timer->cancel();
+			return;
+		}
 
+		m_config_watch_timer->start(chrono::Seconds(config_watch_interval), [this](bool canceled)
+		{
+			if (canceled)	// don't do anything if the timer has been canceled
+			{
+				return;
+			}
+
+			// an editor may replace the file, a missing file is checked again next time
+			std::error_code error;
+			auto const write_time = std::filesystem::last_write_time(m_config_file, error);
+			if (!error && write_time != m_config_write_time)
+			{
+				m_config_write_time = write_time;
+				m_logger->info("[Reload] {} changed", m_config_file);
+				reload();
+			}
+			start_config_watch();
+		});
+	}
+
+	void Miner::reload()
+	{
+		std::error_code error;
+		m_config_write_time = std::filesystem::last_write_time(m_config_file, error);
+
+		config::Config reloaded{ m_logger };
+		if (!reloaded.read_config(m_config_file))
+		{
+			m_logger->error("[Reload] {} not applied, mining continues with the running config", m_config_file);
+			return;
+		}
+
+		auto changes = m_config.compare(reloaded);
+		for (auto const& key : changes.m_restart_required)
+		{
+			m_logger->warn("[Reload] '{}' changed, it takes effect after a restart", key);
+		}
+		if (changes.empty())
+		{
+			m_logger->info("[Reload] Nothing to apply");
+			return;
+		}
+
+		if (changes.m_log_level)
+		{
+			m_logger->info("[Reload] Log level {}", reloaded.get_log_level());
+			m_logger->set_level(static_cast<spdlog::level::level_enum>(reloaded.get_log_level()));
+		}
+
+		// the LLP trace decides at start whether the logger runs at its trace level
+		if (changes.m_llp_trace)
+		{
+			m_logger->info("[Reload] LLP trace settings changed, restarting the trace");
+			auto const& llp_trace_config = reloaded.get_llp_trace_config();
+			Packet_trace::instance().start(m_logger, static_cast<spdlog::level::level_enum>(llp_trace_config.m_log_level),
+				get_llp_trace_sample_intervals(llp_trace_config, m_logger), llp_trace_config.m_capture_file);
+		}
+		else if (changes.m_log_level)
+		{
+			Packet_trace::instance().update_log_level();
+		}
+
+		if (changes.m_workers)
+		{
+			// the mining mode of the running config, a changed mode is one of the restart settings
+			m_layout->apply(reloaded.get_worker_config(), m_config.get_mining_mode());
+		}
+
+		std::vector<network::Endpoint> wallet_endpoints;
+		network::Endpoint local_endpoint;
+		if (changes.m_connection)
+		{
+			wallet_endpoints = get_wallet_endpoints(reloaded);
+			if (wallet_endpoints.empty())
+			{
+				m_logger->error("[Reload] Wallet {} can't be resolved, the connection settings are not applied", reloaded.get_wallet_ip());
+				changes.m_connection = false;
+			}
+			else
+			{
+				local_endpoint = get_local_ip(reloaded.get_local_ip());
+			}
+		}
+
+		m_worker_manager->reload(reloaded, changes, wallet_endpoints, std::move(local_endpoint));
+		start_config_watch();
+	}
+
+	network::Endpoint Miner::get_wallet_endpoint(std::string const& ip_address, std::uint16_t port)
+	{
+		network::Endpoint wallet_endpoint{network::Transport_protocol::tcp, ip_address, port};
+		if(wallet_endpoint.transport_protocol() == network::Transport_protocol::none)
+		{
+			// resolve dns name
+			m_logger->info("Resolving DNS name: {}", ip_address);
+			wallet_endpoint = resolve_dns(ip_address, port);
+			if(wallet_endpoint.transport_protocol() == network::Transport_protocol::none)
+			{
+				m_logger->error("Failed to resolve DNS name: {}", ip_address);
+				return wallet_endpoint;
+			}
+			m_logger->info("DNS resolved to: {}", wallet_endpoint.to_string());
+		}
+		return wallet_endpoint;
+	}
+
+	std::vector<network::Endpoint> Miner::get_wallet_endpoints(config::Config const& config)
+	{
+		std::vector<network::Endpoint> wallet_endpoints;
+		auto wallet_endpoint = get_wallet_endpoint(config.get_wallet_ip(), config.get_port());
+		if(wallet_endpoint.transport_protocol() == network::Transport_protocol::none)
+		{
+			return wallet_endpoints;
+		}
+		wallet_endpoints.push_back(std::move(wallet_endpoint));
+
+		for(auto const& node : config.get_failover_nodes())
+		{
+			// an unreachable failover node must not stop the miner
+			auto node_endpoint = get_wallet_endpoint(node.m_wallet_ip, node.m_port);
+			if(node_endpoint.transport_protocol() != network::Transport_protocol::none)
+			{
+				wallet_endpoints.push_back(std::move(node_endpoint));
+			}
+		}
+		return wallet_endpoints;
 	}
 
 	network::Endpoint Miner::resolve_dns(std::string const& dns_name, std::uint16_t port)
@@ -171,12 +403,12 @@ namespace nexusminer
 		return network::Endpoint{ *endpoint.begin()};
 	}
 
-	network::Endpoint Miner::get_local_ip()
+	network::Endpoint Miner::get_local_ip(std::string const& local_ip)
 	{
-		std::string local_ip = m_config.get_local_ip();
-		std::for_each(local_ip.begin(), local_ip.end(), [](char& c) { c = ::tolower(c); });
+		std::string local_ip_lower = local_ip;
+		std::for_each(local_ip_lower.begin(), local_ip_lower.end(), [](char& c) { c = ::tolower(c); });
 
-		if (local_ip == "auto")
+		if (local_ip_lower == "auto")
 		{
 			try 
 			{
@@ -216,8 +448,8 @@ namespace nexusminer
 		}
 		else
 		{
-			m_logger->debug("Using configured local IP: {}", m_config.get_local_ip());
-			return network::Endpoint{ network::Transport_protocol::tcp, m_config.get_local_ip(), 0 };
+			m_logger->debug("Using configured local IP: {}", local_ip);
+			return network::Endpoint{ network::Transport_protocol::tcp, local_ip, 0 };
 		}
 	}
 }
@@ -1,11 +1,14 @@
 #ifndef NEXUSMINER_MINER_HPP
 #define NEXUSMINER_MINER_HPP
 
+#include <filesystem>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "config/config.hpp"
 #include "network/endpoint.hpp"
+#include "chrono/timer.hpp"
 #include <spdlog/spdlog.h>
 #include <asio/signal_set.hpp>
 
@@ -15,6 +18,7 @@ namespace asio {
 namespace nexusminer
 {
 namespace network { class Component; }
+namespace cpu { class Layout; }
 
 class Worker_manager;
 
@@ -28,11 +32,22 @@ public:
 	bool init(std::string const& miner_config_file);
 	bool check_config(std::string const& miner_config_file);
 	void run();
+	// feed an LLP capture file (llp_trace/capture_file) through the workers instead of connecting, speed 0 = no delays
+	bool replay(std::string const& capture_file, double speed);
 
 private:
 
+	// wallet ip address or dns name, transport protocol none if it can't be resolved
+	network::Endpoint get_wallet_endpoint(std::string const& ip_address, std::uint16_t port);
+	// the primary wallet first, then the failover nodes that resolve. Empty if the primary wallet doesn't resolve.
+	std::vector<network::Endpoint> get_wallet_endpoints(config::Config const& config);
 	network::Endpoint resolve_dns(std::string const& dns_name, std::uint16_t port);
-	network::Endpoint get_local_ip();
+	network::Endpoint get_local_ip(std::string const& local_ip);
+
+	// read the config file again on SIGHUP and, with config_watch_interval, when the file changes
+	void wait_for_reload_signal();
+	void start_config_watch();
+	void reload();
 
 	std::shared_ptr<::asio::io_context> m_io_context;
 	std::shared_ptr<::asio::signal_set> m_signals;
@@ -41,6 +56,11 @@ private:
 	std::shared_ptr<spdlog::logger> m_logger;
 
 	config::Config m_config;
+	std::string m_config_file;
+	std::unique_ptr<cpu::Layout> m_layout;		// keeps the SMT benchmark result for reloads
+	std::shared_ptr<::asio::signal_set> m_reload_signals;
+	chrono::Timer::Uptr m_config_watch_timer;
+	std::filesystem::file_time_type m_config_write_time;
 };
 
 }
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <cstring>
 #include <thread>
+#include <algorithm>
 #include "spdlog/spdlog.h"
 #include <LLC/flkey.h>
 
@@ -75,6 +76,91 @@ bool falcon_sign(const std::vector<uint8_t>& privkey,
     }
 }
 
+struct Falcon_signer::Impl
+{
+    LLC::CPrivKey privkey;          // compact key, empty in expanded key mode
+    LLC::CPrivKey expanded_key;     // expanded key, 8 byte aligned by the allocator
+    LLC::CPrivKey tmp;
+    shake256_context rng;
+    std::chrono::microseconds expansion_time{0};
+    bool valid = false;
+};
+
+Falcon_signer::Falcon_signer(const LLC::CPrivKey& privkey, bool expand_key)
+    : m_impl{std::make_unique<Impl>()}
+{
+    // seed once, the PRNG state carries over between signatures
+    if (shake256_init_prng_from_system(&m_impl->rng) != 0) {
+        spdlog::error("Failed to seed Falcon signing PRNG from system");
+        return;
+    }
+    if (privkey.empty()) {
+        return;
+    }
+
+    if (!expand_key) {
+        m_impl->privkey = privkey;
+        m_impl->tmp.resize(FALCON_TMPSIZE_SIGNDYN(9));
+        m_impl->valid = true;
+        return;
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    m_impl->expanded_key.resize(FALCON_EXPANDEDKEY_SIZE(9));
+    m_impl->tmp.resize(std::max<size_t>(FALCON_TMPSIZE_EXPANDPRIV(9), FALCON_TMPSIZE_SIGNTREE(9)));
+    if (falcon_expand_privkey(m_impl->expanded_key.data(), m_impl->expanded_key.size(),
+        privkey.data(), privkey.size(), m_impl->tmp.data(), m_impl->tmp.size()) != 0) {
+        spdlog::error("Failed to expand Falcon private key");
+        m_impl->expanded_key.clear();
+        return;
+    }
+    m_impl->expansion_time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    m_impl->valid = true;
+}
+
+Falcon_signer::~Falcon_signer() = default;
+
+bool Falcon_signer::is_valid() const
+{
+    return m_impl->valid;
+}
+
+bool Falcon_signer::is_expanded() const
+{
+    return !m_impl->expanded_key.empty();
+}
+
+std::chrono::microseconds Falcon_signer::get_expansion_time() const
+{
+    return m_impl->expansion_time;
+}
+
+bool Falcon_signer::sign(const std::vector<uint8_t>& data, std::vector<uint8_t>& signature)
+{
+    if (!m_impl->valid || data.empty()) {
+        return false;
+    }
+
+    // constant time signature, as FLKey::Sign
+    signature.resize(FALCON_SIG_CT_SIZE(9));
+    size_t signature_size = signature.size();
+    int const result = is_expanded()
+        ? falcon_sign_tree(&m_impl->rng, signature.data(), &signature_size, m_impl->expanded_key.data(),
+            data.data(), data.size(), 1, m_impl->tmp.data(), m_impl->tmp.size())
+        : falcon_sign_dyn(&m_impl->rng, signature.data(), &signature_size,
+            m_impl->privkey.data(), m_impl->privkey.size(), data.data(), data.size(), 1,
+            m_impl->tmp.data(), m_impl->tmp.size());
+    if (result != 0) {
+        spdlog::error("Failed to sign data with Falcon key");
+        signature.clear();
+        return false;
+    }
+    signature.resize(signature_size);
+
+    return true;
+}
+
 bool falcon_verify(const std::vector<uint8_t>& pubkey,
                    const std::vector<uint8_t>& data,
                    const std::vector<uint8_t>& signature)
@@ -116,7 +202,8 @@ std::string to_hex(const std::vector<uint8_t>& data)
     return oss.str();
 }
 
-bool from_hex(const std::string& hex, std::vector<uint8_t>& data)
+template<typename Bytes>
+static bool from_hex_bytes(const std::string& hex, Bytes& data)
 {
     if (hex.length() % 2 != 0) {
         return false;
@@ -140,6 +227,16 @@ bool from_hex(const std::string& hex, std::vector<uint8_t>& data)
     return true;
 }
 
+bool from_hex(const std::string& hex, std::vector<uint8_t>& data)
+{
+    return from_hex_bytes(hex, data);
+}
+
+bool from_hex(const std::string& hex, LLC::CPrivKey& data)
+{
+    return from_hex_bytes(hex, data);
+}
+
 bool create_falcon_config(const std::string& config_filename,
                          bool include_privkey,
                          const std::string& miner_id)
@@ -4,6 +4,9 @@
 #include <vector>
 #include <string>
 #include <cstdint>
+#include <memory>
+#include <chrono>
+#include <LLC/types/typedef.h>
 
 namespace nexusminer
 {
@@ -34,6 +37,58 @@ bool falcon_sign(const std::vector<uint8_t>& privkey,
                  const std::vector<uint8_t>& data, 
                  std::vector<uint8_t>& signature);
 
+/**
+ * @brief Reusable Falcon-512 signer
+ * 
+ * Keeps the private key, a PRNG seeded once from the system and the scratch
+ * buffer of the signing call, so repeated signatures don't set up a key object
+ * and allocate temporary memory each time. Not thread safe.
+ * 
+ * With expand_key the private key is expanded once (falcon_expand_privkey) and
+ * every signature uses falcon_sign_tree, which skips re-deriving the LDL tree
+ * from the compact key. The expanded key (~56 KB) and the scratch buffer are
+ * held in locked memory (secure_allocator), the compact key is not kept.
+ */
+class Falcon_signer
+{
+public:
+
+    Falcon_signer(const LLC::CPrivKey& privkey, bool expand_key);
+    ~Falcon_signer();
+
+    Falcon_signer(const Falcon_signer&) = delete;
+    Falcon_signer& operator=(const Falcon_signer&) = delete;
+
+    /**
+     * @brief Check if the PRNG could be seeded and the private key is set (and expanded)
+     */
+    bool is_valid() const;
+
+    /**
+     * @brief True if signatures use the expanded key
+     */
+    bool is_expanded() const;
+
+    /**
+     * @brief Time spent expanding the private key, zero in compact key mode
+     */
+    std::chrono::microseconds get_expansion_time() const;
+
+    /**
+     * @brief Sign data, produces the same constant-time signature format as falcon_sign()
+     * 
+     * @param data The data to sign
+     * @param[out] signature The resulting signature
+     * @return true if signing succeeded, false otherwise
+     */
+    bool sign(const std::vector<uint8_t>& data, std::vector<uint8_t>& signature);
+
+private:
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
 /**
  * @brief Verify a Falcon signature
  * 
@@ -63,6 +118,11 @@ std::string to_hex(const std::vector<uint8_t>& data);
  */
 bool from_hex(const std::string& hex, std::vector<uint8_t>& data);
 
+/**
+ * @brief Convert a hexadecimal private key to binary, the key stays in locked memory that is cleared when freed
+ */
+bool from_hex(const std::string& hex, LLC::CPrivKey& data);
+
 /**
  * @brief Generate a Falcon miner configuration file
  * 
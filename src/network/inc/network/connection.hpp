@@ -37,6 +37,9 @@ public:
     //  If the connection is in state connected, transmit() asynchronously initiates a transmission of the payload over this connection.
     virtual void transmit(Shared_payload tx_buffer) = 0;
 
+    //  Transmit prefix and body of the payload with one scatter-gather write, the body is not copied
+    virtual void transmit(Gather_payload tx_payload) = 0;
+
     // Closes the connection
     virtual void close() = 0;
 };
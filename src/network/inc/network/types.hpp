@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <vector>
+#include <array>
 #include <cstdint>
 #include <string>
 
@@ -85,6 +86,72 @@ inline std::string code_to_string(Code code)
 using Payload = std::vector<std::uint8_t>;
 using Shared_payload = std::shared_ptr<Payload>;
 
+// read only range of a shared payload. Copies of a slice share the buffer, no bytes are copied.
+class Payload_slice {
+public:
+    Payload_slice() = default;
+
+    // whole payload
+    Payload_slice(Shared_payload buffer)
+        : m_buffer{std::move(buffer)}
+        , m_offset{0}
+        , m_size{m_buffer ? m_buffer->size() : 0}
+    {
+    }
+
+    Payload_slice(Shared_payload buffer, std::size_t offset, std::size_t size)
+        : m_buffer{std::move(buffer)}
+        , m_offset{offset}
+        , m_size{size}
+    {
+    }
+
+    std::uint8_t const* data() const { return m_buffer ? m_buffer->data() + m_offset : nullptr; }
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    std::uint8_t const* begin() const { return data(); }
+    std::uint8_t const* end() const { return data() + m_size; }
+    std::uint8_t operator[](std::size_t index) const { return data()[index]; }
+
+    Shared_payload const& buffer() const { return m_buffer; }
+    std::size_t offset() const { return m_offset; }
+
+    // copy of the sliced bytes for code that needs its own vector
+    Payload to_payload() const { return empty() ? Payload{} : Payload(begin(), end()); }
+
+private:
+    Shared_payload m_buffer;
+    std::size_t m_offset{0};
+    std::size_t m_size{0};
+};
+
+// Transmit unit for scatter-gather writes: a few prefix bytes (e.g. a packet header) stored inline followed by
+// a payload slice. Both parts go to the socket in one gather write without joining them into one buffer.
+struct Gather_payload {
+    static constexpr std::size_t max_prefix_size = 8;
+
+    std::array<std::uint8_t, max_prefix_size> m_prefix{};
+    std::size_t m_prefix_size{0};
+    Payload_slice m_body{};
+
+    Gather_payload() = default;
+
+    // plain payload without prefix
+    Gather_payload(Shared_payload payload)
+        : m_body{std::move(payload)}
+    {
+    }
+
+    std::size_t size() const { return m_prefix_size + m_body.size(); }
+    bool empty() const { return size() == 0; }
+
+    // byte at index of the concatenated prefix and body
+    std::uint8_t operator[](std::size_t index) const
+    {
+        return index < m_prefix_size ? m_prefix[index] : m_body[index - m_prefix_size];
+    }
+};
+
 enum class Transport_protocol { tcp = 0, udp = 1, none = 3 };
 
 struct Internet_protocol {
@@ -5,9 +5,11 @@
 #include "asio/write.hpp"
 #include "network/connection.hpp"
 #include "network/tcp/protocol_description.hpp"
-#include "LLP/llp_logging.hpp"
+#include "LLP/packet_trace.hpp"
+#include "stats/event_trace.hpp"
 #include <spdlog/spdlog.h>
 #include <queue>
+#include <array>
 #include <memory>
 
 namespace nexusminer {
@@ -41,6 +43,7 @@ public:
     Endpoint const& remote_endpoint() const override { return m_remote_endpoint; }
     Endpoint const& local_endpoint() const override { return m_local_endpoint; }
     void transmit(Shared_payload tx_buffer) override;
+    void transmit(Gather_payload tx_payload) override;
     void close() override;
 
     // interface towards socket
@@ -59,7 +62,8 @@ private:
     std::shared_ptr<Protocol_socket> m_asio_socket;
     Endpoint m_remote_endpoint;
     Endpoint m_local_endpoint;
-    std::queue<Shared_payload> m_tx_queue;
+    std::queue<Gather_payload> m_tx_queue;
+    Shared_payload m_receive_buffer;
     Connection::Handler m_connection_handler;
     std::shared_ptr<spdlog::logger> m_logger;
 };
@@ -74,6 +78,7 @@ inline Connection_impl<ProtocolDescriptionType>::Connection_impl(
     , m_remote_endpoint{std::move(remote_endpoint)}
     , m_local_endpoint{std::move(local_endpoint)}
     , m_tx_queue{}
+    , m_receive_buffer{}
     , m_connection_handler{std::move(handler)}
     , m_logger{spdlog::get("logger")}
 {
@@ -88,6 +93,7 @@ inline Connection_impl<ProtocolDescriptionType>::Connection_impl(
     , m_remote_endpoint{std::move(remote_endpoint)}
     , m_local_endpoint{}     // will be set later, this constructor is called in accept/listen case
     , m_tx_queue{}
+    , m_receive_buffer{}
 	, m_connection_handler{} // will be set later, this constructor is called in accept/listen case
     , m_logger{spdlog::get("logger")}
 {
@@ -175,74 +181,18 @@ inline void Connection_impl<ProtocolDescriptionType>::receive()
                     return;
                 }
 
-                Shared_payload receive_buffer = std::make_shared<std::vector<std::uint8_t>>(length);
+                // reuse the receive buffer of the previous read unless the handler kept a reference to it
+                if (!self->m_receive_buffer || self->m_receive_buffer.use_count() > 1)
+                {
+                    self->m_receive_buffer = std::make_shared<Payload>();
+                }
+                Shared_payload receive_buffer = self->m_receive_buffer;
                 receive_buffer->resize(length);
 
                 self->m_asio_socket->receive(asio::buffer(*receive_buffer, receive_buffer->size()), 0, error);
                 if (!error)
                 {
-                    // Log received LLP packets
-                    if (self->m_logger && receive_buffer && !receive_buffer->empty())
-                    {
-                        // Try to parse packet(s) from buffer for logging
-                        std::size_t offset = 0;
-                        while (offset < receive_buffer->size())
-                        {
-                            if (offset + 1 > receive_buffer->size()) break;
-                            
-                            std::uint8_t header = (*receive_buffer)[offset];
-                            std::uint32_t pkt_length = 0;
-                            
-                            // Check if it's a data packet (has length field)
-                            if (offset + 5 <= receive_buffer->size())
-                            {
-                                pkt_length = ((*receive_buffer)[offset + 1] << 24) + 
-                                           ((*receive_buffer)[offset + 2] << 16) + 
-                                           ((*receive_buffer)[offset + 3] << 8) + 
-                                           (*receive_buffer)[offset + 4];
-                            }
-                            
-                            // Create data payload for hex preview
-                            network::Shared_payload data_payload;
-                            if (offset + 5 < receive_buffer->size())
-                            {
-                                std::size_t data_end = std::min(offset + 5 + pkt_length, receive_buffer->size());
-                                data_payload = std::make_shared<network::Payload>(
-                                    receive_buffer->begin() + offset + 5, 
-                                    receive_buffer->begin() + data_end);
-                            }
-                            
-                            std::string hex_preview = format_llp_payload_hex(data_payload, 16);
-                            if (!hex_preview.empty())
-                            {
-                                self->m_logger->info("[LLP RECV] header={} (0x{:02x}) {} length={} payload=[{}]", 
-                                    static_cast<int>(header), header, get_llp_header_name(header), 
-                                    pkt_length, hex_preview);
-                            }
-                            else
-                            {
-                                self->m_logger->info("[LLP RECV] header={} (0x{:02x}) {} length={}", 
-                                    static_cast<int>(header), header, get_llp_header_name(header), pkt_length);
-                            }
-                            
-                            // Move to next packet (header + 4 bytes length + data)
-                            if (pkt_length > 0 && offset + 5 + pkt_length <= receive_buffer->size())
-                            {
-                                offset += 5 + pkt_length;
-                            }
-                            else if (pkt_length == 0)
-                            {
-                                // Request packet (no data)
-                                offset += 1;
-                            }
-                            else
-                            {
-                                // Incomplete packet, stop logging
-                                break;
-                            }
-                        }
-                    }
-                    
+                    // received packets are traced after framing (Packet_trace)
                     self->m_connection_handler(Result::receive_ok, std::move(receive_buffer));
                     self->receive();
                 }
@@ -283,6 +233,7 @@ inline void Connection_impl<ProtocolDescriptionType>::change(Result::Code code)
 {
     if (code == Result::Code::connection_ok) 
     {
+        Packet_trace::instance().trace_event(Packet_trace::Direction::connect, m_local_endpoint.port());
         m_connection_handler(code, Shared_payload{});
         receive();
     }
@@ -304,6 +255,22 @@ inline void Connection_impl<ProtocolDescriptionType>::handle_accept(Connection::
 
 template<typename ProtocolDescriptionType>
 void Connection_impl<ProtocolDescriptionType>::transmit(Shared_payload tx_buffer)
+{
+    // Early-return if buffer is null (no header/payload to send)
+    if (!tx_buffer)
+    {
+        if (m_logger)
+        {
+            m_logger->error("[LLP SEND] Cannot transmit - payload is null or empty");
+        }
+        return;
+    }
+
+    transmit(Gather_payload{std::move(tx_buffer)});
+}
+
+template<typename ProtocolDescriptionType>
+void Connection_impl<ProtocolDescriptionType>::transmit(Gather_payload tx_payload)
 {
     // Early-return if connection handler is null (connection already closed/uninitialised)
     if (!m_connection_handler) 
@@ -325,8 +292,8 @@ void Connection_impl<ProtocolDescriptionType>::transmit(Shared_payload tx_buffer
         return;
     }
     
-    // Early-return if buffer is null or empty (no header/payload to send)
-    if (!tx_buffer || tx_buffer->empty())
+    // Early-return if payload is empty (no header/payload to send)
+    if (tx_payload.empty())
     {
         if (m_logger)
         {
@@ -336,7 +303,7 @@ void Connection_impl<ProtocolDescriptionType>::transmit(Shared_payload tx_buffer
     }
     
     // Enqueue the payload and trigger transmission if queue was previously empty
-    m_tx_queue.emplace(tx_buffer);
+    m_tx_queue.emplace(std::move(tx_payload));
     if (m_tx_queue.size() == 1) 
     {
         transmit_trigger();
@@ -371,10 +338,11 @@ void Connection_impl<ProtocolDescriptionType>::transmit_trigger()
         return;
     }
     
-    auto const payload = m_tx_queue.front();
+    // the payload stays at the front of the queue until the write completed. the prefix bytes are written from there.
+    auto const& payload = m_tx_queue.front();
     
-    // Check payload is non-null and non-empty
-    if (!payload || payload->empty())
+    // Check payload is non-empty
+    if (payload.empty())
     {
         if (m_logger)
         {
@@ -389,69 +357,18 @@ void Connection_impl<ProtocolDescriptionType>::transmit_trigger()
         return;
     }
     
-    // Log LLP packet send with robust size checking
-    if (m_logger)
-    {
-        // Ensure we can safely read the header
-        if (payload->size() >= 1)
-        {
-            std::uint8_t header = (*payload)[0];
-            std::uint32_t length = 0;
-            
-            // Distinguish header-only (size == 1) vs header+payload packets
-            if (payload->size() == 1)
-            {
-                // Header-only request packet (GET_BLOCK, GET_HEIGHT, PING, etc.)
-                m_logger->info("[LLP SEND] header={} (0x{:02x}) {} length=0 (header-only)", 
-                    static_cast<int>(header), header, get_llp_header_name(header));
-            }
-            else if (payload->size() >= 5)
-            {
-                // Header + length field + data
-                length = (static_cast<std::uint32_t>((*payload)[1]) << 24) |
-                         (static_cast<std::uint32_t>((*payload)[2]) << 16) |
-                         (static_cast<std::uint32_t>((*payload)[3]) << 8) |
-                         static_cast<std::uint32_t>((*payload)[4]);
-                
-                // Create a shared pointer to the data portion for hex formatting
-                network::Shared_payload data_payload;
-                if (payload->size() > 5)
-                {
-                    std::size_t data_start = 5;
-                    std::size_t data_end = std::min(data_start + length, payload->size());
-                    if (data_end > data_start)
-                    {
-                        data_payload = std::make_shared<network::Payload>(
-                            payload->begin() + data_start, 
-                            payload->begin() + data_end);
-                    }
-                }
-                
-                std::string hex_preview = format_llp_payload_hex(data_payload, 16);
-                if (!hex_preview.empty())
-                {
-                    m_logger->info("[LLP SEND] header={} (0x{:02x}) {} length={} payload=[{}]", 
-                        static_cast<int>(header), header, get_llp_header_name(header), length, hex_preview);
-                }
-                else
-                {
-                    m_logger->info("[LLP SEND] header={} (0x{:02x}) {} length={}", 
-                        static_cast<int>(header), header, get_llp_header_name(header), length);
-                }
-            }
-            else
-            {
-                // Malformed packet: size is between 2 and 4
-                m_logger->error("[LLP SEND] Malformed LLP payload: size={} (expected 1 for header-only or >=5 for data packet)", 
-                    payload->size());
-            }
-        }
-    }
+    // sampled wire tracing, hex formatting happens on the trace thread
+    Packet_trace::instance().trace(Packet_trace::Direction::send, m_local_endpoint.port(), payload);
     
-    ::asio::async_write(*m_asio_socket, ::asio::buffer(*payload, payload->size()),
+    std::array<::asio::const_buffer, 2> const buffers{
+        ::asio::buffer(payload.m_prefix.data(), payload.m_prefix_size),
+        ::asio::buffer(payload.m_body.data(), payload.m_body.size())};
+    ::asio::async_write(*m_asio_socket, buffers,
         // don't forget to keep the payload until transmission has been completed!!!
-        [weak_self = get_weak_self(), payload](auto, auto) 
+        [weak_self = get_weak_self(), body = payload.m_body, transmit_start_ticks = stats::Tick_clock::now()](auto, auto bytes_transferred) 
         {
+            stats::Event_trace::instance().complete("transmit", "network", transmit_start_ticks, stats::Tick_clock::now(),
+                "bytes", bytes_transferred);
             auto self = weak_self.lock();
             if ((self != nullptr) && self->m_connection_handler) 
             {
@@ -488,6 +405,7 @@ inline void Connection_impl<ProtocolDescriptionType>::close_internal(Result::Cod
             (void)m_asio_socket->close(error);
         }
 
+        Packet_trace::instance().trace_event(Packet_trace::Direction::disconnect, m_local_endpoint.port());
         auto const connection_handler = std::move(m_connection_handler);
         m_connection_handler = nullptr;
         connection_handler(code, Shared_payload{});
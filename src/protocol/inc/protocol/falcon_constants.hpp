@@ -39,6 +39,12 @@ namespace FalconConstants {
      * Using a conservative upper bound to account for natural variation
      */
     constexpr size_t FALCON512_SIG_MAX = 700;
+    
+    /**
+     * Size of the constant-time Falcon-512 signature encoding
+     * (FALCON_SIG_CT_SIZE(9)), upper bound for the submission buffer
+     */
+    constexpr size_t FALCON512_SIG_CT_SIZE = 809;
 
 } // namespace FalconConstants
 
@@ -7,9 +7,12 @@
 #include <string>
 #include <chrono>
 #include <atomic>
+#include <mutex>
 #include "spdlog/spdlog.h"
+#include "LLC/types/typedef.h"
 
 namespace nexusminer {
+namespace keys { class Falcon_signer; }
 namespace protocol {
 
 /**
@@ -52,13 +55,17 @@ public:
     /**
      * @brief Constructor
      * @param pubkey Falcon-512 public key (897 bytes)
-     * @param privkey Falcon-512 private key (1281 bytes)
+     * @param privkey Falcon-512 private key (1281 bytes), only the signer keeps
+     *                the key, in locked memory
+     * @param expand_key Expand the private key once into locked memory and sign
+     *                   with the expanded key (falcon_sign_tree)
      */
     FalconSignatureWrapper(const std::vector<uint8_t>& pubkey,
-                          const std::vector<uint8_t>& privkey);
+                          const LLC::CPrivKey& privkey,
+                          bool expand_key = true);
     
     /**
-     * @brief Destructor - securely clears private key from memory
+     * @brief Destructor - the signer clears its key material when it is freed
      */
     ~FalconSignatureWrapper();
     
@@ -128,6 +135,8 @@ public:
         uint64_t payload_signatures;
         uint64_t total_time_microseconds;
         uint64_t average_time_microseconds;
+        bool expanded_key;                      // signatures use the expanded private key
+        uint64_t key_expansion_time_microseconds;
     };
     
     PerformanceStats get_stats() const;
@@ -156,9 +165,13 @@ private:
     
     // Member variables
     std::vector<uint8_t> m_pubkey;
-    std::vector<uint8_t> m_privkey;
+    std::size_t m_privkey_size;  // for diagnostics, the key itself is only held by the signer
     bool m_initialized;
     
+    // Reusable signer (seeded PRNG and scratch buffer), shared by the io and signing threads
+    std::unique_ptr<keys::Falcon_signer> m_signer;
+    std::mutex m_signer_mutex;
+    
     // Logger
     std::shared_ptr<spdlog::logger> m_logger;
     
@@ -102,11 +102,11 @@ public:
      * This is the primary READ operation - processes incoming block templates
      * from the LLL-TAO node. The template is validated before being accepted.
      * 
-     * @param data Raw packet data (block header bytes)
+     * @param data Raw packet data (block header bytes), usually a slice of the receive buffer
      * @param source_endpoint Node endpoint source for logging
      * @return ValidationResult with validation status
      */
-    ValidationResult read_template(const network::Payload& data, 
+    ValidationResult read_template(network::Payload_slice const& data, 
                                    const std::string& source_endpoint = "");
     
     /**
@@ -118,6 +118,41 @@ public:
     ValidationResult read_template(network::Shared_payload data,
                                    const std::string& source_endpoint = "");
     
+    /**
+     * @brief Read and validate a prefetched BLOCK_DATA packet into the standby slot
+     * 
+     * Same checks as read_template, but the template is neither made current nor
+     * fed. It replaces any previous standby template and is swapped in with
+     * promote_next_template when the miner needs new work.
+     * 
+     * @param data Raw packet data (block header bytes)
+     * @param source_endpoint Node endpoint source for logging
+     * @return ValidationResult with validation status
+     */
+    ValidationResult read_next_template(network::Payload_slice const& data,
+                                        const std::string& source_endpoint = "");
+    
+    /**
+     * @brief Get the standby template (if validated)
+     * @return Pointer to the standby template, nullptr if none available
+     */
+    const MiningTemplate* get_next_template() const;
+    
+    /**
+     * @brief Make the standby template current and feed it
+     * 
+     * Swaps the standby slot with the current template in one step, the old
+     * current template is dropped.
+     * 
+     * @return true if a standby template was available
+     */
+    bool promote_next_template();
+    
+    /**
+     * @brief Drop the standby template (e.g. after the height changed)
+     */
+    void discard_next_template();
+    
     /**
      * @brief Check if a valid template is available for mining
      * @return true if template is validated and ready
@@ -245,6 +280,8 @@ public:
         uint64_t templates_rejected;
         uint64_t templates_stale;
         uint64_t templates_fed;
+        uint64_t templates_prefetched;  // Standby templates validated ahead of need
+        uint64_t templates_promoted;    // Standby templates swapped in without a round trip
         uint64_t blocks_verified;
         uint64_t blocks_submitted;
         uint64_t total_read_time_us;
@@ -277,13 +314,24 @@ private:
      */
     ValidationResult validate_template(const MiningTemplate& tmpl);
     
+    /**
+     * @brief Parse and validate raw template data, shared by the READ operations
+     * @param data Raw bytes
+     * @param source_endpoint Node endpoint source
+     * @param tmpl Output template, VALIDATED on success
+     * @return ValidationResult
+     */
+    ValidationResult parse_and_validate(network::Payload_slice const& data,
+                                        const std::string& source_endpoint,
+                                        MiningTemplate& tmpl);
+    
     /**
      * @brief Parse block header from raw bytes
      * @param data Raw bytes
      * @param block Output block structure
      * @return true if parsing succeeded
      */
-    bool parse_block_header(const network::Payload& data, ::LLP::CBlock& block);
+    bool parse_block_header(network::Payload_slice const& data, ::LLP::CBlock& block);
     
     // Member variables
     uint8_t m_channel;
@@ -291,6 +339,7 @@ private:
     uint32_t m_current_height;
     
     MiningTemplate m_current_template;
+    MiningTemplate m_next_template;     // Prefetched standby template (double buffer)
     TemplateFeedHandler m_feed_handler;
     
     std::shared_ptr<spdlog::logger> m_logger;
@@ -301,6 +350,8 @@ private:
     std::atomic<uint64_t> m_templates_rejected;
     std::atomic<uint64_t> m_templates_stale;
     std::atomic<uint64_t> m_templates_fed;
+    std::atomic<uint64_t> m_templates_prefetched;
+    std::atomic<uint64_t> m_templates_promoted;
     std::atomic<uint64_t> m_blocks_verified;
     std::atomic<uint64_t> m_blocks_submitted;
     std::atomic<uint64_t> m_total_read_time_us;
@@ -24,7 +24,7 @@ public:
 protected:
 
     // out_param nbits. Returns data without the nbits from pool.
-    network::Shared_payload extract_nbits_from_block(network::Shared_payload data, std::uint32_t& nbits);
+    network::Payload_slice extract_nbits_from_block(network::Shared_payload data, std::uint32_t& nbits);
 
     std::shared_ptr<spdlog::logger> m_logger;
     Set_block_handler m_set_block_handler;
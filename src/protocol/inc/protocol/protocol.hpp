@@ -38,13 +38,22 @@ public:
 
     using Login_handler = std::function<void(bool login_result)>;
     using Set_block_handler = std::function<void(::LLP::CBlock block, std::uint32_t nBits)>;
+    // receives the SUBMIT_BLOCK packet, empty if it could not be built. May be called from another thread.
+    using Submit_handler = std::function<void(network::Gather_payload submission)>;
 
     virtual ~Protocol() = default;
 
     virtual void reset() = 0;
     virtual network::Shared_payload login(Login_handler handler) = 0;
     virtual network::Shared_payload get_work() = 0;
-    virtual network::Shared_payload submit_block(std::vector<std::uint8_t> const& block_data, std::uint64_t nonce ) = 0;
+    // request a standby template ahead of need, empty if the protocol doesn't prefetch or one is already requested
+    virtual network::Shared_payload prefetch_work() { return network::Shared_payload{}; }
+    virtual network::Gather_payload submit_block(std::vector<std::uint8_t> const& block_data, std::uint64_t nonce ) = 0;
+    // asynchronous variant for protocols with expensive submissions, default builds the packet in place
+    virtual void submit_block(std::vector<std::uint8_t> const& block_data, std::uint64_t nonce, Submit_handler handler)
+    {
+        handler(submit_block(block_data, nonce));
+    }
 
     virtual void process_messages(Packet packet, std::shared_ptr<network::Connection> connection) = 0;
     virtual void set_block_handler(Set_block_handler handler) = 0;
@@ -0,0 +1,77 @@
+#ifndef NEXUSMINER_PROTOCOL_SIGNING_EXECUTOR_HPP
+#define NEXUSMINER_PROTOCOL_SIGNING_EXECUTOR_HPP
+
+#include "protocol/falcon_wrapper.hpp"
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+
+namespace nexusminer {
+namespace protocol {
+
+/**
+ * @brief Dedicated thread for Falcon signatures
+ *
+ * Moves signature generation off the io thread, so the caller can continue
+ * (serialise the rest of the submission, receive the next packet) while the
+ * signature is computed. Requests are signed in order. One executor serves
+ * the sessions of all nodes, they sign with the same key.
+ */
+class Signing_executor {
+public:
+
+    /**
+     * @brief Called on the signing thread
+     * @param result Signature or error
+     * @param queue_time Time the request waited for the signing thread
+     */
+    using Handler = std::function<void(FalconSignatureWrapper::SignatureResult&& result,
+                                       std::chrono::microseconds queue_time)>;
+
+    /**
+     * @param falcon_wrapper Signer, shared with the sessions that sign on the io thread
+     */
+    explicit Signing_executor(std::shared_ptr<FalconSignatureWrapper> falcon_wrapper);
+
+    /**
+     * @brief Destructor - signs the queued requests and joins the thread
+     */
+    ~Signing_executor();
+
+    Signing_executor(const Signing_executor&) = delete;
+    Signing_executor& operator=(const Signing_executor&) = delete;
+
+    /**
+     * @brief Queue a message for signing, returns immediately
+     */
+    void sign(std::vector<uint8_t> message, FalconSignatureWrapper::SignatureType type, Handler handler);
+
+private:
+
+    struct Request {
+        std::vector<uint8_t> message;
+        FalconSignatureWrapper::SignatureType type;
+        Handler handler;
+        std::chrono::steady_clock::time_point queued;
+    };
+
+    void run();
+
+    std::shared_ptr<FalconSignatureWrapper> m_falcon_wrapper;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Request> m_requests;
+    bool m_stop;
+    std::thread m_thread;
+};
+
+} // namespace protocol
+} // namespace nexusminer
+
+#endif // NEXUSMINER_PROTOCOL_SIGNING_EXECUTOR_HPP
@@ -3,9 +3,11 @@
 
 #include "protocol/protocol.hpp"
 #include "protocol/falcon_wrapper.hpp"
+#include "protocol/signing_executor.hpp"
 #include "protocol/mining_template_interface.hpp"
 #include "spdlog/spdlog.h"
 #include <memory>
+#include <deque>
 
 namespace nexusminer {
 namespace network { class Connection; }
@@ -22,13 +24,18 @@ public:
     network::Shared_payload login(Login_handler handler) override;
     network::Shared_payload get_work() override;
     network::Shared_payload get_height();
-    network::Shared_payload submit_block(std::vector<std::uint8_t> const& block_data, std::uint64_t nonce) override;
+    // GET_BLOCK for the standby template, empty if prefetch is disabled or a prefetch is outstanding
+    network::Shared_payload prefetch_work() override;
+    network::Gather_payload submit_block(std::vector<std::uint8_t> const& block_data, std::uint64_t nonce) override;
+    // signs on the signing thread, the handler is called from there
+    void submit_block(std::vector<std::uint8_t> const& block_data, std::uint64_t nonce, Submit_handler handler) override;
     void set_block_handler(Set_block_handler handler) override { m_set_block_handler = std::move(handler); }
 
     void process_messages(Packet packet, std::shared_ptr<network::Connection> connection) override;
     
-    // Falcon miner authentication
-    void set_miner_keys(std::vector<uint8_t> const& pubkey, std::vector<uint8_t> const& privkey);
+    // Falcon miner authentication. The signer and its signing thread are shared by the sessions of all nodes
+    void set_signer(std::shared_ptr<FalconSignatureWrapper> falcon_wrapper,
+        std::shared_ptr<Signing_executor> signing_executor);
     bool is_authenticated() const { return m_authenticated; }
     void set_address(std::string const& address) { m_address = address; }
     
@@ -36,6 +43,10 @@ public:
     void enable_block_signing(bool enable) { m_block_signing_enabled = enable; }
     bool is_block_signing_enabled() const { return m_block_signing_enabled; }
     
+    // Template prefetch: keep a validated standby template so block transitions skip the GET_BLOCK round trip
+    void enable_template_prefetch(bool enable) { m_template_prefetch_enabled = enable; }
+    bool is_template_prefetch_enabled() const { return m_template_prefetch_enabled; }
+    
     // Session management (LLL-TAO PR #22)
     network::Shared_payload send_session_keepalive();
     std::uint32_t get_session_id() const { return m_session_id; }
@@ -46,9 +57,25 @@ public:
 
 private:
     
+    // Purpose of an outstanding GET_BLOCK, the node answers them in order
+    enum class Work_request { dispatch, prefetch };
+    
     // Helper method to send SET_CHANNEL packet
     void send_set_channel(std::shared_ptr<network::Connection> connection);
 
+    // SUBMIT_BLOCK: message to sign (merkle_root + nonce + timestamp), then the packet with the signature appended
+    bool prepare_submission(std::vector<std::uint8_t> const& block_data, std::uint64_t nonce,
+        std::vector<std::uint8_t>& message_to_sign);
+    // static, the signing thread finishes submissions of sessions that may be gone by then
+    static network::Gather_payload finish_submission(spdlog::logger& logger, FalconSignatureWrapper const& falcon_wrapper,
+        network::Shared_payload submission, FalconSignatureWrapper::SignatureResult const& sig_result,
+        std::uint32_t session_id);
+
+    // Prefetched BLOCK_DATA: keep as standby, or switch right away if the network moved to a new height
+    void process_prefetched_template(Packet const& packet, std::shared_ptr<network::Connection> connection);
+    // Swap the standby template in and hand it to the workers, false if there is none
+    bool dispatch_next_template(char const* reason);
+
     std::uint8_t m_channel;
     std::shared_ptr<spdlog::logger> m_logger;
     std::uint32_t m_current_height;
@@ -59,18 +86,22 @@ private:
     
     // Falcon miner authentication state (Phase 2)
     std::vector<uint8_t> m_miner_pubkey;
-    std::vector<uint8_t> m_miner_privkey;
     bool m_authenticated;
     std::uint32_t m_session_id;
     std::string m_address;  // Miner's network address for auth message
     std::uint64_t m_auth_timestamp;  // Timestamp for auth message
     
     // Unified Falcon Signature Wrapper (Phase 2 enhancement)
-    std::unique_ptr<FalconSignatureWrapper> m_falcon_wrapper;
+    std::shared_ptr<FalconSignatureWrapper> m_falcon_wrapper;
     bool m_block_signing_enabled;  // Optional block signing feature
     
     // Mining Template Interface for unified READ/FEED operations
     std::unique_ptr<MiningTemplateInterface> m_template_interface;
+    bool m_template_prefetch_enabled;
+    std::deque<Work_request> m_work_requests;  // Only tracked with prefetch enabled
+
+    // Block signatures off the io thread
+    std::shared_ptr<Signing_executor> m_signing_executor;
 };
 
 }
@@ -0,0 +1,750 @@
+//local stand-in for a Nexus node (solo) or pool speaking the LLP subset NexusMiner uses.
+//serves block templates with a configurable block interval and difficulty, delays and fragments its responses
+//and reports the protocol latencies of the connected miners. meant for load and latency tests over loopback,
+//it does not validate Falcon signatures or proof of work.
+
+#include <string>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
+#include <random>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <map>
+#include <optional>
+#include <array>
+#include <algorithm>
+#include <csignal>
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <nlohmann/json.hpp>
+#include "asio/io_context.hpp"
+#include "asio/signal_set.hpp"
+#include "network/create_component.hpp"
+#include "network/socket.hpp"
+#include "timer_factory.hpp"
+#include "packet.hpp"
+#include "packet_framer.hpp"
+#include "utils.hpp"
+#include "stats/latency_histogram.hpp"
+
+namespace nexusminer {
+namespace protocol
+{
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using Merkle_root = std::array<std::uint8_t, 32>;
+
+    struct Simulator_options
+    {
+        std::uint16_t m_port = 8323;
+        bool m_pool = false;
+        std::uint32_t m_channel = 2;
+        std::uint32_t m_nbits = 0;      // 0 = channel default
+        std::uint32_t m_start_height = 100000;
+        chrono::Milliseconds m_block_interval{ 30000 };
+        chrono::Milliseconds m_latency{ 0 };
+        std::size_t m_fragment_size = 0;    // 0 = packets are sent in one piece
+        chrono::Milliseconds m_fragment_delay{ 0 };
+        chrono::Seconds m_report_interval{ 10 };
+        bool m_new_block_on_accept = true;
+    };
+
+    //hash channel: 20 leading zero bits, a cpu worker finds a block within seconds. prime channel: difficulty 3
+    std::uint32_t default_nbits(std::uint32_t channel)
+    {
+        return channel == 1 ? 0x01c9c380 : 0x7e0fffff;
+    }
+
+    void show_usage(std::string const& name)
+    {
+        std::cerr << "Usage: " << name << " <option(s)>\n"
+                  << "Options:\n"
+                  << "\t-h,--help\t\t\tShow this help message\n"
+                  << "\t--port N\t\t\tListen port (default 8323)\n"
+                  << "\t--pool\t\t\t\tSpeak the pool protocol (LOGIN/WORK) instead of the solo protocol\n"
+                  << "\t--channel 1|2\t\t\tChannel of the pool templates, solo uses the channel the miner sets (default 2)\n"
+                  << "\t--nbits HEX\t\t\tDifficulty of the templates (default 7e0fffff hash, 01c9c380 prime)\n"
+                  << "\t--height N\t\t\tInitial block height (default 100000)\n"
+                  << "\t--block-interval MS\t\tTime between new blocks, 0 = only on accepted blocks (default 30000)\n"
+                  << "\t--keep-block-on-accept\t\tDon't start a new block when a submitted block is accepted\n"
+                  << "\t--latency MS\t\t\tDelay of every response and notification (default 0)\n"
+                  << "\t--fragment N\t\t\tSplit every packet into writes of at most N bytes (default 0 = off)\n"
+                  << "\t--fragment-delay MS\t\tDelay between the fragments of a packet (default 0)\n"
+                  << "\t--report-interval S\t\tSeconds between latency reports (default 10)\n"
+                  << "\t--verbose\t\t\tLog every packet"
+                  << std::endl;
+    }
+
+    class Simulator;
+
+    //one miner connection
+    class Session : public std::enable_shared_from_this<Session>
+    {
+    public:
+
+        Session(Simulator& simulator, std::uint32_t id, network::Connection::Sptr connection);
+
+        void process(Packet packet);
+        void notify_new_block();
+        void close() { m_connection->close(); }
+        void append(network::Payload const& data) { m_framer.append(data); }
+        bool next(Packet& packet) { return m_framer.next(packet) == Packet_framer::Result::packet; }
+
+        std::uint32_t id() const { return m_id; }
+
+    private:
+
+        struct Issued_template
+        {
+            std::uint32_t m_height;
+            Clock::time_point m_sent;
+            bool m_submitted;
+        };
+
+        struct Outbound
+        {
+            Clock::time_point m_due;
+            network::Shared_payload m_data;
+        };
+
+        void send(Packet const& packet);
+        void send_due();
+        void send_template();
+        void submit_block(Packet const& packet);
+        network::Payload build_header(Merkle_root const& merkle_root) const;
+
+        Simulator& m_simulator;
+        std::uint32_t m_id;
+        network::Connection::Sptr m_connection;
+        Packet_framer m_framer;
+        chrono::Timer::Uptr m_send_timer;
+        std::deque<Outbound> m_outbound;
+        std::shared_ptr<spdlog::logger> m_logger;
+
+        bool m_authenticated;
+        bool m_logged_in;
+        std::uint32_t m_channel;
+        std::uint32_t m_work_id;
+        std::map<Merkle_root, Issued_template> m_templates;
+        Merkle_root m_last_template;
+        std::optional<Clock::time_point> m_block_notified;
+    };
+
+    class Simulator
+    {
+    public:
+
+        Simulator(std::shared_ptr<::asio::io_context> io_context, Simulator_options options)
+            : m_io_context{ std::move(io_context) }
+            , m_options{ std::move(options) }
+            , m_logger{ spdlog::get("logger") }
+            , m_timer_factory{ std::make_shared<chrono::Timer_factory>(m_io_context) }
+            , m_block_timer{ m_timer_factory->create_timer() }
+            , m_report_timer{ m_timer_factory->create_timer() }
+            , m_random{ std::random_device{}() }
+            , m_height{ m_options.m_start_height }
+            , m_next_session_id{ 1 }
+        {
+            m_prev_hash = random_bytes();
+        }
+
+        bool start()
+        {
+            m_network_component = network::create_component(m_io_context);
+            network::Endpoint local_endpoint{ network::Transport_protocol::tcp, "127.0.0.1", m_options.m_port };
+            m_socket = m_network_component->get_socket_factory()->create_socket(local_endpoint);
+            if (!m_socket || m_socket->listen([this](network::Connection::Sptr&& connection) { return accept(std::move(connection)); })
+                != network::Result::socket_ok)
+            {
+                m_logger->error("Failed to listen on 127.0.0.1:{}", m_options.m_port);
+                return false;
+            }
+
+            m_logger->info("{} simulator listening on 127.0.0.1:{}, height {}, block interval {} ms, latency {} ms, fragment {} bytes",
+                m_options.m_pool ? "Pool" : "Solo node", m_options.m_port, m_height, m_options.m_block_interval.count(),
+                m_options.m_latency.count(), m_options.m_fragment_size);
+            m_started = Clock::now();
+            start_block_timer();
+            start_report_timer();
+            return true;
+        }
+
+        void stop()
+        {
+            m_block_timer->cancel();
+            m_report_timer->cancel();
+            if (m_socket)
+            {
+                m_socket->stop_listen();
+            }
+            for (auto& session : m_sessions)
+            {
+                session.second->close();
+            }
+            m_sessions.clear();
+            print_report();
+        }
+
+        //new height, announced to every connected miner
+        void new_block(std::string const& reason)
+        {
+            ++m_height;
+            m_prev_hash = random_bytes();
+            ++m_blocks;
+            m_logger->info("New block {} ({})", m_height, reason);
+            for (auto& session : m_sessions)
+            {
+                session.second->notify_new_block();
+            }
+            start_block_timer();
+        }
+
+        Merkle_root random_merkle_root()
+        {
+            Merkle_root merkle_root;
+            auto const bytes = random_bytes();
+            std::copy(bytes.begin(), bytes.end(), merkle_root.begin());
+            merkle_root[0] |= 0x01;     // miners refuse an all zero merkle root
+            return merkle_root;
+        }
+
+        std::uint32_t next_session_id() { return m_next_session_id++; }
+
+        Simulator_options const& options() const { return m_options; }
+        std::uint32_t height() const { return m_height; }
+        std::vector<std::uint8_t> const& prev_hash() const { return m_prev_hash; }
+        chrono::Timer_factory& timer_factory() { return *m_timer_factory; }
+
+        // block notification (BLOCK_HEIGHT push or WORK) to the GET_BLOCK of the miner
+        stats::Latency_histogram m_notify_to_request;
+        // template sent to the first submission on it
+        stats::Latency_histogram m_template_to_submit;
+        std::uint64_t m_templates_sent{ 0 };
+        std::uint64_t m_accepted{ 0 };
+        std::uint64_t m_rejected{ 0 };
+        std::uint64_t m_stale{ 0 };
+        std::uint64_t m_bytes_sent{ 0 };
+        std::uint64_t m_bytes_received{ 0 };
+        std::uint64_t m_fragments_sent{ 0 };
+
+    private:
+
+        network::Connection::Handler accept(network::Connection::Sptr&& connection)
+        {
+            auto const id = m_next_connection_id++;
+            auto session = std::make_shared<Session>(*this, id, std::move(connection));
+            m_sessions.emplace(id, session);
+
+            std::weak_ptr<Session> weak_session = session;
+            return [this, weak_session, id](network::Result::Code result, network::Shared_payload&& receive_buffer)
+            {
+                auto session = weak_session.lock();
+                if (!session)
+                {
+                    return;
+                }
+
+                if (result == network::Result::connection_ok)
+                {
+                    m_logger->info("Miner {} connected", id);
+                }
+                else if (result == network::Result::receive_ok && receive_buffer)
+                {
+                    m_bytes_received += receive_buffer->size();
+                    session->append(*receive_buffer);
+                    Packet packet;
+                    while (session->next(packet))
+                    {
+                        session->process(std::move(packet));
+                    }
+                }
+                else if (network::Result::is_error(result))
+                {
+                    m_logger->info("Miner {} disconnected ({})", id, network::Result::code_to_string(result));
+                    m_sessions.erase(id);
+                }
+            };
+        }
+
+        void start_block_timer()
+        {
+            if (m_options.m_block_interval.count() == 0)
+            {
+                return;
+            }
+
+            m_block_timer->start(m_options.m_block_interval, [this](bool canceled)
+            {
+                if (!canceled)
+                {
+                    new_block("block interval");
+                }
+            });
+        }
+
+        void start_report_timer()
+        {
+            m_report_timer->start(m_options.m_report_interval, [this](bool canceled)
+            {
+                if (canceled)
+                {
+                    return;
+                }
+                print_report();
+                start_report_timer();
+            });
+        }
+
+        void print_report() const
+        {
+            auto const elapsed = std::chrono::duration_cast<std::chrono::seconds>(Clock::now() - m_started);
+            std::stringstream ss;
+            ss << std::fixed << std::setprecision(3);
+            ss << "Simulator report after " << elapsed.count() << "s: " << m_sessions.size() << " miners, "
+               << m_blocks << " new blocks, " << m_templates_sent << " templates, " << m_accepted << " accepted, "
+               << m_rejected << " rejected (" << m_stale << " stale), " << m_bytes_received << " bytes received, "
+               << m_bytes_sent << " bytes sent in " << m_fragments_sent << " writes\n";
+            print_histogram(ss, "Block notification to GET_BLOCK", m_notify_to_request);
+            print_histogram(ss, "Template to first submission", m_template_to_submit);
+            m_logger->info(ss.str());
+        }
+
+        static void print_histogram(std::stringstream& ss, std::string const& name, stats::Latency_histogram const& histogram)
+        {
+            ss << "  " << std::left << std::setw(34) << name << std::right << histogram.count() << " samples";
+            if (histogram.count() > 0)
+            {
+                ss << ", avg " << histogram.average().count() / 1000.0 << " ms, p50 <= "
+                   << histogram.percentile(0.5).count() / 1000.0 << " ms, p99 <= "
+                   << histogram.percentile(0.99).count() / 1000.0 << " ms, max " << histogram.max().count() / 1000.0 << " ms";
+            }
+            ss << "\n";
+        }
+
+        std::vector<std::uint8_t> random_bytes()
+        {
+            std::vector<std::uint8_t> bytes(32);
+            std::uniform_int_distribution<int> distribution{ 0, 255 };
+            for (auto& byte : bytes)
+            {
+                byte = static_cast<std::uint8_t>(distribution(m_random));
+            }
+            return bytes;
+        }
+
+        std::shared_ptr<::asio::io_context> m_io_context;
+        Simulator_options m_options;
+        std::shared_ptr<spdlog::logger> m_logger;
+        std::shared_ptr<chrono::Timer_factory> m_timer_factory;
+        chrono::Timer::Uptr m_block_timer;
+        chrono::Timer::Uptr m_report_timer;
+        network::Component::Uptr m_network_component;
+        network::Socket::Sptr m_socket;
+        std::map<std::uint32_t, std::shared_ptr<Session>> m_sessions;
+        std::mt19937 m_random;
+        std::uint32_t m_height;
+        std::vector<std::uint8_t> m_prev_hash;
+        std::uint32_t m_next_session_id;
+        std::uint32_t m_next_connection_id{ 1 };
+        std::uint64_t m_blocks{ 0 };
+        Clock::time_point m_started;
+    };
+
+    Session::Session(Simulator& simulator, std::uint32_t id, network::Connection::Sptr connection)
+        : m_simulator{ simulator }
+        , m_id{ id }
+        , m_connection{ std::move(connection) }
+        , m_framer{}
+        , m_send_timer{ simulator.timer_factory().create_timer() }
+        , m_logger{ spdlog::get("logger") }
+        , m_authenticated{ false }
+        , m_logged_in{ false }
+        , m_channel{ simulator.options().m_channel }
+        , m_work_id{ 0 }
+        , m_last_template{}
+    {
+    }
+
+    void Session::process(Packet packet)
+    {
+        m_logger->debug("Miner {}: received {} ({} bytes)", m_id, get_packet_header_name(packet.m_header), packet.m_length);
+
+        switch (packet.m_header)
+        {
+        case Packet::MINER_AUTH_INIT:
+        {
+            auto const challenge = m_simulator.random_merkle_root();
+            send(Packet{ Packet::MINER_AUTH_CHALLENGE, network::Payload(challenge.begin(), challenge.end()) });
+            break;
+        }
+        case Packet::MINER_AUTH_RESPONSE:
+        {
+            // [pubkey_len(2)][pubkey][timestamp(8)][sig_len(2)][sig], the signature is not verified
+            auto const pubkey_length = packet.m_length >= 2 ? (packet.m_data[0] | (packet.m_data[1] << 8)) : 0;
+            if (pubkey_length == 0 || packet.m_length < 2U + pubkey_length + 10U)
+            {
+                m_logger->warn("Miner {}: malformed MINER_AUTH_RESPONSE ({} bytes)", m_id, packet.m_length);
+                send(Packet{ Packet::MINER_AUTH_RESULT, network::Payload{ 0x00 } });
+                break;
+            }
+
+            m_authenticated = true;
+            auto const session_id = m_simulator.next_session_id();
+            send(Packet{ Packet::MINER_AUTH_RESULT, network::Payload{ 0x01,
+                static_cast<std::uint8_t>(session_id), static_cast<std::uint8_t>(session_id >> 8),
+                static_cast<std::uint8_t>(session_id >> 16), static_cast<std::uint8_t>(session_id >> 24) } });
+            m_logger->info("Miner {}: authenticated, session 0x{:08x}", m_id, session_id);
+            break;
+        }
+        case Packet::SESSION_KEEPALIVE:
+        {
+            // remaining session timeout in seconds (LE)
+            send(Packet{ Packet::SESSION_KEEPALIVE, network::Payload{ 0x2c, 0x01, 0x00, 0x00 } });
+            break;
+        }
+        case Packet::SET_CHANNEL:
+        {
+            if (!packet.m_data.empty())
+            {
+                m_channel = packet.m_data[0];
+            }
+            send(Packet{ Packet::CHANNEL_ACK, network::Payload{ static_cast<std::uint8_t>(m_channel) } });
+            break;
+        }
+        case Packet::LOGIN:
+        {
+            m_logged_in = true;
+            std::string const result{ "{\"result_code\":0}" };
+            send(Packet{ Packet::LOGIN_V2_SUCCESS, network::Payload(result.begin(), result.end()) });
+            break;
+        }
+        case Packet::GET_HEIGHT:
+        {
+            send(Packet{ Packet::BLOCK_HEIGHT, uint2bytes(m_simulator.height()) });
+            break;
+        }
+        case Packet::GET_REWARD:
+        {
+            send(Packet{ Packet::BLOCK_REWARD, uint2bytes64(2500000000ULL) });
+            break;
+        }
+        case Packet::GET_BLOCK:
+        {
+            if (m_block_notified)
+            {
+                m_simulator.m_notify_to_request.record(
+                    std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - *m_block_notified));
+                m_block_notified.reset();
+            }
+            send_template();
+            break;
+        }
+        case Packet::SUBMIT_BLOCK:
+        {
+            submit_block(packet);
+            break;
+        }
+        case Packet::HASHRATE:
+        {
+            if (packet.m_length >= 8)
+            {
+                m_logger->info("Miner {}: reported hashrate {:.3f}", m_id, bytes2double(packet.m_data.to_payload()));
+            }
+            break;
+        }
+        case Packet::PING:
+            break;
+        default:
+            m_logger->debug("Miner {}: ignored {}", m_id, get_packet_header_name(packet.m_header));
+            break;
+        }
+    }
+
+    void Session::notify_new_block()
+    {
+        if (m_simulator.options().m_pool)
+        {
+            // pools push the work of the new block
+            if (m_logged_in)
+            {
+                send_template();
+            }
+            return;
+        }
+
+        if (!m_authenticated)
+        {
+            return;
+        }
+        m_block_notified = Clock::now();
+        send(Packet{ Packet::BLOCK_HEIGHT, uint2bytes(m_simulator.height()) });
+    }
+
+    network::Payload Session::build_header(Merkle_root const& merkle_root) const
+    {
+        auto const nbits = m_simulator.options().m_nbits != 0 ? m_simulator.options().m_nbits : default_nbits(m_channel);
+        auto const time = static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+        // 92 byte compact header, big-endian fields
+        network::Payload header;
+        header.reserve(92);
+        auto append = [&header](std::vector<std::uint8_t> const& bytes) { header.insert(header.end(), bytes.begin(), bytes.end()); };
+        append(uint2bytes(5));      // nVersion
+        append(m_simulator.prev_hash());
+        header.insert(header.end(), merkle_root.begin(), merkle_root.end());
+        append(uint2bytes(m_channel));
+        append(uint2bytes(m_simulator.height()));
+        append(uint2bytes(nbits));
+        header.insert(header.end(), 8, 0);     // nNonce
+        append(uint2bytes(time));
+        return header;
+    }
+
+    void Session::send_template()
+    {
+        if (!m_simulator.options().m_pool && !m_authenticated)
+        {
+            m_logger->warn("Miner {}: GET_BLOCK before authentication", m_id);
+            return;
+        }
+
+        // forget templates of old blocks, submissions on them are stale anyway
+        auto const height = m_simulator.height();
+        for (auto it = m_templates.begin(); it != m_templates.end();)
+        {
+            it = it->second.m_height + 2 < height ? m_templates.erase(it) : std::next(it);
+        }
+
+        auto const merkle_root = m_simulator.random_merkle_root();
+        auto header = build_header(merkle_root);
+        m_templates[merkle_root] = Issued_template{ height, Clock::now(), false };
+        m_last_template = merkle_root;
+        ++m_simulator.m_templates_sent;
+
+        if (!m_simulator.options().m_pool)
+        {
+            send(Packet{ Packet::BLOCK_DATA, std::move(header) });
+            return;
+        }
+
+        // pool work: nBits followed by the header
+        auto const nbits = m_simulator.options().m_nbits != 0 ? m_simulator.options().m_nbits : default_nbits(m_channel);
+        network::Payload block_bytes = uint2bytes(nbits);
+        block_bytes.insert(block_bytes.end(), header.begin(), header.end());
+        nlohmann::json j;
+        j["work_id"] = ++m_work_id;
+        j["block"]["bytes"] = block_bytes;
+        auto const j_string = j.dump();
+        send(Packet{ Packet::WORK, network::Payload(j_string.begin(), j_string.end()) });
+    }
+
+    void Session::submit_block(Packet const& packet)
+    {
+        auto const received = Clock::now();
+        auto it = m_templates.end();
+        if (m_simulator.options().m_pool)
+        {
+            // the miner doesn't fill in the work id yet, shares count against the latest work
+            it = m_templates.find(m_last_template);
+        }
+        else if (packet.m_length >= 32)
+        {
+            // [merkle_root(64)][nonce(8)][timestamp(8)][sig_len(2)][signature], the leading bytes are the template merkle root
+            Merkle_root merkle_root;
+            std::copy(packet.m_data.begin(), packet.m_data.begin() + merkle_root.size(), merkle_root.begin());
+            it = m_templates.find(merkle_root);
+        }
+
+        if (it == m_templates.end() || it->second.m_height != m_simulator.height())
+        {
+            if (it != m_templates.end())
+            {
+                ++m_simulator.m_stale;
+            }
+            ++m_simulator.m_rejected;
+            m_logger->info("Miner {}: block rejected ({})", m_id, it == m_templates.end() ? "unknown template" : "stale");
+            send(Packet{ Packet::REJECT });
+            return;
+        }
+
+        if (!it->second.m_submitted)
+        {
+            it->second.m_submitted = true;
+            m_simulator.m_template_to_submit.record(
+                std::chrono::duration_cast<std::chrono::microseconds>(received - it->second.m_sent));
+        }
+        ++m_simulator.m_accepted;
+        m_logger->info("Miner {}: block accepted at height {}", m_id, it->second.m_height);
+        send(Packet{ m_simulator.options().m_pool ? static_cast<std::uint8_t>(Packet::ACCEPT) : static_cast<std::uint8_t>(Packet::BLOCK_ACCEPTED) });
+
+        if (m_simulator.options().m_new_block_on_accept && !m_simulator.options().m_pool)
+        {
+            m_simulator.new_block("block accepted");
+        }
+    }
+
+    void Session::send(Packet const& packet)
+    {
+        auto bytes = packet.get_bytes();
+        if (!bytes)
+        {
+            m_logger->error("Miner {}: failed to encode {}", m_id, get_packet_header_name(packet.m_header));
+            return;
+        }
+        m_logger->debug("Miner {}: sending {} ({} bytes)", m_id, get_packet_header_name(packet.m_header), bytes->size());
+
+        auto const& options = m_simulator.options();
+        auto due = Clock::now() + options.m_latency;
+        if (!m_outbound.empty())
+        {
+            // keep the packet order, a packet never overtakes the fragments of the previous one
+            due = std::max(due, m_outbound.back().m_due);
+        }
+
+        auto const fragment_size = options.m_fragment_size == 0 ? bytes->size() : options.m_fragment_size;
+        for (std::size_t offset = 0; offset < bytes->size(); offset += fragment_size)
+        {
+            auto const size = std::min(fragment_size, bytes->size() - offset);
+            auto fragment = std::make_shared<network::Payload>(bytes->begin() + offset, bytes->begin() + offset + size);
+            m_outbound.push_back(Outbound{ due, std::move(fragment) });
+            due += options.m_fragment_delay;
+        }
+        send_due();
+    }
+
+    void Session::send_due()
+    {
+        auto const now = Clock::now();
+        while (!m_outbound.empty() && m_outbound.front().m_due <= now)
+        {
+            m_simulator.m_bytes_sent += m_outbound.front().m_data->size();
+            ++m_simulator.m_fragments_sent;
+            m_connection->transmit(std::move(m_outbound.front().m_data));
+            m_outbound.pop_front();
+        }
+
+        if (m_outbound.empty())
+        {
+            return;
+        }
+
+        auto const wait = std::chrono::duration_cast<chrono::Milliseconds>(m_outbound.front().m_due - now) + chrono::Milliseconds{ 1 };
+        std::weak_ptr<Session> weak_self = shared_from_this();
+        m_send_timer->start(wait, [weak_self](bool canceled)
+        {
+            auto self = weak_self.lock();
+            if (!canceled && self)
+            {
+                self->send_due();
+            }
+        });
+    }
+}
+}
+}
+
+int main(int argc, char** argv)
+{
+    using namespace nexusminer;
+    using namespace nexusminer::protocol;
+
+    Simulator_options options;
+    bool verbose = false;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            bool const has_value = i + 1 < argc;
+            if ((arg == "-h") || (arg == "--help"))
+            {
+                show_usage(argv[0]);
+                return 0;
+            }
+            else if (arg == "--port" && has_value)
+            {
+                options.m_port = static_cast<std::uint16_t>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--pool")
+            {
+                options.m_pool = true;
+            }
+            else if (arg == "--channel" && has_value)
+            {
+                options.m_channel = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--nbits" && has_value)
+            {
+                options.m_nbits = static_cast<std::uint32_t>(std::stoul(argv[++i], nullptr, 16));
+            }
+            else if (arg == "--height" && has_value)
+            {
+                options.m_start_height = static_cast<std::uint32_t>(std::stoul(argv[++i]));
+            }
+            else if (arg == "--block-interval" && has_value)
+            {
+                options.m_block_interval = chrono::Milliseconds{ std::stoul(argv[++i]) };
+            }
+            else if (arg == "--keep-block-on-accept")
+            {
+                options.m_new_block_on_accept = false;
+            }
+            else if (arg == "--latency" && has_value)
+            {
+                options.m_latency = chrono::Milliseconds{ std::stoul(argv[++i]) };
+            }
+            else if (arg == "--fragment" && has_value)
+            {
+                options.m_fragment_size = std::stoul(argv[++i]);
+            }
+            else if (arg == "--fragment-delay" && has_value)
+            {
+                options.m_fragment_delay = chrono::Milliseconds{ std::stoul(argv[++i]) };
+            }
+            else if (arg == "--report-interval" && has_value)
+            {
+                options.m_report_interval = chrono::Seconds{ std::max(1UL, std::stoul(argv[++i])) };
+            }
+            else if (arg == "--verbose")
+            {
+                verbose = true;
+            }
+            else
+            {
+                show_usage(argv[0]);
+                return -1;
+            }
+        }
+    }
+    catch (std::exception const& e)
+    {
+        std::cerr << "Invalid option value: " << e.what() << std::endl;
+        show_usage(argv[0]);
+        return -1;
+    }
+
+    auto logger = spdlog::stdout_color_mt("logger");
+    logger->set_level(verbose ? spdlog::level::debug : spdlog::level::info);
+
+    auto io_context = std::make_shared<::asio::io_context>();
+    Simulator simulator{ io_context, options };
+    if (!simulator.start())
+    {
+        return -1;
+    }
+
+    ::asio::signal_set signals{ *io_context, SIGINT, SIGTERM };
+    signals.async_wait([&simulator, io_context](auto, auto)
+    {
+        simulator.stop();
+        io_context->stop();
+    });
+
+    io_context->run();
+    return 0;
+}
@@ -8,9 +8,10 @@ namespace nexusminer {
 namespace protocol {
 
 FalconSignatureWrapper::FalconSignatureWrapper(const std::vector<uint8_t>& pubkey,
-                                              const std::vector<uint8_t>& privkey)
+                                              const LLC::CPrivKey& privkey,
+                                              bool expand_key)
     : m_pubkey(pubkey)
-    , m_privkey(privkey)
+    , m_privkey_size(privkey.size())
     , m_initialized(false)
     , m_logger(spdlog::get("logger"))
     , m_total_signatures(0)
@@ -25,37 +26,36 @@ FalconSignatureWrapper::FalconSignatureWrapper(const std::vector<uint8_t>& pubke
     
     // Validate keys on construction
     if (validate_keys()) {
+        m_signer = std::make_unique<keys::Falcon_signer>(privkey, expand_key);
+    }
+    
+    if (m_signer && m_signer->is_valid()) {
         m_initialized = true;
         m_logger->info("[FalconWrapper] Initialized successfully");
         m_logger->debug("[FalconWrapper]   - Public key: {} bytes", m_pubkey.size());
-        m_logger->debug("[FalconWrapper]   - Private key: {} bytes", m_privkey.size());
+        m_logger->debug("[FalconWrapper]   - Private key: {} bytes", m_privkey_size);
+        if (m_signer->is_expanded()) {
+            m_logger->info("[FalconWrapper] Private key expanded in locked memory ({} us), signing with the expanded key",
+                m_signer->get_expansion_time().count());
+        }
+    } else if (m_signer) {
+        m_logger->error("[FalconWrapper] Initialization failed - signer could not be set up");
     } else {
         m_logger->error("[FalconWrapper] Initialization failed - invalid key sizes");
         m_logger->error("[FalconWrapper]   - Expected pubkey: {} bytes, got: {}", 
                        FalconConstants::FALCON512_PUBKEY_SIZE, m_pubkey.size());
         m_logger->error("[FalconWrapper]   - Expected privkey: {} bytes, got: {}", 
-                       FalconConstants::FALCON512_PRIVKEY_SIZE, m_privkey.size());
+                       FalconConstants::FALCON512_PRIVKEY_SIZE, m_privkey_size);
     }
 }
 
-FalconSignatureWrapper::~FalconSignatureWrapper()
-{
-    // Securely clear private key from memory
-    // Use volatile pointer to prevent compiler optimization
-    if (!m_privkey.empty()) {
-        volatile uint8_t* vptr = m_privkey.data();
-        for (size_t i = 0; i < m_privkey.size(); ++i) {
-            vptr[i] = 0;
-        }
-        m_logger->debug("[FalconWrapper] Private key securely cleared from memory");
-    }
-}
+FalconSignatureWrapper::~FalconSignatureWrapper() = default;
 
 bool FalconSignatureWrapper::validate_keys() const
 {
     // Use shared constants from falcon_constants.hpp
     return (m_pubkey.size() == FalconConstants::FALCON512_PUBKEY_SIZE) && 
-           (m_privkey.size() == FalconConstants::FALCON512_PRIVKEY_SIZE);
+           (m_privkey_size == FalconConstants::FALCON512_PRIVKEY_SIZE);
 }
 
 FalconSignatureWrapper::SignatureResult 
@@ -217,23 +217,28 @@ FalconSignatureWrapper::sign_internal(const std::vector<uint8_t>& data,
         return result;
     }
     
-    // Validate private key is still available
-    if (m_privkey.empty()) {
-        result.error_message = "Private key is empty";
-        m_logger->error("[FalconWrapper] SYNC_ERROR: Private key was cleared or never set");
+    // Validate the signer holds the private key
+    if (!m_initialized) {
+        result.error_message = "Signer is not initialized";
+        m_logger->error("[FalconWrapper] SYNC_ERROR: Private key was never set");
         return result;
     }
     
     // Enhanced diagnostics: Log key status before signing
-    m_logger->debug("[FalconWrapper] SYNC_STATE: Private key size: {} bytes", m_privkey.size());
+    m_logger->debug("[FalconWrapper] SYNC_STATE: Private key size: {} bytes", m_privkey_size);
     
     // Use the miner_keys module for actual signature generation
-    if (!keys::falcon_sign(m_privkey, data, result.signature)) {
+    bool signed_ok = false;
+    {
+        std::lock_guard<std::mutex> lock(m_signer_mutex);
+        signed_ok = m_signer && m_signer->sign(data, result.signature);
+    }
+    if (!signed_ok) {
         result.error_message = "Falcon signature generation failed";
         result.success = false;
-        m_logger->error("[FalconWrapper] SYNC_ERROR: falcon_sign() returned false");
+        m_logger->error("[FalconWrapper] SYNC_ERROR: Falcon_signer::sign() returned false");
         m_logger->error("[FalconWrapper]   - Input data size: {} bytes", data.size());
-        m_logger->error("[FalconWrapper]   - Private key size: {} bytes", m_privkey.size());
+        m_logger->error("[FalconWrapper]   - Private key size: {} bytes", m_privkey_size);
     } else {
         result.success = true;
         m_total_signatures.fetch_add(1, std::memory_order_relaxed);
@@ -260,6 +265,8 @@ FalconSignatureWrapper::PerformanceStats FalconSignatureWrapper::get_stats() con
     stats.average_time_microseconds = stats.total_signatures > 0 
         ? stats.total_time_microseconds / stats.total_signatures 
         : 0;
+    stats.expanded_key = m_signer && m_signer->is_expanded();
+    stats.key_expansion_time_microseconds = m_signer ? m_signer->get_expansion_time().count() : 0;
     
     return stats;
 }
@@ -1,9 +1,11 @@
 #include "protocol/mining_template_interface.hpp"
 #include "LLP/block_utils.hpp"
+#include "stats/event_trace.hpp"
 #include <chrono>
 #include <cstring>
 #include <sstream>
 #include <iomanip>
+#include <utility>
 
 namespace nexusminer {
 namespace protocol {
@@ -19,6 +21,8 @@ MiningTemplateInterface::MiningTemplateInterface(uint8_t channel, uint32_t sessi
     , m_templates_rejected(0)
     , m_templates_stale(0)
     , m_templates_fed(0)
+    , m_templates_prefetched(0)
+    , m_templates_promoted(0)
     , m_blocks_verified(0)
     , m_blocks_submitted(0)
     , m_total_read_time_us(0)
@@ -32,6 +36,9 @@ MiningTemplateInterface::MiningTemplateInterface(uint8_t channel, uint32_t sessi
     m_current_template.state = TemplateState::EMPTY;
     m_current_template.session_id = session_id;
     m_current_template.timestamp_received = 0;
+    m_next_template.state = TemplateState::EMPTY;
+    m_next_template.session_id = session_id;
+    m_next_template.timestamp_received = 0;
     
     // Validate channel
     if (m_channel != 1 && m_channel != 2) {
@@ -51,8 +58,51 @@ MiningTemplateInterface::~MiningTemplateInterface()
 }
 
 MiningTemplateInterface::ValidationResult 
-MiningTemplateInterface::read_template(const network::Payload& data,
+MiningTemplateInterface::read_template(network::Payload_slice const& data,
                                         const std::string& source_endpoint)
+{
+    stats::Trace_span span{"read_template", "protocol", "bytes", data.size()};
+    MiningTemplate tmpl;
+    auto result = parse_and_validate(data, source_endpoint, tmpl);
+    
+    if (result.is_valid) {
+        m_current_template = tmpl;
+        m_current_height = tmpl.block.nHeight;
+        m_templates_validated.fetch_add(1, std::memory_order_relaxed);
+        
+        m_logger->info("[TemplateInterface] READ SUCCESS: Template validated for height {} (channel: {}, nBits: 0x{:08x})",
+            tmpl.block.nHeight, tmpl.block.nChannel, tmpl.nBits);
+        
+        // Auto-feed to registered handlers
+        feed_current_template();
+    }
+    
+    return result;
+}
+
+MiningTemplateInterface::ValidationResult 
+MiningTemplateInterface::read_next_template(network::Payload_slice const& data,
+                                             const std::string& source_endpoint)
+{
+    MiningTemplate tmpl;
+    auto result = parse_and_validate(data, source_endpoint, tmpl);
+    
+    if (result.is_valid) {
+        m_next_template = tmpl;
+        m_templates_validated.fetch_add(1, std::memory_order_relaxed);
+        m_templates_prefetched.fetch_add(1, std::memory_order_relaxed);
+        
+        m_logger->debug("[TemplateInterface] PREFETCH: Standby template validated for height {} (nBits: 0x{:08x})",
+            tmpl.block.nHeight, tmpl.nBits);
+    }
+    
+    return result;
+}
+
+MiningTemplateInterface::ValidationResult 
+MiningTemplateInterface::parse_and_validate(network::Payload_slice const& data,
+                                             const std::string& source_endpoint,
+                                             MiningTemplate& tmpl)
 {
     auto start_time = std::chrono::high_resolution_clock::now();
     
@@ -70,7 +120,6 @@ MiningTemplateInterface::read_template(const network::Payload& data,
         data.size(), source_endpoint.empty() ? "unknown" : source_endpoint);
     
     // Parse the block header
-    MiningTemplate tmpl;
     tmpl.state = TemplateState::PENDING;
     tmpl.session_id = m_session_id;
     tmpl.source_endpoint = source_endpoint;
@@ -101,15 +150,6 @@ MiningTemplateInterface::read_template(const network::Payload& data,
     
     if (result.is_valid) {
         tmpl.state = TemplateState::VALIDATED;
-        m_current_template = tmpl;
-        m_current_height = tmpl.block.nHeight;
-        m_templates_validated.fetch_add(1, std::memory_order_relaxed);
-        
-        m_logger->info("[TemplateInterface] READ SUCCESS: Template validated for height {} (channel: {}, nBits: 0x{:08x})",
-            tmpl.block.nHeight, tmpl.block.nChannel, tmpl.nBits);
-        
-        // Auto-feed to registered handlers
-        feed_current_template();
     } else {
         m_templates_rejected.fetch_add(1, std::memory_order_relaxed);
         m_logger->warn("[TemplateInterface] READ FAILED: {}", result.error_message);
@@ -133,7 +173,7 @@ MiningTemplateInterface::read_template(network::Shared_payload data,
         result.error_message = "Empty or null template data";
         return result;
     }
-    return read_template(*data, source_endpoint);
+    return read_template(network::Payload_slice{ std::move(data) }, source_endpoint);
 }
 
 bool MiningTemplateInterface::has_valid_template() const
@@ -151,6 +191,43 @@ MiningTemplateInterface::get_current_template() const
     return nullptr;
 }
 
+const MiningTemplateInterface::MiningTemplate* 
+MiningTemplateInterface::get_next_template() const
+{
+    if (m_next_template.state == TemplateState::VALIDATED) {
+        return &m_next_template;
+    }
+    return nullptr;
+}
+
+bool MiningTemplateInterface::promote_next_template()
+{
+    if (!get_next_template()) {
+        return false;
+    }
+    
+    // Swap instead of copy, the standby slot ends up with the old template which is dropped below
+    std::swap(m_current_template, m_next_template);
+    m_current_height = m_current_template.block.nHeight;
+    m_next_template.state = TemplateState::EMPTY;
+    m_templates_promoted.fetch_add(1, std::memory_order_relaxed);
+    
+    m_logger->info("[TemplateInterface] PREFETCH: Standby template promoted for height {} (nBits: 0x{:08x})",
+        m_current_template.block.nHeight, m_current_template.nBits);
+    
+    // Auto-feed to registered handlers
+    feed_current_template();
+    return true;
+}
+
+void MiningTemplateInterface::discard_next_template()
+{
+    if (m_next_template.state != TemplateState::EMPTY) {
+        m_next_template.state = TemplateState::EMPTY;
+        m_logger->debug("[TemplateInterface] PREFETCH: Standby template discarded");
+    }
+}
+
 void MiningTemplateInterface::set_template_feed_handler(TemplateFeedHandler handler)
 {
     m_feed_handler = std::move(handler);
@@ -256,6 +333,7 @@ void MiningTemplateInterface::set_session_id(uint32_t session_id)
 {
     m_session_id = session_id;
     m_current_template.session_id = session_id;
+    m_next_template.session_id = session_id;
     m_logger->info("[TemplateInterface] Session ID set to 0x{:08x}", session_id);
 }
 
@@ -280,6 +358,8 @@ MiningTemplateInterface::TemplateStats MiningTemplateInterface::get_stats() cons
     stats.templates_rejected = m_templates_rejected.load(std::memory_order_relaxed);
     stats.templates_stale = m_templates_stale.load(std::memory_order_relaxed);
     stats.templates_fed = m_templates_fed.load(std::memory_order_relaxed);
+    stats.templates_prefetched = m_templates_prefetched.load(std::memory_order_relaxed);
+    stats.templates_promoted = m_templates_promoted.load(std::memory_order_relaxed);
     stats.blocks_verified = m_blocks_verified.load(std::memory_order_relaxed);
     stats.blocks_submitted = m_blocks_submitted.load(std::memory_order_relaxed);
     stats.total_read_time_us = m_total_read_time_us.load(std::memory_order_relaxed);
@@ -294,6 +374,8 @@ void MiningTemplateInterface::reset_stats()
     m_templates_rejected.store(0, std::memory_order_relaxed);
     m_templates_stale.store(0, std::memory_order_relaxed);
     m_templates_fed.store(0, std::memory_order_relaxed);
+    m_templates_prefetched.store(0, std::memory_order_relaxed);
+    m_templates_promoted.store(0, std::memory_order_relaxed);
     m_blocks_verified.store(0, std::memory_order_relaxed);
     m_blocks_submitted.store(0, std::memory_order_relaxed);
     m_total_read_time_us.store(0, std::memory_order_relaxed);
@@ -386,7 +468,7 @@ MiningTemplateInterface::validate_template(const MiningTemplate& tmpl)
     return result;
 }
 
-bool MiningTemplateInterface::parse_block_header(const network::Payload& data, 
+bool MiningTemplateInterface::parse_block_header(network::Payload_slice const& data, 
                                                   ::LLP::CBlock& block)
 {
     try {
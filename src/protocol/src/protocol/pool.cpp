@@ -4,6 +4,7 @@
 #include "network/connection.hpp"
 #include "stats/stats_collector.hpp"
 #include "stats/types.hpp"
+#include "stats/event_trace.hpp"
 #include "LLP/block_utils.hpp"
 #include <spdlog/spdlog.h>
 #include <nlohmann/json.hpp>
@@ -35,14 +36,14 @@ network::Shared_payload Pool::login(Login_handler handler)
     return packet.get_bytes();
 }
 
-network::Shared_payload Pool::submit_block(std::vector<std::uint8_t> const& block_data, std::uint64_t nonce)
+network::Gather_payload Pool::submit_block(std::vector<std::uint8_t> const& block_data, std::uint64_t nonce)
 {
     m_logger->info("Submitting Block...");
 
     // Enhanced diagnostics: Validate block_data before submission
     if (block_data.empty()) {
         m_logger->error("[Pool Submit] CRITICAL: block_data is empty! Cannot submit block.");
-        return network::Shared_payload{};
+        return network::Gather_payload{};
     }
     
     nlohmann::json j;
@@ -57,17 +58,17 @@ network::Shared_payload Pool::submit_block(std::vector<std::uint8_t> const& bloc
     m_logger->info("[Pool Submit]   - JSON metadata: {} bytes", j_string.size());
     
     network::Payload submit_data{ j_string.begin(), j_string.end() };
-    Packet packet{ Packet::SUBMIT_BLOCK, std::make_shared<network::Payload>(submit_data) };
+    Packet packet{ Packet::SUBMIT_BLOCK, std::move(submit_data) };
     
-    auto result = packet.get_bytes();
+    auto result = packet.get_gather_payload();
     
     // Enhanced diagnostics: Validate packet encoding
-    if (!result || result->empty()) {
+    if (result.empty()) {
         m_logger->error("[Pool Submit] CRITICAL: SUBMIT_BLOCK packet encoding failed!");
-        return network::Shared_payload{};
+        return network::Gather_payload{};
     }
     
-    m_logger->debug("[Pool Submit] SUBMIT_BLOCK packet successfully encoded: {} bytes wire format", result->size());
+    m_logger->debug("[Pool Submit] SUBMIT_BLOCK packet successfully encoded: {} bytes wire format", result.size());
     
     return result;
 }
@@ -84,7 +85,7 @@ void Pool::process_messages(Packet packet, std::shared_ptr<network::Connection>
     }
     else if(packet.m_header == Packet::LOGIN_V2_FAIL)
     {
-        nlohmann::json j = nlohmann::json::parse(packet.m_data->begin(), packet.m_data->end());
+        nlohmann::json j = nlohmann::json::parse(packet.m_data.begin(), packet.m_data.end());
         std::uint8_t const result_code = j.at("result_code");
         auto const result_message = j.at("result_message");
 
@@ -96,23 +97,24 @@ void Pool::process_messages(Packet packet, std::shared_ptr<network::Connection>
     }
     if (packet.m_header == Packet::POOL_NOTIFICATION)
     {
-        nlohmann::json j = nlohmann::json::parse(packet.m_data->begin(), packet.m_data->end());
+        nlohmann::json j = nlohmann::json::parse(packet.m_data.begin(), packet.m_data.end());
         auto const message = j.at("message");
         m_logger->info("POOL notification: {}", message);
     }
     else if (packet.m_header == Packet::WORK)
     {
+        stats::Trace_span span{"WORK", "protocol", "bytes", packet.m_length};
         try
         {
             // Enhanced diagnostics: Validate packet data
-            if (!packet.m_data || packet.m_data->empty()) {
+            if (packet.m_data.empty()) {
                 m_logger->error("[Pool Work] CRITICAL: WORK packet has null or empty data");
                 return;
             }
             
-            m_logger->debug("[Pool Work] Received WORK packet: {} bytes", packet.m_data->size());
+            m_logger->debug("[Pool Work] Received WORK packet: {} bytes", packet.m_data.size());
             
-            nlohmann::json j = nlohmann::json::parse(packet.m_data->begin(), packet.m_data->end());
+            nlohmann::json j = nlohmann::json::parse(packet.m_data.begin(), packet.m_data.end());
             std::uint32_t const work_id = j.at("work_id");
             auto const json_block = j.at("block");
             network::Shared_payload block_data = std::make_shared<network::Payload>(json_block["bytes"].get<network::Payload>());
@@ -127,7 +129,7 @@ void Pool::process_messages(Packet packet, std::shared_ptr<network::Connection>
             auto original_block = extract_nbits_from_block(block_data, nbits);
             
             // Use centralized deserializer for BLOCK_DATA parsing
-            auto block = nexusminer::llp_utils::deserialize_block_header(*original_block);
+            auto block = nexusminer::llp_utils::deserialize_block_header(original_block);
             
             // Enhanced diagnostics: Log work details
             m_logger->info("[Pool Work] New work received:");
@@ -148,8 +150,8 @@ void Pool::process_messages(Packet packet, std::shared_ptr<network::Connection>
         catch (std::exception& e)
         {
             m_logger->error("[Pool Work] CRITICAL: Invalid WORK json received. Exception: {}", e.what());
-            if (packet.m_data) {
-                m_logger->error("[Pool Work]   - Packet data size: {} bytes", packet.m_data->size());
+            if (!packet.m_data.empty()) {
+                m_logger->error("[Pool Work]   - Packet data size: {} bytes", packet.m_data.size());
             }
         }
     }
@@ -182,6 +184,7 @@ void Pool::process_messages(Packet packet, std::shared_ptr<network::Connection>
     }
 }
 
+// one minute window, reacts to real changes within a minute and still smooths single stats intervals
 double Pool::get_hashrate_from_workers()
 {
     double hashrate = 0.0;
@@ -191,13 +194,13 @@ double Pool::get_hashrate_from_workers()
         if (m_mining_mode == config::Mining_mode::HASH)
         {
             auto& hash_stats = std::get<stats::Hash>(worker);
-            hashrate += (hash_stats.m_hash_count / static_cast<double>(m_stats_collector->get_elapsed_time_seconds().count())) / 1.0e6;
+            hashrate += hash_stats.m_rates.m_short / 1.0e6;
         }
         else
         {
             auto& prime_stats = std::get<stats::Prime>(worker);
             //GISPS = Billion integers searched per second
-            hashrate += (prime_stats.m_range_searched / (1.0e9 * static_cast<double>(m_stats_collector->get_elapsed_time_seconds().count())));
+            hashrate += prime_stats.m_rates.m_short / 1.0e9;
         }
     }
 
@@ -33,10 +33,15 @@ network::Shared_payload Pool_base::get_work()
     return packet.get_bytes();
 }
 
-network::Shared_payload Pool_base::extract_nbits_from_block(network::Shared_payload data, std::uint32_t& nbits)
+network::Payload_slice Pool_base::extract_nbits_from_block(network::Shared_payload data, std::uint32_t& nbits)
 {
-    nbits = bytes2uint(std::vector<unsigned char>(data->begin(), data->begin() + 4));
-    return std::make_shared<network::Payload>(data->begin() + 4, data->end());
+    nbits = bytes2uint(*data);
+    if (data->size() < 4)
+    {
+        return network::Payload_slice{};
+    }
+    auto const block_size = data->size() - 4;
+    return network::Payload_slice{ std::move(data), 4, block_size };
 }
 
 }
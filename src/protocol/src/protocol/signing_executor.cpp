@@ -0,0 +1,63 @@
+#include "protocol/signing_executor.hpp"
+#include "stats/event_trace.hpp"
+
+namespace nexusminer {
+namespace protocol {
+
+Signing_executor::Signing_executor(std::shared_ptr<FalconSignatureWrapper> falcon_wrapper)
+    : m_falcon_wrapper(std::move(falcon_wrapper))
+    , m_stop(false)
+    , m_thread([this]() { run(); })
+{
+}
+
+Signing_executor::~Signing_executor()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_condition.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void Signing_executor::sign(std::vector<uint8_t> message, FalconSignatureWrapper::SignatureType type, Handler handler)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requests.push_back(Request{std::move(message), type, std::move(handler), std::chrono::steady_clock::now()});
+    }
+    m_condition.notify_one();
+}
+
+void Signing_executor::run()
+{
+    stats::Event_trace::instance().set_thread_name("falcon signer");
+    for (;;) {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stop || !m_requests.empty(); });
+            if (m_requests.empty()) {
+                break;  // stopped and drained
+            }
+            request = std::move(m_requests.front());
+            m_requests.pop_front();
+        }
+
+        auto const queue_time = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - request.queued);
+        auto const sign_start_ticks = stats::Tick_clock::now();
+        auto result = m_falcon_wrapper->sign_payload(request.message, request.type);
+        stats::Event_trace::instance().complete("falcon_sign", "protocol", sign_start_ticks, stats::Tick_clock::now(),
+            "bytes", request.message.size());
+        if (request.handler) {
+            request.handler(std::move(result), queue_time);
+        }
+    }
+}
+
+} // namespace protocol
+} // namespace nexusminer
@@ -4,9 +4,10 @@
 #include "packet.hpp"
 #include "network/connection.hpp"
 #include "stats/stats_collector.hpp"
+#include "stats/event_trace.hpp"
 #include "LLP/block_utils.hpp"
 #include "LLP/llp_logging.hpp"
-#include "../miner_keys.hpp"
+#include <algorithm>
 #include <chrono>
 
 namespace nexusminer
@@ -49,6 +50,9 @@ Solo::Solo(std::uint8_t channel, std::shared_ptr<stats::Collector> stats_collect
 , m_falcon_wrapper{nullptr}
 , m_block_signing_enabled{false}  // Disabled by default for performance
 , m_template_interface{nullptr}
+, m_template_prefetch_enabled{false}
+, m_work_requests{}
+, m_signing_executor{nullptr}
 {
    // Log constructor call with requested channel value
     m_logger->info("Solo::Solo: ctor called, channel={}", static_cast<int>(m_channel));
@@ -76,8 +80,11 @@ void Solo::reset()
     m_session_id = 0;
     m_auth_timestamp = 0;
     
+    m_work_requests.clear();
+    
     // Reset template interface for new session
     if (m_template_interface) {
+        m_template_interface->discard_next_template();
         m_template_interface->set_session_id(0);
         m_template_interface->reset_stats();
     }
@@ -92,7 +99,7 @@ network::Shared_payload Solo::login(Login_handler handler)
     }
     
     // Falcon authentication is mandatory - no legacy fallback
-    if (m_miner_pubkey.empty() || m_miner_privkey.empty()) {
+    if (!m_falcon_wrapper || !m_falcon_wrapper->is_valid()) {
         m_logger->error("[Solo Auth] CRITICAL: Falcon miner keys are required for authentication");
         m_logger->error("[Solo Auth] Legacy authentication mode has been removed");
         m_logger->error("[Solo Auth] Please configure Falcon keys in miner.conf:");
@@ -121,54 +128,18 @@ network::Shared_payload Solo::login(Login_handler handler)
     m_logger->info("[Solo Auth]   - Timestamp: {} (0x{:016x})", m_auth_timestamp, m_auth_timestamp);
     
     // Use Falcon Signature Wrapper for authentication signature
-    std::vector<uint8_t> signature;
-    if (m_falcon_wrapper && m_falcon_wrapper->is_valid()) {
-        m_logger->info("[Solo Auth] Using Falcon Signature Wrapper for authentication");
-        auto sig_result = m_falcon_wrapper->sign_authentication(m_address, m_auth_timestamp);
-        
-        if (!sig_result.success) {
-            m_logger->error("[Solo Auth] CRITICAL: Falcon Wrapper signature failed: {}", sig_result.error_message);
-            m_logger->error("[Solo Auth] Falling back to direct signature method");
-            
-            // Fallback to direct signing if wrapper fails
-            std::vector<uint8_t> auth_message;
-            auth_message.insert(auth_message.end(), m_address.begin(), m_address.end());
-            for (int i = 0; i < 8; ++i) {
-                auth_message.push_back((m_auth_timestamp >> (i * 8)) & 0xFF);
-            }
-            
-            if (!keys::falcon_sign(m_miner_privkey, auth_message, signature)) {
-                m_logger->error("[Solo Auth] CRITICAL: Fallback signature also failed");
-                handler(false);
-                return network::Shared_payload{};
-            }
-        } else {
-            signature = std::move(sig_result.signature);
-            m_logger->info("[Solo Auth] Wrapper signature generated in {} μs", sig_result.generation_time.count());
-        }
-    } else {
-        m_logger->warn("[Solo Auth] Falcon Wrapper not available, using direct signature method");
-        
-        // Build auth message: address + timestamp
-        std::vector<uint8_t> auth_message;
-        auth_message.insert(auth_message.end(), m_address.begin(), m_address.end());
-        
-        // Append timestamp (8 bytes, little-endian)
-        for (int i = 0; i < 8; ++i) {
-            auth_message.push_back((m_auth_timestamp >> (i * 8)) & 0xFF);
-        }
-        
-        // Sign the auth message with Falcon private key
-        if (!keys::falcon_sign(m_miner_privkey, auth_message, signature)) {
-            m_logger->error("[Solo Auth] CRITICAL: Failed to sign auth message with Falcon private key");
-            m_logger->error("[Solo Auth]   - Private key size: {} bytes", m_miner_privkey.size());
-            m_logger->error("[Solo Auth] Possible causes:");
-            m_logger->error("[Solo Auth]   - Invalid or corrupted private key");
-            m_logger->error("[Solo Auth]   - Falcon signature library error");
-            handler(false);
-            return network::Shared_payload{};
-        }
+    auto sig_result = m_falcon_wrapper->sign_authentication(m_address, m_auth_timestamp);
+    if (!sig_result.success) {
+        m_logger->error("[Solo Auth] CRITICAL: Failed to sign auth message with Falcon private key: {}",
+            sig_result.error_message);
+        m_logger->error("[Solo Auth] Possible causes:");
+        m_logger->error("[Solo Auth]   - Invalid or corrupted private key");
+        m_logger->error("[Solo Auth]   - Falcon signature library error");
+        handler(false);
+        return network::Shared_payload{};
     }
+    std::vector<uint8_t> signature = std::move(sig_result.signature);
+    m_logger->info("[Solo Auth] Wrapper signature generated in {} μs", sig_result.generation_time.count());
     
     m_logger->info("[Solo Auth] Successfully signed auth message");
     m_logger->info("[Solo Auth]   - Signature size: {} bytes", signature.size());
@@ -262,8 +233,8 @@ network::Shared_payload Solo::login(Login_handler handler)
                    packet.is_auth_packet(), 
                    static_cast<int>(Packet::MINER_AUTH_INIT), 
                    static_cast<int>(Packet::SESSION_KEEPALIVE));
-    m_logger->debug("[Solo Auth]   - Data pointer: {}", packet.m_data ? "valid" : "null");
-    m_logger->debug("[Solo Auth]   - Data size via m_data: {}", packet.m_data ? packet.m_data->size() : 0);
+    m_logger->debug("[Solo Auth]   - Data pointer: {}", !packet.m_data.empty() ? "valid" : "null");
+    m_logger->debug("[Solo Auth]   - Data size via m_data: {}", packet.m_data.size());
     m_logger->debug("[Solo Auth]   - m_length field: {}", packet.m_length);
     
     // Validate packet encoding
@@ -280,7 +251,7 @@ network::Shared_payload Solo::login(Login_handler handler)
         m_logger->error("[Solo Auth]   - Packet length: {} bytes", packet.m_length);
         m_logger->error("[Solo Auth]   - Packet is_valid: {}", packet.is_valid());
         m_logger->error("[Solo Auth]   - Packet is_auth_packet: {}", packet.is_auth_packet());
-        m_logger->error("[Solo Auth]   - Data pointer valid: {}", packet.m_data != nullptr);
+        m_logger->error("[Solo Auth]   - Data pointer valid: {}", !packet.m_data.empty());
         if (!packet.is_valid()) {
             m_logger->error("[Solo Auth] Possible causes:");
             m_logger->error("[Solo Auth]   - Packet header not in valid range for payload packets");
@@ -340,6 +311,9 @@ network::Shared_payload Solo::get_work()
     auto payload = packet.get_bytes();
     if (payload && !payload->empty()) {
         m_logger->debug("[Solo Phase 2] GET_BLOCK encoded payload size: {} bytes", payload->size());
+        if (m_template_prefetch_enabled) {
+            m_work_requests.push_back(Work_request::dispatch);
+        }
     } else {
         m_logger->error("[Solo Phase 2] GET_BLOCK get_bytes() returned null or empty payload!");
     }
@@ -347,6 +321,88 @@ network::Shared_payload Solo::get_work()
     return payload;     
 }
 
+network::Shared_payload Solo::prefetch_work()
+{
+    if (!m_template_prefetch_enabled || !m_authenticated || !m_template_interface) {
+        return network::Shared_payload{};
+    }
+    
+    // One prefetch in flight is enough, the next refresh replaces the standby template anyway
+    if (std::find(m_work_requests.begin(), m_work_requests.end(), Work_request::prefetch) != m_work_requests.end()) {
+        return network::Shared_payload{};
+    }
+    
+    Packet packet{ Packet::GET_BLOCK };
+    auto payload = packet.get_bytes();
+    if (!payload || payload->empty()) {
+        m_logger->error("[Solo Prefetch] GET_BLOCK get_bytes() returned null or empty payload!");
+        return network::Shared_payload{};
+    }
+    
+    m_logger->debug("[Solo Prefetch] Requesting standby template");
+    m_work_requests.push_back(Work_request::prefetch);
+    return payload;
+}
+
+void Solo::process_prefetched_template(Packet const& packet, std::shared_ptr<network::Connection> connection)
+{
+    std::string source_endpoint;
+    if (connection) {
+        source_endpoint = connection->remote_endpoint().to_string();
+    }
+    
+    auto validation_result = m_template_interface->read_next_template(packet.m_data, source_endpoint);
+    if (!validation_result.is_valid) {
+        m_logger->warn("[Solo Prefetch] Standby template rejected: {}", validation_result.error_message);
+        return;
+    }
+    
+    auto const* next = m_template_interface->get_next_template();
+    auto const* current = m_template_interface->get_current_template();
+    
+    // No active template (e.g. a lost GET_BLOCK answer) or a new block on the network: switch now
+    if (!current || next->block.nHeight > m_current_height) {
+        m_logger->info("Nexus Network: New height {} (old height: {})", next->block.nHeight, m_current_height);
+        dispatch_next_template("new height");
+        
+        // keep a spare for the next transition
+        if (connection) {
+            auto prefetch_payload = prefetch_work();
+            if (prefetch_payload) {
+                connection->transmit(prefetch_payload);
+            }
+        }
+        return;
+    }
+    
+    m_logger->debug("[Solo Prefetch] Standby template ready (height: {}, validated in {} μs)",
+        next->block.nHeight, validation_result.validation_time.count());
+}
+
+bool Solo::dispatch_next_template(char const* reason)
+{
+    if (!m_template_interface || !m_set_block_handler) {
+        return false;
+    }
+    
+    auto const* next = m_template_interface->get_next_template();
+    if (next && next->block.nHeight < m_current_height) {
+        m_template_interface->discard_next_template();   // outdated by a block we didn't prefetch
+        return false;
+    }
+    if (!m_template_interface->promote_next_template()) {
+        return false;
+    }
+    
+    auto const* tmpl = m_template_interface->get_current_template();
+    m_current_height = tmpl->block.nHeight;
+    
+    m_logger->info("[Solo Prefetch] Dispatching standby template to workers ({}, height: {}, nBits: 0x{:08x})",
+        reason, tmpl->block.nHeight, tmpl->nBits);
+    m_set_block_handler(tmpl->block, tmpl->nBits);
+    return true;
+}
+
 network::Shared_payload Solo::get_height()
 {
     m_logger->info("[Solo] Requesting blockchain height via GET_HEIGHT");
@@ -370,7 +426,8 @@ network::Shared_payload Solo::get_height()
     return payload;
 }
 
-network::Shared_payload Solo::submit_block(std::vector<std::uint8_t> const& block_data, std::uint64_t nonce)
+bool Solo::prepare_submission(std::vector<std::uint8_t> const& block_data, std::uint64_t nonce,
+    std::vector<std::uint8_t>& message_to_sign)
 {
     m_logger->info("Submitting Block...");
 
@@ -378,7 +435,7 @@ network::Shared_payload Solo::submit_block(std::vector<std::uint8_t> const& bloc
     if (block_data.empty()) {
         m_logger->error("[Solo Submit] CRITICAL: block_data is empty! Cannot submit block.");
         m_logger->error("[Solo Submit] Recovery: Requesting new work to recover from empty payload scenario");
-        return network::Shared_payload{};
+        return false;
     }
     
     // LLL-TAO SignedWorkSubmission format (from Disposable Falcon Wrapper - PR #20):
@@ -392,7 +449,7 @@ network::Shared_payload Solo::submit_block(std::vector<std::uint8_t> const& bloc
         m_logger->error("[Solo Submit] CRITICAL: Falcon wrapper not available for block signing");
         m_logger->error("[Solo Submit] Stateless sessions REQUIRE signed block submissions per LLL-TAO protocol");
         m_logger->error("[Solo Submit] Block submission cannot proceed without valid Falcon keys");
-        return network::Shared_payload{};
+        return false;
     }
     
     // Enhanced diagnostics: Log block submission structure
@@ -407,81 +464,134 @@ network::Shared_payload Solo::submit_block(std::vector<std::uint8_t> const& bloc
     m_logger->info("[Solo Submit]   - Timestamp: {} (0x{:016x})", submission_timestamp, submission_timestamp);
     
     // Build the complete submission payload: merkle_root + nonce + timestamp
-    std::vector<uint8_t> message_to_sign;
+    message_to_sign.clear();
     message_to_sign.reserve(block_data.size() + 16);  // block_data + nonce(8) + timestamp(8)
     message_to_sign.insert(message_to_sign.end(), block_data.begin(), block_data.end());
     append_uint64_le(message_to_sign, nonce);
     append_uint64_le(message_to_sign, submission_timestamp);
-    
-    // Generate Falcon signature for block submission
-    m_logger->info("[Solo Submit] Generating required Falcon signature for SignedWorkSubmission");
-    auto sig_result = m_falcon_wrapper->sign_payload(message_to_sign, 
-        FalconSignatureWrapper::SignatureType::BLOCK);
-    
+    return true;
+}
+
+network::Gather_payload Solo::finish_submission(spdlog::logger& logger, FalconSignatureWrapper const& falcon_wrapper,
+    network::Shared_payload submission, FalconSignatureWrapper::SignatureResult const& sig_result,
+    std::uint32_t session_id)
+{
     if (!sig_result.success) {
-        m_logger->error("[Solo Submit] CRITICAL: Falcon signature generation failed: {}", sig_result.error_message);
-        m_logger->error("[Solo Submit] Block submission cannot proceed without valid signature");
-        return network::Shared_payload{};
+        logger.error("[Solo Submit] CRITICAL: Falcon signature generation failed: {}", sig_result.error_message);
+        logger.error("[Solo Submit] Block submission cannot proceed without valid signature");
+        return network::Gather_payload{};
     }
     
-    // Build the packet payload
-    Packet packet{ Packet::SUBMIT_BLOCK };
-    packet.m_data = std::make_shared<network::Payload>();
-    packet.m_data->reserve(block_data.size() + 16 + 2 + sig_result.signature.size());
-    
-    // Append merkle_root (64 bytes)
-    packet.m_data->insert(packet.m_data->end(), block_data.begin(), block_data.end());
-    
-    // Append nonce (8 bytes LE)
-    append_uint64_le(*packet.m_data, nonce);
-    
-    // Append timestamp (8 bytes LE)
-    append_uint64_le(*packet.m_data, submission_timestamp);
-    
     // Append signature length (2 bytes LE)
     uint16_t sig_len = static_cast<uint16_t>(sig_result.signature.size());
-    append_uint16_le(*packet.m_data, sig_len);
+    append_uint16_le(*submission, sig_len);
     
     // Append signature bytes
-    packet.m_data->insert(packet.m_data->end(), 
-                         sig_result.signature.begin(), 
-                         sig_result.signature.end());
+    submission->insert(submission->end(), 
+                       sig_result.signature.begin(), 
+                       sig_result.signature.end());
     
-    m_logger->info("[Solo Submit] SignedWorkSubmission signature appended");
-    m_logger->info("[Solo Submit]   - Signature length: {} bytes", sig_len);
-    m_logger->info("[Solo Submit]   - Generation time: {} μs", sig_result.generation_time.count());
+    logger.info("[Solo Submit] SignedWorkSubmission signature appended");
+    logger.info("[Solo Submit]   - Signature length: {} bytes", sig_len);
+    logger.info("[Solo Submit]   - Generation time: {} μs", sig_result.generation_time.count());
+    auto const signing_stats = falcon_wrapper.get_stats();
+    logger.info("[Solo Submit]   - Falcon signing: {} signatures, average {} μs ({} private key)",
+        signing_stats.total_signatures, signing_stats.average_time_microseconds,
+        signing_stats.expanded_key ? "expanded" : "compact");
     
-    // Set packet length to actual data size
-    packet.m_length = packet.m_data->size();
+    // packet length is the actual data size
+    Packet packet{ Packet::SUBMIT_BLOCK, std::move(submission) };
     
     // Validate final payload size
     // Format: merkle_root(64) + nonce(8) + timestamp(8) + sig_len(2) + signature(~690) = ~772 bytes
-    std::size_t actual_size = packet.m_data->size();
+    std::size_t actual_size = packet.m_data.size();
     std::size_t expected_min_size = 82;  // merkle_root(64) + nonce(8) + timestamp(8) + sig_len(2)
     
     if (actual_size < expected_min_size) {
-        m_logger->error("[Solo Submit] Payload size too small: expected at least {} bytes, got {} bytes", 
+        logger.error("[Solo Submit] Payload size too small: expected at least {} bytes, got {} bytes", 
             expected_min_size, actual_size);
     }
     
-    m_logger->info("[Solo Phase 2] Submitting SignedWorkSubmission (session: 0x{:08x})", m_session_id);
-    m_logger->info("[Solo Submit]   - Total submission payload: {} bytes", actual_size);
-    m_logger->info("[Solo Submit]   - Format: [merkle_root(64)][nonce(8)][timestamp(8)][sig_len(2)][signature]");
+    logger.info("[Solo Phase 2] Submitting SignedWorkSubmission (session: 0x{:08x})", session_id);
+    logger.info("[Solo Submit]   - Total submission payload: {} bytes", actual_size);
+    logger.info("[Solo Submit]   - Format: [merkle_root(64)][nonce(8)][timestamp(8)][sig_len(2)][signature]");
     
-    auto result = packet.get_bytes();
+    // header and length prefix are written in front of the submission without copying it
+    auto result = packet.get_gather_payload();
     
     // Enhanced diagnostics: Validate packet encoding
-    if (!result || result->empty()) {
-        m_logger->error("[Solo Submit] CRITICAL: SUBMIT_BLOCK packet encoding failed! get_bytes() returned empty.");
-        m_logger->error("[Solo Submit] Recovery: Will retry work request after failed submission");
-        return network::Shared_payload{};
+    if (result.empty()) {
+        logger.error("[Solo Submit] CRITICAL: SUBMIT_BLOCK packet encoding failed! get_gather_payload() returned empty.");
+        logger.error("[Solo Submit] Recovery: Will retry work request after failed submission");
+        return network::Gather_payload{};
     }
     
-    m_logger->debug("[Solo Submit] SUBMIT_BLOCK packet successfully encoded: {} bytes wire format", result->size());
+    logger.debug("[Solo Submit] SUBMIT_BLOCK packet successfully encoded: {} bytes wire format", result.size());
 
     return result;  
 }
 
+// submission payload without the signature, room reserved for sig_len and signature
+static network::Shared_payload make_submission_payload(std::vector<std::uint8_t> const& message_to_sign)
+{
+    auto submission = std::make_shared<network::Payload>();
+    submission->reserve(message_to_sign.size() + 2 + FalconConstants::FALCON512_SIG_CT_SIZE);
+    submission->insert(submission->end(), message_to_sign.begin(), message_to_sign.end());
+    return submission;
+}
+
+network::Gather_payload Solo::submit_block(std::vector<std::uint8_t> const& block_data, std::uint64_t nonce)
+{
+    std::vector<std::uint8_t> message_to_sign;
+    if (!prepare_submission(block_data, nonce, message_to_sign)) {
+        return network::Gather_payload{};
+    }
+    
+    // Generate Falcon signature for block submission
+    m_logger->info("[Solo Submit] Generating required Falcon signature for SignedWorkSubmission");
+    auto sig_result = m_falcon_wrapper->sign_payload(message_to_sign, 
+        FalconSignatureWrapper::SignatureType::BLOCK);
+    if (sig_result.success) {
+        m_stats_collector->get_submit_latency().m_sign.record(sig_result.generation_time);
+    }
+    
+    return finish_submission(*m_logger, *m_falcon_wrapper, make_submission_payload(message_to_sign), sig_result,
+        m_session_id);
+}
+
+void Solo::submit_block(std::vector<std::uint8_t> const& block_data, std::uint64_t nonce, Submit_handler handler)
+{
+    std::vector<std::uint8_t> message_to_sign;
+    if (!prepare_submission(block_data, nonce, message_to_sign)) {
+        handler(network::Gather_payload{});
+        return;
+    }
+    
+    if (!m_signing_executor) {
+        handler(submit_block(block_data, nonce));
+        return;
+    }
+    
+    // the io thread continues with the next packet while the signing thread signs and finishes the packet
+    m_logger->info("[Solo Submit] Generating required Falcon signature for SignedWorkSubmission (signing thread)");
+    auto submission = make_submission_payload(message_to_sign);
+    // submit_block runs on the io thread, which also writes the session id on re-authentication.
+    // capture it here, the signing thread must not read the member.
+    // the executor is shared by all nodes and outlives this session, capture what the handler needs, not this
+    m_signing_executor->sign(std::move(message_to_sign), FalconSignatureWrapper::SignatureType::BLOCK,
+        [logger = m_logger, falcon_wrapper = m_falcon_wrapper, stats_collector = m_stats_collector,
+         submission = std::move(submission), handler = std::move(handler), session_id = m_session_id](
+            FalconSignatureWrapper::SignatureResult&& sig_result, std::chrono::microseconds queue_time) mutable
+    {
+        auto& submit_latency = stats_collector->get_submit_latency();
+        submit_latency.m_sign_queue.record(queue_time);
+        if (sig_result.success) {
+            submit_latency.m_sign.record(sig_result.generation_time);
+        }
+        handler(finish_submission(*logger, *falcon_wrapper, std::move(submission), sig_result, session_id));
+    });
+}
+
 void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection> connection)  
 {
     // Reject invalid packets at the start
@@ -506,12 +616,12 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
     if (packet.m_header == Packet::BLOCK_HEIGHT)
     {
         // Validate packet data before processing
-        if (!packet.m_data || packet.m_length < 4) {
+        if (packet.m_data.empty() || packet.m_length < 4) {
             m_logger->warn("Solo::process_messages: BLOCK_HEIGHT packet has invalid data or length < 4");
             return;
         }
         
-        auto const height = bytes2uint(*packet.m_data);
+        auto const height = bytes2uint(packet.m_data);
         
         // Log the received height information
         m_logger->info("[Solo] Received BLOCK_HEIGHT: height={}", height);
@@ -521,6 +631,16 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
             m_logger->info("Nexus Network: New height {} (old height: {})", height, m_current_height);
             m_current_height = height;
             
+            // Standby template already built on the new block: switch without a round trip
+            if (m_template_prefetch_enabled && dispatch_next_template("height notification"))
+            {
+                auto prefetch_payload = prefetch_work();
+                if (prefetch_payload) {
+                    connection->transmit(prefetch_payload);
+                }
+                return;
+            }
+            
             // After receiving height, request actual work via GET_BLOCK
             m_logger->info("[Solo] Height updated, requesting work via GET_BLOCK");
             connection->transmit(get_work());          
@@ -539,21 +659,33 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
     else if (packet.m_header == Packet::BLOCK_REWARD)
     {
         // Validate packet data before processing
-        if (!packet.m_data || packet.m_length < 8) {
+        if (packet.m_data.empty() || packet.m_length < 8) {
             m_logger->warn("Solo::process_messages: BLOCK_REWARD packet has invalid data or length < 8");
             return;
         }
         
         // Parse reward using bytes2uint64 (consistent with bytes2uint - big-endian byte order)
-        m_current_reward = bytes2uint64(*packet.m_data);
+        m_current_reward = bytes2uint64(packet.m_data);
         
         m_logger->info("[Solo] Received BLOCK_REWARD: reward={}", m_current_reward);
     }
     // Block from wallet received
     else if(packet.m_header == Packet::BLOCK_DATA)
     {
+        stats::Trace_span span{"BLOCK_DATA", "protocol", "bytes", packet.m_length};
+        // Answers arrive in request order, unsolicited BLOCK_DATA is treated as work
+        auto request = Work_request::dispatch;
+        if (m_template_prefetch_enabled && !m_work_requests.empty()) {
+            request = m_work_requests.front();
+            m_work_requests.pop_front();
+        }
+        if (request == Work_request::prefetch && m_template_interface) {
+            process_prefetched_template(packet, connection);
+            return;
+        }
+        
         // Enhanced diagnostics: Check payload is non-null
-        if (!packet.m_data) {
+        if (packet.m_data.empty()) {
             m_logger->error("[Solo] CRITICAL: BLOCK_DATA received with null payload");
             m_logger->error("[Solo] Recovery: Requesting new work to recover from empty payload scenario");
             if (connection) {
@@ -569,7 +701,7 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
         
         // Enhanced diagnostics: Log payload size information
         m_logger->info("[Solo] BLOCK_DATA payload diagnostics:");
-        m_logger->info("[Solo]   - Payload size: {} bytes", packet.m_data->size());
+        m_logger->info("[Solo]   - Payload size: {} bytes", packet.m_data.size());
         m_logger->info("[Solo]   - Packet length field: {} bytes", packet.m_length);
         
         // Validate packet has minimum required data
@@ -648,12 +780,25 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
                 tmpl->block.nHeight, tmpl->nBits);
             m_set_block_handler(tmpl->block, tmpl->nBits);
             
+            // Keep a validated standby template for the next transition
+            if (m_template_prefetch_enabled && connection) {
+                auto const* next = m_template_interface->get_next_template();
+                if (next && next->block.nHeight < tmpl->block.nHeight) {
+                    m_template_interface->discard_next_template();
+                }
+                auto prefetch_payload = prefetch_work();
+                if (prefetch_payload) {
+                    connection->transmit(prefetch_payload);
+                }
+            }
+            
             // Log template interface statistics periodically
             auto stats = m_template_interface->get_stats();
             if (stats.templates_received % 10 == 0) {
-                m_logger->debug("[Solo Template Stats] Received: {}, Validated: {}, Rejected: {}, Fed: {}",
+                m_logger->debug("[Solo Template Stats] Received: {}, Validated: {}, Rejected: {}, Fed: {}, Prefetched: {}, Promoted: {}",
                     stats.templates_received, stats.templates_validated, 
-                    stats.templates_rejected, stats.templates_fed);
+                    stats.templates_rejected, stats.templates_fed,
+                    stats.templates_prefetched, stats.templates_promoted);
             }
         }
         else {
@@ -662,7 +807,7 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
             
             try {
                 // Use centralized deserializer
-                auto block = nexusminer::llp_utils::deserialize_block_header(*packet.m_data);
+                auto block = nexusminer::llp_utils::deserialize_block_header(packet.m_data);
                 
                 // Enhanced diagnostics: Log parsed header fields
                 m_logger->info("[Solo] Received block header:");
@@ -719,7 +864,7 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
             }
             catch (const std::exception& e) {
                 m_logger->error("[Solo] CRITICAL: Failed to deserialize BLOCK_DATA: {}", e.what());
-                m_logger->error("[Solo]   - Payload size: {} bytes", packet.m_data->size());
+                m_logger->error("[Solo]   - Payload size: {} bytes", packet.m_data.size());
                 m_logger->error("[Solo]   - This may indicate protocol mismatch or data corruption");
                 m_logger->error("[Solo] Recovery: Requesting new work to recover from deserialization failure");
                 if (connection) {
@@ -750,6 +895,11 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
             m_logger->info("[Solo] Block accepted on connection {}:{}", remote_addr, actual_port);
         }
         
+        // Our block moved the chain on, the standby template builds on the previous one
+        if (m_template_interface) {
+            m_template_interface->discard_next_template();
+        }
+        
         // Request new work with recovery logic
         auto work_payload = get_work();
         if (!work_payload || work_payload->empty()) {
@@ -787,6 +937,15 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
         m_logger->info("[Solo]   - Invalid proof-of-work (nonce doesn't meet difficulty)");
         m_logger->info("[Solo]   - Blockchain reorganization occurred");
         
+        // A standby template at the current height replaces the GET_BLOCK round trip
+        if (m_template_prefetch_enabled && dispatch_next_template("block rejected")) {
+            auto prefetch_payload = prefetch_work();
+            if (prefetch_payload) {
+                connection->transmit(prefetch_payload);
+            }
+            return;
+        }
+        
         // Request new work with recovery logic
         auto work_payload = get_work();
         if (!work_payload || work_payload->empty()) {
@@ -825,19 +984,19 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
         m_logger->info("[Solo Phase 2] Received MINER_AUTH_RESULT from node");
         
         // Enhanced diagnostics: Validate packet
-        if (!packet.m_data || packet.m_length < 1) {
+        if (packet.m_data.empty() || packet.m_length < 1) {
             m_logger->error("[Solo Auth] CRITICAL: MINER_AUTH_RESULT packet has invalid data");
-            m_logger->error("[Solo Auth]   - Packet data null: {}", packet.m_data == nullptr);
+            m_logger->error("[Solo Auth]   - Packet data null: {}", packet.m_data.empty());
             m_logger->error("[Solo Auth]   - Packet length: {}", packet.m_length);
             m_logger->error("[Solo Auth] Cannot proceed - authentication protocol error");
             return;
         }
         
-        bool auth_success = (*packet.m_data)[0] != 0;
+        bool auth_success = packet.m_data[0] != 0;
         
         m_logger->info("[Solo Auth] Authentication result:");
         m_logger->info("[Solo Auth]   - Status byte: 0x{:02x} ({})", 
-            (*packet.m_data)[0], auth_success ? "SUCCESS" : "FAILURE");
+            packet.m_data[0], auth_success ? "SUCCESS" : "FAILURE");
         m_logger->info("[Solo Auth]   - Packet length: {} bytes", packet.m_length);
         
         if (auth_success) {
@@ -846,13 +1005,13 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
             // Extract session ID if present (4 bytes, little-endian)
             if (packet.m_length >= 5) {
                 // Read little-endian uint32
-                m_session_id = static_cast<uint32_t>((*packet.m_data)[1]) | 
-                               (static_cast<uint32_t>((*packet.m_data)[2]) << 8) | 
-                               (static_cast<uint32_t>((*packet.m_data)[3]) << 16) | 
-                               (static_cast<uint32_t>((*packet.m_data)[4]) << 24);
+                m_session_id = static_cast<uint32_t>(packet.m_data[1]) | 
+                               (static_cast<uint32_t>(packet.m_data[2]) << 8) | 
+                               (static_cast<uint32_t>(packet.m_data[3]) << 16) | 
+                               (static_cast<uint32_t>(packet.m_data[4]) << 24);
                 m_logger->info("[Solo Phase 2] ✓ Authentication SUCCEEDED - Session ID: 0x{:08x}", m_session_id);
                 m_logger->info("[Solo Auth]   - Session ID bytes (LE): {:02x} {:02x} {:02x} {:02x}",
-                    (*packet.m_data)[1], (*packet.m_data)[2], (*packet.m_data)[3], (*packet.m_data)[4]);
+                    packet.m_data[1], packet.m_data[2], packet.m_data[3], packet.m_data[4]);
                 
                 // Update template interface with authenticated session ID (FALCON tunnel established)
                 if (m_template_interface) {
@@ -897,7 +1056,7 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
             
             // Enhanced diagnostics: Parse extended error info if available
             if (packet.m_length >= 2) {
-                uint8_t error_code = (*packet.m_data)[1];
+                uint8_t error_code = packet.m_data[1];
                 m_logger->error("[Solo Auth] Error code from node: 0x{:02x}", error_code);
                 
                 // Interpret error codes based on LLL-TAO implementation
@@ -990,8 +1149,8 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
         }
         
         // Parse channel acknowledgment with enhanced diagnostics
-        if (packet.m_data && packet.m_length >= 1) {
-            uint8_t acked_channel = (*packet.m_data)[0];
+        if (!packet.m_data.empty() && packet.m_length >= 1) {
+            uint8_t acked_channel = packet.m_data[0];
             m_logger->info("[Solo] Channel acknowledged: {} ({})", 
                 static_cast<int>(acked_channel), 
                 (acked_channel == 1) ? "prime" : "hash");
@@ -1009,8 +1168,8 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
             // Format (if extended): [channel(1)][port(2, big-endian, optional)]
             if (packet.m_length >= 3) {
                 // Node is sending back port information (future enhancement)
-                uint16_t node_port = (static_cast<uint16_t>((*packet.m_data)[1]) << 8) | 
-                                     static_cast<uint16_t>((*packet.m_data)[2]);
+                uint16_t node_port = (static_cast<uint16_t>(packet.m_data[1]) << 8) | 
+                                     static_cast<uint16_t>(packet.m_data[2]);
                 
                 m_logger->info("[Solo] Extended CHANNEL_ACK: Node communicated LLP port: {}", node_port);
                 
@@ -1029,7 +1188,7 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
             }
         } else {
             m_logger->warn("[Solo] WARNING: CHANNEL_ACK packet has no data or insufficient length");
-            m_logger->warn("[Solo]   - Packet data null: {}", packet.m_data == nullptr);
+            m_logger->warn("[Solo]   - Packet data null: {}", packet.m_data.empty());
             m_logger->warn("[Solo]   - Packet length: {}", packet.m_length);
         }
         
@@ -1048,12 +1207,12 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
         // LLL-TAO PR #22: Handle SESSION_START for session management
         m_logger->info("[Solo Session] Received SESSION_START from node");
         
-        if (packet.m_data && packet.m_length >= 4) {
+        if (!packet.m_data.empty() && packet.m_length >= 4) {
             // Parse session timeout (4 bytes, little-endian)
-            uint32_t session_timeout = (*packet.m_data)[0] |
-                                       ((*packet.m_data)[1] << 8) |
-                                       ((*packet.m_data)[2] << 16) |
-                                       ((*packet.m_data)[3] << 24);
+            uint32_t session_timeout = packet.m_data[0] |
+                                       (packet.m_data[1] << 8) |
+                                       (packet.m_data[2] << 16) |
+                                       (packet.m_data[3] << 24);
             
             m_logger->info("[Solo Session] Session parameters:");
             m_logger->info("[Solo Session]   - Timeout: {} seconds", session_timeout);
@@ -1070,12 +1229,12 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
         // LLL-TAO PR #22: Handle SESSION_KEEPALIVE response
         m_logger->debug("[Solo Session] Received SESSION_KEEPALIVE response");
         
-        if (packet.m_data && packet.m_length >= 4) {
+        if (!packet.m_data.empty() && packet.m_length >= 4) {
             // Parse remaining timeout (4 bytes, little-endian)
-            uint32_t remaining_timeout = (*packet.m_data)[0] |
-                                         ((*packet.m_data)[1] << 8) |
-                                         ((*packet.m_data)[2] << 16) |
-                                         ((*packet.m_data)[3] << 24);
+            uint32_t remaining_timeout = packet.m_data[0] |
+                                         (packet.m_data[1] << 8) |
+                                         (packet.m_data[2] << 16) |
+                                         (packet.m_data[3] << 24);
             
             m_logger->debug("[Solo Session] Session keepalive acknowledged - {} seconds remaining", remaining_timeout);
         }
@@ -1086,26 +1245,13 @@ void Solo::process_messages(Packet packet, std::shared_ptr<network::Connection>
     } 
 }
 
-void Solo::set_miner_keys(std::vector<uint8_t> const& pubkey, std::vector<uint8_t> const& privkey)
+void Solo::set_signer(std::shared_ptr<FalconSignatureWrapper> falcon_wrapper,
+    std::shared_ptr<Signing_executor> signing_executor)
 {
-    m_miner_pubkey = pubkey;
-    m_miner_privkey = privkey;
-    m_logger->info("[Solo] Miner Falcon keys configured (pubkey: {} bytes, privkey: {} bytes)", 
-        pubkey.size(), privkey.size());
-    
-    // Initialize the Unified Falcon Signature Wrapper
-    try {
-        m_falcon_wrapper = std::make_unique<FalconSignatureWrapper>(pubkey, privkey);
-        if (m_falcon_wrapper->is_valid()) {
-            m_logger->info("[Solo] Falcon Signature Wrapper initialized successfully");
-        } else {
-            m_logger->error("[Solo] Falcon Signature Wrapper initialization failed - invalid keys");
-            m_falcon_wrapper.reset();
-        }
-    } catch (const std::exception& e) {
-        m_logger->error("[Solo] Failed to initialize Falcon Signature Wrapper: {}", e.what());
-        m_falcon_wrapper.reset();
-    }
+    m_falcon_wrapper = std::move(falcon_wrapper);
+    m_signing_executor = std::move(signing_executor);
+    m_miner_pubkey = m_falcon_wrapper ? m_falcon_wrapper->get_public_key() : std::vector<uint8_t>{};
+    m_logger->info("[Solo] Miner Falcon signer configured (pubkey: {} bytes)", m_miner_pubkey.size());
 }
 
 network::Shared_payload Solo::send_session_keepalive()
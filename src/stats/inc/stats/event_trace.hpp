@@ -0,0 +1,383 @@
+#ifndef NEXUSMINER_STATS_EVENT_TRACE_HPP
+#define NEXUSMINER_STATS_EVENT_TRACE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include "stats/tick_clock.hpp"
+
+namespace nexusminer {
+namespace stats
+{
+
+// Timeline tracing in the Chrome trace event format (JSON array), opens in chrome://tracing and ui.perfetto.dev.
+// Every thread records into its own single producer ring, a record is a few plain stores and one release store.
+// While tracing is off a span costs one relaxed load. A background thread drains the rings every flush_interval,
+// converts the ticks to microseconds and writes the file. Events that don't fit into a full ring are dropped.
+// Names, categories and argument names must be string literals (only the pointer is recorded).
+class Event_trace
+{
+public:
+
+    static constexpr std::size_t ring_size = 8192;     // events per thread, power of 2
+    static constexpr std::chrono::milliseconds flush_interval{ 50 };
+
+    // process wide tracer, shared by all threads like Packet_trace
+    static Event_trace& instance()
+    {
+        static Event_trace event_trace;
+        return event_trace;
+    }
+
+    ~Event_trace()
+    {
+        stop();
+    }
+
+    // start tracing into file, an empty file name leaves tracing off
+    void start(std::shared_ptr<spdlog::logger> logger, std::string const& file)
+    {
+        stop();
+        if (file.empty())
+        {
+            return;
+        }
+
+        m_logger = std::move(logger);
+        m_file.open(file, std::ios::trunc);
+        if (!m_file.is_open())
+        {
+            if (m_logger)
+            {
+                m_logger->error("[TRACE] Unable to open event trace file {}", file);
+            }
+            return;
+        }
+        m_file << "[";
+        m_first_event = true;
+        m_start_ticks = Tick_clock::now();
+        m_start = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = false;
+            // threads named in an earlier run are named again in this file
+            for (auto& buffer : m_buffers)
+            {
+                buffer->m_named = false;
+            }
+        }
+        m_consumer = std::thread([this]() { consume(); });
+        m_enabled.store(true, std::memory_order_release);
+        if (m_logger)
+        {
+            m_logger->info("[TRACE] Writing event trace to {}", file);
+        }
+    }
+
+    void stop()
+    {
+        m_enabled.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_condition.notify_one();
+        if (m_consumer.joinable())
+        {
+            m_consumer.join();
+        }
+        if (m_file.is_open())
+        {
+            m_file << "\n]\n";
+            m_file.close();
+            auto const dropped = m_dropped_events.exchange(0, std::memory_order_relaxed);
+            if (m_logger && dropped > 0)
+            {
+                m_logger->warn("[TRACE] {} events dropped, the trace rings were full", dropped);
+            }
+        }
+    }
+
+    bool enabled() const
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    // names the calling thread in the timeline, kept across start/stop
+    void set_thread_name(std::string name)
+    {
+        auto& local = thread_local_buffer();
+        local.m_name = std::move(name);
+        if (local.m_buffer)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            local.m_buffer->m_name = local.m_name;
+            local.m_buffer->m_named = false;
+        }
+    }
+
+    // span between two Tick_clock readings of the calling thread
+    void complete(char const* name, char const* category, std::uint64_t start_ticks, std::uint64_t stop_ticks,
+        char const* arg_name = nullptr, std::uint64_t arg = 0)
+    {
+        if (!enabled())
+        {
+            return;
+        }
+        push(Event{ name, category, arg_name, arg, start_ticks, stop_ticks - start_ticks, false });
+    }
+
+    // point in time on the calling thread
+    void instant(char const* name, char const* category, char const* arg_name = nullptr, std::uint64_t arg = 0)
+    {
+        if (!enabled())
+        {
+            return;
+        }
+        push(Event{ name, category, arg_name, arg, Tick_clock::now(), 0, true });
+    }
+
+    std::uint64_t dropped_events() const
+    {
+        return m_dropped_events.load(std::memory_order_relaxed);
+    }
+
+private:
+
+    struct Event
+    {
+        char const* m_name;
+        char const* m_category;
+        char const* m_arg_name;
+        std::uint64_t m_arg;
+        std::uint64_t m_start;
+        std::uint64_t m_duration;
+        bool m_instant;
+    };
+
+    struct Ring
+    {
+        explicit Ring(std::uint32_t tid) : m_events(ring_size), m_tid{ tid } {}
+
+        std::vector<Event> m_events;
+        alignas(64) std::atomic<std::size_t> m_head{ 0 };     // written by the owning thread
+        alignas(64) std::atomic<std::size_t> m_tail{ 0 };     // written by the consumer
+        std::uint32_t m_tid;
+        std::string m_name;         // guarded by m_mutex
+        bool m_named{ false };      // guarded by m_mutex
+        std::atomic<bool> m_retired{ false };
+    };
+
+    // the thread's ring, created on its first event. Retired when the thread exits, the consumer frees it once drained
+    struct Thread_local
+    {
+        ~Thread_local()
+        {
+            if (m_buffer)
+            {
+                m_buffer->m_retired.store(true, std::memory_order_release);
+            }
+        }
+
+        std::shared_ptr<Ring> m_buffer;
+        std::string m_name;
+    };
+
+    Event_trace() = default;
+
+    static Thread_local& thread_local_buffer()
+    {
+        static thread_local Thread_local local;
+        return local;
+    }
+
+    void push(Event const& event)
+    {
+        auto& local = thread_local_buffer();
+        if (!local.m_buffer)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            local.m_buffer = std::make_shared<Ring>(m_next_tid++);
+            local.m_buffer->m_name = local.m_name;
+            m_buffers.push_back(local.m_buffer);
+        }
+
+        auto& ring = *local.m_buffer;
+        auto const head = ring.m_head.load(std::memory_order_relaxed);
+        if (head - ring.m_tail.load(std::memory_order_acquire) >= ring_size)
+        {
+            m_dropped_events.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        ring.m_events[head & (ring_size - 1)] = event;
+        ring.m_head.store(head + 1, std::memory_order_release);
+    }
+
+    void consume()
+    {
+        std::vector<std::shared_ptr<Ring>> buffers;
+        for (;;)
+        {
+            bool stop;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait_for(lock, flush_interval, [this]() { return m_stop; });
+                stop = m_stop;
+                buffers = m_buffers;
+            }
+
+            // the tick rate is measured over the whole trace, it only gets more accurate
+            auto const elapsed_ticks = Tick_clock::now() - m_start_ticks;
+            auto const elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_start).count();
+            auto const us_per_tick = elapsed_ticks == 0 ? 0.0 : elapsed / static_cast<double>(elapsed_ticks);
+
+            fmt::memory_buffer out;
+            for (auto const& buffer : buffers)
+            {
+                write_thread_name(out, *buffer);
+                auto tail = buffer->m_tail.load(std::memory_order_relaxed);
+                auto const head = buffer->m_head.load(std::memory_order_acquire);
+                for (; tail != head; ++tail)
+                {
+                    write(out, buffer->m_tid, buffer->m_events[tail & (ring_size - 1)], us_per_tick);
+                }
+                buffer->m_tail.store(tail, std::memory_order_release);
+            }
+            m_file.write(out.data(), static_cast<std::streamsize>(out.size()));
+            m_file.flush();
+
+            {
+                // threads that exited don't write anymore, their drained rings can go
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(), [](auto const& buffer)
+                    {
+                        return buffer->m_retired.load(std::memory_order_acquire) &&
+                            buffer->m_tail.load(std::memory_order_relaxed) == buffer->m_head.load(std::memory_order_acquire);
+                    }), m_buffers.end());
+            }
+            if (stop)
+            {
+                break;
+            }
+        }
+    }
+
+    void write_thread_name(fmt::memory_buffer& out, Ring& buffer)
+    {
+        std::string name;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (buffer.m_named || buffer.m_name.empty())
+            {
+                return;
+            }
+            buffer.m_named = true;
+            name = buffer.m_name;
+        }
+        separator(out);
+        fmt::format_to(std::back_inserter(out), "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"",
+            buffer.m_tid);
+        for (auto const c : name)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out.push_back('\\');
+            }
+            out.push_back(c);
+        }
+        fmt::format_to(std::back_inserter(out), "\"}}}}");
+    }
+
+    void write(fmt::memory_buffer& out, std::uint32_t tid, Event const& event, double us_per_tick)
+    {
+        // events recorded before start (ring leftovers of an earlier run) land at 0
+        auto const ts = event.m_start > m_start_ticks ? static_cast<double>(event.m_start - m_start_ticks) * us_per_tick : 0.0;
+        separator(out);
+        fmt::format_to(std::back_inserter(out), "{{\"name\":\"{}\",\"cat\":\"{}\",\"pid\":1,\"tid\":{},\"ts\":{:.3f}",
+            event.m_name, event.m_category, tid, ts);
+        if (event.m_instant)
+        {
+            fmt::format_to(std::back_inserter(out), ",\"ph\":\"i\",\"s\":\"t\"");
+        }
+        else
+        {
+            fmt::format_to(std::back_inserter(out), ",\"ph\":\"X\",\"dur\":{:.3f}", static_cast<double>(event.m_duration) * us_per_tick);
+        }
+        if (event.m_arg_name)
+        {
+            fmt::format_to(std::back_inserter(out), ",\"args\":{{\"{}\":{}}}", event.m_arg_name, event.m_arg);
+        }
+        out.push_back('}');
+    }
+
+    void separator(fmt::memory_buffer& out)
+    {
+        static constexpr char first[] = "\n";
+        static constexpr char next[] = ",\n";
+        m_first_event ? out.append(first, first + 1) : out.append(next, next + 2);
+        m_first_event = false;
+    }
+
+    std::atomic<bool> m_enabled{ false };
+    std::shared_ptr<spdlog::logger> m_logger;
+    std::ofstream m_file;
+    bool m_first_event{ true };
+    std::uint64_t m_start_ticks{ 0 };
+    std::chrono::steady_clock::time_point m_start{};
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::vector<std::shared_ptr<Ring>> m_buffers;
+    std::uint32_t m_next_tid{ 1 };
+    bool m_stop{ false };
+    std::thread m_consumer;
+    std::atomic<std::uint64_t> m_dropped_events{ 0 };
+};
+
+// Records the scope as a span of the calling thread when tracing is on.
+class Trace_span
+{
+public:
+
+    Trace_span(char const* name, char const* category, char const* arg_name = nullptr, std::uint64_t arg = 0)
+    : m_name{ Event_trace::instance().enabled() ? name : nullptr }
+    , m_category{ category }
+    , m_arg_name{ arg_name }
+    , m_arg{ arg }
+    , m_start{ m_name ? Tick_clock::now() : 0 }
+    {
+    }
+
+    ~Trace_span()
+    {
+        if (m_name)
+        {
+            Event_trace::instance().complete(m_name, m_category, m_start, Tick_clock::now(), m_arg_name, m_arg);
+        }
+    }
+
+    Trace_span(Trace_span const&) = delete;
+    Trace_span& operator=(Trace_span const&) = delete;
+
+private:
+
+    char const* m_name;
+    char const* m_category;
+    char const* m_arg_name;
+    std::uint64_t m_arg;
+    std::uint64_t m_start;
+};
+
+}
+}
+#endif
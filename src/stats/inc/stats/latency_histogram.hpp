@@ -0,0 +1,120 @@
+#ifndef NEXUSMINER_STATS_LATENCY_HISTOGRAM_HPP
+#define NEXUSMINER_STATS_LATENCY_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace nexusminer {
+namespace stats
+{
+
+// Lock free latency histogram in microseconds with HDR style log-linear buckets: latencies below 16us have
+// their own bucket, above that every power of two is split into 8 buckets, so a percentile is never off by
+// more than 12.5%. The last bucket is open ended (above ~36 hours).
+class Latency_histogram
+{
+public:
+
+    static constexpr std::size_t sub_bucket_bits = 3;
+    static constexpr std::size_t sub_bucket_count = std::size_t{ 1 } << sub_bucket_bits;
+    static constexpr std::size_t bucket_count = 35 * sub_bucket_count;
+
+    void record(std::chrono::microseconds latency)
+    {
+        auto const value = latency.count() > 0 ? static_cast<std::uint64_t>(latency.count()) : 0U;
+        m_buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_total.fetch_add(value, std::memory_order_relaxed);
+
+        auto max = m_max.load(std::memory_order_relaxed);
+        while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    std::uint64_t count() const { return m_count.load(std::memory_order_relaxed); }
+    std::chrono::microseconds max() const { return std::chrono::microseconds{ m_max.load(std::memory_order_relaxed) }; }
+    std::chrono::microseconds total() const { return std::chrono::microseconds{ m_total.load(std::memory_order_relaxed) }; }
+
+    std::chrono::microseconds average() const
+    {
+        auto const samples = count();
+        return std::chrono::microseconds{ samples == 0 ? 0 : m_total.load(std::memory_order_relaxed) / samples };
+    }
+
+    // upper bound of the bucket that contains the quantile (0.0 - 1.0), capped at the maximum seen
+    std::chrono::microseconds percentile(double quantile) const
+    {
+        auto const samples = count();
+        if (samples == 0)
+        {
+            return std::chrono::microseconds{ 0 };
+        }
+
+        auto const rank = static_cast<std::uint64_t>(quantile * static_cast<double>(samples - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < bucket_count; ++i)
+        {
+            seen += m_buckets[i].load(std::memory_order_relaxed);
+            if (seen >= rank)
+            {
+                return std::min(bucket_upper_bound(i), max());
+            }
+        }
+        return max();
+    }
+
+    // samples at or below limit us, exact when limit is a bucket upper bound (every value below 2 * sub_bucket_count,
+    // every power of two minus one). Otherwise the bucket that straddles limit is left out.
+    std::uint64_t count_at_or_below(std::uint64_t limit) const
+    {
+        std::uint64_t result = 0;
+        for (std::size_t i = 0; i < bucket_count && bucket_upper_bound(i).count() <= static_cast<std::int64_t>(limit); ++i)
+        {
+            result += m_buckets[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    // largest latency that falls into the bucket
+    static std::chrono::microseconds bucket_upper_bound(std::size_t index)
+    {
+        if (index < 2 * sub_bucket_count)
+        {
+            return std::chrono::microseconds{ index };
+        }
+        auto const shift = index / sub_bucket_count - 1;
+        auto const lower = static_cast<std::uint64_t>(sub_bucket_count + index % sub_bucket_count) << shift;
+        return std::chrono::microseconds{ lower + (std::uint64_t{ 1 } << shift) - 1 };
+    }
+
+private:
+
+    static std::size_t bucket_index(std::uint64_t value)
+    {
+        if (value < 2 * sub_bucket_count)
+        {
+            return static_cast<std::size_t>(value);
+        }
+        std::size_t most_significant_bit = 0;
+        for (auto v = value; v > 1; v >>= 1)
+        {
+            most_significant_bit++;
+        }
+        auto const shift = most_significant_bit - sub_bucket_bits;
+        auto const index = (shift + 1) * sub_bucket_count + static_cast<std::size_t>(value >> shift) - sub_bucket_count;
+        return std::min(index, bucket_count - 1);
+    }
+
+    std::array<std::atomic<std::uint64_t>, bucket_count> m_buckets{};
+    std::atomic<std::uint64_t> m_count{ 0 };
+    std::atomic<std::uint64_t> m_total{ 0 };
+    std::atomic<std::uint64_t> m_max{ 0 };
+};
+
+}
+}
+#endif
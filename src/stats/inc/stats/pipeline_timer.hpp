@@ -0,0 +1,63 @@
+#ifndef NEXUSMINER_STATS_PIPELINE_TIMER_HPP
+#define NEXUSMINER_STATS_PIPELINE_TIMER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "stats/tick_clock.hpp"
+#include "stats/types.hpp"
+
+namespace nexusminer {
+namespace stats
+{
+
+// Stage times of a prime worker. Written by the mining thread only (plain relaxed stores, no locked
+// instructions), read by update_statistics. Ticks are converted to time against steady_clock over the
+// whole lifetime of the timer, so the conversion gets more precise the longer the worker runs.
+class Prime_pipeline_timer
+{
+public:
+
+    enum Stage { sieve = 0, find_chains, fermat, clean_chains, total, stage_count };
+
+    Prime_pipeline_timer()
+    : m_start_ticks{ Tick_clock::now() }
+    , m_start{ std::chrono::steady_clock::now() }
+    {
+    }
+
+    void add(Stage stage, std::uint64_t start_ticks, std::uint64_t stop_ticks)
+    {
+        auto& ticks = m_ticks[stage];
+        ticks.store(ticks.load(std::memory_order_relaxed) + (stop_ticks - start_ticks), std::memory_order_relaxed);
+    }
+
+    // fills the stage times of pipeline, the counts are left alone
+    void get_stages(Prime_pipeline& pipeline) const
+    {
+        auto const elapsed_ticks = Tick_clock::now() - m_start_ticks;
+        auto const elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - m_start).count();
+        auto const ns_per_tick = elapsed_ticks == 0 ? 1.0 : elapsed / static_cast<double>(elapsed_ticks);
+        auto const to_ns = [this, ns_per_tick](Stage stage)
+        {
+            return std::chrono::nanoseconds{ static_cast<std::int64_t>(
+                static_cast<double>(m_ticks[stage].load(std::memory_order_relaxed)) * ns_per_tick) };
+        };
+        pipeline.m_sieve = to_ns(sieve);
+        pipeline.m_find_chains = to_ns(find_chains);
+        pipeline.m_fermat = to_ns(fermat);
+        pipeline.m_clean_chains = to_ns(clean_chains);
+        pipeline.m_total = to_ns(total);
+    }
+
+private:
+
+    std::array<std::atomic<std::uint64_t>, stage_count> m_ticks{};
+    std::uint64_t m_start_ticks;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+}
+}
+#endif
@@ -0,0 +1,131 @@
+#ifndef NEXUSMINER_STATS_RATE_TRACKER_HPP
+#define NEXUSMINER_STATS_RATE_TRACKER_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include "stats/types.hpp"
+
+namespace nexusminer {
+namespace stats
+{
+
+// Turns a monotonic work counter (hashes, integers searched) into rates per second.
+// Keeps a fixed ring of samples spaced at least sample_spacing apart, enough to cover the longest window.
+// Not thread safe, owned by the single writer of a worker counter block.
+class Rate_tracker
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t capacity = 256;
+    static constexpr std::chrono::seconds sample_spacing{ 4 };
+    static constexpr std::chrono::seconds short_window{ 60 };
+    static constexpr std::chrono::seconds long_window{ 15 * 60 };
+    static constexpr std::chrono::seconds ewma_time_constant{ 30 };
+
+    static_assert(capacity * sample_spacing > long_window, "sample ring does not cover the long window");
+
+    Rates update(std::uint64_t total, Clock::time_point now)
+    {
+        if (m_size == 0)
+        {
+            push(total, now);
+            m_last = m_samples[m_newest];
+            return m_rates;
+        }
+
+        auto const elapsed = seconds(now - m_last.m_time);
+        if (elapsed <= 0.0)
+        {
+            return m_rates;
+        }
+
+        m_rates.m_instant = static_cast<double>(total - m_last.m_total) / elapsed;
+        m_rates.m_ewma = m_ewma_started
+            ? m_rates.m_ewma + (1.0 - std::exp(-elapsed / seconds(ewma_time_constant))) * (m_rates.m_instant - m_rates.m_ewma)
+            : m_rates.m_instant;
+        m_ewma_started = true;
+        m_last = Sample{ now, total };
+
+        if (now - m_samples[m_newest].m_time >= sample_spacing)
+        {
+            push(total, now);
+        }
+        m_rates.m_short = window_rate(total, now, short_window);
+        m_rates.m_long = window_rate(total, now, long_window);
+        return m_rates;
+    }
+
+private:
+
+    struct Sample
+    {
+        Clock::time_point m_time{};
+        std::uint64_t m_total{ 0 };
+    };
+
+    static double seconds(Clock::duration duration)
+    {
+        return std::chrono::duration<double>(duration).count();
+    }
+
+    void push(std::uint64_t total, Clock::time_point now)
+    {
+        m_newest = m_size == 0 ? 0 : (m_newest + 1) % capacity;
+        m_samples[m_newest] = Sample{ now, total };
+        m_size = std::min(m_size + 1, capacity);
+    }
+
+    // rate since the newest sample that is at least window old, or since the oldest sample while the
+    // ring does not reach that far back yet
+    double window_rate(std::uint64_t total, Clock::time_point now, Clock::duration window) const
+    {
+        auto const* start = &m_samples[(m_newest + capacity - (m_size - 1)) % capacity];
+        for (std::size_t i = 0; i < m_size; ++i)
+        {
+            auto const& sample = m_samples[(m_newest + capacity - i) % capacity];
+            if (now - sample.m_time >= window)
+            {
+                start = &sample;
+                break;
+            }
+        }
+
+        auto const elapsed = seconds(now - start->m_time);
+        return elapsed > 0.0 ? static_cast<double>(total - start->m_total) / elapsed : m_rates.m_instant;
+    }
+
+    std::array<Sample, capacity> m_samples{};
+    std::size_t m_newest{ 0 };
+    std::size_t m_size{ 0 };
+    Sample m_last{};
+    bool m_ewma_started{ false };
+    Rates m_rates{};
+};
+
+// Folds a worker counter into a monotonic total. Workers publish lifetime counts and never reset them on a new
+// block, a count that goes down (a restarted device, ...) continues from its new value.
+class Monotonic_counter
+{
+public:
+
+    std::uint64_t update(std::uint64_t value)
+    {
+        m_total += value >= m_last_value ? value - m_last_value : value;
+        m_last_value = value;
+        return m_total;
+    }
+
+private:
+
+    std::uint64_t m_last_value{ 0 };
+    std::uint64_t m_total{ 0 };
+};
+
+}
+}
+#endif
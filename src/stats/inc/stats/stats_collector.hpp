@@ -2,11 +2,11 @@
 #define NEXUSMINER_STATS_COLLECTOR_HPP
 
 #include "stats/types.hpp"
+#include "stats/worker_counters.hpp"
 #include <memory>
 #include <vector>
 #include <variant>
 #include <chrono>
-#include <mutex>
 
 namespace nexusminer {
 namespace config { class Config; }
@@ -18,16 +18,29 @@ public:
 
 	Collector(config::Config& config);
 
+    // Lock free and allocation free. Every worker (and its work switch counters) must only be published
+    // from one thread at a time, the global stats can be updated from any thread.
     void update_global_stats(Global const& stats);
     void update_worker_stats(std::uint16_t internal_worker_id, Hash const& stats);
     void update_worker_stats(std::uint16_t internal_worker_id, Prime const& stats);
-    // copy of workers stats
-    std::vector<std::variant<Hash, Prime>> get_workers_stats() const { return m_workers; }
-    std::variant<Hash, Prime> get_worker_stats(std::uint32_t internal_worker_id) { return m_workers[internal_worker_id]; }
+    void update_work_switch_stats(std::uint16_t internal_worker_id, std::chrono::microseconds latency);
+    // a config reload changed the workers: counters for worker_count workers, the replaced ones start from zero.
+    // Only while no worker publishes, i.e. from the io thread with the work distributor stopped.
+    void update_workers(std::size_t worker_count, std::vector<std::uint16_t> const& replaced);
+    // consistent snapshot per worker
+    std::vector<std::variant<Hash, Prime>> get_workers_stats() const;
+    std::variant<Hash, Prime> get_worker_stats(std::uint32_t internal_worker_id) const;
+    std::vector<Work_switch> get_work_switch_stats() const;
     std::chrono::duration<double> get_elapsed_time_seconds() const { return 
         std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - m_start_time); }
 
-    Global get_global_stats() const { return m_global_stats; }
+    Global get_global_stats() const { return m_global_stats.snapshot(); }
+
+    // histograms are lock free, updated from the io and signing threads
+    Submit_latency& get_submit_latency() { return m_submit_latency; }
+    Submit_latency const& get_submit_latency() const { return m_submit_latency; }
+    Block_latency& get_block_latency() { return m_block_latency; }
+    Block_latency const& get_block_latency() const { return m_block_latency; }
     
     // Log summary of all worker statistics
     void log_summary();
@@ -36,16 +49,16 @@ public:
 private:
 
     config::Config& m_config;
-    std::vector<std::variant<Hash, Prime>> m_workers;
+    // one heap block per worker, the counter blocks never move
+    std::vector<std::unique_ptr<Hash_counters>> m_hash_workers;
+    std::vector<std::unique_ptr<Prime_counters>> m_prime_workers;
+    std::vector<std::unique_ptr<Work_switch_counters>> m_work_switches;
 
-    Global m_global_stats;
+    Global_counters m_global_stats;
+    Submit_latency m_submit_latency;
+    Block_latency m_block_latency;
     std::chrono::steady_clock::time_point m_start_time;
 
-    // worker stats are updated in seperate worker threads
-    // the access to the worker data (form stats_printer) has to be protected
-    std::mutex m_worker_mutex;
-
-
 };
 
 }
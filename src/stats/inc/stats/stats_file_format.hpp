@@ -0,0 +1,149 @@
+#ifndef NEXUSMINER_STATS_STATS_FILE_FORMAT_HPP
+#define NEXUSMINER_STATS_STATS_FILE_FORMAT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace nexusminer {
+namespace stats
+{
+// Layout of the binary stats file written by Printer_binary and read by the stats_reader tool.
+// File_header, worker_count Worker_info entries, then a ring of capacity fixed size records starting at
+// m_header_size. A record is a Record_header followed by worker_count Worker_record entries. All fields are
+// little endian and naturally aligned, new fields only go into the reserved space or a new version.
+namespace stats_file
+{
+
+constexpr std::array<char, 8> magic{ 'N', 'X', 'S', 'T', 'A', 'T', 'S', '\0' };
+constexpr std::uint32_t version = 1;
+constexpr std::size_t worker_id_size = 32;
+
+// latency histograms of the collector in record order
+enum Latency
+{
+    sign_queue = 0,
+    sign,
+    find_to_transmit,
+    template_validate,
+    validated_to_mining,
+    found_to_checked,
+    checked_to_signed,
+    signed_to_transmit,
+    submit_to_result,
+    latency_count
+};
+
+constexpr std::array<char const*, latency_count> latency_names{ "sign_queue", "sign", "find_to_transmit",
+    "template_validate", "validated_to_mining", "found_to_checked", "checked_to_signed", "signed_to_transmit",
+    "submit_to_result" };
+
+struct File_header
+{
+    std::array<char, 8> m_magic;
+    std::uint32_t m_version;
+    std::uint32_t m_header_size;    // offset of the first record
+    std::uint32_t m_record_size;
+    std::uint32_t m_capacity;       // records in the ring
+    std::uint32_t m_worker_count;
+    std::uint32_t m_interval;       // seconds between records
+    std::uint8_t m_mining_mode;     // config::Mining_mode
+    std::uint8_t m_pool;
+    std::array<std::uint8_t, 6> m_reserved;
+    std::int64_t m_start_time;      // unix time in ms
+    std::uint64_t m_record_count;   // records written so far, the newest is at (m_record_count - 1) % m_capacity
+};
+
+struct Worker_info
+{
+    std::array<char, worker_id_size> m_id;     // zero terminated, truncated
+    std::uint8_t m_mode;    // config::Worker_mode
+    std::array<std::uint8_t, 7> m_reserved;
+};
+
+// cumulative since start, percentiles as in Latency_histogram
+struct Latency_summary
+{
+    std::uint64_t m_count;
+    std::uint64_t m_total_us;
+    std::uint64_t m_p50_us;
+    std::uint64_t m_p99_us;
+    std::uint64_t m_max_us;
+};
+
+struct Record_header
+{
+    std::uint64_t m_sequence;       // m_record_count of the record + 1, 0 while it is written
+    std::int64_t m_time;            // unix time in ms
+    std::uint64_t m_elapsed_ms;     // since the miner started
+    std::uint32_t m_accepted_blocks;
+    std::uint32_t m_rejected_blocks;
+    std::uint32_t m_accepted_shares;
+    std::uint32_t m_rejected_shares;
+    std::uint32_t m_connection_retries;
+    std::uint32_t m_reserved;
+    std::array<Latency_summary, latency_count> m_latency;
+};
+
+// both hash and prime fields, the ones of the other mining mode stay zero
+struct Worker_record
+{
+    double m_rate_instant;
+    double m_rate_short;
+    double m_rate_long;
+    double m_rate_ewma;
+
+    // hash
+    std::uint64_t m_hash_count;
+    std::int32_t m_best_leading_zeros;
+    std::int32_t m_met_difficulty_count;
+    std::int32_t m_nonce_candidates;
+    std::int32_t m_hash_errors;
+
+    // prime
+    std::uint64_t m_range_searched;
+    std::uint32_t m_primes;
+    std::uint32_t m_chains;
+    std::uint32_t m_difficulty;
+    std::uint32_t m_reserved;
+    double m_most_difficult_chain;
+    double m_cpu_load;
+    std::array<std::uint32_t, 10> m_chain_histogram;
+    std::int64_t m_sieve_ns;
+    std::int64_t m_find_chains_ns;
+    std::int64_t m_fermat_ns;
+    std::int64_t m_clean_chains_ns;
+    std::int64_t m_total_ns;
+    std::uint64_t m_fermat_tests;
+    std::uint64_t m_fermat_passes;
+    std::uint64_t m_pipeline_chains;
+
+    // block switches
+    std::uint32_t m_switch_count;
+    std::uint32_t m_reserved_switch;
+    std::int64_t m_switch_last_us;
+    std::int64_t m_switch_max_us;
+    std::int64_t m_switch_total_us;
+};
+
+static_assert(std::is_trivially_copyable<File_header>::value && sizeof(File_header) == 56, "stats file layout changed");
+static_assert(std::is_trivially_copyable<Worker_info>::value && sizeof(Worker_info) == 40, "stats file layout changed");
+static_assert(std::is_trivially_copyable<Record_header>::value && sizeof(Record_header) == 408, "stats file layout changed");
+static_assert(std::is_trivially_copyable<Worker_record>::value && sizeof(Worker_record) == 232, "stats file layout changed");
+
+// records start cache line aligned
+inline std::size_t header_size(std::size_t worker_count)
+{
+    return (sizeof(File_header) + worker_count * sizeof(Worker_info) + 63) / 64 * 64;
+}
+
+inline std::size_t record_size(std::size_t worker_count)
+{
+    return sizeof(Record_header) + worker_count * sizeof(Worker_record);
+}
+
+}
+}
+}
+#endif
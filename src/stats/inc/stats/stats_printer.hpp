@@ -18,8 +18,34 @@ public:
     virtual ~Printer() = default;
 
     virtual void print() = 0;
+
+    // a config reload changed the workers or the print interval, the worker config the printer references is updated
+    virtual void reload(std::uint16_t interval) { (void)interval; }
 };
 
+// p50/p99/max in ms of the block lifecycle intervals that have samples
+inline std::string print_block_latency(Block_latency const& block_latency)
+{
+    std::stringstream ss;
+    ss << std::setprecision(2) << std::fixed;
+    auto const print_latency = [&ss](char const* name, Latency_histogram const& histogram)
+    {
+        if (histogram.count() > 0)
+        {
+            ss << " " << name << " " << histogram.percentile(0.5).count() / 1000.0 << "/"
+                << histogram.percentile(0.99).count() / 1000.0 << "/" << histogram.max().count() / 1000.0;
+        }
+    };
+    print_latency("received->validated", block_latency.m_template_validate);
+    print_latency("validated->mining", block_latency.m_validated_to_mining);
+    print_latency("found->checked", block_latency.m_found_to_checked);
+    print_latency("checked->signed", block_latency.m_checked_to_signed);
+    print_latency("signed->transmit", block_latency.m_signed_to_transmit);
+    print_latency("submit->result", block_latency.m_submit_to_result);
+    auto const result = ss.str();
+    return result.empty() ? result : "Block lifecycle ms (p50/p99/max):" + result + "\n";
+}
+
 class Printer_solo
 {
 public:
@@ -34,6 +60,22 @@ public:
             << " rejected: " << global_stats.m_rejected_blocks;
         ss << " Connection retries: " << global_stats.m_connection_retries << std::endl;
 
+        auto const& submit_latency = stats_collector.get_submit_latency();
+        if (submit_latency.m_find_to_transmit.count() > 0)
+        {
+            auto const print_latency = [&ss](char const* name, Latency_histogram const& histogram)
+            {
+                ss << " " << name << " " << histogram.percentile(0.5).count() / 1000.0 << "/"
+                    << histogram.percentile(0.99).count() / 1000.0 << "/" << histogram.max().count() / 1000.0;
+            };
+            ss << "Block submit latency ms (p50/p99/max):";
+            print_latency("sign queue", submit_latency.m_sign_queue);
+            print_latency("sign", submit_latency.m_sign);
+            print_latency("found->transmit", submit_latency.m_find_to_transmit);
+            ss << std::endl;
+        }
+        ss << print_block_latency(stats_collector.get_block_latency());
+
         return ss.str();
     }
 };
@@ -51,6 +93,7 @@ public:
         ss << " Shares accepted: " << global_stats.m_accepted_shares
             << " rejected: " << global_stats.m_rejected_shares;
         ss << " Connection retries: " << global_stats.m_connection_retries << std::endl;
+        ss << print_block_latency(stats_collector.get_block_latency());
 
         return ss.str();
     }
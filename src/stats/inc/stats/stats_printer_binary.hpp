@@ -0,0 +1,60 @@
+#ifndef NEXUSMINER_STATS_PRINTER_BINARY_HPP
+#define NEXUSMINER_STATS_PRINTER_BINARY_HPP
+
+#include "stats/stats_printer.hpp"
+#include "stats/stats_collector.hpp"
+#include "config/types.hpp"
+#include "config/worker_config.hpp"
+#include "config/stats_printer_config.hpp"
+#include <spdlog/spdlog.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nexusminer {
+namespace stats
+{
+
+class Mapped_file;
+
+// Appends every counter of the collector as one fixed size record per print to a memory mapped ring file
+// (layout in stats_file_format.hpp). The file is sized once when the printer starts, a print is a copy into
+// the mapping without any formatting or file io. Every run gets its own file, the start time is added to the
+// configured name. Export with the stats_reader tool.
+class Printer_binary : public Printer
+{
+public:
+
+    Printer_binary(config::Stats_printer_config_binary const& config, config::Mining_mode mining_mode, bool pool,
+        std::uint16_t interval, std::vector<config::Worker_config> const& worker_config, Collector& stats_collector);
+    ~Printer_binary();
+
+    // create and map the file, false if that fails
+    bool start();
+
+    void print() override;
+    // the record layout depends on the workers, a new run file starts
+    void reload(std::uint16_t interval) override;
+
+private:
+
+    config::Stats_printer_config_binary m_config;
+    config::Mining_mode m_mining_mode;
+    bool m_pool;
+    std::uint16_t m_interval;
+    std::vector<config::Worker_config> const& m_worker_config;
+    Collector& m_stats_collector;
+    std::shared_ptr<spdlog::logger> m_logger;
+
+    std::unique_ptr<Mapped_file> m_file;
+    std::size_t m_header_size{ 0 };
+    std::size_t m_record_size{ 0 };
+    std::uint32_t m_capacity{ 0 };
+    std::uint64_t m_record_count{ 0 };
+    std::vector<std::uint8_t> m_record;
+};
+
+}
+}
+#endif
@@ -50,6 +50,7 @@ inline void Printer_console<PrinterType>::print()
     auto const globals_string = PrinterType::print_global(m_stats_collector);
 
     auto const workers = m_stats_collector.get_workers_stats();
+    auto const work_switches = m_stats_collector.get_work_switch_stats();
     std::stringstream ss;
     ss << globals_string;
 
@@ -61,7 +62,9 @@ inline void Printer_console<PrinterType>::print()
         if (m_mining_mode == config::Mining_mode::HASH)
         {
             auto& hash_stats = std::get<Hash>(worker);
-            ss << std::setprecision(2) << std::fixed << (hash_stats.m_hash_count / static_cast<double>(m_stats_collector.get_elapsed_time_seconds().count())) / 1.0e6 << "MH/s. ";
+            auto const& rates = hash_stats.m_rates;
+            ss << std::setprecision(2) << std::fixed << rates.m_short / 1.0e6 << "MH/s (now/15m/ewma " << rates.m_instant / 1.0e6
+                << "/" << rates.m_long / 1.0e6 << "/" << rates.m_ewma / 1.0e6 << "). ";
             ss << (m_worker_config[worker_config_index].m_mode == config::Worker_mode::FPGA ? hash_stats.m_nonce_candidates_recieved : hash_stats.m_met_difficulty_count)
                 << " candidates found. Most difficult: " << hash_stats.m_best_leading_zeros;
             if (m_worker_config[worker_config_index].m_mode == config::Worker_mode::FPGA)
@@ -73,7 +76,9 @@ inline void Printer_console<PrinterType>::print()
             auto& prime_stats = std::get<Prime>(worker);
             ss << std::setprecision(2) << std::fixed;
             //GISPS = Billion integers searched per second
-            ss << (prime_stats.m_range_searched / (1.0e9 * static_cast<double>(m_stats_collector.get_elapsed_time_seconds().count()))) << " GISPS ";
+            auto const& rates = prime_stats.m_rates;
+            ss << rates.m_short / 1.0e9 << " GISPS (now/15m/ewma " << rates.m_instant / 1.0e9 << "/" << rates.m_long / 1.0e9
+                << "/" << rates.m_ewma / 1.0e9 << ") ";
             ss << "Chain Count: ";
             for (auto i=5; i< prime_stats.m_chain_histogram.size(); i++)
             {
@@ -81,6 +86,21 @@ inline void Printer_console<PrinterType>::print()
             }
             ss << " Best " << prime_stats.m_most_difficult_chain;
             ss << " Current Difficulty " << prime_stats.m_difficulty / 10000000.0;
+            auto const& pipeline = prime_stats.m_pipeline;
+            if (pipeline.m_total.count() > 0)
+            {
+                ss << " Stages % (sieve/find/fermat/clean): " << 100.0 * pipeline.share(pipeline.m_sieve) << "/"
+                    << 100.0 * pipeline.share(pipeline.m_find_chains) << "/" << 100.0 * pipeline.share(pipeline.m_fermat) << "/"
+                    << 100.0 * pipeline.share(pipeline.m_clean_chains);
+                ss << " Fermat pass " << 100.0 * pipeline.fermat_pass_rate() << "% Tests/chain " << pipeline.fermat_tests_per_chain()
+                    << " Chains/M " << prime_stats.chains_per_million();
+            }
+        }
+        if (worker_config_index < work_switches.size() && work_switches[worker_config_index].m_switch_count > 0)
+        {
+            auto const& work_switch = work_switches[worker_config_index];
+            ss << " Block switch ms (last/avg/max): " << work_switch.m_last_latency.count() / 1000.0 << "/"
+                << work_switch.average_latency().count() / 1000.0 << "/" << work_switch.m_max_latency.count() / 1000.0;
         }
         worker_config_index++;
         if (worker_config_index < workers.size())
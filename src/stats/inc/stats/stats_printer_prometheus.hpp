@@ -0,0 +1,77 @@
+#ifndef NEXUSMINER_STATS_PRINTER_PROMETHEUS_HPP
+#define NEXUSMINER_STATS_PRINTER_PROMETHEUS_HPP
+
+#include "stats/stats_printer.hpp"
+#include "stats/stats_collector.hpp"
+#include "config/worker_config.hpp"
+#include "config/stats_printer_config.hpp"
+#include "network/socket_factory.hpp"
+#include <spdlog/spdlog.h>
+#include <array>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nexusminer {
+namespace stats
+{
+
+// Serves the collector as OpenMetrics (or Prometheus text format 0.0.4 for older scrapers) at /metrics.
+// Runs on the io_context like every other connection. A rendered exposition is cached and shared by all
+// scrapes within min_render_interval, a scrape only costs the response header.
+class Printer_prometheus : public Printer, public std::enable_shared_from_this<Printer_prometheus>
+{
+public:
+
+    static constexpr std::chrono::seconds min_render_interval{ 1 };
+    static constexpr std::size_t max_request_size = 8 * 1024;
+    static constexpr std::size_t max_connections = 32;
+
+    Printer_prometheus(network::Socket_factory::Sptr socket_factory, config::Stats_printer_config_prometheus const& config,
+        bool pool, std::vector<config::Worker_config> const& worker_config, Collector& stats_collector);
+
+    // start listening, false if the address can't be bound
+    bool start();
+
+    // keeps the cached exposition warm, scrapes between two prints only render if it got stale
+    void print() override;
+
+private:
+
+    enum Format { openmetrics = 0, text = 1, format_count };
+
+    struct Session
+    {
+        network::Connection::Sptr m_connection;
+        std::string m_request;
+    };
+
+    network::Connection::Handler accept(network::Connection::Sptr&& connection);
+    void receive(std::uint64_t session_id, network::Payload const& data);
+    void respond(Session& session, std::string const& request);
+    void transmit(Session& session, std::string const& status, std::string const& content_type,
+        network::Shared_payload body, bool head);
+
+    network::Shared_payload const& exposition(Format format);
+    network::Shared_payload render(Format format) const;
+
+    network::Socket_factory::Sptr m_socket_factory;
+    config::Stats_printer_config_prometheus m_config;
+    bool m_pool;
+    std::vector<config::Worker_config> const& m_worker_config;
+    Collector& m_stats_collector;
+    std::shared_ptr<spdlog::logger> m_logger;
+    network::Socket::Sptr m_socket;
+
+    std::map<std::uint64_t, Session> m_sessions;
+    std::uint64_t m_next_session_id{ 0 };
+
+    std::array<network::Shared_payload, format_count> m_exposition;
+    std::array<std::chrono::steady_clock::time_point, format_count> m_rendered;
+};
+
+}
+}
+#endif
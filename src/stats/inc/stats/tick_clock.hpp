@@ -0,0 +1,36 @@
+#ifndef NEXUSMINER_STATS_TICK_CLOCK_HPP
+#define NEXUSMINER_STATS_TICK_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define NEXUSMINER_HAS_RDTSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define NEXUSMINER_HAS_RDTSC 1
+#endif
+
+namespace nexusminer {
+namespace stats
+{
+
+// Timestamps for hot loops. Reads the time stamp counter on x86 (constant rate on every CPU that can mine,
+// a few ns and no serialisation), steady_clock in ns elsewhere.
+struct Tick_clock
+{
+    static std::uint64_t now()
+    {
+#ifdef NEXUSMINER_HAS_RDTSC
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+};
+
+}
+}
+#endif
@@ -7,6 +7,8 @@
 #include <variant>
 #include <chrono>
 #include <mutex>
+#include <algorithm>
+#include "stats/latency_histogram.hpp"
 
 namespace nexusminer {
 namespace stats
@@ -32,13 +34,65 @@ struct Global
     }
 };
 
+// time from a new block arriving until a worker has switched to it
+struct Work_switch
+{
+    std::uint32_t m_switch_count{ 0 };
+    std::chrono::microseconds m_last_latency{ 0 };
+    std::chrono::microseconds m_max_latency{ 0 };
+    std::chrono::microseconds m_total_latency{ 0 };
+
+    void add(std::chrono::microseconds latency)
+    {
+        m_switch_count++;
+        m_last_latency = latency;
+        m_max_latency = std::max(m_max_latency, latency);
+        m_total_latency += latency;
+    }
+
+    std::chrono::microseconds average_latency() const
+    {
+        return m_switch_count == 0 ? std::chrono::microseconds{ 0 } : m_total_latency / m_switch_count;
+    }
+};
+
+// block submission path, found block -> Falcon signature -> handed to the connection
+struct Submit_latency
+{
+    Latency_histogram m_sign_queue;         // waiting for the signing thread
+    Latency_histogram m_sign;               // Falcon signature generation
+    Latency_histogram m_find_to_transmit;   // block found until queued for transmission
+};
+
+// block lifecycle, from a new template until the node answered the submission. Found blocks and shares
+// are timed by the worker that found them, the rest on the io, dispatcher and signing threads.
+struct Block_latency
+{
+    Latency_histogram m_template_validate;      // template packet received until validated and handed to the workers
+    Latency_histogram m_validated_to_mining;    // handed to the workers until a worker mines on it, one sample per worker
+    Latency_histogram m_found_to_checked;       // candidate found by the search until it passed the difficulty check
+    Latency_histogram m_checked_to_signed;      // difficulty checked until the submission is signed (pool: encoded)
+    Latency_histogram m_signed_to_transmit;     // signed until queued on the connection
+    Latency_histogram m_submit_to_result;       // queued on the connection until BLOCK_ACCEPTED / BLOCK_REJECTED
+};
+
+// work per second of a worker (hashes or integers searched), see Rate_tracker
+struct Rates
+{
+    double m_instant{ 0.0 };    // since the previous stats update
+    double m_short{ 0.0 };      // 1 minute window
+    double m_long{ 0.0 };       // 15 minute window
+    double m_ewma{ 0.0 };       // exponentially weighted, 30s time constant
+};
+
 struct Hash
 {
-    std::uint64_t m_hash_count{0};
+    std::uint64_t m_hash_count{0};      // monotonic once published, block changes don't reset it
     int m_best_leading_zeros{0};
     int m_met_difficulty_count{0};
     int m_nonce_candidates_recieved{0};
     int m_hash_error_count{0};
+    Rates m_rates{};    // filled in by the collector
 
     Hash() = default;
 
@@ -49,6 +103,7 @@ struct Hash
         m_met_difficulty_count = other.m_met_difficulty_count;
         m_nonce_candidates_recieved = other.m_nonce_candidates_recieved;
         m_hash_error_count = other.m_hash_error_count;
+        m_rates = other.m_rates;
     }
 
     Hash& operator+=(Hash const& other)
@@ -62,15 +117,54 @@ struct Hash
     }
 };
 
+// Prime pipeline stages of one worker. Times are cumulative since start, the counts are raw sieve counters
+// (reset on every block) until the collector folds them into totals.
+struct Prime_pipeline
+{
+    std::chrono::nanoseconds m_sieve{ 0 };
+    std::chrono::nanoseconds m_find_chains{ 0 };
+    std::chrono::nanoseconds m_fermat{ 0 };
+    std::chrono::nanoseconds m_clean_chains{ 0 };   // GPU only
+    std::chrono::nanoseconds m_total{ 0 };          // whole mining loop, the rest goes to difficulty checks and bookkeeping
+    std::uint64_t m_fermat_tests{ 0 };
+    std::uint64_t m_fermat_passes{ 0 };
+    std::uint64_t m_chains{ 0 };
+
+    double fermat_pass_rate() const
+    {
+        return m_fermat_tests == 0 ? 0.0 : static_cast<double>(m_fermat_passes) / static_cast<double>(m_fermat_tests);
+    }
+
+    double fermat_tests_per_chain() const
+    {
+        return m_chains == 0 ? 0.0 : static_cast<double>(m_fermat_tests) / static_cast<double>(m_chains);
+    }
+
+    // share of the mining loop spent in a stage
+    double share(std::chrono::nanoseconds stage) const
+    {
+        return m_total.count() == 0 ? 0.0 : static_cast<double>(stage.count()) / static_cast<double>(m_total.count());
+    }
+};
+
 struct Prime
 {
+    static constexpr std::size_t chain_histogram_size = 10;
+
     std::uint32_t m_primes{ 0 };
     std::uint32_t m_chains{ 0 };
     std::uint32_t m_difficulty{ 0 };
-    std::uint64_t m_range_searched { 0 };
+    std::uint64_t m_range_searched { 0 };    // monotonic once published
     double m_most_difficult_chain{ 0.0 };
     double m_cpu_load{ 0.0 };  // estimated CPU load in [0.0, 1.0]
-    std::vector<std::uint32_t> m_chain_histogram{0,0,0,0,0,0,0,0,0,0};
+    std::array<std::uint32_t, chain_histogram_size> m_chain_histogram{};
+    Rates m_rates{};    // filled in by the collector
+    Prime_pipeline m_pipeline{};
+
+    double chains_per_million() const
+    {
+        return m_range_searched == 0 ? 0.0 : 1.0e6 * static_cast<double>(m_pipeline.m_chains) / static_cast<double>(m_range_searched);
+    }
 
     Prime& operator+=(Prime const& other)
     {
@@ -0,0 +1,334 @@
+#ifndef NEXUSMINER_STATS_WORKER_COUNTERS_HPP
+#define NEXUSMINER_STATS_WORKER_COUNTERS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include "stats/types.hpp"
+#include "stats/rate_tracker.hpp"
+
+namespace nexusminer {
+namespace stats
+{
+
+constexpr std::size_t cache_line_size = 64;
+
+// Single writer sequence lock. The writer never blocks or allocates, readers retry while a write is in progress.
+// The protected fields have to be atomics accessed with relaxed ordering so a torn read is never undefined behaviour,
+// the sequence check throws such a read away.
+class Seqlock
+{
+public:
+
+    template<typename Write>
+    void write(Write&& write)
+    {
+        auto const sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        write();
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    template<typename Read>
+    auto read(Read&& read) const
+    {
+        for (;;)
+        {
+            auto const sequence = m_sequence.load(std::memory_order_acquire);
+            if ((sequence & 1U) == 0)
+            {
+                auto result = read();
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_sequence.load(std::memory_order_relaxed) == sequence)
+                {
+                    return result;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+private:
+
+    std::atomic<std::uint32_t> m_sequence{ 0 };
+};
+
+// Published rates, only accessed under the Seqlock of the owning block.
+class Rate_counters
+{
+public:
+
+    void store(Rates const& rates)
+    {
+        m_instant.store(rates.m_instant, std::memory_order_relaxed);
+        m_short.store(rates.m_short, std::memory_order_relaxed);
+        m_long.store(rates.m_long, std::memory_order_relaxed);
+        m_ewma.store(rates.m_ewma, std::memory_order_relaxed);
+    }
+
+    Rates load() const
+    {
+        Rates rates;
+        rates.m_instant = m_instant.load(std::memory_order_relaxed);
+        rates.m_short = m_short.load(std::memory_order_relaxed);
+        rates.m_long = m_long.load(std::memory_order_relaxed);
+        rates.m_ewma = m_ewma.load(std::memory_order_relaxed);
+        return rates;
+    }
+
+private:
+
+    std::atomic<double> m_instant{ 0.0 };
+    std::atomic<double> m_short{ 0.0 };
+    std::atomic<double> m_long{ 0.0 };
+    std::atomic<double> m_ewma{ 0.0 };
+};
+
+// Published prime pipeline stages, only accessed under the Seqlock of the owning block.
+class Pipeline_counters
+{
+public:
+
+    void store(Prime_pipeline const& pipeline)
+    {
+        m_sieve.store(pipeline.m_sieve.count(), std::memory_order_relaxed);
+        m_find_chains.store(pipeline.m_find_chains.count(), std::memory_order_relaxed);
+        m_fermat.store(pipeline.m_fermat.count(), std::memory_order_relaxed);
+        m_clean_chains.store(pipeline.m_clean_chains.count(), std::memory_order_relaxed);
+        m_total.store(pipeline.m_total.count(), std::memory_order_relaxed);
+        m_fermat_tests.store(pipeline.m_fermat_tests, std::memory_order_relaxed);
+        m_fermat_passes.store(pipeline.m_fermat_passes, std::memory_order_relaxed);
+        m_chains.store(pipeline.m_chains, std::memory_order_relaxed);
+    }
+
+    Prime_pipeline load() const
+    {
+        Prime_pipeline pipeline;
+        pipeline.m_sieve = std::chrono::nanoseconds{ m_sieve.load(std::memory_order_relaxed) };
+        pipeline.m_find_chains = std::chrono::nanoseconds{ m_find_chains.load(std::memory_order_relaxed) };
+        pipeline.m_fermat = std::chrono::nanoseconds{ m_fermat.load(std::memory_order_relaxed) };
+        pipeline.m_clean_chains = std::chrono::nanoseconds{ m_clean_chains.load(std::memory_order_relaxed) };
+        pipeline.m_total = std::chrono::nanoseconds{ m_total.load(std::memory_order_relaxed) };
+        pipeline.m_fermat_tests = m_fermat_tests.load(std::memory_order_relaxed);
+        pipeline.m_fermat_passes = m_fermat_passes.load(std::memory_order_relaxed);
+        pipeline.m_chains = m_chains.load(std::memory_order_relaxed);
+        return pipeline;
+    }
+
+private:
+
+    std::atomic<std::int64_t> m_sieve{ 0 };
+    std::atomic<std::int64_t> m_find_chains{ 0 };
+    std::atomic<std::int64_t> m_fermat{ 0 };
+    std::atomic<std::int64_t> m_clean_chains{ 0 };
+    std::atomic<std::int64_t> m_total{ 0 };
+    std::atomic<std::uint64_t> m_fermat_tests{ 0 };
+    std::atomic<std::uint64_t> m_fermat_passes{ 0 };
+    std::atomic<std::uint64_t> m_chains{ 0 };
+};
+
+// Counter block of one hash worker. Each block sits on its own cache lines so that publishing workers never share a line.
+class alignas(cache_line_size) Hash_counters
+{
+public:
+
+    // workers publish a lifetime hash count, the published count keeps growing even if a worker's count restarts
+    void publish(Hash const& stats)
+    {
+        auto const hash_count = m_monotonic_hash_count.update(stats.m_hash_count);
+        auto const rates = m_rate_tracker.update(hash_count, Rate_tracker::Clock::now());
+        m_lock.write([this, &stats, hash_count, &rates]()
+        {
+            m_hash_count.store(hash_count, std::memory_order_relaxed);
+            m_rates.store(rates);
+            m_best_leading_zeros.store(stats.m_best_leading_zeros, std::memory_order_relaxed);
+            m_met_difficulty_count.store(stats.m_met_difficulty_count, std::memory_order_relaxed);
+            m_nonce_candidates_recieved.store(stats.m_nonce_candidates_recieved, std::memory_order_relaxed);
+            m_hash_error_count.store(stats.m_hash_error_count, std::memory_order_relaxed);
+        });
+    }
+
+    Hash snapshot() const
+    {
+        return m_lock.read([this]()
+        {
+            Hash stats;
+            stats.m_hash_count = m_hash_count.load(std::memory_order_relaxed);
+            stats.m_best_leading_zeros = m_best_leading_zeros.load(std::memory_order_relaxed);
+            stats.m_met_difficulty_count = m_met_difficulty_count.load(std::memory_order_relaxed);
+            stats.m_nonce_candidates_recieved = m_nonce_candidates_recieved.load(std::memory_order_relaxed);
+            stats.m_hash_error_count = m_hash_error_count.load(std::memory_order_relaxed);
+            stats.m_rates = m_rates.load();
+            return stats;
+        });
+    }
+
+private:
+
+    Seqlock m_lock;
+    std::atomic<std::uint64_t> m_hash_count{ 0 };
+    std::atomic<int> m_best_leading_zeros{ 0 };
+    std::atomic<int> m_met_difficulty_count{ 0 };
+    std::atomic<int> m_nonce_candidates_recieved{ 0 };
+    std::atomic<int> m_hash_error_count{ 0 };
+    Rate_counters m_rates;
+
+    // writer side only
+    Monotonic_counter m_monotonic_hash_count;
+    Rate_tracker m_rate_tracker;
+};
+
+// Counter block of one prime worker, the chain histogram is published together with the counters.
+class alignas(cache_line_size) Prime_counters
+{
+public:
+
+    void publish(Prime const& stats)
+    {
+        auto const range_searched = m_monotonic_range_searched.update(stats.m_range_searched);
+        auto const rates = m_rate_tracker.update(range_searched, Rate_tracker::Clock::now());
+        auto pipeline = stats.m_pipeline;
+        pipeline.m_fermat_tests = m_monotonic_fermat_tests.update(pipeline.m_fermat_tests);
+        pipeline.m_fermat_passes = m_monotonic_fermat_passes.update(pipeline.m_fermat_passes);
+        pipeline.m_chains = m_monotonic_chains.update(pipeline.m_chains);
+        m_lock.write([this, &stats, range_searched, &rates, &pipeline]()
+        {
+            m_primes.store(stats.m_primes, std::memory_order_relaxed);
+            m_chains.store(stats.m_chains, std::memory_order_relaxed);
+            m_difficulty.store(stats.m_difficulty, std::memory_order_relaxed);
+            m_range_searched.store(range_searched, std::memory_order_relaxed);
+            m_rates.store(rates);
+            m_pipeline.store(pipeline);
+            m_most_difficult_chain.store(stats.m_most_difficult_chain, std::memory_order_relaxed);
+            m_cpu_load.store(stats.m_cpu_load, std::memory_order_relaxed);
+            for (std::size_t i = 0; i < m_chain_histogram.size(); ++i)
+            {
+                m_chain_histogram[i].store(stats.m_chain_histogram[i], std::memory_order_relaxed);
+            }
+        });
+    }
+
+    Prime snapshot() const
+    {
+        return m_lock.read([this]()
+        {
+            Prime stats;
+            stats.m_primes = m_primes.load(std::memory_order_relaxed);
+            stats.m_chains = m_chains.load(std::memory_order_relaxed);
+            stats.m_difficulty = m_difficulty.load(std::memory_order_relaxed);
+            stats.m_range_searched = m_range_searched.load(std::memory_order_relaxed);
+            stats.m_most_difficult_chain = m_most_difficult_chain.load(std::memory_order_relaxed);
+            stats.m_cpu_load = m_cpu_load.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < m_chain_histogram.size(); ++i)
+            {
+                stats.m_chain_histogram[i] = m_chain_histogram[i].load(std::memory_order_relaxed);
+            }
+            stats.m_rates = m_rates.load();
+            stats.m_pipeline = m_pipeline.load();
+            return stats;
+        });
+    }
+
+private:
+
+    Seqlock m_lock;
+    std::atomic<std::uint32_t> m_primes{ 0 };
+    std::atomic<std::uint32_t> m_chains{ 0 };
+    std::atomic<std::uint32_t> m_difficulty{ 0 };
+    std::atomic<std::uint64_t> m_range_searched{ 0 };
+    std::atomic<double> m_most_difficult_chain{ 0.0 };
+    std::atomic<double> m_cpu_load{ 0.0 };
+    std::array<std::atomic<std::uint32_t>, Prime::chain_histogram_size> m_chain_histogram{};
+    Rate_counters m_rates;
+    Pipeline_counters m_pipeline;
+
+    // writer side only
+    Monotonic_counter m_monotonic_range_searched;
+    Monotonic_counter m_monotonic_fermat_tests;
+    Monotonic_counter m_monotonic_fermat_passes;
+    Monotonic_counter m_monotonic_chains;
+    Rate_tracker m_rate_tracker;
+};
+
+// Work switch latencies of one worker, written by the work distributor thread of that worker.
+class alignas(cache_line_size) Work_switch_counters
+{
+public:
+
+    void add(std::chrono::microseconds latency)
+    {
+        m_lock.write([this, latency]()
+        {
+            auto const count = latency.count();
+            m_switch_count.store(m_switch_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            m_last_latency.store(count, std::memory_order_relaxed);
+            if (count > m_max_latency.load(std::memory_order_relaxed))
+            {
+                m_max_latency.store(count, std::memory_order_relaxed);
+            }
+            m_total_latency.store(m_total_latency.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+        });
+    }
+
+    Work_switch snapshot() const
+    {
+        return m_lock.read([this]()
+        {
+            Work_switch stats;
+            stats.m_switch_count = m_switch_count.load(std::memory_order_relaxed);
+            stats.m_last_latency = std::chrono::microseconds{ m_last_latency.load(std::memory_order_relaxed) };
+            stats.m_max_latency = std::chrono::microseconds{ m_max_latency.load(std::memory_order_relaxed) };
+            stats.m_total_latency = std::chrono::microseconds{ m_total_latency.load(std::memory_order_relaxed) };
+            return stats;
+        });
+    }
+
+private:
+
+    Seqlock m_lock;
+    std::atomic<std::uint32_t> m_switch_count{ 0 };
+    std::atomic<std::int64_t> m_last_latency{ 0 };
+    std::atomic<std::int64_t> m_max_latency{ 0 };
+    std::atomic<std::int64_t> m_total_latency{ 0 };
+};
+
+// Connection and share counters, updated from the io thread and read by the printers.
+class Global_counters
+{
+public:
+
+    void add(Global const& stats)
+    {
+        m_accepted_blocks.fetch_add(stats.m_accepted_blocks, std::memory_order_relaxed);
+        m_rejected_blocks.fetch_add(stats.m_rejected_blocks, std::memory_order_relaxed);
+        m_accepted_shares.fetch_add(stats.m_accepted_shares, std::memory_order_relaxed);
+        m_rejected_shares.fetch_add(stats.m_rejected_shares, std::memory_order_relaxed);
+        m_connection_retries.fetch_add(stats.m_connection_retries, std::memory_order_relaxed);
+    }
+
+    Global snapshot() const
+    {
+        Global stats;
+        stats.m_accepted_blocks = m_accepted_blocks.load(std::memory_order_relaxed);
+        stats.m_rejected_blocks = m_rejected_blocks.load(std::memory_order_relaxed);
+        stats.m_accepted_shares = m_accepted_shares.load(std::memory_order_relaxed);
+        stats.m_rejected_shares = m_rejected_shares.load(std::memory_order_relaxed);
+        stats.m_connection_retries = m_connection_retries.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+
+    std::atomic<std::uint32_t> m_accepted_blocks{ 0 };
+    std::atomic<std::uint32_t> m_rejected_blocks{ 0 };
+    std::atomic<std::uint32_t> m_accepted_shares{ 0 };
+    std::atomic<std::uint32_t> m_rejected_shares{ 0 };
+    std::atomic<std::uint32_t> m_connection_retries{ 0 };
+};
+
+}
+}
+#endif
@@ -0,0 +1,395 @@
+//exports a binary stats file written by the 'binary' stats printer as CSV (one row per record and worker)
+//or JSON (an array with one object per record). Files of a running miner can be read, records that are
+//being written are skipped.
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include "stats/stats_file_format.hpp"
+
+namespace nexusminer {
+namespace stats
+{
+namespace
+{
+    enum class Format { csv, json };
+
+    struct Reader_options
+    {
+        std::string m_file;
+        std::string m_output;
+        Format m_format = Format::csv;
+        std::uint64_t m_last = 0;   // 0 = all records
+    };
+
+    void show_usage(std::string const& name)
+    {
+        std::cerr << "Usage: " << name << " <stats file> <option(s)>\n"
+                  << "Options:\n"
+                  << "\t-h,--help\t\tShow this help message\n"
+                  << "\t--format csv|json\tOutput format (default csv)\n"
+                  << "\t--output FILE\t\tWrite to FILE instead of stdout\n"
+                  << "\t--last N\t\tOnly the newest N records"
+                  << std::endl;
+    }
+
+    char const* hardware_name(std::uint8_t mode)
+    {
+        switch (mode)
+        {
+        case 1: return "fpga";
+        case 2: return "gpu";
+        default: return "cpu";
+        }
+    }
+
+    std::string json_string(char const* value)
+    {
+        std::string escaped = "\"";
+        for (auto c = value; *c; ++c)
+        {
+            if (*c == '"' || *c == '\\')
+            {
+                escaped += '\\';
+            }
+            if (static_cast<unsigned char>(*c) >= 0x20)
+            {
+                escaped += *c;
+            }
+        }
+        return escaped + "\"";
+    }
+
+    std::string csv_string(char const* value)
+    {
+        std::string escaped = "\"";
+        for (auto c = value; *c; ++c)
+        {
+            escaped += *c;
+            if (*c == '"')
+            {
+                escaped += '"';
+            }
+        }
+        return escaped + "\"";
+    }
+
+    // calls field(name, value) for the record fields that belong to the mining mode of the file
+    template<typename Field>
+    void visit_record(stats_file::Record_header const& record, bool pool, Field&& field)
+    {
+        field("time_ms", record.m_time);
+        field("elapsed_ms", record.m_elapsed_ms);
+        if (pool)
+        {
+            field("accepted_shares", record.m_accepted_shares);
+            field("rejected_shares", record.m_rejected_shares);
+        }
+        else
+        {
+            field("accepted_blocks", record.m_accepted_blocks);
+            field("rejected_blocks", record.m_rejected_blocks);
+        }
+        field("connection_retries", record.m_connection_retries);
+        for (std::size_t i = 0; i < stats_file::latency_count; ++i)
+        {
+            std::string const name = stats_file::latency_names[i];
+            auto const& latency = record.m_latency[i];
+            field(name + "_count", latency.m_count);
+            field(name + "_total_us", latency.m_total_us);
+            field(name + "_p50_us", latency.m_p50_us);
+            field(name + "_p99_us", latency.m_p99_us);
+            field(name + "_max_us", latency.m_max_us);
+        }
+    }
+
+    template<typename Field>
+    void visit_worker(stats_file::Worker_record const& worker, bool hash, Field&& field)
+    {
+        field("rate_instant", worker.m_rate_instant);
+        field("rate_1m", worker.m_rate_short);
+        field("rate_15m", worker.m_rate_long);
+        field("rate_ewma", worker.m_rate_ewma);
+        if (hash)
+        {
+            field("hash_count", worker.m_hash_count);
+            field("best_leading_zeros", worker.m_best_leading_zeros);
+            field("met_difficulty_count", worker.m_met_difficulty_count);
+            field("nonce_candidates", worker.m_nonce_candidates);
+            field("hash_errors", worker.m_hash_errors);
+        }
+        else
+        {
+            field("range_searched", worker.m_range_searched);
+            field("primes", worker.m_primes);
+            field("chains", worker.m_chains);
+            field("difficulty", worker.m_difficulty);
+            field("most_difficult_chain", worker.m_most_difficult_chain);
+            field("cpu_load", worker.m_cpu_load);
+            for (std::size_t length = 0; length < worker.m_chain_histogram.size(); ++length)
+            {
+                field("chain_length_" + std::to_string(length), worker.m_chain_histogram[length]);
+            }
+            field("sieve_ns", worker.m_sieve_ns);
+            field("find_chains_ns", worker.m_find_chains_ns);
+            field("fermat_ns", worker.m_fermat_ns);
+            field("clean_chains_ns", worker.m_clean_chains_ns);
+            field("total_ns", worker.m_total_ns);
+            field("fermat_tests", worker.m_fermat_tests);
+            field("fermat_passes", worker.m_fermat_passes);
+            field("pipeline_chains", worker.m_pipeline_chains);
+        }
+        field("switch_count", worker.m_switch_count);
+        field("switch_last_us", worker.m_switch_last_us);
+        field("switch_max_us", worker.m_switch_max_us);
+        field("switch_total_us", worker.m_switch_total_us);
+    }
+
+    class Stats_file
+    {
+    public:
+
+        bool open(std::string const& file_name)
+        {
+            m_file.open(file_name, std::ios::binary);
+            if (!m_file || !m_file.read(reinterpret_cast<char*>(&m_header), sizeof(m_header)))
+            {
+                std::cerr << "Unable to read " << file_name << std::endl;
+                return false;
+            }
+            if (m_header.m_magic != stats_file::magic || m_header.m_version != stats_file::version)
+            {
+                std::cerr << file_name << " is not a version " << stats_file::version << " stats file" << std::endl;
+                return false;
+            }
+            if (m_header.m_capacity == 0 || m_header.m_record_size != stats_file::record_size(m_header.m_worker_count) ||
+                m_header.m_header_size < sizeof(m_header) + m_header.m_worker_count * sizeof(stats_file::Worker_info))
+            {
+                std::cerr << file_name << " has an invalid header" << std::endl;
+                return false;
+            }
+            m_workers.resize(m_header.m_worker_count);
+            if (!m_workers.empty() && !m_file.read(reinterpret_cast<char*>(m_workers.data()),
+                static_cast<std::streamsize>(m_workers.size() * sizeof(stats_file::Worker_info))))
+            {
+                std::cerr << file_name << " is truncated" << std::endl;
+                return false;
+            }
+            for (auto& worker : m_workers)
+            {
+                worker.m_id.back() = '\0';
+            }
+            m_record.resize(m_header.m_record_size);
+            return true;
+        }
+
+        stats_file::File_header const& header() const { return m_header; }
+        std::vector<stats_file::Worker_info> const& workers() const { return m_workers; }
+
+        // oldest record that is still in the ring
+        std::uint64_t first_record() const
+        {
+            return m_header.m_record_count > m_header.m_capacity ? m_header.m_record_count - m_header.m_capacity : 0;
+        }
+
+        // false if the record was overwritten or is being written
+        bool read(std::uint64_t number, stats_file::Record_header& record, std::vector<stats_file::Worker_record>& workers)
+        {
+            auto const offset = static_cast<std::uint64_t>(m_header.m_header_size) + (number % m_header.m_capacity) * m_header.m_record_size;
+            m_file.clear();
+            m_file.seekg(static_cast<std::streamoff>(offset));
+            if (!m_file.read(reinterpret_cast<char*>(m_record.data()), static_cast<std::streamsize>(m_record.size())))
+            {
+                return false;
+            }
+            std::memcpy(&record, m_record.data(), sizeof(record));
+            if (record.m_sequence != number + 1)
+            {
+                return false;
+            }
+            workers.resize(m_workers.size());
+            for (std::size_t i = 0; i < workers.size(); ++i)
+            {
+                std::memcpy(&workers[i], m_record.data() + sizeof(record) + i * sizeof(stats_file::Worker_record),
+                    sizeof(stats_file::Worker_record));
+            }
+            return true;
+        }
+
+    private:
+
+        std::ifstream m_file;
+        stats_file::File_header m_header{};
+        std::vector<stats_file::Worker_info> m_workers;
+        std::vector<std::uint8_t> m_record;
+    };
+
+    void export_records(Stats_file& file, Reader_options const& options, std::ostream& out)
+    {
+        auto const& header = file.header();
+        bool const pool = header.m_pool != 0;
+        bool const hash = header.m_mining_mode == 1;
+        auto first = file.first_record();
+        if (options.m_last != 0 && header.m_record_count - first > options.m_last)
+        {
+            first = header.m_record_count - options.m_last;
+        }
+
+        out << std::setprecision(std::numeric_limits<double>::max_digits10);
+        stats_file::Record_header record{};
+        std::vector<stats_file::Worker_record> workers;
+        if (options.m_format == Format::csv)
+        {
+            bool first_column = true;
+            auto const column = [&out, &first_column](std::string const& name, auto)
+            {
+                out << (first_column ? "" : ",") << name;
+                first_column = false;
+            };
+            visit_record(record, pool, column);
+            out << ",worker,hardware";
+            visit_worker(stats_file::Worker_record{}, hash, column);
+            out << "\n";
+
+            auto const value = [&out](std::string const&, auto value) { out << "," << value; };
+            for (auto number = first; number < header.m_record_count; ++number)
+            {
+                if (!file.read(number, record, workers))
+                {
+                    continue;
+                }
+                for (std::size_t i = 0; i < workers.size(); ++i)
+                {
+                    first_column = true;
+                    visit_record(record, pool, [&out, &first_column](std::string const&, auto value)
+                        {
+                            out << (first_column ? "" : ",") << value;
+                            first_column = false;
+                        });
+                    out << "," << csv_string(file.workers()[i].m_id.data()) << "," << hardware_name(file.workers()[i].m_mode);
+                    visit_worker(workers[i], hash, value);
+                    out << "\n";
+                }
+            }
+        }
+        else
+        {
+            bool first_field = true;
+            auto const field = [&out, &first_field](std::string const& name, auto value)
+            {
+                out << (first_field ? "" : ",") << "\"" << name << "\":" << value;
+                first_field = false;
+            };
+            out << "[";
+            bool first_object = true;
+            for (auto number = first; number < header.m_record_count; ++number)
+            {
+                if (!file.read(number, record, workers))
+                {
+                    continue;
+                }
+                out << (first_object ? "\n{" : ",\n{");
+                first_object = false;
+                first_field = true;
+                visit_record(record, pool, field);
+                out << ",\"workers\":[";
+                for (std::size_t i = 0; i < workers.size(); ++i)
+                {
+                    out << (i == 0 ? "{" : ",{") << "\"worker\":" << json_string(file.workers()[i].m_id.data())
+                        << ",\"hardware\":\"" << hardware_name(file.workers()[i].m_mode) << "\"";
+                    first_field = false;
+                    visit_worker(workers[i], hash, field);
+                    out << "}";
+                }
+                out << "]}";
+            }
+            out << "\n]\n";
+        }
+    }
+}
+}
+}
+
+int main(int argc, char** argv)
+{
+    using namespace nexusminer::stats;
+
+    Reader_options options;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            bool const has_value = i + 1 < argc;
+            if ((arg == "-h") || (arg == "--help"))
+            {
+                show_usage(argv[0]);
+                return 0;
+            }
+            else if (arg == "--format" && has_value)
+            {
+                std::string const format = argv[++i];
+                if (format != "csv" && format != "json")
+                {
+                    show_usage(argv[0]);
+                    return 1;
+                }
+                options.m_format = format == "json" ? Format::json : Format::csv;
+            }
+            else if (arg == "--output" && has_value)
+            {
+                options.m_output = argv[++i];
+            }
+            else if (arg == "--last" && has_value)
+            {
+                options.m_last = std::stoull(argv[++i]);
+            }
+            else if (options.m_file.empty() && !arg.empty() && arg[0] != '-')
+            {
+                options.m_file = arg;
+            }
+            else
+            {
+                show_usage(argv[0]);
+                return 1;
+            }
+        }
+    }
+    catch (std::exception const&)
+    {
+        show_usage(argv[0]);
+        return 1;
+    }
+
+    if (options.m_file.empty())
+    {
+        show_usage(argv[0]);
+        return 1;
+    }
+
+    Stats_file file;
+    if (!file.open(options.m_file))
+    {
+        return 1;
+    }
+
+    if (options.m_output.empty())
+    {
+        export_records(file, options, std::cout);
+        return 0;
+    }
+
+    std::ofstream out{ options.m_output };
+    if (!out)
+    {
+        std::cerr << "Unable to write " << options.m_output << std::endl;
+        return 1;
+    }
+    export_records(file, options, out);
+    return 0;
+}
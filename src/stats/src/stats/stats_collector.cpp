@@ -2,6 +2,8 @@
 #include "config/config.hpp"
 #include "config/types.hpp"
 #include <spdlog/spdlog.h>
+#include <cassert>
+#include <type_traits>
 
 namespace nexusminer
 {
@@ -12,56 +14,112 @@ Collector::Collector(config::Config& config)
 : m_config{config}
 , m_start_time{std::chrono::steady_clock::now()}
 {
-    for(auto& worker_config : m_config.get_worker_config())
+    update_workers(m_config.get_worker_config().size(), {});
+}
+
+void Collector::update_workers(std::size_t worker_count, std::vector<std::uint16_t> const& replaced)
+{
+    auto const update = [worker_count, &replaced](auto& counters)
     {
-        if(m_config.get_mining_mode() == config::Mining_mode::HASH)
+        using Counters = typename std::decay_t<decltype(counters)>::value_type::element_type;
+        for(auto const internal_worker_id : replaced)
         {
-            m_workers.push_back(Hash{});
+            if(internal_worker_id < counters.size())
+            {
+                counters[internal_worker_id] = std::make_unique<Counters>();
+            }
         }
-        else
+        counters.resize(worker_count);
+        for(auto& worker_counters : counters)
         {
-            m_workers.push_back(Prime{});
+            if(!worker_counters)
+            {
+                worker_counters = std::make_unique<Counters>();
+            }
         }
+    };
+
+    if(m_config.get_mining_mode() == config::Mining_mode::HASH)
+    {
+        update(m_hash_workers);
+    }
+    else
+    {
+        update(m_prime_workers);
     }
+    update(m_work_switches);
 }
 
 void Collector::update_global_stats(Global const& stats)
 {
-    m_global_stats += stats;
+    m_global_stats.add(stats);
 }
 
 void Collector::update_worker_stats(std::uint16_t internal_worker_id, Hash const& stats)
 {
     assert(m_config.get_mining_mode() == config::Mining_mode::HASH);
 
-    std::scoped_lock lock(m_worker_mutex);
-
-    auto& hash_stats = std::get<Hash>(m_workers[internal_worker_id]);
-    hash_stats = stats;
+    m_hash_workers[internal_worker_id]->publish(stats);
 }
 
 void Collector::update_worker_stats(std::uint16_t internal_worker_id, Prime const& stats)
 {
     assert(m_config.get_mining_mode() == config::Mining_mode::PRIME);
 
-    std::scoped_lock lock(m_worker_mutex);
-    
-    auto& prime_stats = std::get<Prime>(m_workers[internal_worker_id]);
-    prime_stats = stats;
+    m_prime_workers[internal_worker_id]->publish(stats);
+}
+
+void Collector::update_work_switch_stats(std::uint16_t internal_worker_id, std::chrono::microseconds latency)
+{
+    m_work_switches[internal_worker_id]->add(latency);
+}
+
+std::vector<std::variant<Hash, Prime>> Collector::get_workers_stats() const
+{
+    std::vector<std::variant<Hash, Prime>> workers;
+    workers.reserve(m_hash_workers.size() + m_prime_workers.size());
+    for(auto const& counters : m_hash_workers)
+    {
+        workers.emplace_back(counters->snapshot());
+    }
+    for(auto const& counters : m_prime_workers)
+    {
+        workers.emplace_back(counters->snapshot());
+    }
+    return workers;
+}
+
+std::variant<Hash, Prime> Collector::get_worker_stats(std::uint32_t internal_worker_id) const
+{
+    if(!m_hash_workers.empty())
+    {
+        return m_hash_workers[internal_worker_id]->snapshot();
+    }
+    return m_prime_workers[internal_worker_id]->snapshot();
+}
+
+std::vector<Work_switch> Collector::get_work_switch_stats() const
+{
+    std::vector<Work_switch> work_switches;
+    work_switches.reserve(m_work_switches.size());
+    for(auto const& counters : m_work_switches)
+    {
+        work_switches.push_back(counters->snapshot());
+    }
+    return work_switches;
 }
 
 void Collector::log_summary()
 {
-    std::scoped_lock lock(m_worker_mutex);
-    
+    auto const workers = get_workers_stats();
     auto worker_configs = m_config.get_worker_config();
-    for (std::size_t i = 0; i < m_workers.size(); ++i) {
+    for (std::size_t i = 0; i < workers.size(); ++i) {
         if (i >= worker_configs.size()) {
             break;
         }
         
         const auto& worker_config = worker_configs[i];
-        const auto& worker_stat = m_workers[i];
+        const auto& worker_stat = workers[i];
         
         if (std::holds_alternative<Prime>(worker_stat)) {
             const auto& prime = std::get<Prime>(worker_stat);
@@ -79,4 +137,4 @@ void Collector::log_summary()
 }
 
 }
-}
\ No newline at end of file
+}
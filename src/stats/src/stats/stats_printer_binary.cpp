@@ -0,0 +1,343 @@
+#include "stats/stats_printer_binary.hpp"
+#include "stats/stats_file_format.hpp"
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/fmt/chrono.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace nexusminer
+{
+namespace stats
+{
+
+// read/write shared mapping of a new file with a fixed size, an existing file is never overwritten
+class Mapped_file
+{
+public:
+
+    Mapped_file() = default;
+    Mapped_file(Mapped_file const&) = delete;
+    Mapped_file& operator=(Mapped_file const&) = delete;
+
+    ~Mapped_file()
+    {
+#ifdef _WIN32
+        if (m_data)
+        {
+            FlushViewOfFile(m_data, 0);
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping)
+        {
+            CloseHandle(m_mapping);
+        }
+        if (m_file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_file);
+        }
+#else
+        if (m_data)
+        {
+            msync(m_data, m_size, MS_SYNC);
+            munmap(m_data, m_size);
+        }
+        if (m_file >= 0)
+        {
+            close(m_file);
+        }
+#endif
+    }
+
+    bool open(std::string const& file_name, std::size_t size)
+    {
+#ifdef _WIN32
+        m_file = CreateFileA(file_name.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_NEW,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE)
+        {
+            m_exists = GetLastError() == ERROR_FILE_EXISTS;
+            return false;
+        }
+        auto const size64 = static_cast<std::uint64_t>(size);
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size64 >> 32),
+            static_cast<DWORD>(size64 & 0xFFFFFFFF), nullptr);
+        if (!m_mapping)
+        {
+            return false;
+        }
+        m_data = static_cast<std::uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_WRITE, 0, 0, size));
+        if (!m_data)
+        {
+            return false;
+        }
+#else
+        m_file = ::open(file_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        if (m_file < 0)
+        {
+            m_exists = errno == EEXIST;
+            return false;
+        }
+        if (ftruncate(m_file, static_cast<off_t>(size)) != 0)
+        {
+            return false;
+        }
+        auto const data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0);
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+        m_data = static_cast<std::uint8_t*>(data);
+#endif
+        m_size = size;
+        return true;
+    }
+
+    std::uint8_t* data() const { return m_data; }
+
+    // open failed because the file is already there
+    bool exists() const { return m_exists; }
+
+private:
+
+#ifdef _WIN32
+    HANDLE m_file{ INVALID_HANDLE_VALUE };
+    HANDLE m_mapping{ nullptr };
+#else
+    int m_file{ -1 };
+#endif
+    std::uint8_t* m_data{ nullptr };
+    std::size_t m_size{ 0 };
+    bool m_exists{ false };
+};
+
+namespace
+{
+
+// stats.nxs -> stats-20260101-120000.nxs, a later run in the same second -> stats-20260101-120000-2.nxs
+std::string run_file_name(std::string const& file_name, std::time_t start_time, unsigned int run)
+{
+    auto suffix = fmt::format("-{:%Y%m%d-%H%M%S}", fmt::localtime(start_time));
+    if (run > 1)
+    {
+        suffix += fmt::format("-{}", run);
+    }
+    auto const separator = file_name.find_last_of("/\\");
+    auto const extension = file_name.find_last_of('.');
+    if (extension == std::string::npos || (separator != std::string::npos && extension < separator) ||
+        extension == (separator == std::string::npos ? 0 : separator + 1))
+    {
+        return file_name + suffix;
+    }
+    return file_name.substr(0, extension) + suffix + file_name.substr(extension);
+}
+
+std::int64_t unix_time_ms()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+stats_file::Latency_summary summary(Latency_histogram const& histogram)
+{
+    stats_file::Latency_summary result{};
+    result.m_count = histogram.count();
+    result.m_total_us = static_cast<std::uint64_t>(histogram.total().count());
+    result.m_p50_us = static_cast<std::uint64_t>(histogram.percentile(0.5).count());
+    result.m_p99_us = static_cast<std::uint64_t>(histogram.percentile(0.99).count());
+    result.m_max_us = static_cast<std::uint64_t>(histogram.max().count());
+    return result;
+}
+
+}
+
+Printer_binary::Printer_binary(config::Stats_printer_config_binary const& config, config::Mining_mode mining_mode, bool pool,
+    std::uint16_t interval, std::vector<config::Worker_config> const& worker_config, Collector& stats_collector)
+: m_config{config}
+, m_mining_mode{mining_mode}
+, m_pool{pool}
+, m_interval{std::max<std::uint16_t>(interval, 1U)}
+, m_worker_config{worker_config}
+, m_stats_collector{stats_collector}
+, m_logger{spdlog::get("logger")}
+{
+}
+
+Printer_binary::~Printer_binary() = default;
+
+bool Printer_binary::start()
+{
+    auto const worker_count = m_worker_config.size();
+    m_header_size = stats_file::header_size(worker_count);
+    m_record_size = stats_file::record_size(worker_count);
+    m_capacity = m_config.records != 0 ? m_config.records : 7U * 24U * 3600U / m_interval;
+    m_record.assign(m_record_size, 0U);
+
+    // a reload within the same second as the last start must not overwrite that run's file
+    constexpr unsigned int max_runs_per_second = 100;
+    auto const start_time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    auto const file_size = m_header_size + static_cast<std::size_t>(m_capacity) * m_record_size;
+    std::string file_name;
+    std::unique_ptr<Mapped_file> file;
+    for (unsigned int run = 1; ; ++run)
+    {
+        file_name = run_file_name(m_config.file_name, start_time, run);
+        file = std::make_unique<Mapped_file>();
+        if (file->open(file_name, file_size))
+        {
+            break;
+        }
+        if (!file->exists() || run == max_runs_per_second)
+        {
+            m_logger->error("[STATS] Unable to create the binary stats file {} ({} bytes)", file_name, file_size);
+            return false;
+        }
+    }
+
+    stats_file::File_header header{};
+    header.m_magic = stats_file::magic;
+    header.m_version = stats_file::version;
+    header.m_header_size = static_cast<std::uint32_t>(m_header_size);
+    header.m_record_size = static_cast<std::uint32_t>(m_record_size);
+    header.m_capacity = m_capacity;
+    header.m_worker_count = static_cast<std::uint32_t>(worker_count);
+    header.m_interval = m_interval;
+    header.m_mining_mode = static_cast<std::uint8_t>(m_mining_mode);
+    header.m_pool = m_pool ? 1U : 0U;
+    header.m_start_time = unix_time_ms();
+    header.m_record_count = 0;
+    std::memcpy(file->data(), &header, sizeof(header));
+
+    for (std::size_t i = 0; i < worker_count; ++i)
+    {
+        stats_file::Worker_info info{};
+        auto const& id = m_worker_config[i].m_id;
+        std::memcpy(info.m_id.data(), id.data(), std::min(id.size(), info.m_id.size() - 1));
+        info.m_mode = static_cast<std::uint8_t>(m_worker_config[i].m_mode);
+        std::memcpy(file->data() + sizeof(header) + i * sizeof(info), &info, sizeof(info));
+    }
+
+    m_file = std::move(file);
+    m_logger->info("[STATS] Writing binary stats to {}, {} records of {} bytes", file_name, m_capacity, m_record_size);
+    return true;
+}
+
+void Printer_binary::reload(std::uint16_t interval)
+{
+    m_interval = std::max<std::uint16_t>(interval, 1U);
+    m_file.reset();
+    m_record_count = 0;
+    start();
+}
+
+void Printer_binary::print()
+{
+    if (!m_file)
+    {
+        return;
+    }
+
+    stats_file::Record_header record_header{};
+    record_header.m_sequence = m_record_count + 1;
+    record_header.m_time = unix_time_ms();
+    record_header.m_elapsed_ms = static_cast<std::uint64_t>(m_stats_collector.get_elapsed_time_seconds().count() * 1000.0);
+    auto const global_stats = m_stats_collector.get_global_stats();
+    record_header.m_accepted_blocks = global_stats.m_accepted_blocks;
+    record_header.m_rejected_blocks = global_stats.m_rejected_blocks;
+    record_header.m_accepted_shares = global_stats.m_accepted_shares;
+    record_header.m_rejected_shares = global_stats.m_rejected_shares;
+    record_header.m_connection_retries = global_stats.m_connection_retries;
+
+    auto const& submit_latency = m_stats_collector.get_submit_latency();
+    auto const& block_latency = m_stats_collector.get_block_latency();
+    record_header.m_latency[stats_file::sign_queue] = summary(submit_latency.m_sign_queue);
+    record_header.m_latency[stats_file::sign] = summary(submit_latency.m_sign);
+    record_header.m_latency[stats_file::find_to_transmit] = summary(submit_latency.m_find_to_transmit);
+    record_header.m_latency[stats_file::template_validate] = summary(block_latency.m_template_validate);
+    record_header.m_latency[stats_file::validated_to_mining] = summary(block_latency.m_validated_to_mining);
+    record_header.m_latency[stats_file::found_to_checked] = summary(block_latency.m_found_to_checked);
+    record_header.m_latency[stats_file::checked_to_signed] = summary(block_latency.m_checked_to_signed);
+    record_header.m_latency[stats_file::signed_to_transmit] = summary(block_latency.m_signed_to_transmit);
+    record_header.m_latency[stats_file::submit_to_result] = summary(block_latency.m_submit_to_result);
+    std::memcpy(m_record.data(), &record_header, sizeof(record_header));
+
+    auto const workers = m_stats_collector.get_workers_stats();
+    auto const work_switches = m_stats_collector.get_work_switch_stats();
+    for (std::size_t i = 0; i < workers.size() && i < m_worker_config.size(); ++i)
+    {
+        stats_file::Worker_record worker_record{};
+        Rates rates{};
+        if (auto const* hash_stats = std::get_if<Hash>(&workers[i]))
+        {
+            rates = hash_stats->m_rates;
+            worker_record.m_hash_count = hash_stats->m_hash_count;
+            worker_record.m_best_leading_zeros = hash_stats->m_best_leading_zeros;
+            worker_record.m_met_difficulty_count = hash_stats->m_met_difficulty_count;
+            worker_record.m_nonce_candidates = hash_stats->m_nonce_candidates_recieved;
+            worker_record.m_hash_errors = hash_stats->m_hash_error_count;
+        }
+        else
+        {
+            auto const& prime_stats = std::get<Prime>(workers[i]);
+            auto const& pipeline = prime_stats.m_pipeline;
+            rates = prime_stats.m_rates;
+            worker_record.m_range_searched = prime_stats.m_range_searched;
+            worker_record.m_primes = prime_stats.m_primes;
+            worker_record.m_chains = prime_stats.m_chains;
+            worker_record.m_difficulty = prime_stats.m_difficulty;
+            worker_record.m_most_difficult_chain = prime_stats.m_most_difficult_chain;
+            worker_record.m_cpu_load = prime_stats.m_cpu_load;
+            std::copy(prime_stats.m_chain_histogram.begin(), prime_stats.m_chain_histogram.end(), worker_record.m_chain_histogram.begin());
+            worker_record.m_sieve_ns = pipeline.m_sieve.count();
+            worker_record.m_find_chains_ns = pipeline.m_find_chains.count();
+            worker_record.m_fermat_ns = pipeline.m_fermat.count();
+            worker_record.m_clean_chains_ns = pipeline.m_clean_chains.count();
+            worker_record.m_total_ns = pipeline.m_total.count();
+            worker_record.m_fermat_tests = pipeline.m_fermat_tests;
+            worker_record.m_fermat_passes = pipeline.m_fermat_passes;
+            worker_record.m_pipeline_chains = pipeline.m_chains;
+        }
+        worker_record.m_rate_instant = rates.m_instant;
+        worker_record.m_rate_short = rates.m_short;
+        worker_record.m_rate_long = rates.m_long;
+        worker_record.m_rate_ewma = rates.m_ewma;
+        if (i < work_switches.size())
+        {
+            auto const& work_switch = work_switches[i];
+            worker_record.m_switch_count = work_switch.m_switch_count;
+            worker_record.m_switch_last_us = work_switch.m_last_latency.count();
+            worker_record.m_switch_max_us = work_switch.m_max_latency.count();
+            worker_record.m_switch_total_us = work_switch.m_total_latency.count();
+        }
+        std::memcpy(m_record.data() + sizeof(record_header) + i * sizeof(worker_record), &worker_record, sizeof(worker_record));
+    }
+
+    // A reader of the live file takes a record only if its sequence matches, the sequence is cleared while the
+    // slot is rewritten and set last.
+    auto* const data = m_file->data();
+    auto* const slot = data + m_header_size + static_cast<std::size_t>(m_record_count % m_capacity) * m_record_size;
+    std::uint64_t const writing = 0;
+    std::memcpy(slot, &writing, sizeof(writing));
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(slot + sizeof(writing), m_record.data() + sizeof(writing), m_record_size - sizeof(writing));
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(slot, m_record.data(), sizeof(writing));
+
+    m_record_count++;
+    std::memcpy(data + offsetof(stats_file::File_header, m_record_count), &m_record_count, sizeof(m_record_count));
+}
+
+}
+}
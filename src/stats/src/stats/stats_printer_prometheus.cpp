@@ -0,0 +1,493 @@
+#include "stats/stats_printer_prometheus.hpp"
+#include "network/endpoint.hpp"
+#include <spdlog/fmt/fmt.h>
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+namespace nexusminer
+{
+namespace stats
+{
+namespace
+{
+
+std::string escape_label_value(std::string const& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (auto const c : value)
+    {
+        switch (c)
+        {
+        case '\\': escaped += "\\\\"; break;
+        case '"': escaped += "\\\""; break;
+        case '\n': escaped += "\\n"; break;
+        default: escaped += c; break;
+        }
+    }
+    return escaped;
+}
+
+char const* hardware_name(config::Worker_mode mode)
+{
+    switch (mode)
+    {
+    case config::Worker_mode::FPGA: return "fpga";
+    case config::Worker_mode::GPU: return "gpu";
+    case config::Worker_mode::CPU:
+    default: return "cpu";
+    }
+}
+
+// Metric families in either exposition format. The formats differ in the counter family names (OpenMetrics
+// names the family without the _total suffix of its samples) and in the # EOF terminator.
+class Exposition_writer
+{
+public:
+
+    Exposition_writer(fmt::memory_buffer& out, bool openmetrics)
+    : m_out{out}
+    , m_openmetrics{openmetrics}
+    {
+    }
+
+    void counter(char const* name, char const* help)
+    {
+        if (m_openmetrics)
+        {
+            family(name, "", "counter", help);
+        }
+        else
+        {
+            family(name, "_total", "counter", help);
+        }
+    }
+
+    void gauge(char const* name, char const* help) { family(name, "", "gauge", help); }
+    void summary(char const* name, char const* help) { family(name, "", "summary", help); }
+    void histogram(char const* name, char const* help) { family(name, "", "histogram", help); }
+
+    template<typename T>
+    void sample(char const* name, char const* suffix, std::string const& labels, T value)
+    {
+        if (labels.empty())
+        {
+            fmt::format_to(std::back_inserter(m_out), "{}{} {}\n", name, suffix, value);
+        }
+        else
+        {
+            fmt::format_to(std::back_inserter(m_out), "{}{}{{{}}} {}\n", name, suffix, labels, value);
+        }
+    }
+
+    // Latency_histogram as a cumulative histogram in seconds, bucket i holds latencies at or below 2^i us.
+    // from 16 us on a latency of exactly 2^i shares its histogram bucket with larger ones and is counted in the next bucket
+    void latency_histogram(char const* name, Latency_histogram const& latency_histogram)
+    {
+        constexpr std::size_t exported_buckets = 32;
+        auto const count = latency_histogram.count();
+        for (std::size_t i = 0; i < exported_buckets; ++i)
+        {
+            auto const limit = std::uint64_t{ 1 } << i;
+            fmt::format_to(std::back_inserter(m_out), "{}_bucket{{le=\"{}\"}} {}\n", name,
+                static_cast<double>(limit) / 1.0e6, std::min(latency_histogram.count_at_or_below(limit), count));
+        }
+        fmt::format_to(std::back_inserter(m_out), "{}_bucket{{le=\"+Inf\"}} {}\n", name, count);
+        sample(name, "_sum", {}, latency_histogram.total().count() / 1.0e6);
+        sample(name, "_count", {}, count);
+    }
+
+    void finish()
+    {
+        if (m_openmetrics)
+        {
+            fmt::format_to(std::back_inserter(m_out), "# EOF\n");
+        }
+    }
+
+private:
+
+    void family(char const* name, char const* suffix, char const* type, char const* help)
+    {
+        fmt::format_to(std::back_inserter(m_out), "# TYPE {}{} {}\n# HELP {}{} {}\n", name, suffix, type, name, suffix, help);
+    }
+
+    fmt::memory_buffer& m_out;
+    bool m_openmetrics;
+};
+
+}
+
+Printer_prometheus::Printer_prometheus(network::Socket_factory::Sptr socket_factory,
+    config::Stats_printer_config_prometheus const& config, bool pool,
+    std::vector<config::Worker_config> const& worker_config, Collector& stats_collector)
+: m_socket_factory{std::move(socket_factory)}
+, m_config{config}
+, m_pool{pool}
+, m_worker_config{worker_config}
+, m_stats_collector{stats_collector}
+, m_logger{spdlog::get("logger")}
+{
+}
+
+bool Printer_prometheus::start()
+{
+    network::Endpoint local_endpoint{network::Transport_protocol::tcp, m_config.address, m_config.port};
+    m_socket = m_socket_factory->create_socket(local_endpoint);
+    std::weak_ptr<Printer_prometheus> weak_self = shared_from_this();
+    if (!m_socket || m_socket->listen([weak_self](network::Connection::Sptr&& connection)
+        {
+            auto self = weak_self.lock();
+            return self ? self->accept(std::move(connection)) : network::Connection::Handler{};
+        }) != network::Result::socket_ok)
+    {
+        m_logger->error("Prometheus exporter failed to listen on {}:{}", m_config.address, m_config.port);
+        m_socket.reset();
+        return false;
+    }
+
+    m_logger->info("Prometheus exporter listening on http://{}:{}/metrics", m_config.address, m_config.port);
+    return true;
+}
+
+void Printer_prometheus::print()
+{
+    for (auto format : { openmetrics, text })
+    {
+        // only formats that have been scraped
+        if (m_exposition[format])
+        {
+            m_exposition[format] = render(format);
+            m_rendered[format] = std::chrono::steady_clock::now();
+        }
+    }
+}
+
+network::Connection::Handler Printer_prometheus::accept(network::Connection::Sptr&& connection)
+{
+    // scrapers keep their connection open, drop the oldest one when a misbehaving client piles them up
+    if (m_sessions.size() >= max_connections)
+    {
+        auto oldest = m_sessions.begin();
+        auto oldest_connection = std::move(oldest->second.m_connection);
+        m_sessions.erase(oldest);
+        oldest_connection->close();
+    }
+
+    auto const session_id = m_next_session_id++;
+    m_sessions.emplace(session_id, Session{std::move(connection), {}});
+
+    std::weak_ptr<Printer_prometheus> weak_self = shared_from_this();
+    return [weak_self, session_id](network::Result::Code result, network::Shared_payload&& receive_buffer)
+    {
+        auto self = weak_self.lock();
+        if (!self)
+        {
+            return;
+        }
+
+        if (result == network::Result::receive_ok && receive_buffer)
+        {
+            self->receive(session_id, *receive_buffer);
+        }
+        else if (result == network::Result::connection_closed || result == network::Result::connection_error)
+        {
+            self->m_sessions.erase(session_id);
+        }
+    };
+}
+
+void Printer_prometheus::receive(std::uint64_t session_id, network::Payload const& data)
+{
+    auto it = m_sessions.find(session_id);
+    if (it == m_sessions.end())
+    {
+        return;
+    }
+
+    auto& session = it->second;
+    session.m_request.append(data.begin(), data.end());
+    for (;;)
+    {
+        auto const end = session.m_request.find("\r\n\r\n");
+        if (end == std::string::npos)
+        {
+            if (session.m_request.size() > max_request_size)
+            {
+                auto connection = std::move(session.m_connection);
+                m_sessions.erase(it);
+                connection->close();
+            }
+            return;
+        }
+
+        auto const request = session.m_request.substr(0, end);
+        session.m_request.erase(0, end + 4);
+        respond(session, request);
+    }
+}
+
+void Printer_prometheus::respond(Session& session, std::string const& request)
+{
+    auto const method_end = request.find(' ');
+    auto const target_end = method_end == std::string::npos ? std::string::npos : request.find(' ', method_end + 1);
+    if (target_end == std::string::npos)
+    {
+        transmit(session, "400 Bad Request", "text/plain", nullptr, false);
+        return;
+    }
+
+    auto const method = request.substr(0, method_end);
+    auto target = request.substr(method_end + 1, target_end - method_end - 1);
+    target = target.substr(0, target.find('?'));
+    auto const head = method == "HEAD";
+    if (method != "GET" && !head)
+    {
+        transmit(session, "405 Method Not Allowed", "text/plain", nullptr, false);
+        return;
+    }
+    if (target != "/metrics")
+    {
+        transmit(session, "404 Not Found", "text/plain", nullptr, head);
+        return;
+    }
+
+    std::string lower_request(request.size(), '\0');
+    std::transform(request.begin(), request.end(), lower_request.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    auto format = text;
+    auto const accept = lower_request.find("\r\naccept:");
+    if (accept != std::string::npos &&
+        lower_request.substr(accept, lower_request.find("\r\n", accept + 2) - accept).find("application/openmetrics-text") != std::string::npos)
+    {
+        format = openmetrics;
+    }
+
+    transmit(session, "200 OK", format == openmetrics ? "application/openmetrics-text; version=1.0.0; charset=utf-8"
+        : "text/plain; version=0.0.4; charset=utf-8", exposition(format), head);
+}
+
+void Printer_prometheus::transmit(Session& session, std::string const& status, std::string const& content_type,
+    network::Shared_payload body, bool head)
+{
+    auto const header = fmt::format("HTTP/1.1 {}\r\nContent-Type: {}\r\nContent-Length: {}\r\n\r\n", status, content_type,
+        body ? body->size() : 0);
+    session.m_connection->transmit(std::make_shared<network::Payload>(header.begin(), header.end()));
+    if (body && !head)
+    {
+        // shared with every other scrape of the same rendering, nothing is copied
+        session.m_connection->transmit(network::Gather_payload{std::move(body)});
+    }
+}
+
+network::Shared_payload const& Printer_prometheus::exposition(Format format)
+{
+    auto const now = std::chrono::steady_clock::now();
+    if (!m_exposition[format] || now - m_rendered[format] >= min_render_interval)
+    {
+        m_exposition[format] = render(format);
+        m_rendered[format] = now;
+    }
+    return m_exposition[format];
+}
+
+network::Shared_payload Printer_prometheus::render(Format format) const
+{
+    fmt::memory_buffer out;
+    Exposition_writer writer{out, format == openmetrics};
+
+    writer.gauge("nexusminer_uptime_seconds", "Seconds since the miner started.");
+    writer.sample("nexusminer_uptime_seconds", "", {}, m_stats_collector.get_elapsed_time_seconds().count());
+
+    auto const global_stats = m_stats_collector.get_global_stats();
+    if (m_pool)
+    {
+        writer.counter("nexusminer_shares", "Shares answered by the pool.");
+        writer.sample("nexusminer_shares", "_total", "result=\"accepted\"", global_stats.m_accepted_shares);
+        writer.sample("nexusminer_shares", "_total", "result=\"rejected\"", global_stats.m_rejected_shares);
+    }
+    else
+    {
+        writer.counter("nexusminer_blocks", "Blocks answered by the node.");
+        writer.sample("nexusminer_blocks", "_total", "result=\"accepted\"", global_stats.m_accepted_blocks);
+        writer.sample("nexusminer_blocks", "_total", "result=\"rejected\"", global_stats.m_rejected_blocks);
+    }
+    writer.counter("nexusminer_connection_retries", "Reconnects to the node or pool.");
+    writer.sample("nexusminer_connection_retries", "_total", {}, global_stats.m_connection_retries);
+
+    auto const& submit_latency = m_stats_collector.get_submit_latency();
+    writer.histogram("nexusminer_block_sign_queue_seconds", "Time a found block waited for the Falcon signing thread.");
+    writer.latency_histogram("nexusminer_block_sign_queue_seconds", submit_latency.m_sign_queue);
+    writer.histogram("nexusminer_block_sign_seconds", "Falcon block signature generation time.");
+    writer.latency_histogram("nexusminer_block_sign_seconds", submit_latency.m_sign);
+    writer.histogram("nexusminer_block_submit_seconds", "Time from a found block until it is queued for transmission.");
+    writer.latency_histogram("nexusminer_block_submit_seconds", submit_latency.m_find_to_transmit);
+
+    auto const& block_latency = m_stats_collector.get_block_latency();
+    writer.histogram("nexusminer_block_template_validate_seconds", "Time from a template packet until it was validated and handed to the workers.");
+    writer.latency_histogram("nexusminer_block_template_validate_seconds", block_latency.m_template_validate);
+    writer.histogram("nexusminer_block_validated_to_mining_seconds", "Time from a validated template until a worker mines on it, one sample per worker.");
+    writer.latency_histogram("nexusminer_block_validated_to_mining_seconds", block_latency.m_validated_to_mining);
+    writer.histogram("nexusminer_block_found_to_checked_seconds", "Time from a candidate found by a worker until it passed the difficulty check.");
+    writer.latency_histogram("nexusminer_block_found_to_checked_seconds", block_latency.m_found_to_checked);
+    writer.histogram("nexusminer_block_checked_to_signed_seconds", "Time from a difficulty checked block until its submission was signed.");
+    writer.latency_histogram("nexusminer_block_checked_to_signed_seconds", block_latency.m_checked_to_signed);
+    writer.histogram("nexusminer_block_signed_to_transmit_seconds", "Time from a signed submission until it was queued on the connection.");
+    writer.latency_histogram("nexusminer_block_signed_to_transmit_seconds", block_latency.m_signed_to_transmit);
+    writer.histogram("nexusminer_block_submit_to_result_seconds", "Time from a queued submission until the node accepted or rejected it.");
+    writer.latency_histogram("nexusminer_block_submit_to_result_seconds", block_latency.m_submit_to_result);
+
+    auto const workers = m_stats_collector.get_workers_stats();
+    auto const work_switches = m_stats_collector.get_work_switch_stats();
+    std::vector<std::string> worker_labels;
+    worker_labels.reserve(workers.size());
+    for (std::size_t i = 0; i < workers.size() && i < m_worker_config.size(); ++i)
+    {
+        worker_labels.push_back(fmt::format("worker=\"{}\",hardware=\"{}\"", escape_label_value(m_worker_config[i].m_id),
+            hardware_name(m_worker_config[i].m_mode)));
+    }
+
+    auto const rate_samples = [&writer](char const* name, std::string const& labels, Rates const& rates)
+    {
+        writer.sample(name, "", labels + ",window=\"instant\"", rates.m_instant);
+        writer.sample(name, "", labels + ",window=\"1m\"", rates.m_short);
+        writer.sample(name, "", labels + ",window=\"15m\"", rates.m_long);
+        writer.sample(name, "", labels + ",window=\"ewma\"", rates.m_ewma);
+    };
+
+    if (!workers.empty() && std::holds_alternative<Hash>(workers.front()))
+    {
+        writer.counter("nexusminer_worker_hashes", "Hashes calculated.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            writer.sample("nexusminer_worker_hashes", "_total", worker_labels[i], std::get<Hash>(workers[i]).m_hash_count);
+        }
+        writer.gauge("nexusminer_worker_hash_rate", "Hashes per second over the window.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            rate_samples("nexusminer_worker_hash_rate", worker_labels[i], std::get<Hash>(workers[i]).m_rates);
+        }
+        writer.counter("nexusminer_worker_candidates", "Nonce candidates that met the difficulty (FPGA: nonces received).");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            auto const& hash_stats = std::get<Hash>(workers[i]);
+            writer.sample("nexusminer_worker_candidates", "_total", worker_labels[i],
+                m_worker_config[i].m_mode == config::Worker_mode::FPGA ? hash_stats.m_nonce_candidates_recieved : hash_stats.m_met_difficulty_count);
+        }
+        writer.counter("nexusminer_worker_hash_errors", "Hash errors reported by the device.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            writer.sample("nexusminer_worker_hash_errors", "_total", worker_labels[i], std::get<Hash>(workers[i]).m_hash_error_count);
+        }
+        writer.gauge("nexusminer_worker_best_leading_zeros", "Most leading zero bits found on the current block.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            writer.sample("nexusminer_worker_best_leading_zeros", "", worker_labels[i], std::get<Hash>(workers[i]).m_best_leading_zeros);
+        }
+    }
+    else if (!workers.empty())
+    {
+        writer.counter("nexusminer_worker_integers_searched", "Integers covered by the sieve.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            writer.sample("nexusminer_worker_integers_searched", "_total", worker_labels[i], std::get<Prime>(workers[i]).m_range_searched);
+        }
+        writer.gauge("nexusminer_worker_sieve_rate", "Integers searched per second over the window.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            rate_samples("nexusminer_worker_sieve_rate", worker_labels[i], std::get<Prime>(workers[i]).m_rates);
+        }
+        writer.counter("nexusminer_worker_fermat_primes", "Candidates that passed the Fermat test.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            writer.sample("nexusminer_worker_fermat_primes", "_total", worker_labels[i], std::get<Prime>(workers[i]).m_primes);
+        }
+        writer.counter("nexusminer_worker_chains", "Prime chains found.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            writer.sample("nexusminer_worker_chains", "_total", worker_labels[i], std::get<Prime>(workers[i]).m_chains);
+        }
+        writer.gauge("nexusminer_worker_chain_length", "Prime chains found by chain length.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            auto const& chain_histogram = std::get<Prime>(workers[i]).m_chain_histogram;
+            for (std::size_t length = 1; length < chain_histogram.size(); ++length)
+            {
+                writer.sample("nexusminer_worker_chain_length", "", fmt::format("{},length=\"{}\"", worker_labels[i], length),
+                    chain_histogram[length]);
+            }
+        }
+        writer.gauge("nexusminer_worker_best_chain", "Most difficult chain found.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            writer.sample("nexusminer_worker_best_chain", "", worker_labels[i], std::get<Prime>(workers[i]).m_most_difficult_chain);
+        }
+        writer.gauge("nexusminer_worker_difficulty", "Current block difficulty.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            writer.sample("nexusminer_worker_difficulty", "", worker_labels[i], std::get<Prime>(workers[i]).m_difficulty / 10000000.0);
+        }
+        writer.gauge("nexusminer_worker_cpu_load", "Estimated CPU load of the worker (0 - 1).");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            writer.sample("nexusminer_worker_cpu_load", "", worker_labels[i], std::get<Prime>(workers[i]).m_cpu_load);
+        }
+
+        // pipeline stages, rate() of a stage over rate() of total is its share of the mining loop
+        writer.counter("nexusminer_worker_stage_seconds", "Time spent in each prime pipeline stage.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            auto const& pipeline = std::get<Prime>(workers[i]).m_pipeline;
+            auto const stage_sample = [&](char const* stage, std::chrono::nanoseconds time)
+            {
+                writer.sample("nexusminer_worker_stage_seconds", "_total", fmt::format("{},stage=\"{}\"", worker_labels[i], stage),
+                    time.count() / 1.0e9);
+            };
+            stage_sample("sieve", pipeline.m_sieve);
+            stage_sample("find_chains", pipeline.m_find_chains);
+            stage_sample("fermat", pipeline.m_fermat);
+            stage_sample("clean_chains", pipeline.m_clean_chains);
+            stage_sample("total", pipeline.m_total);
+        }
+        writer.counter("nexusminer_worker_fermat_tests", "Fermat tests run.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            writer.sample("nexusminer_worker_fermat_tests", "_total", worker_labels[i], std::get<Prime>(workers[i]).m_pipeline.m_fermat_tests);
+        }
+        writer.gauge("nexusminer_worker_fermat_pass_ratio", "Fraction of Fermat tests that passed.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            writer.sample("nexusminer_worker_fermat_pass_ratio", "", worker_labels[i], std::get<Prime>(workers[i]).m_pipeline.fermat_pass_rate());
+        }
+        writer.gauge("nexusminer_worker_fermat_tests_per_chain", "Fermat tests run per chain candidate.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            writer.sample("nexusminer_worker_fermat_tests_per_chain", "", worker_labels[i], std::get<Prime>(workers[i]).m_pipeline.fermat_tests_per_chain());
+        }
+        writer.gauge("nexusminer_worker_chains_per_million", "Chain candidates per million integers searched.");
+        for (std::size_t i = 0; i < worker_labels.size(); ++i)
+        {
+            writer.sample("nexusminer_worker_chains_per_million", "", worker_labels[i], std::get<Prime>(workers[i]).chains_per_million());
+        }
+    }
+
+    // template latency: new block published until the worker mines on it
+    writer.summary("nexusminer_worker_block_switch_seconds", "Time from a new block until the worker switched to it.");
+    for (std::size_t i = 0; i < worker_labels.size() && i < work_switches.size(); ++i)
+    {
+        writer.sample("nexusminer_worker_block_switch_seconds", "_sum", worker_labels[i], work_switches[i].m_total_latency.count() / 1.0e6);
+        writer.sample("nexusminer_worker_block_switch_seconds", "_count", worker_labels[i], work_switches[i].m_switch_count);
+    }
+    writer.gauge("nexusminer_worker_block_switch_max_seconds", "Slowest block switch of the worker.");
+    for (std::size_t i = 0; i < worker_labels.size() && i < work_switches.size(); ++i)
+    {
+        writer.sample("nexusminer_worker_block_switch_max_seconds", "", worker_labels[i], work_switches[i].m_max_latency.count() / 1.0e6);
+    }
+
+    writer.finish();
+    return std::make_shared<network::Payload>(out.begin(), out.end());
+}
+
+}
+}
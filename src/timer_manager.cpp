@@ -1,29 +1,23 @@
 #include "timer_manager.hpp"
-#include "network/endpoint.hpp"
 #include "network/connection.hpp"
 #include "packet.hpp"
-#include "worker_manager.hpp"
+#include "protocol/protocol.hpp"
 #include "stats/stats_collector.hpp"
 #include "stats/stats_printer.hpp"
 #include "worker.hpp"
+#include "cpu/scheduler.hpp"
 
 namespace nexusminer
 {
 Timer_manager::Timer_manager(chrono::Timer_factory::Sptr timer_factory)
 : m_timer_factory{std::move(timer_factory)}
 {
-    m_connection_retry_timer = m_timer_factory->create_timer();
     m_get_height_timer = m_timer_factory->create_timer();
     m_ping_timer = m_timer_factory->create_timer();
+    m_template_prefetch_timer = m_timer_factory->create_timer();
     m_stats_collector_timer = m_timer_factory->create_timer();
     m_stats_printer_timer = m_timer_factory->create_timer();
-}
-
-void Timer_manager::start_connection_retry_timer(std::uint16_t timer_interval, std::weak_ptr<Worker_manager> worker_manager, 
-    network::Endpoint const& wallet_endpoint)
-{
-    m_connection_retry_timer->start(chrono::Seconds(timer_interval), 
-        connection_retry_handler(std::move(worker_manager), wallet_endpoint));
+    m_cpu_scheduler_timer = m_timer_factory->create_timer();
 }
 
 void Timer_manager::start_get_height_timer(std::uint16_t timer_interval, std::weak_ptr<network::Connection> connection)
@@ -36,11 +30,18 @@ void Timer_manager::start_ping_timer(std::uint16_t timer_interval, std::weak_ptr
     m_ping_timer->start(chrono::Seconds(timer_interval), ping_handler(timer_interval, std::move(connection)));
 }
 
+void Timer_manager::start_template_prefetch_timer(std::uint16_t timer_interval, std::weak_ptr<network::Connection> connection,
+    std::weak_ptr<protocol::Protocol> protocol)
+{
+    m_template_prefetch_timer->start(chrono::Seconds(timer_interval), 
+        template_prefetch_handler(timer_interval, std::move(connection), std::move(protocol)));
+}
+
 void Timer_manager::start_stats_collector_timer(std::uint16_t timer_interval, std::vector<std::shared_ptr<Worker>> workers, 
     std::shared_ptr<stats::Collector> stats_collector)
 {
-    m_stats_collector_timer->start(chrono::Seconds(timer_interval), stats_collector_handler(timer_interval, workers, 
-        std::move(stats_collector)));
+    m_stats_collector_timer->start(chrono::Seconds(timer_interval), stats_collector_handler(timer_interval, 
+        std::vector<std::weak_ptr<Worker>>(workers.begin(), workers.end()), std::move(stats_collector)));
 }
 
 void Timer_manager::start_stats_printer_timer(std::uint16_t timer_interval, std::vector<std::shared_ptr<stats::Printer>> stats_printers)
@@ -48,31 +49,24 @@ void Timer_manager::start_stats_printer_timer(std::uint16_t timer_interval, std:
     m_stats_printer_timer->start(chrono::Seconds(timer_interval), stats_printer_handler(timer_interval, std::move(stats_printers)));
 }
 
+void Timer_manager::start_cpu_scheduler_timer(std::uint16_t timer_interval, std::shared_ptr<cpu::Scheduler> cpu_scheduler)
+{
+    m_cpu_scheduler_timer->start(chrono::Seconds(timer_interval), cpu_scheduler_handler(timer_interval, std::move(cpu_scheduler)));
+}
+
+void Timer_manager::stop_cpu_scheduler_timer()
+{
+    m_cpu_scheduler_timer->cancel();
+}
+
 void Timer_manager::stop()
 {
-    m_connection_retry_timer->cancel();
     m_get_height_timer->cancel();
     m_ping_timer->cancel();
+    m_template_prefetch_timer->cancel();
     m_stats_collector_timer->cancel();
     m_stats_printer_timer->cancel();
-}
-
-chrono::Timer::Handler Timer_manager::connection_retry_handler(std::weak_ptr<Worker_manager> worker_manager,
-    network::Endpoint const& wallet_endpoint)
-{
-    return[worker_manager, wallet_endpoint](bool canceled)
-    {
-        if (canceled)	// don't do anything if the timer has been canceled
-        {
-            return;
-        }
-
-        auto worker_manager_shared = worker_manager.lock();
-        if(worker_manager_shared)
-        {
-            worker_manager_shared->connect(wallet_endpoint);
-        }
-    }; 
+    m_cpu_scheduler_timer->cancel();
 }
 
 chrono::Timer::Handler Timer_manager::get_height_handler(std::uint16_t get_height_interval, std::weak_ptr<network::Connection> connection)
@@ -118,8 +112,36 @@ chrono::Timer::Handler Timer_manager::ping_handler(std::uint16_t ping_interval,
     };
 }
 
+chrono::Timer::Handler Timer_manager::template_prefetch_handler(std::uint16_t template_prefetch_interval, 
+    std::weak_ptr<network::Connection> connection, std::weak_ptr<protocol::Protocol> protocol)
+{
+    return[this, connection, protocol, template_prefetch_interval](bool canceled)
+    {
+        if (canceled)	// don't do anything if the timer has been canceled
+        {
+            return;
+        }
+
+        auto connection_shared = connection.lock();
+        auto protocol_shared = protocol.lock();
+        if(connection_shared && protocol_shared)
+        {
+            // refresh the standby template, also notices new blocks on the network
+            auto payload = protocol_shared->prefetch_work();
+            if(payload)
+            {
+                connection_shared->transmit(payload);
+            }
+
+            // restart timer
+            m_template_prefetch_timer->start(chrono::Seconds(template_prefetch_interval), 
+                template_prefetch_handler(template_prefetch_interval, std::move(connection_shared), std::move(protocol_shared)));
+        }
+    }; 
+}
+
 chrono::Timer::Handler Timer_manager::stats_collector_handler(std::uint16_t stats_collector_interval, 
-    std::vector<std::shared_ptr<Worker>> workers, std::shared_ptr<stats::Collector> stats_collector)
+    std::vector<std::weak_ptr<Worker>> workers, std::shared_ptr<stats::Collector> stats_collector)
 {
     return[this, workers, stats_collector_interval, stats_collector = std::move(stats_collector)](bool canceled)
     {
@@ -130,7 +152,11 @@ chrono::Timer::Handler Timer_manager::stats_collector_handler(std::uint16_t stat
 
         for(auto& worker : workers)
         {
-            worker->update_statistics(*stats_collector);
+            auto worker_shared = worker.lock();
+            if(worker_shared)
+            {
+                worker_shared->update_statistics(*stats_collector);
+            }
         }
         // restart timer
         m_stats_collector_timer->start(chrono::Seconds(stats_collector_interval), 
@@ -159,4 +185,22 @@ chrono::Timer::Handler Timer_manager::stats_printer_handler(std::uint16_t stats_
     }; 
 }
 
+chrono::Timer::Handler Timer_manager::cpu_scheduler_handler(std::uint16_t cpu_scheduler_interval,
+    std::shared_ptr<cpu::Scheduler> cpu_scheduler)
+{
+    return[this, cpu_scheduler_interval, cpu_scheduler = std::move(cpu_scheduler)](bool canceled)
+    {
+        if (canceled)	// don't do anything if the timer has been canceled
+        {
+            return;
+        }
+
+        cpu_scheduler->update();
+
+        // restart timer
+        m_cpu_scheduler_timer->start(chrono::Seconds(cpu_scheduler_interval), cpu_scheduler_handler(cpu_scheduler_interval,
+            std::move(cpu_scheduler)));
+    };
+}
+
 }
\ No newline at end of file
@@ -11,7 +11,6 @@ namespace nexusminer
 {
 namespace network
 {
-    class Endpoint;
     class Connection;
 }
 namespace stats
@@ -19,7 +18,14 @@ namespace stats
     class Printer;
     class Collector;
 }
-class Worker_manager;
+namespace protocol
+{
+    class Protocol;
+}
+namespace cpu
+{
+    class Scheduler;
+}
 class Worker;
 
 
@@ -29,32 +35,37 @@ public:
 
     Timer_manager(chrono::Timer_factory::Sptr timer_factory);
 
-    void start_connection_retry_timer(std::uint16_t timer_interval, std::weak_ptr<Worker_manager> worker_manager, 
-        network::Endpoint const& wallet_endpoint);
     void start_get_height_timer(std::uint16_t timer_interval, std::weak_ptr<network::Connection> connection);
     void start_ping_timer(std::uint16_t timer_interval, std::weak_ptr<network::Connection> connection);
+    void start_template_prefetch_timer(std::uint16_t timer_interval, std::weak_ptr<network::Connection> connection,
+        std::weak_ptr<protocol::Protocol> protocol);
     void start_stats_collector_timer(std::uint16_t timer_interval, std::vector<std::shared_ptr<Worker>> workers, 
         std::shared_ptr<stats::Collector> stats_collector);
     void start_stats_printer_timer(std::uint16_t timer_interval, std::vector<std::shared_ptr<stats::Printer>> stats_printers);
+    void start_cpu_scheduler_timer(std::uint16_t timer_interval, std::shared_ptr<cpu::Scheduler> cpu_scheduler);
+    void stop_cpu_scheduler_timer();
 
     void stop();
 
 private:
 
-    chrono::Timer::Handler connection_retry_handler(std::weak_ptr<Worker_manager> worker_manager, 
-        network::Endpoint const& wallet_endpoint);
     chrono::Timer::Handler get_height_handler(std::uint16_t get_height_interval, std::weak_ptr<network::Connection> connection);
     chrono::Timer::Handler ping_handler(std::uint16_t ping_interval, std::weak_ptr<network::Connection> connection);
-    chrono::Timer::Handler stats_collector_handler(std::uint16_t stats_collector_interval, std::vector<std::shared_ptr<Worker>> workers, 
+    chrono::Timer::Handler template_prefetch_handler(std::uint16_t template_prefetch_interval, 
+        std::weak_ptr<network::Connection> connection, std::weak_ptr<protocol::Protocol> protocol);
+    // weak, the timer must not keep workers alive that a config reload removed
+    chrono::Timer::Handler stats_collector_handler(std::uint16_t stats_collector_interval, std::vector<std::weak_ptr<Worker>> workers, 
         std::shared_ptr<stats::Collector> stats_collector);
     chrono::Timer::Handler stats_printer_handler(std::uint16_t stats_printer_interval, std::vector<std::shared_ptr<stats::Printer>> stats_printers);
+    chrono::Timer::Handler cpu_scheduler_handler(std::uint16_t cpu_scheduler_interval, std::shared_ptr<cpu::Scheduler> cpu_scheduler);
 
     chrono::Timer_factory::Sptr m_timer_factory;
-    chrono::Timer::Uptr m_connection_retry_timer;
     chrono::Timer::Uptr m_get_height_timer;
     chrono::Timer::Uptr m_ping_timer;
+    chrono::Timer::Uptr m_template_prefetch_timer;
     chrono::Timer::Uptr m_stats_collector_timer;
     chrono::Timer::Uptr m_stats_printer_timer;
+    chrono::Timer::Uptr m_cpu_scheduler_timer;
 };
 }
 
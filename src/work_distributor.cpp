@@ -0,0 +1,127 @@
+#include "work_distributor.hpp"
+#include "stats/stats_collector.hpp"
+#include "stats/event_trace.hpp"
+#include <algorithm>
+
+namespace nexusminer
+{
+Work_distributor::Work_distributor(std::vector<std::shared_ptr<Worker>> const& workers,
+    std::shared_ptr<stats::Collector> stats_collector)
+: m_logger{spdlog::get("logger")}
+, m_stats_collector{std::move(stats_collector)}
+{
+    start(workers);
+}
+
+Work_distributor::~Work_distributor()
+{
+    stop();
+}
+
+void Work_distributor::publish(::LLP::CBlock const& block, std::uint32_t nbits, Worker::Block_found_handler result)
+{
+    auto const published = std::chrono::steady_clock::now();
+    stats::Event_trace::instance().instant("publish_block", "work", "height", block.nHeight);
+    for(auto& dispatcher : m_dispatchers)
+    {
+        {
+            std::scoped_lock lock(dispatcher->m_mutex);
+            if(dispatcher->m_pending_work)
+            {
+                m_logger->debug("Worker {} is still switching, pending block replaced", dispatcher->m_internal_worker_id);
+            }
+            dispatcher->m_pending_work = Work{block, nbits, result, published};
+        }
+        dispatcher->m_condition.notify_one();
+    }
+    m_last_work = Work{block, nbits, std::move(result), published};
+}
+
+void Work_distributor::stop()
+{
+    for(auto& dispatcher : m_dispatchers)
+    {
+        {
+            std::scoped_lock lock(dispatcher->m_mutex);
+            dispatcher->m_stop = true;
+        }
+        dispatcher->m_condition.notify_one();
+    }
+
+    m_stopped.clear();
+    for(auto& dispatcher : m_dispatchers)
+    {
+        if(dispatcher->m_thread.joinable())
+        {
+            dispatcher->m_thread.join();
+        }
+        m_stopped.emplace_back(dispatcher->m_worker, std::move(dispatcher->m_pending_work));
+    }
+    m_dispatchers.clear();
+}
+
+void Work_distributor::start(std::vector<std::shared_ptr<Worker>> const& workers)
+{
+    for(std::size_t i = 0; i < workers.size(); ++i)
+    {
+        auto dispatcher = std::make_unique<Dispatcher>();
+        dispatcher->m_internal_worker_id = static_cast<std::uint16_t>(i);
+        dispatcher->m_worker = workers[i];
+
+        std::weak_ptr<Worker> const worker = workers[i];
+        auto const stopped = std::find_if(m_stopped.begin(), m_stopped.end(), [&worker](auto const& entry)
+        {
+            return !entry.first.owner_before(worker) && !worker.owner_before(entry.first);
+        });
+        if(stopped != m_stopped.end())
+        {
+            dispatcher->m_pending_work = std::move(stopped->second);
+        }
+        else if(m_last_work)
+        {
+            dispatcher->m_pending_work = m_last_work;
+            dispatcher->m_pending_work->m_published = std::chrono::steady_clock::now();
+        }
+        m_dispatchers.push_back(std::move(dispatcher));
+    }
+    m_stopped.clear();
+
+    // start the threads after the vector is complete, each thread only references its own dispatcher
+    for(auto& dispatcher : m_dispatchers)
+    {
+        dispatcher->m_thread = std::thread(&Work_distributor::run, this, std::ref(*dispatcher));
+    }
+}
+
+void Work_distributor::run(Dispatcher& dispatcher)
+{
+    stats::Event_trace::instance().set_thread_name("dispatcher " + std::to_string(dispatcher.m_internal_worker_id));
+    for(;;)
+    {
+        Work work;
+        {
+            std::unique_lock lock(dispatcher.m_mutex);
+            dispatcher.m_condition.wait(lock, [&dispatcher] { return dispatcher.m_stop || dispatcher.m_pending_work; });
+            if(dispatcher.m_stop)
+            {
+                break;
+            }
+            work = std::move(*dispatcher.m_pending_work);
+            dispatcher.m_pending_work.reset();
+        }
+
+        {
+            stats::Trace_span span{"set_block", "work", "worker", dispatcher.m_internal_worker_id};
+            dispatcher.m_worker->set_block(std::move(work.m_block), work.m_nbits, std::move(work.m_result));
+        }
+
+        auto const latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - work.m_published);
+        m_stats_collector->update_work_switch_stats(dispatcher.m_internal_worker_id, latency);
+        m_stats_collector->get_block_latency().m_validated_to_mining.record(latency);
+        m_logger->debug("Worker {} switched to new block in {:.3f} ms", dispatcher.m_internal_worker_id,
+            latency.count() / 1000.0);
+    }
+}
+
+}
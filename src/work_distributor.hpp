@@ -0,0 +1,73 @@
+#ifndef NEXUSMINER_WORK_DISTRIBUTOR_HPP
+#define NEXUSMINER_WORK_DISTRIBUTOR_HPP
+
+#include "worker.hpp"
+#include <spdlog/spdlog.h>
+
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <utility>
+#include <chrono>
+
+namespace nexusminer
+{
+namespace stats { class Collector; }
+
+// Hands new blocks to all workers without blocking the io_context thread.
+// Every worker has its own dispatch thread, so the (possibly slow) set_block calls run concurrently.
+// A block that arrives while a worker is still switching replaces the pending one, the worker only
+// switches to the latest block.
+class Work_distributor
+{
+public:
+
+    Work_distributor(std::vector<std::shared_ptr<Worker>> const& workers, std::shared_ptr<stats::Collector> stats_collector);
+    ~Work_distributor();
+
+    // returns immediately, the workers switch in their dispatch threads
+    void publish(::LLP::CBlock const& block, std::uint32_t nbits, Worker::Block_found_handler result);
+
+    // stop all dispatch threads and release the workers. Blocks not yet handed to a worker are kept for start().
+    void stop();
+
+    // dispatch threads for the workers after a config reload changed them. A worker that was there before stop()
+    // gets the block that was still pending for it, a new worker starts on the last published block.
+    void start(std::vector<std::shared_ptr<Worker>> const& workers);
+
+private:
+
+    struct Work
+    {
+        ::LLP::CBlock m_block;
+        std::uint32_t m_nbits;
+        Worker::Block_found_handler m_result;
+        std::chrono::steady_clock::time_point m_published;
+    };
+
+    struct Dispatcher
+    {
+        std::uint16_t m_internal_worker_id{ 0 };
+        std::shared_ptr<Worker> m_worker;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::optional<Work> m_pending_work;
+        bool m_stop{ false };
+        std::thread m_thread;
+    };
+
+    void run(Dispatcher& dispatcher);
+
+    std::shared_ptr<spdlog::logger> m_logger;
+    std::shared_ptr<stats::Collector> m_stats_collector;
+    std::vector<std::unique_ptr<Dispatcher>> m_dispatchers;
+    std::optional<Work> m_last_work;
+    // pending block per worker of the stopped dispatchers, the weak_ptr identifies the worker even if it is gone
+    std::vector<std::pair<std::weak_ptr<Worker>, std::optional<Work>>> m_stopped;
+};
+}
+
+#endif
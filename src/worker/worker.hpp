@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <functional>
+#include <chrono>
 #include <algorithm>
 #include "LLC/types/uint1024.h"
 #include "block.hpp"
@@ -65,6 +66,10 @@ public:
 	uint32_t nBits = 0x7b032ed8;
 	uint64_t nNonce = 21155560019;
 
+	// not part of the header. Set by the worker for the block lifecycle latency stats
+	std::chrono::steady_clock::time_point m_found{};	// the search produced the candidate
+	std::chrono::steady_clock::time_point m_checked{};	// the candidate passed the difficulty check
+
 };
 
 class Worker {
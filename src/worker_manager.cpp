@@ -1,5 +1,6 @@
 #include "worker_manager.hpp"
 #include "cpu/worker_hash.hpp"
+#include "cpu/scheduler.hpp"
 
 #include "fpga/worker_hash.hpp"
 #ifdef GPU_CUDA_ENABLED
@@ -10,41 +11,95 @@
 #endif
 #ifdef PRIME_ENABLED
 #include "cpu/worker_prime.hpp"
+#include "cpu/calibration.hpp"
 #endif
 #include "packet.hpp"
+#include "packet_framer.hpp"
+#include "packet_trace.hpp"
+#include "work_distributor.hpp"
+#include "capture_replay.hpp"
 #include "config/config.hpp"
 #include "config/types.hpp"
 #include "LLP/block.hpp"
 #include "stats/stats_printer_console.hpp"
 #include "stats/stats_printer_file.hpp"
+#include "stats/stats_printer_prometheus.hpp"
+#include "stats/stats_printer_binary.hpp"
 #include "stats/stats_collector.hpp"
 #include "miner_keys.hpp"
 #include "protocol/solo.hpp"
 #include "protocol/pool.hpp"
+#include "version.h"
+#include "asio/post.hpp"
 #include <variant>
+#include <chrono>
+#include <algorithm>
+#include <tuple>
 
 namespace nexusminer
 {
+namespace
+{
+// same hardware, thread placement and identity: the running worker can stay, only its throttling may change
+bool same_worker(config::Worker_config const& running, config::Worker_config const& reloaded)
+{
+    if (running.m_id != reloaded.m_id || running.m_mode != reloaded.m_mode ||
+        running.m_worker_mode.index() != reloaded.m_worker_mode.index())
+    {
+        return false;
+    }
+    if (auto const* cpu_config = std::get_if<config::Worker_config_cpu>(&running.m_worker_mode))
+    {
+        auto const& reloaded_cpu_config = std::get<config::Worker_config_cpu>(reloaded.m_worker_mode);
+        // the priority is set when the mining thread starts
+        return std::tie(cpu_config->m_threads, cpu_config->m_affinity_mask, cpu_config->m_hyperthreading, cpu_config->m_efficiency_cores,
+                cpu_config->m_cpu, cpu_config->m_priority, cpu_config->m_sieve_wheel, cpu_config->m_sieve_autotune) ==
+            std::tie(reloaded_cpu_config.m_threads, reloaded_cpu_config.m_affinity_mask, reloaded_cpu_config.m_hyperthreading,
+                reloaded_cpu_config.m_efficiency_cores, reloaded_cpu_config.m_cpu, reloaded_cpu_config.m_priority,
+                reloaded_cpu_config.m_sieve_wheel, reloaded_cpu_config.m_sieve_autotune);
+    }
+    if (auto const* gpu_config = std::get_if<config::Worker_config_gpu>(&running.m_worker_mode))
+    {
+        return gpu_config->m_device == std::get<config::Worker_config_gpu>(reloaded.m_worker_mode).m_device;
+    }
+    return std::get<config::Worker_config_fpga>(running.m_worker_mode).serial_port ==
+        std::get<config::Worker_config_fpga>(reloaded.m_worker_mode).serial_port;
+}
+
+// take over the throttling of a kept cpu worker (read by the cpu scheduler only), true if it changed
+bool retune(config::Worker_config& running, config::Worker_config const& reloaded)
+{
+    auto* cpu_config = std::get_if<config::Worker_config_cpu>(&running.m_worker_mode);
+    if (!cpu_config)
+    {
+        return false;
+    }
+    auto const& reloaded_cpu_config = std::get<config::Worker_config_cpu>(reloaded.m_worker_mode);
+    auto const changed = cpu_config->m_group != reloaded_cpu_config.m_group ||
+        cpu_config->m_power_limit_percent != reloaded_cpu_config.m_power_limit_percent ||
+        cpu_config->m_target_hashrate != reloaded_cpu_config.m_target_hashrate;
+    cpu_config->m_group = reloaded_cpu_config.m_group;
+    cpu_config->m_power_limit_percent = reloaded_cpu_config.m_power_limit_percent;
+    cpu_config->m_target_hashrate = reloaded_cpu_config.m_target_hashrate;
+    return changed;
+}
+}
+
 Worker_manager::Worker_manager(std::shared_ptr<asio::io_context> io_context, Config& config, 
-    chrono::Timer_factory::Sptr timer_factory, network::Socket::Sptr socket)
+    chrono::Timer_factory::Sptr timer_factory, network::Socket_factory::Sptr socket_factory,
+    network::Endpoint local_endpoint)
 : m_io_context{std::move(io_context)}
 , m_config{config}
-, m_socket{std::move(socket)}
+, m_timer_factory{timer_factory}
+, m_socket_factory{std::move(socket_factory)}
+, m_local_endpoint{std::move(local_endpoint)}
 , m_logger{spdlog::get("logger")}
 , m_stats_collector{std::make_shared<stats::Collector>(m_config)}
 , m_timer_manager{std::move(timer_factory)}
 {
     auto const& pool_config = m_config.get_pool_config();
-    if(pool_config.m_use_pool)
+    if(!pool_config.m_use_pool)
     {
-        // Pool mining always uses the standard Pool protocol
-        m_miner_protocol = std::make_shared<protocol::Pool>(m_logger, m_config.get_mining_mode(), m_config.get_pool_config(), m_stats_collector);
-    }
-    else
-    {
-        // Solo mining requires Falcon authentication - no legacy fallback
-        auto solo_protocol = std::make_shared<protocol::Solo>(m_config.get_mining_mode() == config::Mining_mode::PRIME ? 1U : 2U, m_stats_collector);
-        
         // Falcon miner authentication is mandatory for solo mining
         if (!m_config.has_miner_falcon_keys())
         {
@@ -61,22 +116,16 @@ Worker_manager::Worker_manager(std::shared_ptr<asio::io_context> io_context, Con
         
         m_logger->info("[Worker_manager] Configuring Falcon miner authentication");
         
-        std::vector<uint8_t> pubkey, privkey;
-        if (!keys::from_hex(m_config.get_miner_falcon_pubkey(), pubkey) ||
-            !keys::from_hex(m_config.get_miner_falcon_privkey(), privkey))
+        if (!create_signer(m_config))
         {
-            m_logger->error("[Worker_manager] CRITICAL: Failed to parse Falcon keys from config - invalid hex format");
-            m_logger->error("[Worker_manager] Keys must be valid hexadecimal strings");
+            m_logger->error("[Worker_manager] CRITICAL: Failed to set up the Falcon signer from the config keys");
+            m_logger->error("[Worker_manager] Keys must be valid hexadecimal Falcon-512 keys");
             m_logger->error("[Worker_manager] Use ./NexusMiner --create-keys to generate valid keys");
-            throw std::runtime_error("Invalid Falcon key format in configuration");
+            throw std::runtime_error("Invalid Falcon keys in configuration");
         }
         
-        solo_protocol->set_miner_keys(pubkey, privkey);
-        solo_protocol->set_address(m_config.get_local_ip());
-        
         // Configure optional block signing
         if (m_config.get_enable_block_signing()) {
-            solo_protocol->enable_block_signing(true);
             m_logger->info("[Worker_manager] Block signing ENABLED for enhanced validation");
             m_logger->warn("[Worker_manager] Note: Block signing adds ~690 bytes to each submission");
         } else {
@@ -85,18 +134,59 @@ Worker_manager::Worker_manager(std::shared_ptr<asio::io_context> io_context, Con
         
         m_logger->info("[Worker_manager] Falcon keys loaded from config");
         m_logger->info("[Worker_manager] Auth address: {}", m_config.get_local_ip());
-        
-        m_miner_protocol = solo_protocol;
     } 
   
     create_stats_printers();
+    // the calibration holds the sieving primes until the workers have taken them
+    auto const calibration = run_calibration();
     create_workers();
 }
 
+std::shared_ptr<protocol::Protocol> Worker_manager::create_protocol() const
+{
+    auto const& pool_config = m_config.get_pool_config();
+    if(pool_config.m_use_pool)
+    {
+        // Pool mining always uses the standard Pool protocol
+        return std::make_shared<protocol::Pool>(m_logger, m_config.get_mining_mode(), m_config.get_pool_config(), m_stats_collector);
+    }
+
+    // Solo mining requires Falcon authentication - no legacy fallback, keys are checked in the constructor
+    auto solo_protocol = std::make_shared<protocol::Solo>(m_config.get_mining_mode() == config::Mining_mode::PRIME ? 1U : 2U, m_stats_collector);
+    solo_protocol->set_signer(m_falcon_wrapper, m_signing_executor);
+    solo_protocol->set_address(m_config.get_local_ip());
+    solo_protocol->enable_template_prefetch(m_config.get_template_prefetch_interval() > 0);
+    solo_protocol->enable_block_signing(m_config.get_enable_block_signing());
+    return solo_protocol;
+}
+
+bool Worker_manager::create_signer(Config const& config)
+{
+    std::vector<std::uint8_t> falcon_pubkey;
+    LLC::CPrivKey falcon_privkey;   // locked memory, cleared when freed after the signer has taken the key
+    if (!config.has_miner_falcon_keys() || !keys::from_hex(config.get_miner_falcon_pubkey(), falcon_pubkey) ||
+        !keys::from_hex(config.get_miner_falcon_privkey(), falcon_privkey))
+    {
+        return false;
+    }
+
+    auto falcon_wrapper = std::make_shared<protocol::FalconSignatureWrapper>(falcon_pubkey, falcon_privkey,
+        config.get_falcon_expanded_key());
+    if (!falcon_wrapper->is_valid())
+    {
+        return false;
+    }
+    m_falcon_wrapper = std::move(falcon_wrapper);
+    m_signing_executor = std::make_shared<protocol::Signing_executor>(m_falcon_wrapper);
+    return true;
+}
+
 void Worker_manager::create_stats_printers()
 {
     bool printer_console_created = false;
     bool printer_file_created = false;
+    bool printer_prometheus_created = false;
+    bool printer_binary_created = false;
     for(auto& stats_printer_config : m_config.get_stats_printer_config())
     {
         switch(stats_printer_config.m_mode)
@@ -121,6 +211,37 @@ void Worker_manager::create_stats_printers()
                 }
                 break;
             }
+            case config::Stats_printer_mode::PROMETHEUS:
+            {
+                if(!printer_prometheus_created)
+                {
+                    printer_prometheus_created = true;
+                    auto const& stats_printer_config_prometheus = std::get<config::Stats_printer_config_prometheus>(stats_printer_config.m_printer_mode);
+                    auto printer = std::make_shared<stats::Printer_prometheus>(m_socket_factory, stats_printer_config_prometheus,
+                        m_config.get_pool_config().m_use_pool, m_config.get_worker_config(), *m_stats_collector);
+                    if (printer->start())
+                    {
+                        m_stats_printers.push_back(std::move(printer));
+                    }
+                }
+                break;
+            }
+            case config::Stats_printer_mode::BINARY:
+            {
+                if(!printer_binary_created)
+                {
+                    printer_binary_created = true;
+                    auto const& stats_printer_config_binary = std::get<config::Stats_printer_config_binary>(stats_printer_config.m_printer_mode);
+                    auto printer = std::make_shared<stats::Printer_binary>(stats_printer_config_binary, m_config.get_mining_mode(),
+                        m_config.get_pool_config().m_use_pool, m_config.get_print_statistics_interval(), m_config.get_worker_config(),
+                        *m_stats_collector);
+                    if (printer->start())
+                    {
+                        m_stats_printers.push_back(std::move(printer));
+                    }
+                }
+                break;
+            }
             case config::Stats_printer_mode::CONSOLE:    // falltrough
             default:
             {
@@ -156,96 +277,411 @@ void Worker_manager::create_workers()
     for(auto& worker_config : m_config.get_worker_config())
     {
         worker_config.m_internal_id = internal_id;
-        switch(worker_config.m_mode)
+        Worker_slot slot;
+        slot.m_config = std::make_unique<config::Worker_config>(worker_config);
+        create_worker(slot);
+        if(slot.m_worker)
+        {
+            m_workers.push_back(slot.m_worker);
+        }
+        m_worker_slots.push_back(std::move(slot));
+        internal_id++;
+    }
+
+    m_work_distributor = std::make_shared<Work_distributor>(m_workers, m_stats_collector);
+    start_cpu_scheduler();
+}
+
+void Worker_manager::create_worker(Worker_slot& slot)
+{
+    auto& worker_config = *slot.m_config;
+    switch(worker_config.m_mode)
+    {
+        case config::Worker_mode::FPGA:
         {
-            case config::Worker_mode::FPGA:
+            if (m_config.get_mining_mode() == config::Mining_mode::PRIME)
             {
-                if (m_config.get_mining_mode() == config::Mining_mode::PRIME)
-                {
-                    m_logger->error("FPGA worker is not supported for PRIME mining!");
-                }
-                else
-                {
-                    m_workers.push_back(std::make_shared<fpga::Worker_hash>(m_io_context, worker_config));
-                }
-                break;
+                m_logger->error("FPGA worker is not supported for PRIME mining!");
             }
-            case config::Worker_mode::GPU:
+            else
             {
+                slot.m_worker = std::make_shared<fpga::Worker_hash>(m_io_context, worker_config);
+            }
+            break;
+        }
+        case config::Worker_mode::GPU:
+        {
 #ifdef GPU_ENABLED
-                if (m_config.get_mining_mode() == config::Mining_mode::PRIME)
-                {
+            if (m_config.get_mining_mode() == config::Mining_mode::PRIME)
+            {
 #ifdef PRIME_ENABLED
-                    m_workers.push_back(std::make_shared<gpu::Worker_prime>(m_io_context, worker_config));
+                slot.m_worker = std::make_shared<gpu::Worker_prime>(m_io_context, worker_config);
 #else
-                    m_logger->error("NexusMiner not built 'WITH_PRIME' -> no worker created!");
+                m_logger->error("NexusMiner not built 'WITH_PRIME' -> no worker created!");
 #endif
-                }
+            }
 #if defined(GPU_CUDA_ENABLED) && !defined(PRIME_ENABLED)
-                else
-                {
-                    m_workers.push_back(std::make_shared<gpu::Worker_hash>(m_io_context, worker_config));
-                }                
+            else
+            {
+                slot.m_worker = std::make_shared<gpu::Worker_hash>(m_io_context, worker_config);
+            }                
 #elif defined(GPU_AMD_ENABLED) && !defined(PRIME_ENABLED)
-                m_logger->error("NexusMiner 'WITH_GPU_AMD' but not 'WITH_PRIME'.  Hash mode on AMD is not supported. -> no worker created!");
+            m_logger->error("NexusMiner 'WITH_GPU_AMD' but not 'WITH_PRIME'.  Hash mode on AMD is not supported. -> no worker created!");
 #endif
 #else
-                m_logger->error("NexusMiner not built 'WITH_GPU_CUDA' or 'WITH_GPU_AMD' -> no worker created!");
+            m_logger->error("NexusMiner not built 'WITH_GPU_CUDA', 'WITH_GPU_AMD' or 'WITH_GPU_EMULATION' -> no worker created!");
 #endif
-                break;
-            }
-            case config::Worker_mode::CPU:    // falltrough
-            default:
+            break;
+        }
+        case config::Worker_mode::CPU:    // falltrough
+        default:
+        {
+            if (m_config.get_mining_mode() == config::Mining_mode::PRIME)
             {
-                if (m_config.get_mining_mode() == config::Mining_mode::PRIME)
-                {
 #ifdef PRIME_ENABLED
-                    m_workers.push_back(std::make_shared<cpu::Worker_prime>(m_io_context, worker_config));
+                auto worker = std::make_shared<cpu::Worker_prime>(m_io_context, worker_config);
+                slot.m_throttle = worker->get_throttle();
+                slot.m_worker = std::move(worker);
 #else
-                    m_logger->error("NexusMiner not built 'WITH_PRIME' -> no worker created!");
+                m_logger->error("NexusMiner not built 'WITH_PRIME' -> no worker created!");
 #endif
-                }
-                else
-                {
-                    m_workers.push_back(std::make_shared<cpu::Worker_hash>(m_io_context, worker_config));
-                }
-                break;
             }
+            else
+            {
+                auto worker = std::make_shared<cpu::Worker_hash>(m_io_context, worker_config);
+                slot.m_throttle = worker->get_throttle();
+                slot.m_worker = std::move(worker);
+            }
+            break;
         }
-        internal_id++;
     }
 }
 
+void Worker_manager::start_cpu_scheduler()
+{
+    m_cpu_scheduler = std::make_shared<cpu::Scheduler>(m_config.get_mining_mode());
+    for(auto const& slot : m_worker_slots)
+    {
+        if(slot.m_throttle)
+        {
+            m_cpu_scheduler->add(*slot.m_config, slot.m_throttle);
+        }
+    }
+
+    if (m_cpu_scheduler->empty())
+    {
+        m_timer_manager.stop_cpu_scheduler_timer();
+        return;
+    }
+    m_cpu_scheduler->log_setup();
+    m_timer_manager.start_cpu_scheduler_timer(cpu::Scheduler::update_interval, m_cpu_scheduler);
+}
+
+// measure the cpu prime kernels once, before the workers start instead of in every worker.
+// the returned calibration keeps the sieving primes it generated, the workers created while it lives reuse them.
+std::unique_ptr<cpu::Calibration> Worker_manager::run_calibration()
+{
+#ifdef PRIME_ENABLED
+    if (m_config.get_mining_mode() != config::Mining_mode::PRIME)
+    {
+        return {};
+    }
+
+    std::vector<config::Sieve_wheel> wheels;
+    for(auto const& worker_config : m_config.get_worker_config())
+    {
+        if (std::holds_alternative<config::Worker_config_cpu>(worker_config.m_worker_mode))
+        {
+            auto const wheel = std::get<config::Worker_config_cpu>(worker_config.m_worker_mode).m_sieve_wheel;
+            if (std::find(wheels.begin(), wheels.end(), wheel) == wheels.end())
+            {
+                wheels.push_back(wheel);
+            }
+        }
+    }
+    if (wheels.empty())
+    {
+        return {};
+    }
+
+    auto calibration = std::make_unique<cpu::Calibration>();
+    calibration->run(wheels);
+    return calibration;
+#else
+    return {};
+#endif
+}
+
 void Worker_manager::stop()
 {
     m_timer_manager.stop();
+    if (m_replay)
+    {
+        m_replay->stop();
+    }
+
+    disconnect();
 
-    // close connection
-    m_connection.reset();
+    // no more block switches, the dispatch threads hold references to the workers
+    if(m_work_distributor)
+    {
+        m_work_distributor->stop();
+    }
 
     // destroy workers
     for(auto& worker : m_workers)
     {
         worker.reset();
     }
+    for(auto& slot : m_worker_slots)
+    {
+        slot.m_worker.reset();
+    }
 }
 
-void Worker_manager::retry_connect(network::Endpoint const& wallet_endpoint)
+void Worker_manager::disconnect()
+{
+    for(auto& node : m_nodes)
+    {
+        node->m_retry_timer->cancel();
+        node->m_probe_timer->cancel();
+        node->m_connection.reset();
+    }
+    m_active_node.reset();
+    m_nodes.clear();
+}
+
+void Worker_manager::reload(Config const& reloaded, config::Config_changes const& changes,
+    std::vector<network::Endpoint> const& wallet_endpoints, network::Endpoint local_endpoint)
+{
+    auto applied = changes;
+    if (applied.m_connection && !m_replay && !reloaded.get_pool_config().m_use_pool)
+    {
+        // the sessions of the old nodes keep the old signer until they are closed
+        if (!create_signer(reloaded))
+        {
+            m_logger->error("[Reload] Falcon keys missing or invalid, the connection settings are not applied");
+            applied.m_connection = false;
+        }
+    }
+
+    auto const print_statistics_interval = m_config.get_print_statistics_interval();
+    m_config.apply(reloaded, applied);
+
+    auto const workers_changed = applied.m_workers && update_workers();
+    auto const interval_changed = print_statistics_interval != m_config.get_print_statistics_interval();
+    if (workers_changed || interval_changed)
+    {
+        for (auto& stats_printer : m_stats_printers)
+        {
+            stats_printer->reload(m_config.get_print_statistics_interval());
+        }
+        if (m_stats_timers_started)
+        {
+            start_stats_timers();
+        }
+    }
+
+    // the height probes and connection retries read their interval when they start next
+    if (applied.m_intervals && m_config.get_pool_config().m_use_pool && m_active_node && m_active_node->m_connection)
+    {
+        m_timer_manager.start_ping_timer(m_config.get_ping_interval(), m_active_node->m_connection);
+    }
+
+    if (applied.m_connection && !m_replay)
+    {
+        // the workers keep mining the last block until a node of the new settings sends one
+        m_logger->info("[Reload] Connection settings changed, reconnecting to {} node(s)", wallet_endpoints.size());
+        disconnect();
+        m_template_height = 0;
+        m_local_endpoint = std::move(local_endpoint);
+        if (!connect(wallet_endpoints))
+        {
+            for (auto const& node : m_nodes)
+            {
+                retry_connect(node);
+            }
+        }
+    }
+}
+
+bool Worker_manager::update_workers()
+{
+    auto& worker_configs = m_config.get_worker_config();
+    std::vector<std::uint16_t> replaced;     // internal ids that get a new worker
+    std::size_t retuned = 0;
+    for (std::size_t i = 0; i < worker_configs.size(); ++i)
+    {
+        worker_configs[i].m_internal_id = static_cast<std::uint16_t>(i);
+        if (i < m_worker_slots.size() && same_worker(*m_worker_slots[i].m_config, worker_configs[i]))
+        {
+            retuned += retune(*m_worker_slots[i].m_config, worker_configs[i]) ? 1 : 0;
+        }
+        else
+        {
+            replaced.push_back(static_cast<std::uint16_t>(i));
+        }
+    }
+    auto const restarted = static_cast<std::size_t>(std::count_if(replaced.begin(), replaced.end(),
+        [this](auto internal_id) { return internal_id < m_worker_slots.size(); }));
+    auto const removed = m_worker_slots.size() > worker_configs.size() ? m_worker_slots.size() - worker_configs.size() : 0;
+    m_logger->info("[Reload] Workers: {} unchanged, {} retuned, {} restarted, {} added, {} removed",
+        worker_configs.size() - replaced.size() - retuned, retuned, restarted, replaced.size() - restarted, removed);
+
+    auto const changed = !replaced.empty() || removed > 0;
+    if (changed)
+    {
+        // no block switches and no work switch stats while the workers change. A worker references its config,
+        // the old worker has to be gone before its slot gets the new config.
+        m_work_distributor->stop();
+        m_workers.clear();
+        for (auto const internal_id : replaced)
+        {
+            if (internal_id < m_worker_slots.size())
+            {
+                m_worker_slots[internal_id].m_worker.reset();
+                m_worker_slots[internal_id].m_throttle.reset();
+            }
+        }
+        m_worker_slots.resize(worker_configs.size());
+        m_stats_collector->update_workers(worker_configs.size(), replaced);
+
+        for (auto const internal_id : replaced)
+        {
+            auto& slot = m_worker_slots[internal_id];
+            slot.m_config = std::make_unique<config::Worker_config>(worker_configs[internal_id]);
+            create_worker(slot);
+        }
+        for (auto const& slot : m_worker_slots)
+        {
+            if (slot.m_worker)
+            {
+                m_workers.push_back(slot.m_worker);
+            }
+        }
+        m_work_distributor->start(m_workers);
+    }
+
+    start_cpu_scheduler();
+    return changed;
+}
+
+void Worker_manager::retry_connect(std::shared_ptr<Node> const& node)
 {           
-    m_connection = nullptr;		// close connection (socket etc)
-    m_miner_protocol->reset();
+    node->m_connection = nullptr;		// close connection (socket etc)
+    node->m_packet_framer->reset();
+    node->m_protocol->reset();
+    node->m_logged_in = false;
+    node->m_probe_timer->cancel();
+    node->m_probe_sent.reset();
+    node->m_probes_unanswered = 0;
+    node->m_submitted.clear();
     stats::Global global_stats{};
     global_stats.m_connection_retries = 1;
     m_stats_collector->update_global_stats(global_stats);
 
+    if (node == m_active_node)
+    {
+        // the workers keep mining the last template until the failover node sends its own
+        m_active_node = nullptr;
+        auto failover_node = select_failover_node();
+        if (failover_node)
+        {
+            activate_node(failover_node, "failover");
+            failover_node->m_connection->transmit(failover_node->m_protocol->get_work());
+        }
+        else
+        {
+            m_logger->warn("No other node connected, workers keep mining the last block");
+        }
+    }
+
+    if (m_replay)
+    {
+        // the capture reconnects on its own
+        return;
+    }
+
     // retry connect
     auto const connection_retry_interval = m_config.get_connection_retry_interval();
-    m_logger->info("Connection retry {} seconds", connection_retry_interval);
-    m_timer_manager.start_connection_retry_timer(connection_retry_interval, shared_from_this(), wallet_endpoint);
+    m_logger->info("Connection retry {} seconds ({})", connection_retry_interval, node->m_endpoint.to_string());
+    std::weak_ptr<Worker_manager> weak_self = shared_from_this();
+    std::weak_ptr<Node> weak_node = node;
+    node->m_retry_timer->start(chrono::Seconds(connection_retry_interval), [weak_self, weak_node](bool canceled)
+    {
+        if (canceled)	// don't do anything if the timer has been canceled
+        {
+            return;
+        }
+
+        auto self = weak_self.lock();
+        auto node = weak_node.lock();
+        if (self && node && !self->connect(node))
+        {
+            self->retry_connect(node);
+        }
+    });
+}
+
+bool Worker_manager::connect(std::vector<network::Endpoint> const& wallet_endpoints)
+{
+    auto const& pool_config = m_config.get_pool_config();
+    for (auto const& wallet_endpoint : wallet_endpoints)
+    {
+        if (pool_config.m_use_pool && !m_nodes.empty())
+        {
+            m_logger->warn("Pool mining uses one connection, node {} ignored", wallet_endpoint.to_string());
+            continue;
+        }
+
+        auto node = create_node(wallet_endpoint);
+        // own socket per node, a socket keeps its local port and can't connect twice from it
+        node->m_socket = m_socket_factory->create_socket(m_local_endpoint);
+        m_nodes.push_back(std::move(node));
+    }
+
+    if (m_nodes.size() > 1)
+    {
+        m_logger->info("[Solo] Mining with {} nodes in parallel, following the node that delivers new blocks first", m_nodes.size());
+    }
+
+    // nodes that can't start now are retried, the others keep the farm busy
+    auto connected = false;
+    for (auto const& node : m_nodes)
+    {
+        if (connect(node))
+        {
+            connected = true;
+        }
+    }
+    if (connected)
+    {
+        for (auto const& node : m_nodes)
+        {
+            if (!node->m_connection)
+            {
+                retry_connect(node);
+            }
+        }
+    }
+    return connected;
+}
+
+std::shared_ptr<Worker_manager::Node> Worker_manager::create_node(network::Endpoint endpoint)
+{
+    auto node = std::make_shared<Node>();
+    node->m_index = m_nodes.size();
+    node->m_endpoint = std::move(endpoint);
+    node->m_packet_framer = std::make_shared<Packet_framer>();
+    node->m_protocol = create_protocol();
+    node->m_retry_timer = m_timer_factory->create_timer();
+    node->m_probe_timer = m_timer_factory->create_timer();
+    return node;
 }
 
-bool Worker_manager::connect(network::Endpoint const& wallet_endpoint)
+bool Worker_manager::connect(std::shared_ptr<Node> const& node)
 {
+    auto const& wallet_endpoint = node->m_endpoint;
     std::string wallet_addr;
     wallet_endpoint.address(wallet_addr);
     uint16_t configured_port = wallet_endpoint.port();
@@ -255,10 +691,12 @@ bool Worker_manager::connect(network::Endpoint const& wallet_endpoint)
     m_logger->debug("[Solo] Connection initiated to endpoint: {}", wallet_endpoint.to_string());
     
     std::weak_ptr<Worker_manager> weak_self = shared_from_this();
-    auto connection = m_socket->connect(wallet_endpoint, [weak_self, wallet_endpoint](auto result, auto receive_buffer)
+    std::weak_ptr<Node> weak_node = node;
+    auto connection = node->m_socket->connect(wallet_endpoint, [weak_self, weak_node, wallet_endpoint](auto result, auto receive_buffer)
     {
         auto self = weak_self.lock();
-        if(self)
+        auto node = weak_node.lock();
+        if(self && node)
         {
             if (result == network::Result::connection_declined ||
                 result == network::Result::connection_aborted ||
@@ -267,13 +705,13 @@ bool Worker_manager::connect(network::Endpoint const& wallet_endpoint)
             {
                 self->m_logger->error("[Solo] Connection to wallet {} not successful. Result: {} - This may indicate wallet lock, sync issues, or network problems", 
                     wallet_endpoint.to_string(), network::Result::code_to_string(result));
-                self->retry_connect(wallet_endpoint);
+                self->retry_connect(node);
             }
             else if (result == network::Result::connection_ok)
             {
                 // Log successful connection with actual port information
-                auto const& remote_ep = self->m_connection->remote_endpoint();
-                auto const& local_ep = self->m_connection->local_endpoint();
+                auto const& remote_ep = node->m_connection->remote_endpoint();
+                auto const& local_ep = node->m_connection->local_endpoint();
                 
                 std::string remote_addr, local_addr;
                 remote_ep.address(remote_addr);
@@ -289,61 +727,18 @@ bool Worker_manager::connect(network::Endpoint const& wallet_endpoint)
                 self->m_logger->debug("[Solo] Port Validation: Connection established on LLP port {}", 
                     actual_remote_port);
 
-                // login
-                self->m_connection->transmit(self->m_miner_protocol->login([self, wallet_endpoint](bool login_result)
-                {
-                    if(!login_result)
-                    {
-                        self->retry_connect(wallet_endpoint);
-                        return;
-                    }
-
-                    auto const print_statistics_interval = self->m_config.get_print_statistics_interval();
-                    self->m_timer_manager.start_stats_collector_timer(print_statistics_interval, self->m_workers, self->m_stats_collector);
-                    self->m_timer_manager.start_stats_printer_timer(print_statistics_interval, self->m_stats_printers);
-
-                    auto const& pool_config = self->m_config.get_pool_config();
-                    if (pool_config.m_use_pool)
-                    {
-                        // pool miner sends PING to keep connection alive
-                        auto const ping_interval = self->m_config.get_ping_interval();
-                        self->m_timer_manager.start_ping_timer(ping_interval, self->m_connection);
-                    }
-                    else
-                    {
-                        // Solo mining uses stateless protocol with mandatory Falcon authentication (no GET_HEIGHT)
-                        self->m_logger->info("[Solo Phase 2] Stateless mining mode - GET_HEIGHT timer disabled");
-                        self->m_logger->info("[Solo Phase 2] Work requests handled via GET_BLOCK after successful auth");
-                    }
-
-                    self->m_miner_protocol->set_block_handler([self, wallet_endpoint](auto block, auto nBits)
-                    {
-                        for(auto& worker : self->m_workers)
-                        {
-                            worker->set_block(block, nBits, [self, wallet_endpoint](auto id, auto block_data)
-                            {
-                                if (self->m_connection)
-                                    self->m_connection->transmit(self->m_miner_protocol->submit_block(
-                                        block_data->merkle_root.GetBytes(), block_data->nNonce));
-                                else
-                                {
-                                    self->m_logger->error("No connection. Can't submit block.");
-                                    self->retry_connect(wallet_endpoint);
-                                }
-                            });
-                        }
-                    });
-                }));
+                self->on_connected(node);
             }
             else
             {
-                if (!self->m_connection)
+                if (!node->m_connection)
                 {
                     self->m_logger->error("No connection to wallet.");
-                    self->retry_connect(wallet_endpoint);
+                    self->retry_connect(node);
+                    return;
                 }
                 // data received
-                self->process_data(std::move(receive_buffer));
+                self->process_data(*node, std::move(receive_buffer));
             }
         }
     });
@@ -353,16 +748,381 @@ bool Worker_manager::connect(network::Endpoint const& wallet_endpoint)
         return false;
     }
 
-    m_connection = std::move(connection);
+    node->m_connection = std::move(connection);
+    node->m_packet_framer->reset();
     return true;
 }
 
-void Worker_manager::process_data(network::Shared_payload&& receive_buffer)
+void Worker_manager::on_connected(std::shared_ptr<Node> const& node)
+{
+    auto self = shared_from_this();
+    std::weak_ptr<Node> weak_node = node;
+
+    // login
+    node->m_connection->transmit(node->m_protocol->login([self, weak_node](bool login_result)
+    {
+        auto node = weak_node.lock();
+        if(!node)
+        {
+            return;
+        }
+        if(!login_result)
+        {
+            self->retry_connect(node);
+            return;
+        }
+        node->m_logged_in = true;
+        self->start_stats_timers();
+
+        auto const& pool_config = self->m_config.get_pool_config();
+        if (pool_config.m_use_pool)
+        {
+            // pool miner sends PING to keep connection alive
+            auto const ping_interval = self->m_config.get_ping_interval();
+            self->m_timer_manager.start_ping_timer(ping_interval, node->m_connection);
+        }
+        else
+        {
+            // Solo mining uses stateless protocol with mandatory Falcon authentication (no GET_HEIGHT)
+            self->m_logger->info("[Solo Phase 2] Stateless mining mode - GET_HEIGHT timer disabled");
+            self->m_logger->info("[Solo Phase 2] Work requests handled via GET_BLOCK after successful auth");
+
+            // with several nodes GET_HEIGHT probes measure the round trip and notice new blocks on every node
+            if (self->m_nodes.size() > 1 && !self->m_replay)
+            {
+                self->start_probe(node);
+            }
+        }
+
+        node->m_protocol->set_block_handler([self, weak_node](auto block, auto nBits)
+        {
+            auto node = weak_node.lock();
+            if (node)
+            {
+                self->on_new_template(node, block, nBits);
+            }
+        });
+
+        if (!self->m_active_node)
+        {
+            self->activate_node(node, "connected");
+        }
+    }));
+}
+
+void Worker_manager::start_stats_timers()
+{
+    auto const print_statistics_interval = m_config.get_print_statistics_interval();
+    m_timer_manager.start_stats_collector_timer(print_statistics_interval, m_workers, m_stats_collector);
+    m_timer_manager.start_stats_printer_timer(print_statistics_interval, m_stats_printers);
+    m_stats_timers_started = true;
+}
+
+bool Worker_manager::replay(std::string const& capture_file, double speed, std::function<void()> finished)
+{
+    m_replay = std::make_shared<Capture_replay>(m_timer_factory);
+    std::weak_ptr<Worker_manager> weak_self = shared_from_this();
+    auto const started = std::chrono::steady_clock::now();
+    return m_replay->start(capture_file, speed, [weak_self](auto record)
+    {
+        auto self = weak_self.lock();
+        if (self)
+        {
+            self->process_replay_record(std::move(record));
+        }
+    },
+    [weak_self, started, finished = std::move(finished)]()
+    {
+        auto self = weak_self.lock();
+        if (!self)
+        {
+            return;
+        }
+
+        auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+        auto const& processing = self->m_replay_processing;
+        self->m_logger->info("Replay finished: {} records ({:.3f}s of capture) in {:.3f}s", self->m_replay->records(),
+            std::chrono::duration_cast<std::chrono::milliseconds>(self->m_replay->capture_duration()).count() / 1000.0,
+            elapsed.count() / 1000.0);
+        self->m_logger->info("Replay packet handling ms (p50/p99/max): {}/{}/{} over {} packets",
+            processing.percentile(0.5).count() / 1000.0, processing.percentile(0.99).count() / 1000.0,
+            processing.max().count() / 1000.0, processing.count());
+
+        // final statistics
+        for (auto& worker : self->m_workers)
+        {
+            worker->update_statistics(*self->m_stats_collector);
+        }
+        for (auto& stats_printer : self->m_stats_printers)
+        {
+            stats_printer->print();
+        }
+        if (finished)
+        {
+            finished();
+        }
+    });
+}
+
+void Worker_manager::process_replay_record(Packet_capture_record&& record)
 {
-    auto remaining_size = receive_buffer->size();
-    do
+    auto node_it = m_replay_nodes.find(record.m_stream);
+    if (node_it == m_replay_nodes.end())
+    {
+        // streams stand in for the node connections of the recorded miner, in the order they show up
+        network::Endpoint endpoint{ network::Transport_protocol::tcp, "127.0.0.1", record.m_stream };
+        auto node = create_node(endpoint);
+        m_logger->info("Replay: stream {} is node {}", record.m_stream, node->m_index);
+        m_nodes.push_back(node);
+        node_it = m_replay_nodes.emplace(record.m_stream, std::move(node)).first;
+    }
+    auto const& node = node_it->second;
+
+    switch (record.m_direction)
+    {
+    case Packet_trace::Direction::connect:
+        if (node->m_connection)
+        {
+            // the live miner dropped the connection without a close event (hung node)
+            retry_connect(node);
+        }
+        node->m_connection = std::make_shared<Replay_connection>(node->m_endpoint, node->m_endpoint);
+        on_connected(node);
+        break;
+    case Packet_trace::Direction::disconnect:
+        if (node->m_connection)
+        {
+            retry_connect(node);
+        }
+        break;
+    case Packet_trace::Direction::receive:
     {
-        auto packet = extract_packet_from_buffer(receive_buffer, remaining_size, receive_buffer->size() - remaining_size);
+        if (!node->m_connection)
+        {
+            // capture started on an established connection
+            node->m_connection = std::make_shared<Replay_connection>(node->m_endpoint, node->m_endpoint);
+            on_connected(node);
+        }
+        auto const start = std::chrono::steady_clock::now();
+        process_data(*node, record.get_wire_bytes());
+        m_replay_processing.record(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start));
+        break;
+    }
+    case Packet_trace::Direction::send:
+    default:
+        // the miner under test sends its own packets
+        break;
+    }
+}
+
+void Worker_manager::activate_node(std::shared_ptr<Node> const& node, char const* reason)
+{
+    if (m_active_node == node)
+    {
+        return;
+    }
+
+    if (m_nodes.size() > 1)
+    {
+        m_logger->info("[Solo] Mining for node {} ({}, rtt {:.3f} ms)", node->m_endpoint.to_string(), reason,
+            node->m_rtt.count() / 1000.0);
+    }
+    m_active_node = node;
+
+    auto const template_prefetch_interval = m_config.get_template_prefetch_interval();
+    if (!m_config.get_pool_config().m_use_pool && template_prefetch_interval > 0)
+    {
+        m_logger->info("[Solo] Template prefetch enabled, standby template refreshed every {}s", template_prefetch_interval);
+        m_timer_manager.start_template_prefetch_timer(template_prefetch_interval, node->m_connection, node->m_protocol);
+    }
+}
+
+std::shared_ptr<Worker_manager::Node> Worker_manager::select_failover_node() const
+{
+    std::shared_ptr<Node> best_node;
+    for (auto const& node : m_nodes)
+    {
+        if (node == m_active_node || !node->m_logged_in || !node->m_connection)
+        {
+            continue;
+        }
+        if (!best_node)
+        {
+            best_node = node;
+            continue;
+        }
+        // measured round trips win over unmeasured ones, then the fastest, then the configured order
+        auto const measured = node->m_rtt.count() != 0;
+        auto const best_measured = best_node->m_rtt.count() != 0;
+        if (measured != best_measured ? measured : (measured && node->m_rtt < best_node->m_rtt))
+        {
+            best_node = node;
+        }
+    }
+    return best_node;
+}
+
+void Worker_manager::start_probe(std::shared_ptr<Node> const& node)
+{
+    // a node that answered probes before and misses this many in a row is considered hung
+    constexpr std::uint16_t max_unanswered_probes = 3;
+
+    std::weak_ptr<Worker_manager> weak_self = shared_from_this();
+    std::weak_ptr<Node> weak_node = node;
+    node->m_probe_timer->start(chrono::Seconds(m_config.get_height_interval()), [weak_self, weak_node](bool canceled)
+    {
+        if (canceled)	// don't do anything if the timer has been canceled
+        {
+            return;
+        }
+
+        auto self = weak_self.lock();
+        auto node = weak_node.lock();
+        if (!self || !node || !node->m_connection)
+        {
+            return;
+        }
+
+        if (node->m_probe_sent && node->m_rtt.count() != 0 && ++node->m_probes_unanswered >= max_unanswered_probes)
+        {
+            self->m_logger->error("[Solo] Node {} missed {} GET_HEIGHT probes, closing connection", node->m_endpoint.to_string(),
+                node->m_probes_unanswered);
+            self->retry_connect(node);
+            return;
+        }
+
+        Packet packet_get_height{ Packet::GET_HEIGHT };
+        node->m_connection->transmit(packet_get_height.get_bytes());
+        node->m_probe_sent = std::chrono::steady_clock::now();
+        self->start_probe(node);
+    });
+}
+
+void Worker_manager::on_new_template(std::shared_ptr<Node> const& node, ::LLP::CBlock const& block, std::uint32_t nBits)
+{
+    if (node != m_active_node)
+    {
+        // the active node already delivered this height
+        if (block.nHeight <= m_template_height)
+        {
+            m_logger->debug("[Solo] Block {} from node {} ignored, already mining it", block.nHeight, node->m_endpoint.to_string());
+            return;
+        }
+        activate_node(node, "delivered the new block first");
+    }
+    if (block.nHeight > m_template_height)
+    {
+        node->m_templates_first++;
+    }
+    m_template_height = block.nHeight;
+    if (node->m_packet_received)
+    {
+        m_stats_collector->get_block_latency().m_template_validate.record(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - *node->m_packet_received));
+    }
+
+    // workers switch concurrently in the distributor threads, the io thread continues with the next packet.
+    // a found block goes back to the node that issued the template, only that node knows it.
+    std::weak_ptr<Worker_manager> weak_self = shared_from_this();
+    std::weak_ptr<Node> weak_node = node;
+    m_work_distributor->publish(block, nBits, [weak_self, weak_node](auto id, auto block_data)
+    {
+        auto self = weak_self.lock();
+        if (!self)
+        {
+            return;
+        }
+        // workers report from their own threads or asio's system pool, node and protocol state belong to the io thread
+        std::shared_ptr<Block_data> found_block = std::move(block_data);
+        ::asio::post(*self->m_io_context, [weak_self, weak_node, found_block]()
+        {
+            if (auto self = weak_self.lock())
+            {
+                self->submit_block(weak_node, *found_block);
+            }
+        });
+    });
+}
+
+void Worker_manager::submit_block(std::weak_ptr<Node> node, Block_data const& block_data)
+{
+    auto node_shared = node.lock();
+    if (!node_shared || !node_shared->m_connection)
+    {
+        m_logger->error("No connection to the node of the block template. Can't submit block.");
+        return;
+    }
+
+    auto const found = std::chrono::steady_clock::now();
+    auto const checked = block_data.m_checked;
+    if (block_data.m_found.time_since_epoch().count() != 0 && checked.time_since_epoch().count() != 0)
+    {
+        m_stats_collector->get_block_latency().m_found_to_checked.record(
+            std::chrono::duration_cast<std::chrono::microseconds>(checked - block_data.m_found));
+    }
+    std::weak_ptr<Worker_manager> weak_self = shared_from_this();
+    // no strong reference to the manager on the signing thread, it owns that thread and must not be released there
+    node_shared->m_protocol->submit_block(block_data.merkle_root.GetBytes(), block_data.nNonce,
+        [weak_self, node, found, checked, stats_collector = m_stats_collector, io_context = m_io_context](
+            network::Gather_payload submission)
+    {
+        auto const signed_time = std::chrono::steady_clock::now();
+        if (checked.time_since_epoch().count() != 0)
+        {
+            stats_collector->get_block_latency().m_checked_to_signed.record(
+                std::chrono::duration_cast<std::chrono::microseconds>(signed_time - checked));
+        }
+
+        // the protocol may finish the submission on its signing thread, the connection belongs to the io thread
+        ::asio::post(*io_context, [weak_self, node, found, signed_time, submission = std::move(submission)]() mutable
+        {
+            auto self = weak_self.lock();
+            auto node_shared = node.lock();
+            if (!self || !node_shared)
+            {
+                return;
+            }
+            if (!node_shared->m_connection)
+            {
+                self->m_logger->error("No connection. Can't submit block.");
+                return;
+            }
+            node_shared->m_connection->transmit(std::move(submission));
+            auto const transmitted = std::chrono::steady_clock::now();
+            self->m_stats_collector->get_submit_latency().m_find_to_transmit.record(
+                std::chrono::duration_cast<std::chrono::microseconds>(transmitted - found));
+            self->m_stats_collector->get_block_latency().m_signed_to_transmit.record(
+                std::chrono::duration_cast<std::chrono::microseconds>(transmitted - signed_time));
+            // the node answers submissions in order, a node that never answers doesn't grow the queue forever
+            constexpr std::size_t max_unanswered_submissions = 64;
+            if (node_shared->m_submitted.size() >= max_unanswered_submissions)
+            {
+                node_shared->m_submitted.pop_front();
+            }
+            node_shared->m_submitted.push_back(transmitted);
+        });
+    });
+}
+
+void Worker_manager::process_data(Node& node, network::Shared_payload&& receive_buffer)
+{
+    if (!receive_buffer)
+    {
+        return;
+    }
+
+    auto const received = std::chrono::steady_clock::now();
+    // packets can be split across reads, the framer keeps the partial packet until the rest arrives
+    node.m_packet_framer->append(*receive_buffer);
+
+    Packet packet;
+    auto result = node.m_packet_framer->next(packet);
+    for (; result == Packet_framer::Result::packet; result = node.m_packet_framer->next(packet))
+    {
+        Packet_trace::instance().trace(Packet_trace::Direction::receive, node.m_connection->local_endpoint().port(),
+            packet.m_header, packet.m_length, packet.m_data);
+
         if (!packet.is_valid())
         {
             m_logger->debug("Received packet is invalid. Header: {0}", packet.m_header);
@@ -372,14 +1132,46 @@ void Worker_manager::process_data(network::Shared_payload&& receive_buffer)
         if (packet.m_header == Packet::PING)
         {
             m_logger->trace("PING received");
+            continue;
         }
-        else
+
+        if (packet.m_header == Packet::BLOCK_HEIGHT && node.m_probe_sent)
+        {
+            // smoothed like the TCP srtt, 1/8 weight for the new sample
+            auto const sample = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - *node.m_probe_sent);
+            node.m_rtt = node.m_rtt.count() == 0 ? sample : (node.m_rtt * 7 + sample) / 8;
+            node.m_probe_sent.reset();
+            node.m_probes_unanswered = 0;
+            m_logger->debug("[Solo] Node {} rtt {:.3f} ms (sample {:.3f} ms, first for {} blocks)", node.m_endpoint.to_string(),
+                node.m_rtt.count() / 1000.0, sample.count() / 1000.0, node.m_templates_first);
+        }
+
+        if ((packet.m_header == Packet::ACCEPT || packet.m_header == Packet::REJECT) && !node.m_submitted.empty())
+        {
+            m_stats_collector->get_block_latency().m_submit_to_result.record(std::chrono::duration_cast<std::chrono::microseconds>(
+                received - node.m_submitted.front()));
+            node.m_submitted.pop_front();
+        }
+
+        // solo/pool specific messages
+        node.m_packet_received = received;
+        node.m_protocol->process_messages(std::move(packet), node.m_connection);
+        node.m_packet_received.reset();
+        if (!node.m_connection)
         {
-            // solo/pool specific messages
-            m_miner_protocol->process_messages(std::move(packet), m_connection);
+            // the protocol handler dropped the connection
+            return;
         }
     }
-    while (remaining_size != 0);
+
+    if (result == Packet_framer::Result::corrupt)
+    {
+        m_logger->error("Received packet length exceeds {} bytes, stream out of sync. Closing connection.",
+            Packet_framer::default_max_packet_length);
+        node.m_packet_framer->reset();
+        node.m_connection->close();
+    }
 }
 
-}
\ No newline at end of file
+}
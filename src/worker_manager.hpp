@@ -3,22 +3,38 @@
 
 #include "network/connection.hpp"
 #include "network/socket.hpp"
+#include "network/socket_factory.hpp"
 #include "network/types.hpp"
 #include <spdlog/spdlog.h>
 #include "chrono/timer_factory.hpp"
 #include "timer_manager.hpp"
 #include "stats/stats_printer.hpp"
+#include "stats/latency_histogram.hpp"
 
 #include <memory>
+#include <vector>
+#include <map>
+#include <string>
+#include <functional>
+#include <optional>
+#include <deque>
+#include <chrono>
 
 namespace asio { class io_context; }
+namespace LLP { class CBlock; }
 
 namespace nexusminer 
 {
-namespace config { class Config; }
+namespace config { class Config; class Worker_config; struct Config_changes; }
 namespace stats { class Collector; }
-namespace protocol { class Protocol; }
+namespace protocol { class Protocol; class FalconSignatureWrapper; class Signing_executor; }
+namespace cpu { class Calibration; class Scheduler; class Throttle; }
 class Worker;
+class Block_data;
+class Packet_framer;
+class Work_distributor;
+class Capture_replay;
+struct Packet_capture_record;
 
 class Worker_manager : public std::enable_shared_from_this<Worker_manager>
 {
@@ -27,33 +43,117 @@ public:
     using Config = config::Config;
 
     Worker_manager(std::shared_ptr<asio::io_context> io_context, Config& config, 
-        chrono::Timer_factory::Sptr timer_factory, network::Socket::Sptr socket);
+        chrono::Timer_factory::Sptr timer_factory, network::Socket_factory::Sptr socket_factory,
+        network::Endpoint local_endpoint);
 
-    bool connect(network::Endpoint const& wallet_endpoint);
+    // connect to all wallets/nodes in parallel, the first one is the primary node
+    bool connect(std::vector<network::Endpoint> const& wallet_endpoints);
+
+    // feed the received packets and connection events of an LLP capture through the workers instead of
+    // connecting. speed scales the original pace, 0 = as fast as possible. finished is called at the end.
+    bool replay(std::string const& capture_file, double speed, std::function<void()> finished);
 
     // stop the component and destroy all workers
     void stop();
 
-private:
+    // Apply a reloaded config (already compared with the running one). Workers whose hardware settings are unchanged
+    // keep mining, changed ones are replaced, a reconnect only happens if the nodes, the pool login or the keys changed.
+    void reload(Config const& reloaded, config::Config_changes const& changes,
+        std::vector<network::Endpoint> const& wallet_endpoints, network::Endpoint local_endpoint);
 
-    void process_data(network::Shared_payload&& receive_buffer);
+private:
 
+    // One wallet/node session. Every node has its own connection, protocol state and timers.
+    struct Node
+    {
+        std::size_t m_index{ 0 };
+        network::Endpoint m_endpoint;
+        network::Socket::Sptr m_socket;
+        network::Connection::Sptr m_connection;
+        std::shared_ptr<Packet_framer> m_packet_framer;
+        std::shared_ptr<protocol::Protocol> m_protocol;
+        chrono::Timer::Uptr m_retry_timer;
+        chrono::Timer::Uptr m_probe_timer;
+        bool m_logged_in{ false };
+        std::optional<std::chrono::steady_clock::time_point> m_probe_sent;
+        std::uint16_t m_probes_unanswered{ 0 };
+        std::chrono::microseconds m_rtt{ 0 };      // smoothed GET_HEIGHT round trip, 0 = not measured yet
+        std::uint64_t m_templates_first{ 0 };     // new heights this node delivered before the others
+        // block lifecycle stats: the packet in process_messages and the submissions waiting for ACCEPT/REJECT
+        std::optional<std::chrono::steady_clock::time_point> m_packet_received;
+        std::deque<std::chrono::steady_clock::time_point> m_submitted;
+    };
+
+    std::shared_ptr<Node> create_node(network::Endpoint endpoint);
+    bool connect(std::shared_ptr<Node> const& node);
+    // connection established: login, then the protocol hands out templates
+    void on_connected(std::shared_ptr<Node> const& node);
+    void process_data(Node& node, network::Shared_payload&& receive_buffer);
+    void process_replay_record(Packet_capture_record&& record);
+    // sign (protocol) and transmit a found block, the latency is recorded in the stats collector. io thread only.
+    void submit_block(std::weak_ptr<Node> node, Block_data const& block_data);
+    // template from a node: published to the workers if it comes from the active node or is the first for a new height
+    void on_new_template(std::shared_ptr<Node> const& node, ::LLP::CBlock const& block, std::uint32_t nBits);
+    // make the node the one the workers mine for
+    void activate_node(std::shared_ptr<Node> const& node, char const* reason);
+    // connected node with the lowest round trip time, nullptr if there is none
+    std::shared_ptr<Node> select_failover_node() const;
+    // GET_HEIGHT probes measure the round trip and detect hung nodes
+    void start_probe(std::shared_ptr<Node> const& node);
+
+    // a configured worker, the slot index is its internal id
+    struct Worker_slot
+    {
+        std::unique_ptr<config::Worker_config> m_config;    // the worker references it, a reload replaces the config vector
+        std::shared_ptr<Worker> m_worker;                   // nullptr if this build doesn't support the hardware
+        std::shared_ptr<cpu::Throttle> m_throttle;          // cpu workers
+    };
+
+    std::shared_ptr<protocol::Protocol> create_protocol() const;
     void create_stats_printers();
     void create_workers();
-
-    void retry_connect(network::Endpoint const& wallet_endpoint);
+    void create_worker(Worker_slot& slot);
+    // (re)build the cpu scheduler from the throttled workers of the slots
+    void start_cpu_scheduler();
+    // workers of a reloaded config, true if workers were added, removed or replaced
+    bool update_workers();
+    std::unique_ptr<cpu::Calibration> run_calibration();
+    // parse the solo Falcon keys of config and replace the signer, false if they are missing or invalid
+    bool create_signer(Config const& config);
+    void start_stats_timers();
+
+    void retry_connect(std::shared_ptr<Node> const& node);
+    // close all node connections, the workers keep mining their block
+    void disconnect();
 
 	std::shared_ptr<::asio::io_context> m_io_context;
     Config& m_config;
-	network::Socket::Sptr m_socket;
-	network::Connection::Sptr m_connection;
+    chrono::Timer_factory::Sptr m_timer_factory;
+	network::Socket_factory::Sptr m_socket_factory;
+    network::Endpoint m_local_endpoint;
     std::shared_ptr<spdlog::logger> m_logger;
     std::shared_ptr<stats::Collector> m_stats_collector;
     Timer_manager m_timer_manager;
-    std::shared_ptr<protocol::Protocol> m_miner_protocol;
+
+    // solo Falcon signer, the key is expanded once and every node session signs with it on the one signing thread
+    std::shared_ptr<protocol::FalconSignatureWrapper> m_falcon_wrapper;
+    std::shared_ptr<protocol::Signing_executor> m_signing_executor;
+
+    std::vector<std::shared_ptr<Node>> m_nodes;
+    std::shared_ptr<Node> m_active_node;        // workers mine its templates, found blocks go back to it
+    std::uint32_t m_template_height{ 0 };       // height of the template the workers mine
+
+    // capture replay instead of live connections, the nodes are keyed by the stream (local port) of the capture
+    std::shared_ptr<Capture_replay> m_replay;
+    std::map<std::uint16_t, std::shared_ptr<Node>> m_replay_nodes;
+    stats::Latency_histogram m_replay_processing;     // process_data time per replayed packet
 
     std::vector<std::shared_ptr<stats::Printer>> m_stats_printers;
-    std::vector<std::shared_ptr<Worker>> m_workers;
+    bool m_stats_timers_started{ false };
+    std::vector<Worker_slot> m_worker_slots;
+    std::vector<std::shared_ptr<Worker>> m_workers;     // the created workers of the slots, in slot order
+    std::shared_ptr<Work_distributor> m_work_distributor;
+    std::shared_ptr<cpu::Scheduler> m_cpu_scheduler;     // target hashrate / power limit of cpu workers
 };
 }
 